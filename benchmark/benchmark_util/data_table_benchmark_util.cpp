@@ -1,7 +1,10 @@
 #include "benchmark_util/data_table_benchmark_util.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
 #include <cstring>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -60,10 +63,22 @@ void RandomDataTableTransaction::RandomSelect(Random *generator) {
 }
 
 void RandomDataTableTransaction::Finish() {
-  if (aborted_)
+  if (aborted_) {
     test_object_->txn_manager_.Abort(txn_);
-  else
+  } else if (!test_object_->wait_for_durable_) {
     commit_time_ = test_object_->txn_manager_.Commit(txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  } else {
+    std::atomic<bool> durable = false;
+    const auto commit_start = std::chrono::high_resolution_clock::now();
+    commit_time_ = test_object_->txn_manager_.Commit(
+        txn_, [](void *arg) { reinterpret_cast<std::atomic<bool> *>(arg)->store(true); }, &durable);
+    while (!durable.load()) std::this_thread::yield();
+    const auto latency_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - commit_start)
+            .count());
+    common::SpinLatch::ScopedSpinLatch guard(&test_object_->commit_latencies_latch_);
+    test_object_->commit_latencies_us_.push_back(latency_us);
+  }
 }
 
 LargeDataTableBenchmarkObject::LargeDataTableBenchmarkObject(const std::vector<uint16_t> &attr_sizes,
@@ -0,0 +1,173 @@
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "catalog/catalog.h"
+#include "execution/ast/context.h"
+#include "execution/compiler/compiler.h"
+#include "execution/compiler/compiler_settings.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sema/error_reporter.h"
+#include "execution/table_generator/table_generator.h"
+#include "execution/util/region.h"
+#include "execution/vm/module.h"
+#include "main/db_main.h"
+#include "test_util/fs_util.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage {
+
+/**
+ * Measures the bytecode interpreter on the sample TPL programs, with and without superinstructions. Only the
+ * interpretation of main() is timed; parsing, code generation and test table generation happen in SetUp().
+ *
+ * Benchmark arguments: the index of the program in PROGRAMS, and whether superinstructions are fused (1) or not (0).
+ */
+class InterpreterBenchmark : public benchmark::Fixture {
+ public:
+  /** A sample TPL program that does not modify the test tables, so that it can be run repeatedly. */
+  struct Program {
+    /** The file name, relative to sample_tpl/. */
+    const char *file_;
+    /** True if main() takes an execution context. */
+    bool is_sql_;
+    /** The value main() returns, see sample_tpl/tpl_tests.txt. */
+    int32_t expected_;
+  };
+
+  // clang-format off
+  static constexpr Program PROGRAMS[] = {
+      {"loop4.tpl",          false, 166167000},
+      {"fib.tpl",            false, 832040},
+      {"compare.tpl",        false, 200},
+      {"array-iterate.tpl",  false, 110},
+      {"if-3.tpl",           false, 100},
+      {"struct-debug.tpl",   false, 100000},
+      {"scan-table.tpl",     true,  500},
+      {"scan-table-2.tpl",   true,  9950},
+      {"scan-vpi-iter.tpl",  true,  500},
+      {"vec-filter.tpl",     true,  2000},
+      {"agg.tpl",            true,  10},
+      {"join.tpl",           true,  1000},
+      {"sort.tpl",           true,  2000},
+  };
+  // clang-format on
+
+  /** The number of benchmarked programs. */
+  static constexpr int64_t NUM_PROGRAMS = sizeof(PROGRAMS) / sizeof(PROGRAMS[0]);
+
+  void SetUp(const benchmark::State &state) final {
+    program_ = &PROGRAMS[state.range(0)];
+
+    db_main_ = DBMain::Builder()
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseGCThread(true)
+                   .SetUseExecution(true)
+                   .SetBytecodeHandlersPath(common::GetBinaryArtifactPath("bytecode_handlers_ir.bc"))
+                   .Build();
+
+    auto catalog = db_main_->GetCatalogLayer()->GetCatalog();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    txn_ = txn_manager_->BeginTransaction();
+    auto db_oid = catalog->CreateDatabase(common::ManagedPointer(txn_), "interpreter_benchmark_db", true);
+    accessor_ = catalog->GetAccessor(common::ManagedPointer(txn_), db_oid, DISABLED);
+
+    exec_ctx_ = std::make_unique<execution::exec::ExecutionContext>(
+        db_oid, common::ManagedPointer(txn_), callback_, nullptr, common::ManagedPointer(accessor_), exec_settings_,
+        db_main_->GetMetricsManager(), DISABLED, DISABLED);
+    exec_ctx_->SetExecutionMode(static_cast<uint8_t>(execution::vm::ExecutionMode::Interpret));
+    if (program_->is_sql_) {
+      execution::sql::TableGenerator table_generator{exec_ctx_.get(), db_main_->GetStorageLayer()->GetBlockStore(),
+                                                     accessor_->GetDefaultNamespace()};
+      table_generator.GenerateTestTables();
+    }
+
+    // Compile the program to bytecode
+    std::ifstream file(common::GetBuildRootPath() + "/../sample_tpl/" + program_->file_);
+    std::stringstream source;
+    source << file.rdbuf();
+    source_ = source.str();
+
+    execution::compiler::CompilerSettings settings;
+    settings.SetShouldFuseSuperinstructions(state.range(1) != 0);
+    error_region_ = std::make_unique<execution::util::Region>("interpreter_benchmark_errors");
+    context_region_ = std::make_unique<execution::util::Region>("interpreter_benchmark_context");
+    error_reporter_ = std::make_unique<execution::sema::ErrorReporter>(error_region_.get());
+    context_ = std::make_unique<execution::ast::Context>(context_region_.get(), error_reporter_.get());
+    execution::compiler::Compiler::Input input(program_->file_, context_.get(), &source_, settings);
+    module_ = execution::compiler::Compiler::RunCompilationSimple(input);
+    NOISEPAGE_ASSERT(module_ != nullptr, "Sample TPL program failed to compile.");
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    module_.reset();
+    context_.reset();
+    error_reporter_.reset();
+    context_region_.reset();
+    error_region_.reset();
+    exec_ctx_.reset();
+    accessor_.reset();
+    txn_manager_->Abort(txn_);
+    // free db main here so we don't need to use the loggers anymore
+    db_main_.reset();
+  }
+
+  /** Interpret main() of the program once. */
+  int32_t RunMain() {
+    if (program_->is_sql_) {
+      std::function<int32_t(execution::exec::ExecutionContext *)> main;
+      module_->GetFunction("main", execution::vm::ExecutionMode::Interpret, &main);
+      return main(exec_ctx_.get());
+    }
+    std::function<int32_t()> main;
+    module_->GetFunction("main", execution::vm::ExecutionMode::Interpret, &main);
+    return main();
+  }
+
+  /** Register one benchmark per program, each with and without superinstructions. */
+  static void Arguments(benchmark::internal::Benchmark *b) {
+    for (int64_t program = 0; program < NUM_PROGRAMS; program++) {
+      for (int64_t fuse = 0; fuse <= 1; fuse++) {
+        b->Args({program, fuse});
+      }
+    }
+  }
+
+  const Program *program_;
+  std::string source_;
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  transaction::TransactionContext *txn_;
+  std::unique_ptr<catalog::CatalogAccessor> accessor_;
+  execution::exec::ExecutionSettings exec_settings_{};
+  execution::exec::OutputCallback callback_ = nullptr;
+  std::unique_ptr<execution::exec::ExecutionContext> exec_ctx_;
+  std::unique_ptr<execution::util::Region> error_region_;
+  std::unique_ptr<execution::util::Region> context_region_;
+  std::unique_ptr<execution::sema::ErrorReporter> error_reporter_;
+  std::unique_ptr<execution::ast::Context> context_;
+  std::unique_ptr<execution::vm::Module> module_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(InterpreterBenchmark, SampleTPL)(benchmark::State &state) {
+  state.SetLabel(std::string(program_->file_) + (state.range(1) != 0 ? " (fused)" : ""));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    const auto result = RunMain();
+    NOISEPAGE_ASSERT(result == program_->expected_, "Sample TPL program returned an unexpected value.");
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(InterpreterBenchmark, SampleTPL)
+    ->Unit(benchmark::kMillisecond)
+    ->Apply(InterpreterBenchmark::Arguments);
+}  // namespace noisepage
@@ -0,0 +1,179 @@
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "common/hash_util.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/join_hash_table.h"
+#include "execution/sql/static_vector.h"
+#include "execution/sql/thread_state_container.h"
+#include "execution/sql/vector.h"
+#include "execution/util/timer.h"
+
+namespace noisepage {
+
+/**
+ * Measures building and probing join hash tables of growing sizes in each of the ways a table can be built:
+ * - Chaining: thread-local tables are merged by inserting all their tuples concurrently into the global table.
+ * - Concise: a single table is built serially into a concise hash table, as concise tables cannot be merged.
+ * - Partitioned: thread-local tables are merged by radix-partitioning their tuples, see JoinHashTable.
+ *
+ * Every build key is unique and probed once, in batches of vectors as the vectorized probe does. Populating the
+ * tables is not timed. The build and probe times of the last iteration are reported as counters.
+ *
+ * Benchmark arguments: the build mode, and the number of build tuples.
+ */
+class JoinHashTableBenchmark : public benchmark::Fixture {
+ public:
+  /** The ways a join hash table is built. */
+  enum class Mode : int64_t { Chaining = 0, Concise, Partitioned };
+
+  /** A build tuple. */
+  struct Tuple {
+    /** The join key. */
+    uint64_t key_;
+    /** The payload. */
+    uint64_t val_;
+  };
+
+  void SetUp(const benchmark::State &state) final {
+    mode_ = static_cast<Mode>(state.range(0));
+    num_tuples_ = state.range(1);
+    exec_settings_.is_join_radix_partitioning_enabled_ = mode_ == Mode::Partitioned;
+  }
+
+  /** @return A fresh execution context, whose memory pool backs the tables built with it. */
+  std::unique_ptr<execution::exec::ExecutionContext> MakeExecCtx() {
+    return std::make_unique<execution::exec::ExecutionContext>(catalog::db_oid_t(0), DISABLED, callback_, nullptr,
+                                                               DISABLED, exec_settings_, DISABLED, DISABLED, DISABLED);
+  }
+
+  /** Insert the build tuples with keys in the given range into the table. */
+  static void Populate(execution::sql::JoinHashTable *jht, uint64_t begin, uint64_t end) {
+    for (uint64_t key = begin; key < end; key++) {
+      auto *tuple = reinterpret_cast<Tuple *>(jht->AllocInputTuple(common::HashUtil::Hash(key)));
+      tuple->key_ = key;
+      tuple->val_ = key;
+    }
+  }
+
+  /** Insert all build tuples for the benchmarked mode, into thread-local tables in the container if it merges them. */
+  void PopulateAll(execution::exec::ExecutionContext *exec_ctx, execution::sql::ThreadStateContainer *container,
+                   execution::sql::JoinHashTable *jht) const {
+    if (mode_ == Mode::Concise) {
+      Populate(jht, 0, num_tuples_);
+      return;
+    }
+
+    container->Reset(
+        sizeof(execution::sql::JoinHashTable),
+        [](auto *ctx, auto *s) {
+          auto *exec_ctx = reinterpret_cast<execution::exec::ExecutionContext *>(ctx);
+          new (s) execution::sql::JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+        },
+        [](auto *ctx, auto *s) { reinterpret_cast<execution::sql::JoinHashTable *>(s)->~JoinHashTable(); }, exec_ctx);
+    tbb::parallel_for(tbb::blocked_range<uint64_t>(0, num_tuples_, std::max(uint64_t{1}, num_tuples_ / 64)),
+                      [&](const auto &range) {
+                        Populate(container->AccessCurrentThreadStateAs<execution::sql::JoinHashTable>(),
+                                 range.begin(), range.end());
+                      });
+  }
+
+  /** Build the populated table in the benchmarked mode. */
+  void Build(execution::sql::ThreadStateContainer *container, execution::sql::JoinHashTable *jht) const {
+    if (mode_ == Mode::Concise) {
+      jht->Build();
+    } else {
+      jht->MergeParallel(container, 0);
+    }
+  }
+
+  /** Probe every build key once in vector-sized batches. @return The number of keys that found their tuple. */
+  uint64_t Probe(const execution::sql::JoinHashTable &jht) const {
+    execution::sql::StaticVector<hash_t> hashes;
+    execution::sql::Vector results(execution::sql::TypeId::Pointer, true, true);
+    auto *raw_hashes = reinterpret_cast<hash_t *>(hashes.GetData());
+    // Entries of a concise table are not chained, but every key is unique
+    const bool follow_chains = !jht.UsingConciseHashTable();
+    uint64_t num_found = 0;
+    for (uint64_t begin = 0; begin < num_tuples_; begin += common::Constants::K_DEFAULT_VECTOR_SIZE) {
+      const uint64_t size = std::min<uint64_t>(common::Constants::K_DEFAULT_VECTOR_SIZE, num_tuples_ - begin);
+      hashes.Resize(size);
+      for (uint64_t i = 0; i < size; i++) {
+        raw_hashes[i] = common::HashUtil::Hash(begin + i);
+      }
+      jht.LookupBatch(hashes, &results);
+
+      const auto *entries = reinterpret_cast<const execution::sql::HashTableEntry *const *>(results.GetData());
+      for (uint64_t i = 0; i < size; i++) {
+        for (const auto *entry = entries[i]; entry != nullptr; entry = follow_chains ? entry->next_ : nullptr) {
+          if (entry->PayloadAs<Tuple>()->key_ == begin + i) {
+            num_found++;
+            break;
+          }
+        }
+      }
+    }
+    return num_found;
+  }
+
+  /** Register every mode with build sizes from 1K to 100M tuples. */
+  static void Arguments(benchmark::internal::Benchmark *b) {
+    for (int64_t mode = 0; mode <= static_cast<int64_t>(Mode::Partitioned); mode++) {
+      for (int64_t size = 1000; size <= 100000000; size *= 10) {
+        b->Args({mode, size});
+      }
+    }
+  }
+
+  Mode mode_;
+  uint64_t num_tuples_;
+  execution::exec::ExecutionSettings exec_settings_{};
+  execution::exec::OutputCallback callback_ = nullptr;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, BuildAndProbe)(benchmark::State &state) {
+  constexpr const char *mode_names[] = {"chaining", "concise", "partitioned"};
+  state.SetLabel(mode_names[state.range(0)]);
+  tbb::task_scheduler_init sched;
+
+  double build_ms = 0, probe_ms = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto exec_ctx = MakeExecCtx();
+    execution::sql::ThreadStateContainer container(exec_ctx->GetMemoryPool());
+    execution::sql::JoinHashTable jht(exec_settings_, exec_ctx.get(), sizeof(Tuple), mode_ == Mode::Concise);
+
+    PopulateAll(exec_ctx.get(), &container, &jht);
+    state.ResumeTiming();
+
+    execution::util::Timer<std::milli> timer;
+    timer.Start();
+    Build(&container, &jht);
+    timer.Stop();
+    build_ms = timer.GetElapsed();
+
+    timer.Start();
+    const auto num_found = Probe(jht);
+    timer.Stop();
+    probe_ms = timer.GetElapsed();
+    NOISEPAGE_ASSERT(num_found == num_tuples_, "Every build key should be found.");
+    benchmark::DoNotOptimize(num_found);
+  }
+  state.counters["build_ms"] = build_ms;
+  state.counters["probe_ms"] = probe_ms;
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+}
+
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, BuildAndProbe)
+    ->Unit(benchmark::kMillisecond)
+    ->Apply(JoinHashTableBenchmark::Arguments);
+}  // namespace noisepage
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "common/spin_latch.h"
 #include "metrics/metrics_thread.h"
 #include "storage/data_table.h"
 #include "test_util/storage_test_util.h"
@@ -142,6 +143,21 @@ class LargeDataTableBenchmarkObject {
    */
   const storage::BlockLayout &Layout() const { return layout_; }
 
+  /**
+   * Makes simulated transactions block until their commits are durable, like clients of the network layer do, and
+   * record how long they blocked.
+   * @param wait_for_durable whether transactions wait for their commits to be durable
+   */
+  void SetWaitForDurable(bool wait_for_durable) { wait_for_durable_ = wait_for_durable; }
+
+  /**
+   * @return commit-to-durable latencies in microseconds recorded since the last call, see SetWaitForDurable
+   */
+  std::vector<uint64_t> TakeCommitLatencies() {
+    common::SpinLatch::ScopedSpinLatch guard(&commit_latencies_latch_);
+    return std::move(commit_latencies_us_);
+  }
+
  private:
   void SimulateOneTransaction(RandomDataTableTransaction *txn, uint32_t txn_id);
 
@@ -167,5 +183,9 @@ class LargeDataTableBenchmarkObject {
   transaction::TimestampManager timestamp_manager_;
   uint32_t txn_length_;
   bool gc_on_;
+
+  bool wait_for_durable_ = false;
+  common::SpinLatch commit_latencies_latch_;
+  std::vector<uint64_t> commit_latencies_us_;
 };
 }  // namespace noisepage
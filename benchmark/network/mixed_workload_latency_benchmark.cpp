@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <pqxx/pqxx>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "catalog/catalog_defs.h"
+#include "main/db_main.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage {
+
+/**
+ * Measures the latency of short point queries while long analytical queries run on other connections of the same
+ * server. All connections are spread over a small number of connection handler threads, so when queries execute on
+ * the handler threads a point query can be stuck behind an analytical query that happens to share its handler. With
+ * an ExecutionScheduler, the handlers only decode packets and the queries run on the execution workers instead.
+ *
+ * Every iteration runs a fixed number of point queries on each OLTP client while the OLAP clients keep issuing
+ * joins. The point query latency percentiles over all iterations are reported as counters.
+ *
+ * Benchmark arguments: the number of execution workers, 0 to execute on the connection handler threads.
+ */
+class MixedWorkloadLatencyBenchmark : public benchmark::Fixture {
+ public:
+  static constexpr uint16_t PORT = 15722;
+  static constexpr uint16_t NUM_HANDLER_THREADS = 2;
+  static constexpr uint32_t NUM_ROWS = 2000;
+  static constexpr uint32_t ROWS_PER_INSERT = 100;
+  static constexpr uint32_t NUM_OLTP_CLIENTS = 8;
+  static constexpr uint32_t NUM_OLAP_CLIENTS = 2;
+  static constexpr uint32_t NUM_OLTP_QUERIES = 200;
+
+  void SetUp(const benchmark::State &state) final {
+    db_main_ = DBMain::Builder()
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseGCThread(true)
+                   .SetUseTrafficCop(true)
+                   .SetUseStatsStorage(true)
+                   .SetUseNetwork(true)
+                   .SetUseExecution(true)
+                   .SetNetworkPort(PORT)
+                   .SetConnectionThreadCount(NUM_HANDLER_THREADS)
+                   .SetNetworkExecutionThreads(static_cast<uint16_t>(state.range(0)))
+                   .Build();
+    db_main_->GetNetworkLayer()->GetServer()->RunServer();
+
+    pqxx::connection c(ConnectionString());
+    pqxx::nontransaction txn(c);
+    txn.exec("CREATE TABLE mixed (k INT, v INT);");
+    for (uint32_t begin = 0; begin < NUM_ROWS; begin += ROWS_PER_INSERT) {
+      std::string insert = "INSERT INTO mixed VALUES ";
+      for (uint32_t k = begin; k < begin + ROWS_PER_INSERT; k++) {
+        insert += fmt::format("{}({}, {})", k == begin ? "" : ", ", k, (k * 7919) % NUM_ROWS);
+      }
+      txn.exec(insert + ";");
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final { db_main_.reset(); }
+
+  /** @return libpq connection string for the benchmarked server */
+  static std::string ConnectionString() {
+    return fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql", PORT,
+                       catalog::DEFAULT_DATABASE);
+  }
+
+  /** Run point queries on a connection, appending each one's latency in microseconds. */
+  static void RunOltpClient(std::vector<double> *latencies) {
+    pqxx::connection c(ConnectionString());
+    pqxx::nontransaction txn(c);
+    for (uint32_t i = 0; i < NUM_OLTP_QUERIES; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      txn.exec(fmt::format("SELECT v FROM mixed WHERE k = {};", (i * 31) % NUM_ROWS));
+      const auto end = std::chrono::steady_clock::now();
+      latencies->push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+  }
+
+  /** Run joins on a connection until told to stop. @return the number of joins that completed */
+  static uint64_t RunOlapClient(const std::atomic<bool> *done) {
+    pqxx::connection c(ConnectionString());
+    pqxx::nontransaction txn(c);
+    uint64_t num_queries = 0;
+    while (!done->load()) {
+      txn.exec("SELECT COUNT(*) FROM mixed AS a, mixed AS b WHERE a.v < b.k;");
+      num_queries++;
+    }
+    return num_queries;
+  }
+
+  /** @return the value at the given percentile of the sorted samples */
+  static double Percentile(const std::vector<double> &sorted, double percentile) {
+    if (sorted.empty()) return 0;
+    const auto idx = static_cast<uint64_t>(percentile / 100 * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(MixedWorkloadLatencyBenchmark, PointQueryLatency)(benchmark::State &state) {
+  state.SetLabel(state.range(0) == 0 ? "inline" : "scheduler");
+
+  std::vector<double> all_latencies;
+  uint64_t num_olap_queries = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    std::atomic<bool> done = false;
+    std::vector<uint64_t> olap_counts(NUM_OLAP_CLIENTS);
+    std::vector<std::thread> olap_clients;
+    for (uint32_t i = 0; i < NUM_OLAP_CLIENTS; i++) {
+      olap_clients.emplace_back([&, i] { olap_counts[i] = RunOlapClient(&done); });
+    }
+
+    std::vector<std::vector<double>> latencies(NUM_OLTP_CLIENTS);
+    std::vector<std::thread> oltp_clients;
+    for (uint32_t i = 0; i < NUM_OLTP_CLIENTS; i++) {
+      oltp_clients.emplace_back([&, i] { RunOltpClient(&latencies[i]); });
+    }
+    for (auto &client : oltp_clients) client.join();
+
+    done = true;
+    for (auto &client : olap_clients) client.join();
+
+    for (uint32_t i = 0; i < NUM_OLTP_CLIENTS; i++) {
+      all_latencies.insert(all_latencies.end(), latencies[i].begin(), latencies[i].end());
+    }
+    for (const auto count : olap_counts) num_olap_queries += count;
+  }
+
+  std::sort(all_latencies.begin(), all_latencies.end());
+  state.counters["p50_us"] = Percentile(all_latencies, 50);
+  state.counters["p99_us"] = Percentile(all_latencies, 99);
+  state.counters["max_us"] = all_latencies.empty() ? 0 : all_latencies.back();
+  state.counters["olap_queries"] = static_cast<double>(num_olap_queries);
+  state.SetItemsProcessed(static_cast<int64_t>(all_latencies.size()));
+}
+
+BENCHMARK_REGISTER_F(MixedWorkloadLatencyBenchmark, PointQueryLatency)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Iterations(3)
+    ->Arg(0)
+    ->Arg(4);
+}  // namespace noisepage
@@ -0,0 +1,82 @@
+#include <memory>
+#include <pqxx/pqxx>  // NOLINT
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "catalog/catalog_defs.h"
+#include "main/db_main.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage {
+
+/**
+ * Measures how fast a large scan is streamed from the server to a client on the same machine. Most of the time goes
+ * into serializing the execution engine's output batches into DataRow packets and writing the WriteQueue out to the
+ * socket, rather than into the scan itself.
+ *
+ * Benchmark arguments: the number of rows in the scanned table.
+ */
+class ResultStreamingBenchmark : public benchmark::Fixture {
+ public:
+  static constexpr uint16_t PORT = 15723;
+  static constexpr uint32_t ROWS_PER_INSERT = 1000;
+
+  void SetUp(const benchmark::State &state) final {
+    db_main_ = DBMain::Builder()
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseGCThread(true)
+                   .SetUseTrafficCop(true)
+                   .SetUseStatsStorage(true)
+                   .SetUseNetwork(true)
+                   .SetUseExecution(true)
+                   .SetNetworkPort(PORT)
+                   .Build();
+    db_main_->GetNetworkLayer()->GetServer()->RunServer();
+
+    const auto num_rows = static_cast<uint32_t>(state.range(0));
+    pqxx::connection c(ConnectionString());
+    pqxx::nontransaction txn(c);
+    txn.exec("CREATE TABLE stream (a INT, b BIGINT, c DOUBLE, d VARCHAR(32));");
+    for (uint32_t begin = 0; begin < num_rows; begin += ROWS_PER_INSERT) {
+      std::string insert = "INSERT INTO stream VALUES ";
+      for (uint32_t k = begin; k < begin + ROWS_PER_INSERT && k < num_rows; k++) {
+        insert += fmt::format("{}({}, {}, {}, 'row number {}')", k == begin ? "" : ", ", k,
+                              static_cast<uint64_t>(k) * 1000003, k * 0.5, k);
+      }
+      txn.exec(insert + ";");
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final { db_main_.reset(); }
+
+  /** @return libpq connection string for the benchmarked server */
+  static std::string ConnectionString() {
+    return fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql", PORT,
+                       catalog::DEFAULT_DATABASE);
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ResultStreamingBenchmark, FullScan)(benchmark::State &state) {
+  pqxx::connection c(ConnectionString());
+  pqxx::nontransaction txn(c);
+
+  uint64_t num_rows = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    pqxx::result r = txn.exec("SELECT * FROM stream;");
+    num_rows += r.size();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(num_rows));
+}
+
+BENCHMARK_REGISTER_F(ResultStreamingBenchmark, FullScan)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Arg(100000)
+    ->Arg(1000000);
+}  // namespace noisepage
@@ -0,0 +1,113 @@
+#include <chrono>  // NOLINT
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/scoped_timer.h"
+#include "execution/compiler/executable_query.h"
+#include "execution/execution_util.h"
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "main/db_main.h"
+#include "test_util/fs_util.h"
+#include "test_util/tpch/workload.h"
+
+namespace noisepage::runner {
+
+/**
+ * Measures how long it takes to JIT compile all TPC-H queries of the TPCHRunner, either from scratch (a cold cache,
+ * e.g., right after a restart with an empty cache) or by loading their object code from the compiled module cache.
+ */
+class CompiledModuleCacheRunner : public benchmark::Fixture {
+ public:
+  // To get tpl_tables, https://github.com/malin1993ml/tpl_tables and "bash gen_tpch.sh 0.1".
+  const std::string tpch_table_root_ = "../../../tpl_tables/tables/";
+  const std::string tpch_database_name_ = "compiled_module_cache_runner_db";
+  const std::string cache_path_ = "./compiled_module_cache_runner";
+
+  std::unique_ptr<DBMain> db_main_;
+  std::unique_ptr<tpch::Workload> workload_;
+  std::vector<const execution::vm::BytecodeModule *> modules_;
+
+  void SetUp(const benchmark::State &state) final {
+    auto db_main_builder = DBMain::Builder()
+                               .SetUseGC(true)
+                               .SetUseCatalog(true)
+                               .SetUseGCThread(true)
+                               .SetUseExecution(true)
+                               .SetBlockStoreSize(1000000)
+                               .SetBlockStoreReuse(1000000)
+                               .SetRecordBufferSegmentSize(1000000)
+                               .SetRecordBufferSegmentReuse(1000000)
+                               .SetBytecodeHandlersPath(common::GetBinaryArtifactPath("bytecode_handlers_ir.bc"))
+                               .SetCompiledModuleCachePath(cache_path_)
+                               .SetCompiledModuleCacheSize(1UL << 30);
+    db_main_ = db_main_builder.Build();
+
+    workload_ = std::make_unique<tpch::Workload>(common::ManagedPointer<DBMain>(db_main_), tpch_database_name_,
+                                                 tpch_table_root_, tpch::Workload::BenchmarkType::TPCH);
+    for (uint32_t query_idx = 0; query_idx < workload_->GetQueryNum(); query_idx++) {
+      for (const auto &fragment : workload_->GetQuery(query_idx).GetFragments()) {
+        modules_.push_back(fragment->GetModule()->GetBytecodeModule());
+      }
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    modules_.clear();
+    workload_.reset();
+    // free db main here so we don't need to use the loggers anymore
+    db_main_.reset();
+    std::error_code error;
+    std::filesystem::remove_all(cache_path_, error);
+  }
+
+  /** JIT compile every module of the workload, returning the elapsed time in microseconds. */
+  uint64_t CompileAll() {
+    uint64_t elapsed_us;
+    {
+      common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+      for (const auto *module : modules_) {
+        auto compiled_module =
+            execution::vm::LLVMEngine::Compile(*module, execution::vm::LLVMEngine::CompilerOptions());
+        benchmark::DoNotOptimize(compiled_module.get());
+      }
+    }
+    return elapsed_us;
+  }
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CompiledModuleCacheRunner, ColdCache)(benchmark::State &state) {
+  auto *cache = execution::vm::LLVMEngine::GetCompiledModuleCache();
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    cache->Clear();
+    state.SetIterationTime(static_cast<double>(CompileAll()) / 1000000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * modules_.size());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CompiledModuleCacheRunner, WarmCache)(benchmark::State &state) {
+  auto *cache = execution::vm::LLVMEngine::GetCompiledModuleCache();
+  cache->Clear();
+  CompileAll();
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    state.SetIterationTime(static_cast<double>(CompileAll()) / 1000000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * modules_.size());
+}
+
+BENCHMARK_REGISTER_F(CompiledModuleCacheRunner, ColdCache)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(5);
+BENCHMARK_REGISTER_F(CompiledModuleCacheRunner, WarmCache)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(5);
+}  // namespace noisepage::runner
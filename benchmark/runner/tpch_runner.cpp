@@ -104,5 +104,33 @@ BENCHMARK_DEFINE_F(TPCHRunner, Runner)(benchmark::State &state) {
   workload_.reset();
 }
 
+// Compares the sorts of the TPC-H queries with and without normalized sort keys. The first argument is the position of
+// the query in the workload: Q1 sorts on two strings, Q5 on a descending real, Q16 on an integer followed by strings
+// and Q18 on a descending real followed by a date, like Q3. The second argument enables normalized keys.
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TPCHRunner, SortRunner)(benchmark::State &state) {
+  workload_ = std::make_unique<tpch::Workload>(common::ManagedPointer<DBMain>(db_main_), tpch_database_name_,
+                                               tpch_table_root_, tpch::Workload::BenchmarkType::TPCH,
+                                               state.range(1) != 0);
+  const auto query_idx = static_cast<uint32_t>(state.range(0));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    workload_->ExecuteQuery(query_idx, mode_);
+  }
+
+  // free the workload here so we don't need to use the loggers anymore
+  workload_.reset();
+}
+
 BENCHMARK_REGISTER_F(TPCHRunner, Runner)->Unit(benchmark::kMillisecond)->UseManualTime()->Iterations(1);
+BENCHMARK_REGISTER_F(TPCHRunner, SortRunner)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({0, 0})
+    ->Args({0, 1})
+    ->Args({2, 0})
+    ->Args({2, 1})
+    ->Args({6, 0})
+    ->Args({6, 1})
+    ->Args({7, 0})
+    ->Args({7, 1});
 }  // namespace noisepage::runner
@@ -0,0 +1,100 @@
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/benchmark_config.h"
+#include "common/scoped_timer.h"
+#include "storage/data_table.h"
+#include "storage/storage_util.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "transaction/transaction_context.h"
+
+namespace noisepage {
+
+/**
+ * Compares the ways a BlockStore can allocate blocks by scanning a table that spans many of them, the way
+ * TableVectorIterator does. The first argument is the BlockAllocationMode (0 for HEAP, 1 for HUGE_PAGES), the
+ * second the BlockNumaPolicy (0 for FIRST_TOUCH, 1 for INTERLEAVE).
+ */
+class BlockStoreBenchmark : public benchmark::Fixture {
+ public:
+  // Tuple layout
+  const uint8_t column_size_ = 8;
+  const storage::BlockLayout layout_{{column_size_, column_size_, column_size_}};
+  const storage::ProjectedRowInitializer initializer_ =
+      storage::ProjectedRowInitializer::Create(layout_, StorageTestUtil::ProjectionListAllColumns(layout_));
+
+  // Workload
+  const uint32_t num_tuples_ = 10000000;
+  const uint32_t num_scans_ = 10;
+
+  // Test infrastructure
+  std::default_random_engine generator_;
+  storage::RecordBufferSegmentPool buffer_pool_{num_tuples_, num_tuples_};
+};
+
+// Scan a table of num_tuples_ tuples num_scans_ times on every thread
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BlockStoreBenchmark, Scan)(benchmark::State &state) {
+  storage::BlockStore block_store(1000, 1000,
+                                  storage::BlockAllocator(static_cast<storage::BlockAllocationMode>(state.range(0)),
+                                                          static_cast<storage::BlockNumaPolicy>(state.range(1))));
+  storage::DataTable table{common::ManagedPointer(&block_store), layout_, storage::layout_version_t(0)};
+
+  // We can use dummy timestamps here since we're not invoking concurrency control
+  transaction::TransactionContext txn(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  byte *const redo_buffer = common::AllocationUtil::AllocateAligned(initializer_.ProjectedRowSize());
+  storage::ProjectedRow *const redo = initializer_.InitializeRow(redo_buffer);
+  StorageTestUtil::PopulateRandomRow(redo, layout_, 0, &generator_);
+  for (uint32_t i = 0; i < num_tuples_; ++i) table.Insert(common::ManagedPointer(&txn), *redo);
+  delete[] redo_buffer;
+
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout_);
+  storage::ProjectedColumnsInitializer initializer(layout_, all_cols, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  std::vector<byte *> buffers;
+  std::vector<storage::ProjectedColumns *> all_columns;
+  for (uint32_t j = 0; j < BenchmarkConfig::num_threads; j++) {
+    buffers.push_back(common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize()));
+    all_columns.push_back(initializer.Initialize(buffers.back()));
+  }
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    auto workload = [&](uint32_t id) {
+      for (uint32_t i = 0; i < num_scans_; i++) {
+        auto it = table.begin();
+        while (it != table.end()) table.Scan(common::ManagedPointer(&txn), &it, all_columns[id]);
+      }
+    };
+    common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+    thread_pool.Startup();
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (uint32_t j = 0; j < BenchmarkConfig::num_threads; j++) {
+        thread_pool.SubmitTask([j, &workload] { workload(j); });
+      }
+      thread_pool.WaitUntilAllFinished();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  for (auto *const buffer : buffers) delete[] buffer;
+  state.SetItemsProcessed(state.iterations() * num_scans_ * num_tuples_ * BenchmarkConfig::num_threads);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark Registration
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(BlockStoreBenchmark, Scan)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->UseManualTime()
+    ->Args({0, 0})
+    ->Args({0, 1})
+    ->Args({1, 0})
+    ->Args({1, 1});
+// clang-format on
+
+}  // namespace noisepage
@@ -154,6 +154,44 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &
   state.SetItemsProcessed(state.iterations() * num_txns_ - lag_count);
 }
 
+// Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC with the number of
+// workers given by the argument, and profile how long it takes to drain that backlog (unlink and deallocate)
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, BacklogDrain)(benchmark::State &state) {
+  const auto num_workers = static_cast<uint32_t>(state.range(0));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    // generate our table and instantiate GC
+    LargeDataTableBenchmarkObject tested({8, 8, 8}, initial_table_size_, txn_length_, update_select_ratio_,
+                                         &block_store_, &buffer_pool_, &generator_, true);
+    gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED, num_workers);
+
+    // clean up insert txn
+    gc_->PerformGarbageCollection();
+    gc_->PerformGarbageCollection();
+
+    // run all txns
+    tested.SimulateOltp(num_txns_, num_concurrent_txns_);
+
+    // time both passes it takes to get rid of the backlog
+    uint64_t elapsed_ms;
+    std::pair<uint32_t, uint32_t> unlink_result, deallocate_result;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      unlink_result = gc_->PerformGarbageCollection();
+      deallocate_result = gc_->PerformGarbageCollection();
+    }
+    EXPECT_EQ(unlink_result.second, num_txns_);
+    EXPECT_EQ(deallocate_result.first, num_txns_);
+
+    delete gc_;
+
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_txns_);
+}
+
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)->Unit(benchmark::kMillisecond)->UseManualTime()->MinTime(1);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
     ->Unit(benchmark::kMillisecond)
@@ -163,4 +201,10 @@ BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, HighContention)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(2);
+BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, BacklogDrain)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(1)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
 }  // namespace noisepage
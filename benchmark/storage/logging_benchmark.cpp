@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 
 #include "benchmark/benchmark.h"
@@ -18,6 +19,8 @@ class LoggingBenchmark : public benchmark::Fixture {
   const std::vector<uint16_t> attr_sizes_ = {8, 8, 8, 8, 8, 8, 8, 8, 8, 8};
   const uint32_t initial_table_size_ = 1000000;
   const uint32_t num_txns_ = 100000;
+  // Every one of these waits for a persist, so there are far fewer of them
+  const uint32_t num_durable_txns_ = 10000;
   storage::BlockStore block_store_{1000, 1000};
   storage::RecordBufferSegmentPool buffer_pool_{1000000, 1000000};
   std::default_random_engine generator_;
@@ -246,6 +249,57 @@ BENCHMARK_DEFINE_F(LoggingBenchmark, SingleStatementSelect)(benchmark::State &st
   state.SetItemsProcessed(state.iterations() * num_txns_ - abort_count);
 }
 
+/**
+ * Single statement inserts whose clients block until their commits are durable, comparing blocking log file writes
+ * (argument 0) to io_uring (argument 1) on throughput and on the tail of the commit-to-durable latency.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(LoggingBenchmark, DurableCommit)(benchmark::State &state) {
+  const bool use_io_uring = state.range(0) != 0;
+  const uint32_t txn_length = 1;
+  const std::vector<double> insert_update_select_ratio = {1, 0, 0};
+  std::vector<uint64_t> latencies_us;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    unlink(noisepage::BenchmarkConfig::logfile_path.data());
+    log_manager_ = new storage::LogManager(
+        noisepage::BenchmarkConfig::logfile_path.data(), num_log_buffers_, log_serialization_interval_,
+        log_persist_interval_, log_persist_threshold_, common::ManagedPointer(&buffer_pool_),
+        common::ManagedPointer(&empty_buffer_queue_), DISABLED,
+        common::ManagedPointer<common::DedicatedThreadRegistry>(&thread_registry_), storage::LogBlockFormat::RAW,
+        use_io_uring);
+    log_manager_->Start();
+    LargeDataTableBenchmarkObject tested(attr_sizes_, 0, txn_length, insert_update_select_ratio, &block_store_,
+                                         &buffer_pool_, &generator_, true, log_manager_);
+    // log all of the Inserts from table creation
+    log_manager_->ForceFlush();
+
+    gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED);
+    gc_thread_ = new storage::GarbageCollectorThread(common::ManagedPointer(gc_), gc_period_, nullptr);
+    tested.SetWaitForDurable(true);
+    const auto result = tested.SimulateOltp(num_durable_txns_, BenchmarkConfig::num_threads);
+    state.SetIterationTime(static_cast<double>(result.second) / 1000.0);
+    const auto iteration_latencies_us = tested.TakeCommitLatencies();
+    latencies_us.insert(latencies_us.end(), iteration_latencies_us.begin(), iteration_latencies_us.end());
+    log_manager_->PersistAndStop();
+    delete log_manager_;
+    delete gc_thread_;
+    delete gc_;
+    unlink(noisepage::BenchmarkConfig::logfile_path.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_durable_txns_);
+  std::sort(latencies_us.begin(), latencies_us.end());
+  const auto percentile = [&](const double fraction) {
+    if (latencies_us.empty()) return 0.0;
+    const auto index = static_cast<size_t>(fraction * static_cast<double>(latencies_us.size() - 1));
+    return static_cast<double>(latencies_us[index]);
+  };
+  state.counters["p50_us"] = percentile(0.5);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["p999_us"] = percentile(0.999);
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -270,6 +324,12 @@ BENCHMARK_REGISTER_F(LoggingBenchmark, SingleStatementSelect)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(1);
+BENCHMARK_REGISTER_F(LoggingBenchmark, DurableCommit)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3)
+    ->Arg(0)
+    ->Arg(1);
 // clang-format on
 
 }  // namespace noisepage
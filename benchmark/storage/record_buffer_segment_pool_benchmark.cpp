@@ -0,0 +1,99 @@
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+
+namespace noisepage {
+
+class RecordBufferSegmentPoolBenchmark : public benchmark::Fixture {
+ public:
+  const uint32_t num_ops_ = 10000000;
+  // Segments a thread holds at once, about what a transaction with a few updates holds in its undo and redo buffers
+  const uint32_t segments_per_txn_ = 4;
+};
+
+// Get and release segments in txn-sized groups, spread over the number of threads given by the argument
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecordBufferSegmentPoolBenchmark, GetRelease)(benchmark::State &state) {
+  const auto num_threads = static_cast<uint32_t>(state.range(0));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    storage::RecordBufferSegmentPool pool(100000, 100000);
+    auto workload = [&] {
+      std::vector<storage::RecordBufferSegment *> segments(segments_per_txn_);
+      for (uint32_t i = 0; i < num_ops_ / num_threads / segments_per_txn_; i++) {
+        for (auto &segment : segments) segment = pool.Get();
+        for (auto *const segment : segments) pool.Release(segment);
+      }
+    };
+    common::WorkerPool thread_pool(num_threads, {});
+    thread_pool.Startup();
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (uint32_t j = 0; j < num_threads; j++) thread_pool.SubmitTask(workload);
+      thread_pool.WaitUntilAllFinished();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * (num_ops_ / num_threads / segments_per_txn_) * segments_per_txn_ *
+                          num_threads);
+}
+
+// Get segments on some threads and release them on others, like txns whose segments are released by the GC and the
+// log manager. The argument is the number of threads.
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecordBufferSegmentPoolBenchmark, GetReleaseOnOtherThread)(benchmark::State &state) {
+  const auto num_threads = static_cast<uint32_t>(state.range(0));
+  const uint32_t segments_per_round = 1000;
+  const uint32_t num_rounds = num_ops_ / num_threads / segments_per_round;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    storage::RecordBufferSegmentPool pool(segments_per_round * num_threads, segments_per_round * num_threads);
+    std::vector<std::vector<storage::RecordBufferSegment *>> handed_over(
+        num_threads, std::vector<storage::RecordBufferSegment *>(segments_per_round));
+    common::WorkerPool thread_pool(num_threads, {});
+    thread_pool.Startup();
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (uint32_t round = 0; round < num_rounds; round++) {
+        for (uint32_t j = 0; j < num_threads; j++)
+          thread_pool.SubmitTask([&, j] {
+            for (auto &segment : handed_over[j]) segment = pool.Get();
+          });
+        thread_pool.WaitUntilAllFinished();
+        // Tasks are not pinned to threads, so the segments are likely released on another thread than they were got on
+        for (uint32_t j = 0; j < num_threads; j++)
+          thread_pool.SubmitTask([&, j] {
+            for (auto *const segment : handed_over[(j + 1) % num_threads]) pool.Release(segment);
+          });
+        thread_pool.WaitUntilAllFinished();
+      }
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_rounds * segments_per_round * num_threads);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark Registration
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(RecordBufferSegmentPoolBenchmark, GetRelease)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+BENCHMARK_REGISTER_F(RecordBufferSegmentPoolBenchmark, GetReleaseOnOtherThread)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+// clang-format on
+
+}  // namespace noisepage
@@ -24,11 +24,13 @@ class RecoveryBenchmark : public benchmark::Fixture {
   std::default_random_engine generator_;
 
   /**
-   * Runs the recovery benchmark with the provided config
+   * Runs the recovery benchmark with the provided config. The number of replay threads is taken from the first
+   * benchmark argument.
    * @param state benchmark state
    * @param config config to use for test object
    */
   void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config) {
+    const auto replay_threads = static_cast<uint32_t>(state->range(0));
     // NOLINTNEXTLINE
     for (auto _ : *state) {
       // Blow away log file after every benchmark iteration
@@ -74,7 +76,7 @@ class RecoveryBenchmark : public benchmark::Fixture {
       storage::RecoveryManager recovery_manager(common::ManagedPointer<storage::AbstractLogProvider>(&log_provider),
                                                 recovery_catalog, recovery_txn_manager,
                                                 recovery_deferred_action_manager, recovery_replication_manager,
-                                                recovery_thread_registry, recovery_block_store);
+                                                recovery_thread_registry, recovery_block_store, replay_threads);
 
       uint64_t elapsed_ms;
       {
@@ -129,6 +131,26 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, HighStress)(benchmark::State &state) {
   RunBenchmark(&state, config);
 }
 
+/**
+ * Run a read-write workload over many tables (5 statements per txn, 50% inserts, 30% updates, 20% selects).
+ * Transactions on different tables can be replayed in parallel, so this shows how replay throughput scales with the
+ * number of replay threads.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, MultiTableWorkload)(benchmark::State &state) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(16)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(initial_table_size_ / 16)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.5, 0.3, 0.2, 0.0})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+
+  RunBenchmark(&state, config);
+}
+
 /**
  * Similar to high-stress workload, blast a narrow table with inserts (1 statements per txn, 100% inserts), but also
  * recovery indexes built on the table
@@ -251,10 +273,19 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, IndexRecovery)(benchmark::State &state) {
 BENCHMARK_REGISTER_F(RecoveryBenchmark, ReadWriteWorkload)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
+    ->Arg(1)
     ->MinTime(10);
 BENCHMARK_REGISTER_F(RecoveryBenchmark, HighStress)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
+    ->Arg(1)
+    ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, MultiTableWorkload)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->ArgName("replay_threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
     ->MinTime(10);
 BENCHMARK_REGISTER_F(RecoveryBenchmark, IndexRecovery)
     ->Unit(benchmark::kMillisecond)
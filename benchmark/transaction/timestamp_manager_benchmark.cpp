@@ -0,0 +1,107 @@
+#include <atomic>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+class TimestampManagerBenchmark : public benchmark::Fixture {
+ public:
+  const uint32_t num_txns_ = 1000000;
+  storage::RecordBufferSegmentPool buffer_pool_{100000, 100000};
+};
+
+// Begin and commit num_txns_ empty txns, spread over the number of threads given by the argument
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TimestampManagerBenchmark, BeginCommit)(benchmark::State &state) {
+  const auto num_threads = static_cast<uint32_t>(state.range(0));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    transaction::TimestampManager timestamp_manager;
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager), DISABLED,
+                                                common::ManagedPointer(&buffer_pool_), false, false, DISABLED};
+    auto workload = [&] {
+      for (uint32_t i = 0; i < num_txns_ / num_threads; i++) {
+        auto *const txn = txn_manager.BeginTransaction();
+        txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        delete txn;
+      }
+    };
+    common::WorkerPool thread_pool(num_threads, {});
+    thread_pool.Startup();
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (uint32_t j = 0; j < num_threads; j++) thread_pool.SubmitTask(workload);
+      thread_pool.WaitUntilAllFinished();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * (num_txns_ / num_threads) * num_threads);
+}
+
+// Same as BeginCommit, but with another thread asking for the oldest running txn in a loop, like the GC would
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TimestampManagerBenchmark, BeginCommitWithOldestTxnScan)(benchmark::State &state) {
+  const auto num_threads = static_cast<uint32_t>(state.range(0));
+  uint64_t num_scans = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    transaction::TimestampManager timestamp_manager;
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager), DISABLED,
+                                                common::ManagedPointer(&buffer_pool_), false, false, DISABLED};
+    std::atomic<uint32_t> num_running_threads = num_threads;
+    auto workload = [&] {
+      for (uint32_t i = 0; i < num_txns_ / num_threads; i++) {
+        auto *const txn = txn_manager.BeginTransaction();
+        txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        delete txn;
+      }
+      num_running_threads--;
+    };
+    common::WorkerPool thread_pool(num_threads + 1, {});
+    thread_pool.Startup();
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      thread_pool.SubmitTask([&] {
+        while (num_running_threads.load() > 0) {
+          timestamp_manager.OldestTransactionStartTime();
+          num_scans++;
+        }
+      });
+      for (uint32_t j = 0; j < num_threads; j++) thread_pool.SubmitTask(workload);
+      thread_pool.WaitUntilAllFinished();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * (num_txns_ / num_threads) * num_threads);
+  state.counters["oldest_txn_scans"] = static_cast<double>(num_scans) / static_cast<double>(state.iterations());
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark Registration
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(TimestampManagerBenchmark, BeginCommit)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_REGISTER_F(TimestampManagerBenchmark, BeginCommitWithOldestTxnScan)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+// clang-format on
+
+}  // namespace noisepage
@@ -24,6 +24,9 @@ def get_grouped_op_unit_data(filename, warmup_period, ee_sample_rate, txn_sample
     :return: the list of global model data
     """
 
+    if "jit_tier" in filename or "pipeline_spill" in filename:
+        # The JIT tier and spill data is only for analysis and is not used as model input
+        return []
     if "txn" in filename:
         # Cannot handle the transaction manager data yet
         return _txn_get_mini_runner_data(filename, txn_sample_rate)
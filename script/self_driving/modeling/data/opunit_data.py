@@ -35,6 +35,9 @@ def get_ou_runner_data(filename, model_results_path, txn_sample_rate, model_map=
     :return: the list of Data for execution operating units
     """
 
+    if "jit_tier" in filename or "pipeline_spill" in filename:
+        # The JIT tier and spill data is only for analysis and is not used as model input
+        return []
     if "txn" in filename:
         # Cannot handle the transaction manager data yet
         return _txn_get_ou_runner_data(filename, model_results_path, txn_sample_rate)
@@ -175,6 +175,26 @@ db_oid_t Catalog::GetDatabaseOid(const common::ManagedPointer<transaction::Trans
   return db_oid;
 }
 
+std::vector<db_oid_t> Catalog::GetDatabaseOids(const common::ManagedPointer<transaction::TransactionContext> txn) {
+  const std::vector<col_oid_t> cols{postgres::PgDatabase::DATOID.oid_};
+
+  // Only one column, so we only need the initializer and not the ProjectionMap
+  const auto pci = databases_->InitializerForProjectedColumns(cols, 100);
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+  auto db_oids = reinterpret_cast<db_oid_t *>(pc->ColumnStart(0));
+
+  std::vector<db_oid_t> result;
+  auto table_iter = databases_->begin();
+  while (table_iter != databases_->end()) {
+    databases_->Scan(txn, &table_iter, pc);
+    for (uint i = 0; i < pc->NumTuples(); i++) result.emplace_back(db_oids[i]);
+  }
+
+  delete[] buffer;
+  return result;
+}
+
 common::ManagedPointer<DatabaseCatalog> Catalog::GetDatabaseCatalog(
     const common::ManagedPointer<transaction::TransactionContext> txn, const db_oid_t database) {
   const auto oid_pri = databases_name_index_->GetProjectedRowInitializer();
@@ -302,6 +302,11 @@ bool DatabaseCatalog::DeleteIndex(const common::ManagedPointer<transaction::Tran
   return pg_core_.DeleteIndex(txn, common::ManagedPointer(this), index);
 }
 
+std::vector<std::pair<table_oid_t, common::ManagedPointer<storage::SqlTable>>> DatabaseCatalog::GetTables(
+    const common::ManagedPointer<transaction::TransactionContext> txn) {
+  return pg_core_.GetTables(txn);
+}
+
 std::vector<index_oid_t> DatabaseCatalog::GetIndexOids(
     const common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table) {
   return pg_core_.GetIndexOids(txn, table);
@@ -1161,6 +1161,37 @@ std::vector<std::pair<uint32_t, PgClass::RelKind>> PgCoreImpl::GetNamespaceClass
   return ns_objects;
 }
 
+std::vector<std::pair<table_oid_t, common::ManagedPointer<storage::SqlTable>>> PgCoreImpl::GetTables(
+    const common::ManagedPointer<transaction::TransactionContext> txn) {
+  const std::vector<col_oid_t> pg_class_oids{PgClass::RELOID.oid_, PgClass::RELKIND.oid_, PgClass::REL_PTR.oid_};
+
+  auto pci = classes_->InitializerForProjectedColumns(pg_class_oids, DatabaseCatalog::TEARDOWN_MAX_TUPLES);
+  auto pm = classes_->ProjectionMapForOids(pg_class_oids);
+
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+
+  // Fetch pointers to the start of each attribute in the projected columns.
+  auto oids = reinterpret_cast<table_oid_t *>(pc->ColumnStart(pm[PgClass::RELOID.oid_]));
+  auto classes = reinterpret_cast<PgClass::RelKind *>(pc->ColumnStart(pm[PgClass::RELKIND.oid_]));
+  auto objects = reinterpret_cast<storage::SqlTable **>(pc->ColumnStart(pm[PgClass::REL_PTR.oid_]));
+
+  // Scan the table, the pointer of a table is only missing while its creating transaction has not set it yet.
+  std::vector<std::pair<table_oid_t, common::ManagedPointer<storage::SqlTable>>> tables;
+  auto table_iter = classes_->begin();
+  while (table_iter != classes_->end()) {
+    classes_->Scan(txn, &table_iter, pc);
+    for (uint32_t i = 0; i < pc->NumTuples(); i++) {
+      if (classes[i] == PgClass::RelKind::REGULAR_TABLE && objects[i] != nullptr) {
+        tables.emplace_back(oids[i], common::ManagedPointer(objects[i]));
+      }
+    }
+  }
+
+  delete[] buffer;
+  return tables;
+}
+
 std::pair<void *, PgClass::RelKind> PgCoreImpl::GetClassPtrKind(
     const common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid) {
   // Initialize both PR initializers, allocate buffer using size of largest one so we can reuse buffer.
@@ -0,0 +1,158 @@
+#include "common/compression_util.h"
+
+#include <x86intrin.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace noisepage::common {
+
+namespace {
+
+// Shortest match worth encoding
+constexpr uint32_t MIN_MATCH = 4;
+// Matches are not searched for in the last bytes of the input, and do not extend into the last literals
+constexpr uint32_t MATCH_FIND_LIMIT = 12;
+constexpr uint32_t LAST_LITERALS = 5;
+// Largest distance a match can reach back
+constexpr uint32_t MAX_OFFSET = 65535;
+// Lengths of at least this are continued in extra bytes after the token
+constexpr uint32_t RUN_MASK = 15;
+constexpr uint32_t HASH_LOG = 12;
+
+uint32_t Read32(const uint8_t *const ptr) {
+  uint32_t result;
+  std::memcpy(&result, ptr, sizeof(uint32_t));
+  return result;
+}
+
+uint32_t HashSequence(const uint32_t sequence) { return (sequence * 2654435761U) >> (32 - HASH_LOG); }
+
+uint8_t *WriteLength(uint8_t *out, uint32_t length) {
+  for (; length >= 255; length -= 255) *out++ = 255;
+  *out++ = static_cast<uint8_t>(length);
+  return out;
+}
+
+bool ReadLength(const uint8_t **in, const uint8_t *const in_end, uint32_t *const length) {
+  uint8_t next;
+  do {
+    if (*in == in_end) return false;
+    next = *(*in)++;
+    *length += next;
+  } while (next == 255);
+  return true;
+}
+
+/** Writes a sequence made of the given literals and, unless match_length is 0, a match. */
+uint8_t *WriteSequence(uint8_t *out, const uint8_t *const literals, const uint32_t literal_length,
+                       const uint32_t offset, const uint32_t match_length) {
+  uint8_t *const token = out++;
+  *token = static_cast<uint8_t>(std::min(literal_length, RUN_MASK) << 4);
+  if (literal_length >= RUN_MASK) out = WriteLength(out, literal_length - RUN_MASK);
+  // Empty inputs may come without a buffer, which memcpy does not allow even for 0 bytes
+  if (literal_length > 0) std::memcpy(out, literals, literal_length);
+  out += literal_length;
+  if (match_length == 0) return out;
+
+  const auto encoded_offset = static_cast<uint16_t>(offset);
+  std::memcpy(out, &encoded_offset, sizeof(uint16_t));
+  out += sizeof(uint16_t);
+  const uint32_t encoded_length = match_length - MIN_MATCH;
+  *token |= static_cast<uint8_t>(std::min(encoded_length, RUN_MASK));
+  if (encoded_length >= RUN_MASK) out = WriteLength(out, encoded_length - RUN_MASK);
+  return out;
+}
+
+}  // namespace
+
+uint32_t CompressionUtil::Compress(const void *const src, const uint32_t size, void *const dst) {
+  const auto *const in = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *const in_end = in + size;
+  auto *out = reinterpret_cast<uint8_t *>(dst);
+  // Start of the literals that have not been written out yet
+  const uint8_t *anchor = in;
+
+  if (size > MATCH_FIND_LIMIT) {
+    // Most recent position of each hashed 4 byte sequence. Stale or colliding entries are filtered out by comparing.
+    std::array<uint32_t, 1U << HASH_LOG> positions{};
+    const uint8_t *const match_find_end = in_end - MATCH_FIND_LIMIT;
+    const uint8_t *const match_end = in_end - LAST_LITERALS;
+    const uint8_t *pos = in;
+    while (pos < match_find_end) {
+      const uint32_t sequence = Read32(pos);
+      const uint32_t hash = HashSequence(sequence);
+      const uint8_t *const candidate = in + positions[hash];
+      positions[hash] = static_cast<uint32_t>(pos - in);
+      if (candidate >= pos || pos - candidate > MAX_OFFSET || Read32(candidate) != sequence) {
+        pos++;
+        continue;
+      }
+
+      uint32_t match_length = MIN_MATCH;
+      while (pos + match_length < match_end && candidate[match_length] == pos[match_length]) match_length++;
+      out = WriteSequence(out, anchor, static_cast<uint32_t>(pos - anchor), static_cast<uint32_t>(pos - candidate),
+                          match_length);
+      pos += match_length;
+      anchor = pos;
+    }
+  }
+
+  // The last sequence is only literals
+  out = WriteSequence(out, anchor, static_cast<uint32_t>(in_end - anchor), 0, 0);
+  return static_cast<uint32_t>(out - reinterpret_cast<uint8_t *>(dst));
+}
+
+bool CompressionUtil::Decompress(const void *const src, const uint32_t src_size, void *const dst,
+                                 const uint32_t dst_size) {
+  const auto *in = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *const in_end = in + src_size;
+  auto *const out_begin = reinterpret_cast<uint8_t *>(dst);
+  uint8_t *out = out_begin;
+  uint8_t *const out_end = out_begin + dst_size;
+
+  while (in < in_end) {
+    const uint8_t token = *in++;
+
+    uint32_t literal_length = token >> 4;
+    if (literal_length == RUN_MASK && !ReadLength(&in, in_end, &literal_length)) return false;
+    if (literal_length > static_cast<uint64_t>(in_end - in) || literal_length > static_cast<uint64_t>(out_end - out))
+      return false;
+    if (literal_length > 0) std::memcpy(out, in, literal_length);
+    in += literal_length;
+    out += literal_length;
+    // The last sequence has no match
+    if (in == in_end) break;
+
+    if (in_end - in < static_cast<int64_t>(sizeof(uint16_t))) return false;
+    uint16_t offset;
+    std::memcpy(&offset, in, sizeof(uint16_t));
+    in += sizeof(uint16_t);
+    if (offset == 0 || offset > out - out_begin) return false;
+
+    uint32_t match_length = token & RUN_MASK;
+    if (match_length == RUN_MASK && !ReadLength(&in, in_end, &match_length)) return false;
+    match_length += MIN_MATCH;
+    if (match_length > static_cast<uint64_t>(out_end - out)) return false;
+    // Copy byte by byte, since the match can overlap the bytes it produces
+    const uint8_t *match = out - offset;
+    for (uint32_t i = 0; i < match_length; i++) *out++ = *match++;
+  }
+  return out == out_end;
+}
+
+uint32_t CompressionUtil::Crc32c(const void *const data, uint64_t size, const uint32_t crc) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+  uint64_t result = ~crc;
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(uint64_t));
+    result = _mm_crc32_u64(result, word);
+  }
+  auto result32 = static_cast<uint32_t>(result);
+  for (; size > 0; size--) result32 = _mm_crc32_u8(result32, *bytes++);
+  return ~result32;
+}
+
+}  // namespace noisepage::common
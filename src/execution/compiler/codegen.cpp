@@ -213,8 +213,10 @@ ast::Expr *CodeGen::ArrayType(uint64_t num_elems, ast::BuiltinType::Kind kind) {
   return GetFactory()->NewArrayType(position_, Const64(num_elems), BuiltinType(kind));
 }
 
-ast::Expr *CodeGen::ArrayAccess(ast::Identifier arr, uint64_t idx) {
-  return GetFactory()->NewIndexExpr(position_, MakeExpr(arr), Const64(idx));
+ast::Expr *CodeGen::ArrayAccess(ast::Identifier arr, uint64_t idx) { return ArrayAccess(MakeExpr(arr), idx); }
+
+ast::Expr *CodeGen::ArrayAccess(ast::Expr *arr, uint64_t idx) {
+  return GetFactory()->NewIndexExpr(position_, arr, Const64(idx));
 }
 
 ast::Expr *CodeGen::TplType(sql::TypeId type) {
@@ -912,9 +914,12 @@ ast::Expr *CodeGen::Hash(const std::vector<ast::Expr *> &values) {
 // ---------------------------------------------------------
 
 ast::Expr *CodeGen::JoinHashTableInit(ast::Expr *join_hash_table, ast::Expr *exec_ctx,
-                                      ast::Identifier build_row_type_name) {
-  ast::Expr *call =
-      CallBuiltin(ast::Builtin::JoinHashTableInit, {join_hash_table, exec_ctx, SizeOf(build_row_type_name)});
+                                      ast::Identifier build_row_type_name, ast::Identifier probe_row_type_name) {
+  std::vector<ast::Expr *> args = {join_hash_table, exec_ctx, SizeOf(build_row_type_name)};
+  if (!probe_row_type_name.IsEmpty()) {
+    args.push_back(SizeOf(probe_row_type_name));
+  }
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableInit, args);
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
@@ -946,6 +951,30 @@ ast::Expr *CodeGen::JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *e
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableIsSpilled(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableIsSpilled, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableSpillProbe(ast::Expr *join_hash_table, ast::Expr *hash_val, ast::Expr *probe_row) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableSpillProbe, {join_hash_table, hash_val, probe_row});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableNextPartition(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableNextPartition, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableNextSpilledProbe(ast::Expr *join_hash_table, ast::Identifier probe_row_type_name) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableNextSpilledProbe, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+  return PtrCast(probe_row_type_name, call);
+}
+
 ast::Expr *CodeGen::JoinHashTableFree(ast::Expr *join_hash_table) {
   ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableFree, {join_hash_table});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1152,9 +1181,12 @@ ast::Expr *CodeGen::AggregatorFree(ast::Expr *agg) {
 // ---------------------------------------------------------
 
 ast::Expr *CodeGen::SorterInit(ast::Expr *sorter, ast::Expr *exec_ctx, ast::Identifier cmp_func_name,
-                               ast::Identifier sort_row_type_name) {
-  ast::Expr *call =
-      CallBuiltin(ast::Builtin::SorterInit, {sorter, exec_ctx, MakeExpr(cmp_func_name), SizeOf(sort_row_type_name)});
+                               ast::Identifier sort_row_type_name, uint32_t key_size) {
+  std::vector<ast::Expr *> args = {sorter, exec_ctx, MakeExpr(cmp_func_name), SizeOf(sort_row_type_name)};
+  if (key_size > 0) {
+    args.push_back(ConstU32(key_size));
+  }
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterInit, args);
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
@@ -1241,6 +1273,12 @@ ast::Expr *CodeGen::SorterIterClose(ast::Expr *iter) {
   return call;
 }
 
+ast::Expr *CodeGen::SortKeyWrite(ast::Expr *key, ast::Expr *val, bool descending) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SortKeyWrite, {key, val, ConstBool(descending)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 // ---------------------------------------------------------
 // SQL functions
 // ---------------------------------------------------------
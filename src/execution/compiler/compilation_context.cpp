@@ -94,7 +94,9 @@ CompilationContext::CompilationContext(ExecutableQuery *query, query_id_t query_
       query_state_type_(codegen_.MakeIdentifier("QueryState")),
       query_state_(query_state_type_, [this](CodeGen *codegen) { return codegen->MakeExpr(query_state_var_); }),
       counters_enabled_(settings.GetIsCountersEnabled()),
-      pipeline_metrics_enabled_(settings.GetIsPipelineMetricsEnabled()) {}
+      pipeline_metrics_enabled_(settings.GetIsPipelineMetricsEnabled()),
+      sort_normalized_keys_enabled_(settings.GetIsSortNormalizedKeysEnabled()),
+      join_spilling_enabled_(settings.GetJoinMemoryBudget() != 0) {}
 
 ast::FunctionDecl *CompilationContext::GenerateInitFunction() {
   const auto name = codegen_.MakeIdentifier(GetFunctionPrefix() + "_Init");
@@ -40,6 +40,8 @@ void ExecutableQuery::Fragment::Run(byte query_state[], vm::ExecutionMode mode)
       throw EXECUTION_EXCEPTION(fmt::format("Could not find function '{}' in query fragment.", func_name),
                                 common::ErrorCode::ERRCODE_INTERNAL_ERROR);
     }
+    const auto tier = module_->GetExecutionTier(mode);
+    exec_ctx->SetExecutionTier(static_cast<uint8_t>(tier), module_->GetCompileTimeUs(tier));
     try {
       func(query_state);
     } catch (const AbortException &e) {
@@ -57,6 +59,8 @@ void ExecutableQuery::Fragment::Run(byte query_state[], vm::ExecutionMode mode)
 
 const vm::ModuleMetadata &ExecutableQuery::Fragment::GetModuleMetadata() const { return module_->GetMetadata(); }
 
+std::size_t ExecutableQuery::Fragment::GetCodeSize() const { return module_->GetBytecodeModule()->GetCodeSize(); }
+
 //===----------------------------------------------------------------------===//
 //
 // Executable Query
@@ -157,7 +161,13 @@ void ExecutableQuery::Setup(std::vector<std::unique_ptr<Fragment>> &&fragments,
                       fragments_.size() > 1 ? "s" : "", query_state_size_);
 }
 
-void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ctx, vm::ExecutionMode mode) {
+std::size_t ExecutableQuery::GetCodeSize() const {
+  std::size_t size = 0;
+  for (const auto &fragment : fragments_) size += fragment->GetCodeSize();
+  return size;
+}
+
+void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ctx, vm::ExecutionMode mode) const {
   // First, allocate the query state and move the execution context into it.
   auto query_state = std::make_unique<byte[]>(query_state_size_);
   *reinterpret_cast<exec::ExecutionContext **>(query_state.get()) = exec_ctx.Get();
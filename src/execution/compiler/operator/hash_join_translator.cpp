@@ -27,6 +27,7 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
       probe_row_var_(GetCodeGen()->MakeFreshIdentifier("probeRow")),
       probe_row_type_(GetCodeGen()->MakeFreshIdentifier("ProbeRow")),
       join_consumer_(GetCodeGen()->MakeFreshIdentifier("joinConsumer")),
+      join_probe_spilled_(GetCodeGen()->MakeFreshIdentifier("joinProbeSpilled")),
       left_pipeline_(this, Pipeline::Parallelism::Parallel) {
   NOISEPAGE_ASSERT(!plan.GetLeftHashKeys().empty(), "Hash-join must have join keys from left input");
   NOISEPAGE_ASSERT(!plan.GetRightHashKeys().empty(), "Hash-join must have join keys from right input");
@@ -81,8 +82,9 @@ void HashJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl
   struct_decl_ = struct_decl;
   decls->push_back(struct_decl);
 
-  /* Probe row declaration - only for left outer joins */
-  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+  /* Probe row declaration - only for left outer joins and joins that may spill */
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT ||
+      IsSpillingEnabled()) {
     // TODO(abalakum): support mini-runners for this struct as well
     fields = codegen->MakeEmptyFieldList();
     GetAllChildOutputFields(1, row_attr_prefix, &fields);
@@ -112,6 +114,24 @@ void HashJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionD
     join_consumer_flag_ = false;
     decls->push_back(function.Finish());
   }
+
+  if (IsSpillingEnabled()) {
+    // Like joinConsumer, the probe-side attributes are read from the probe row parameter
+    auto *pipeline = GetPipeline();
+    WorkContext ctx(GetCompilationContext(), *pipeline);
+    ctx.SetSource(this);
+    auto *codegen = GetCodeGen();
+    util::RegionVector<ast::FieldDecl *> params = pipeline->PipelineParams();
+    params.push_back(codegen->MakeField(probe_row_var_, codegen->PointerType(probe_row_type_)));
+    join_consumer_flag_ = true;
+    FunctionBuilder function(codegen, join_probe_spilled_, std::move(params), codegen->Nil());
+    {
+      auto hash_val = HashKeys(&ctx, &function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+      LookupJoinHashTable(&ctx, &function, hash_val);
+    }
+    join_consumer_flag_ = false;
+    decls->push_back(function.Finish());
+  }
 }
 
 ast::FunctionDecl *HashJoinTranslator::GenerateStartHookFunction() const {
@@ -158,8 +178,14 @@ void HashJoinTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipel
   }
 }
 
+bool HashJoinTranslator::IsSpillingEnabled() const {
+  // The spilled probe rows are joined by a helper that only takes the regular pipeline parameters
+  return GetCompilationContext()->IsJoinSpillingEnabled() && !GetPipeline()->IsNested();
+}
+
 void HashJoinTranslator::InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
-  function->Append(GetCodeGen()->JoinHashTableInit(jht_ptr, GetExecutionContext(), build_row_type_));
+  const auto probe_row_type = IsSpillingEnabled() ? probe_row_type_ : ast::Identifier();
+  function->Append(GetCodeGen()->JoinHashTableInit(jht_ptr, GetExecutionContext(), build_row_type_, probe_row_type));
 }
 
 void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
@@ -290,6 +316,32 @@ void HashJoinTranslator::InsertIntoJoinHashTable(WorkContext *ctx, FunctionBuild
 void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
 
+  auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+  if (!IsSpillingEnabled()) {
+    LookupJoinHashTable(ctx, function, hash_val);
+    return;
+  }
+
+  // If the build side spilled, spill the probe row into its partition, to be joined once all rows are spilled
+  // if (@joinHTIsSpilled(jht))
+  If check_spilled(function, codegen->JoinHashTableIsSpilled(global_join_ht_.GetPtr(codegen)));
+  {
+    // var probeRow : ProbeRow
+    auto probe_row = codegen->MakeExpr(probe_row_var_);
+    function->Append(codegen->DeclareVarNoInit(probe_row_var_, codegen->MakeExpr(probe_row_type_)));
+    FillProbeRow(ctx, function, probe_row);
+    // @joinHTSpillProbe(jht, hashVal, &probeRow)
+    function->Append(
+        codegen->JoinHashTableSpillProbe(global_join_ht_.GetPtr(codegen), hash_val, codegen->AddressOf(probe_row)));
+  }
+  check_spilled.Else();
+  { LookupJoinHashTable(ctx, function, hash_val); }
+  check_spilled.EndIf();
+}
+
+void HashJoinTranslator::LookupJoinHashTable(WorkContext *ctx, FunctionBuilder *function, ast::Expr *hash_val) const {
+  auto *codegen = GetCodeGen();
+
   // var entryIterBase: HashTableEntryIterator
   auto iter_name_base = codegen->MakeFreshIdentifier("entryIterBase");
   function->Append(codegen->DeclareVarNoInit(iter_name_base, ast::BuiltinType::HashTableEntryIterator));
@@ -299,7 +351,6 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
   function->Append(codegen->DeclareVarWithInit(iter_name, codegen->AddressOf(codegen->MakeExpr(iter_name_base))));
 
   auto entry_iter = codegen->MakeExpr(iter_name);
-  auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
 
   // Probe matches.
   const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
@@ -381,7 +432,14 @@ void HashJoinTranslator::CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *f
 
     // If left outer join, then call joinConsumer in order to reduce TPL code duplication,
     // otherwise just push to parent
-    if (join_plan.GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+    if (join_plan.GetLogicalJoinType() == planner::LogicalJoinType::LEFT && join_consumer_flag_) {
+      // Within joinProbeSpilled, the probe row is already materialized
+      // joinConsumer(queryState, pipelineState, buildRow, probeRow);
+      std::initializer_list<ast::Expr *> args{GetQueryStatePtr(),
+                                              codegen->MakeExpr(GetPipeline()->GetPipelineStateVar()),
+                                              codegen->MakeExpr(build_row_var_), codegen->MakeExpr(probe_row_var_)};
+      function->Append(codegen->Call(join_consumer_, args));
+    } else if (join_plan.GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
       // var probeRow : ProbeRow
       auto probe_row_type = codegen->MakeExpr(probe_row_type_);
       auto probe_row = codegen->MakeExpr(probe_row_var_);
@@ -473,6 +531,51 @@ void HashJoinTranslator::CollectUnmatchedLeftRows(FunctionBuilder *function) con
   function->Append(codegen->JoinHTIteratorFree(jht_iter_expr));
 }
 
+void HashJoinTranslator::JoinSpilledPartitions(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  const bool is_left_join =
+      GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT;
+
+  // if (@joinHTIsSpilled(jht))
+  If check_spilled(function, codegen->JoinHashTableIsSpilled(global_join_ht_.GetPtr(codegen)));
+  {
+    // while (@joinHTNextPartition(jht))
+    Loop partition_loop(function, codegen->JoinHashTableNextPartition(global_join_ht_.GetPtr(codegen)));
+    {
+      // var spilledProbeRow = @ptrCast(*ProbeRow, @joinHTNextSpilledProbe(jht))
+      auto spilled_probe_row = codegen->MakeFreshIdentifier("spilledProbeRow");
+      function->Append(codegen->DeclareVarWithInit(
+          spilled_probe_row, codegen->JoinHashTableNextSpilledProbe(global_join_ht_.GetPtr(codegen), probe_row_type_)));
+
+      // for (; spilledProbeRow != nil; spilledProbeRow = @ptrCast(*ProbeRow, @joinHTNextSpilledProbe(jht)))
+      auto has_next = codegen->Compare(parsing::Token::Type::BANG_EQUAL, codegen->MakeExpr(spilled_probe_row),
+                                       codegen->Nil());
+      auto next_probe_row = codegen->JoinHashTableNextSpilledProbe(global_join_ht_.GetPtr(codegen), probe_row_type_);
+      auto next = codegen->Assign(codegen->MakeExpr(spilled_probe_row), next_probe_row);
+      Loop probe_loop(function, static_cast<ast::Stmt *>(nullptr), has_next, next);
+      {
+        // joinProbeSpilled(queryState, pipelineState, spilledProbeRow)
+        std::initializer_list<ast::Expr *> args{GetQueryStatePtr(),
+                                                codegen->MakeExpr(GetPipeline()->GetPipelineStateVar()),
+                                                codegen->MakeExpr(spilled_probe_row)};
+        function->Append(codegen->Call(join_probe_spilled_, args));
+      }
+      probe_loop.EndLoop();
+
+      // Build rows can only be matched by probe rows of the same partition
+      if (is_left_join) {
+        CollectUnmatchedLeftRows(function);
+      }
+    }
+    partition_loop.EndLoop();
+  }
+  if (is_left_join) {
+    check_spilled.Else();
+    CollectUnmatchedLeftRows(function);
+  }
+  check_spilled.EndIf();
+}
+
 void HashJoinTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
   if (IsLeftPipeline(ctx->GetPipeline())) {
     InsertIntoJoinHashTable(ctx, function);
@@ -513,7 +616,9 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       RecordCounters(pipeline, function);
     }
   } else {
-    if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+    if (IsSpillingEnabled()) {
+      JoinSpilledPartitions(function);
+    } else if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
       CollectUnmatchedLeftRows(function);
     }
 
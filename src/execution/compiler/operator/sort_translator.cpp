@@ -7,6 +7,7 @@
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
 #include "execution/compiler/work_context.h"
+#include "execution/sql/sort_key.h"
 #include "execution/sql/sorter.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -15,6 +16,7 @@ namespace noisepage::execution::compiler {
 
 namespace {
 constexpr const char SORT_ROW_ATTR_PREFIX[] = "attr";
+constexpr const char SORT_ROW_KEY[] = "key";
 }  // namespace
 
 SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, CompilationContext *compilation_context,
@@ -26,7 +28,9 @@ SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, Compilation
       rhs_row_(GetCodeGen()->MakeIdentifier("rhs")),
       compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("Compare"))),
       build_pipeline_(this, Pipeline::Parallelism::Parallel),
-      current_row_(CurrentRow::Child) {
+      current_row_(CurrentRow::Child),
+      key_size_(0),
+      num_key_columns_(0) {
   NOISEPAGE_ASSERT(plan.GetChildrenSize() == 1, "Sorts expected to have a single child.");
   // Register this as the source for the pipeline. It must be serial to maintain
   // sorted output order.
@@ -44,6 +48,24 @@ SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, Compilation
     compilation_context->Prepare(*expr);
   }
 
+  // Encode as many leading sort keys as possible into a normalized key. The comparison function
+  // orders rows whose normalized keys are equal.
+  if (compilation_context->IsSortNormalizedKeysEnabled()) {
+    for (const auto &[expr, _] : plan.GetSortKeys()) {
+      (void)_;
+      const auto type = sql::GetTypeId(expr->GetReturnValueType());
+      const uint32_t size = sql::SortKey::EncodedSize(type);
+      if (size == 0) {
+        break;
+      }
+      key_size_ += size;
+      num_key_columns_++;
+      if (sql::SortKey::IsTruncated(type)) {
+        break;
+      }
+    }
+  }
+
   // Register a Sorter instance in the global query state.
   CodeGen *codegen = compilation_context->GetCodeGen();
   ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
@@ -75,6 +97,11 @@ SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, Compilation
 void SortTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
   auto *codegen = GetCodeGen();
   auto fields = codegen->MakeEmptyFieldList();
+  // The normalized key must be the first field in the sort row.
+  if (key_size_ > 0) {
+    fields.push_back(codegen->MakeField(codegen->MakeIdentifier(SORT_ROW_KEY),
+                                        codegen->ArrayType(key_size_, ast::BuiltinType::Uint8)));
+  }
   GetAllChildOutputFields(0, SORT_ROW_ATTR_PREFIX, &fields);
   ast::StructDecl *struct_decl = codegen->DeclareStruct(sort_row_type_, std::move(fields));
   struct_decl_ = struct_decl;
@@ -136,7 +163,7 @@ void SortTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
 
 void SortTranslator::InitializeSorter(FunctionBuilder *function, ast::Expr *sorter_ptr) const {
   auto ctx = GetExecutionContext();
-  function->Append(GetCodeGen()->SorterInit(sorter_ptr, ctx, compare_func_, sort_row_type_));
+  function->Append(GetCodeGen()->SorterInit(sorter_ptr, ctx, compare_func_, sort_row_type_, key_size_));
 }
 
 void SortTranslator::TearDownSorter(FunctionBuilder *function, ast::Expr *sorter_ptr) const {
@@ -354,6 +381,24 @@ void SortTranslator::FillSortRow(WorkContext *ctx, FunctionBuilder *function) co
     ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
     function->Append(codegen->Assign(lhs, rhs));
   }
+  FillSortKey(ctx, function);
+}
+
+void SortTranslator::FillSortKey(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  const auto &sort_keys = GetPlanAs<planner::OrderByPlanNode>().GetSortKeys();
+  uint32_t offset = 0;
+  for (std::size_t key_idx = 0; key_idx < num_key_columns_; key_idx++) {
+    const auto &[expr, sort_order] = sort_keys[key_idx];
+    // @sortKeyWrite(&sortRow.key[offset], value, descending)
+    ast::Expr *key =
+        codegen->AccessStructMember(codegen->MakeExpr(sort_row_var_), codegen->MakeIdentifier(SORT_ROW_KEY));
+    ast::Expr *key_ptr = codegen->AddressOf(codegen->ArrayAccess(key, offset));
+    ast::Expr *value = ctx->DeriveValue(*expr, this);
+    function->Append(codegen->SortKeyWrite(key_ptr, value, sort_order == optimizer::OrderByOrderingType::DESC));
+    offset += sql::SortKey::EncodedSize(sql::GetTypeId(expr->GetReturnValueType()));
+  }
+  NOISEPAGE_ASSERT(offset == key_size_, "Normalized key size mismatch");
 }
 
 void SortTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const {
@@ -131,6 +131,7 @@ void ExecutionContext::StartPipelineTracker(pipeline_id_t pipeline_id) {
 void ExecutionContext::EndPipelineTracker(query_id_t query_id, pipeline_id_t pipeline_id,
                                           selfdriving::ExecOUFeatureVector *ouvec) {
   if (common::thread_context.metrics_store_ != nullptr && common::thread_context.resource_tracker_.IsRunning()) {
+    const uint64_t spilled_bytes = mem_tracker_->GetSpilledSize();
     if (common::thread_context.nesting_depth_ == 0) {
       common::thread_context.resource_tracker_.Stop();
       auto mem_size = mem_tracker_->GetAllocatedSize();
@@ -148,6 +149,7 @@ void ExecutionContext::EndPipelineTracker(query_id_t query_id, pipeline_id_t pip
     selfdriving::ExecutionOperatingUnitFeatureVector features(ouvec->pipeline_features_->begin(),
                                                               ouvec->pipeline_features_->end());
     common::thread_context.metrics_store_->RecordPipelineData(query_id, pipeline_id, execution_mode_,
+                                                              execution_tier_, compile_time_us_, spilled_bytes,
                                                               std::move(features), resource_metrics);
   }
 }
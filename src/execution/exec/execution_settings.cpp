@@ -10,6 +10,12 @@ void ExecutionSettings::UpdateFromSettingsManager(common::ManagedPointer<setting
     number_of_parallel_execution_threads_ = settings->GetInt(settings::Param::num_parallel_execution_threads);
     is_counters_enabled_ = settings->GetBool(settings::Param::counters_enable);
     is_pipeline_metrics_enabled_ = settings->GetBool(settings::Param::pipeline_metrics_enable);
+    is_sort_normalized_keys_enabled_ = settings->GetBool(settings::Param::sort_normalized_keys_enable);
+    sort_memory_budget_ = settings->GetInt64(settings::Param::sort_memory_budget);
+    join_memory_budget_ = settings->GetInt64(settings::Param::join_memory_budget);
+    agg_memory_budget_ = settings->GetInt64(settings::Param::agg_memory_budget);
+    is_agg_adaptive_preaggregation_enabled_ = settings->GetBool(settings::Param::agg_adaptive_preaggregation_enable);
+    is_join_radix_partitioning_enabled_ = settings->GetBool(settings::Param::join_radix_partitioning_enable);
   }
 }
 
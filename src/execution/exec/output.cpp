@@ -96,10 +96,7 @@ void OutputWriter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_
   std::scoped_lock latch(output_synchronization_);
 
   // Write out the rows for this batch
-  for (uint32_t row = 0; row < num_tuples; row++) {
-    const byte *const tuple = tuples + row * tuple_size;
-    out_->WriteDataRow(tuple, schema_->GetColumns(), field_formats_);
-  }
+  out_->WriteDataRows(tuples, num_tuples, tuple_size, schema_->GetColumns(), field_formats_);
 
   num_rows_ += num_tuples;
 }
@@ -672,7 +672,7 @@ void Sema::CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin)
 }
 
 void Sema::CheckBuiltinJoinHashTableInit(ast::CallExpr *call) {
-  if (!CheckArgCount(call, 3)) {
+  if (!CheckArgCountBetween(call, 3, 4)) {
     return;
   }
 
@@ -692,12 +692,18 @@ void Sema::CheckBuiltinJoinHashTableInit(ast::CallExpr *call) {
     return;
   }
 
-  // Third and last argument must be a 32-bit number representing the tuple size
+  // Third argument must be a 32-bit number representing the tuple size
   if (!args[2]->GetType()->IsIntegerType()) {
     ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint32));
     return;
   }
 
+  // Optional fourth argument must be a 32-bit number representing the size of spilled probe tuples
+  if (args.size() > 3 && !args[3]->GetType()->IsIntegerType()) {
+    ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Uint32));
+    return;
+  }
+
   // This call returns nothing
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
@@ -820,6 +826,60 @@ void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::HashTableEntryIterator));
 }
 
+void Sema::CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableNextPartition: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      // Third argument is a pointer to the probe tuple
+      if (!args[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, "pointer to probe tuple");
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      // This call returns a byte pointer, nil once the partition is exhausted
+      call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table spill call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinJoinHashTableFree(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -2113,7 +2173,7 @@ void Sema::CheckBuiltinPtrCastCall(ast::CallExpr *call) {
 }
 
 void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
-  if (!CheckArgCount(call, 4)) {
+  if (!CheckArgCountBetween(call, 4, 5)) {
     return;
   }
 
@@ -2142,13 +2202,19 @@ void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
     return;
   }
 
-  // Fourth and last argument must be a 32-bit number representing the tuple size
+  // Fourth argument must be a 32-bit number representing the tuple size
   const auto uint_kind = ast::BuiltinType::Uint32;
   if (!args[3]->GetType()->IsSpecificBuiltin(uint_kind)) {
     ReportIncorrectCallArg(call, 3, GetBuiltinType(uint_kind));
     return;
   }
 
+  // Optional fifth argument must be a 32-bit number representing the size of the normalized key
+  if (args.size() > 4 && !args[4]->IsIntegerLiteral() && !args[4]->GetType()->IsSpecificBuiltin(uint_kind)) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(uint_kind));
+    return;
+  }
+
   // This call returns nothing
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
@@ -2351,6 +2417,37 @@ void Sema::CheckBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin)
   }
 }
 
+void Sema::CheckBuiltinSortKeyWrite(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 3)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to the key bytes
+  const auto uint8_kind = ast::BuiltinType::Uint8;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), uint8_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(uint8_kind)->PointerTo());
+    return;
+  }
+
+  // Second argument must be a SQL value that can be encoded into a key
+  if (!args[1]->GetType()->IsSqlValueType() || args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Decimal)) {
+    ReportIncorrectCallArg(call, 1, "SQL boolean, integer, real, date, timestamp or string");
+    return;
+  }
+
+  // Third argument must be a boolean indicating a descending key
+  const auto bool_kind = ast::BuiltinType::Bool;
+  if (!args[2]->GetType()->IsSpecificBuiltin(bool_kind)) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(bool_kind));
+    return;
+  }
+
+  // This call returns nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinIndexIteratorInit(execution::ast::CallExpr *call, ast::Builtin builtin) {
   // First argument must be a pointer to a IndexIterator
   const auto index_kind = ast::BuiltinType::IndexIterator;
@@ -3766,6 +3863,13 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinJoinHashTableLookup(call);
       break;
     }
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableNextPartition:
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      CheckBuiltinJoinHashTableSpillCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       CheckBuiltinJoinHashTableFree(call);
       break;
@@ -3816,6 +3920,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::SortKeyWrite: {
+      CheckBuiltinSortKeyWrite(call);
+      break;
+    }
     case ast::Builtin::ResultBufferNew:
     case ast::Builtin::ResultBufferAllocOutRow:
     case ast::Builtin::ResultBufferFinalize:
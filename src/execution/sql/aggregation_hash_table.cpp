@@ -4,8 +4,10 @@
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
 #include <memory>
-#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -167,7 +169,12 @@ AggregationHashTable::AggregationHashTable(const exec::ExecutionSettings &exec_s
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)),
+      memory_budget_(exec_settings.GetAggMemoryBudget()),
+      num_spilled_tuples_(0),
+      adaptive_preaggregation_(exec_settings.GetIsAggAdaptivePreAggregationEnabled()),
+      bypass_preaggregation_(false),
+      preagg_tuple_count_(0) {
   hash_table_.SetSize(initial_size, memory_->GetTracker());
   max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
 
@@ -203,8 +210,7 @@ AggregationHashTable::~AggregationHashTable() {
   if (partition_tables_ != nullptr) {
     for (uint32_t i = 0; i < DEFAULT_NUM_PARTITIONS; i++) {
       if (partition_tables_[i] != nullptr) {
-        partition_tables_[i]->~AggregationHashTable();
-        memory_->Deallocate(partition_tables_[i], sizeof(AggregationHashTable));
+        FreeTableOverPartition(i);
       }
     }
     memory_->DeallocateArray(partition_tables_, DEFAULT_NUM_PARTITIONS);
@@ -285,21 +291,60 @@ void AggregationHashTable::FlushToOverflowPartitions() {
   // hash values using a bijective hash scrambling before feeding them to the
   // estimator.
 
-  hash_table_.FlushEntries([this](HashTableEntry *entry) {
-    const uint64_t partition_idx = (entry->hash_ >> partition_shift_bits_);
-    entry->next_ = partition_heads_[partition_idx];
-    partition_heads_[partition_idx] = entry;
-    if (UNLIKELY(partition_tails_[partition_idx] == nullptr)) {
-      partition_tails_[partition_idx] = entry;
-    }
-    partition_estimates_[partition_idx]->Update(common::HashUtil::ScrambleHash(entry->hash_));
-  });
+  hash_table_.FlushEntries([this](HashTableEntry *entry) { LinkIntoOverflowPartition(entry); });
 
   // Update stats
   stats_.num_flushes_++;
 }
 
+void AggregationHashTable::LinkIntoOverflowPartition(HashTableEntry *entry) {
+  const uint64_t partition_idx = (entry->hash_ >> partition_shift_bits_);
+  entry->next_ = partition_heads_[partition_idx];
+  partition_heads_[partition_idx] = entry;
+  if (UNLIKELY(partition_tails_[partition_idx] == nullptr)) {
+    partition_tails_[partition_idx] = entry;
+  }
+  partition_estimates_[partition_idx]->Update(common::HashUtil::ScrambleHash(entry->hash_));
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  NOISEPAGE_ASSERT(hash_table_.GetElementCount() == 0, "All entries must be in the overflow partitions to spill");
+  if (!IsSpilled()) {
+    EXECUTION_LOG_DEBUG("AHT: {} bytes of overflow entries exceed the budget of {} bytes, spilling",
+                        entries_.size() * entries_.ElementSize(), memory_budget_);
+    spilled_partitions_.resize(DEFAULT_NUM_PARTITIONS);
+  }
+
+  const uint32_t entry_size = entries_.ElementSize();
+  for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+    if (partition_heads_[part_idx] == nullptr) {
+      continue;
+    }
+    auto &files = spilled_partitions_[part_idx];
+    if (files.empty()) {
+      files.emplace_back(std::make_unique<SpillFile>(entry_size, memory_->GetTracker()));
+    }
+    for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+      std::memcpy(files.back()->Append(), entry, entry_size);
+    }
+    partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+  }
+
+  // The chunks are kept, and reused until the next spill. The partition
+  // estimates are kept, too, as they still describe the spilled entries.
+  num_spilled_tuples_ += entries_.size();
+  entries_.clear();
+
+  // Update stats
+  stats_.num_spills_++;
+}
+
 byte *AggregationHashTable::AllocInputTuplePartitioned(hash_t hash) {
+  // Entries handed out before the last flush have been written by now
+  if (UNLIKELY(NeedsToSpill())) {
+    SpillOverflowPartitions();
+  }
+
   byte *ret = AllocInputTuple(hash);
   if (NeedsToFlushToOverflowPartitions()) {
     FlushToOverflowPartitions();
@@ -492,6 +537,58 @@ void AggregationHashTable::AdvanceGroups(VectorProjectionIterator *input_batch,
   advance_agg_fn(&iter, input_batch);
 }
 
+void AggregationHashTable::SamplePreAggregationReduction() {
+  // The table is about to be flushed, so it holds every group formed by the
+  // tuples pre-aggregated since the last flush.
+  const auto groups = static_cast<float>(GetTupleCount());
+  if (adaptive_preaggregation_ && preagg_tuple_count_ != 0 &&
+      groups >= PREAGG_BYPASS_RATIO * static_cast<float>(preagg_tuple_count_)) {
+    EXECUTION_LOG_TRACE("AHT: {} tuples formed {} groups, bypassing pre-aggregation", preagg_tuple_count_,
+                        GetTupleCount());
+    bypass_preaggregation_ = true;
+    preagg_tuple_count_ = PREAGG_BYPASS_RESAMPLE_FACTOR * flush_threshold_;
+  } else {
+    preagg_tuple_count_ = 0;
+  }
+}
+
+void AggregationHashTable::PartitionBatch(VectorProjectionIterator *input_batch,
+                                          const AggregationHashTable::VectorInitAggFn init_agg_fn,
+                                          const AggregationHashTable::VectorAdvanceAggFn advance_agg_fn) {
+  if (UNLIKELY(partition_heads_ == nullptr)) {
+    AllocateOverflowPartitions();
+  }
+
+  // Every tuple gets a new aggregate of its own, which "finds" its group.
+  TupleIdList *tids = batch_state_->GroupsFound();
+  tids->AssignFrom(*batch_state_->GroupsNotFound());
+
+  auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(batch_state_->Hashes()->GetData());
+  auto *RESTRICT raw_entries = reinterpret_cast<HashTableEntry **>(batch_state_->Entries()->GetData());
+  tids->ForEach([&](const uint64_t i) {
+    auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+    entry->hash_ = raw_hashes[i];
+    LinkIntoOverflowPartition(entry);
+    raw_entries[i] = entry;
+  });
+
+  // Initialize the new aggregates, then update them with their tuple.
+  VectorProjectionIterator iter(batch_state_->Projection(), tids);
+  input_batch->SetVectorProjection(input_batch->GetVectorProjection(), tids);
+  init_agg_fn(&iter, input_batch);
+  AdvanceGroups(input_batch, advance_agg_fn);
+
+  // Resume pre-aggregation once enough tuples have been partitioned directly.
+  const uint64_t num_tuples = tids->GetTupleCount();
+  stats_.num_bypassed_tuples_ += num_tuples;
+  if (num_tuples >= preagg_tuple_count_) {
+    bypass_preaggregation_ = false;
+    preagg_tuple_count_ = 0;
+  } else {
+    preagg_tuple_count_ -= num_tuples;
+  }
+}
+
 void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes,
                                         const AggregationHashTable::VectorInitAggFn init_agg_fn,
                                         const AggregationHashTable::VectorAdvanceAggFn advance_agg_fn,
@@ -508,12 +605,25 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
         std::make_unique<HashToGroupIdMap>());         // The Hash-to-GroupID map
   }
 
+  // Spill the overflow partitions if they have outgrown the memory budget.
+  // The aggregates of the previous batch have been advanced by now.
+  if (partitioned_aggregation && NeedsToSpill()) {
+    SpillOverflowPartitions();
+  }
+
   // Reset state for the incoming batch.
   batch_state_->Reset(input_batch);
+  const uint32_t num_tuples = input_batch->GetSelectedTupleCount();
 
   // Compute the hashes.
   ComputeHash(input_batch, key_indexes);
 
+  // Partition the batch directly if pre-aggregation barely reduces the input.
+  if (partitioned_aggregation && bypass_preaggregation_) {
+    PartitionBatch(input_batch, init_agg_fn, advance_agg_fn);
+    return;
+  }
+
   // Find groups.
   FindGroups(input_batch, key_indexes);
 
@@ -523,7 +633,9 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
   // If the caller requested a partitioned aggregation, drain the main hash
   // table out to the overflow partitions, but only if needed.
   if (partitioned_aggregation) {
+    preagg_tuple_count_ += num_tuples;
     if (NeedsToFlushToOverflowPartitions()) {
+      SamplePreAggregationReduction();
       FlushToOverflowPartitions();
     }
   } else {
@@ -567,36 +679,111 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
     stats_.num_inserts_ += table->stats_.num_inserts_;
     table->FlushToOverflowPartitions();
 
-    // Now, move over their memory
-    owned_entries_.emplace_back(std::move(table->entries_));
-
     NOISEPAGE_ASSERT(table->owned_entries_.empty(),
                      "A thread-local aggregation table should not have any owned "
                      "entries themselves. Nested/recursive aggregations not supported.");
 
-    // Now, move over their overflow partitions list
+    // Update the unique-count estimates of the partitions before they're moved
     for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-      if (table->partition_heads_[part_idx] != nullptr) {
-        // Link in the partition list
-        table->partition_tails_[part_idx]->next_ = partition_heads_[part_idx];
-        partition_heads_[part_idx] = table->partition_heads_[part_idx];
-        if (partition_tails_[part_idx] == nullptr) {
-          partition_tails_[part_idx] = table->partition_tails_[part_idx];
-        }
-        // Update the partition's unique-count estimate
+      if (table->HasOverflowEntries(part_idx)) {
         partition_estimates_[part_idx]->Merge(table->partition_estimates_[part_idx]);
       }
     }
+
+    // Now, move over their memory and overflow partitions
+    TakeOverflowPartitions(table);
   }
 
   exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(tl_agg_ht.size()));
 }
 
+void AggregationHashTable::TakeOverflowPartitions(AggregationHashTable *source) {
+  // Link in the in-memory partition lists
+  for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+    if (source->partition_heads_[part_idx] != nullptr) {
+      source->partition_tails_[part_idx]->next_ = partition_heads_[part_idx];
+      partition_heads_[part_idx] = source->partition_heads_[part_idx];
+      if (partition_tails_[part_idx] == nullptr) {
+        partition_tails_[part_idx] = source->partition_tails_[part_idx];
+      }
+    }
+  }
+
+  // Take over the spill files of the partitions
+  if (source->IsSpilled()) {
+    if (!IsSpilled()) {
+      spilled_partitions_.resize(DEFAULT_NUM_PARTITIONS);
+    }
+    for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+      auto &files = source->spilled_partitions_[part_idx];
+      std::move(files.begin(), files.end(), std::back_inserter(spilled_partitions_[part_idx]));
+      files.clear();
+    }
+    num_spilled_tuples_ += source->num_spilled_tuples_;
+  }
+
+  // Move over the memory of the entries
+  owned_entries_.emplace_back(std::move(source->entries_));
+}
+
+void AggregationHashTable::MergeOverflowPartition(void *query_state, const uint32_t partition_idx,
+                                                  AggregationHashTable *target,
+                                                  const AggregationHashTable::MergePartitionFn merge_fn) {
+  // First, the entries still in memory
+  if (partition_heads_[partition_idx] != nullptr) {
+    AHTOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
+    merge_fn(query_state, target, &iter);
+  }
+
+  if (!IsSpilled()) {
+    return;
+  }
+
+  auto &files = spilled_partitions_[partition_idx];
+  if (files.empty()) {
+    return;
+  }
+
+  // Then, the spilled entries. The merging function may link entries into the
+  // target instead of copying them, so they are read back into memory owned by
+  // the target, and chained into a partition list of their own.
+  const uint32_t entry_size = entries_.ElementSize();
+  decltype(entries_) loaded(entry_size, MemoryPoolAllocator<byte>(target->memory_));
+  HashTableEntry *head = nullptr;
+  std::unique_ptr<byte[]> block;
+  for (const auto &file : files) {
+    file->Finish();
+    if (block == nullptr) {
+      block = std::make_unique<byte[]>(file->GetRecordsPerBlock() * entry_size);
+    }
+    for (uint64_t first = 0, n; (n = file->ReadBlock(first, block.get())) != 0; first += n) {
+      for (uint64_t i = 0; i < n; i++) {
+        auto *entry = reinterpret_cast<HashTableEntry *>(loaded.Append());
+        std::memcpy(entry, block.get() + i * entry_size, entry_size);
+        entry->next_ = head;
+        head = entry;
+      }
+    }
+  }
+
+  // The partition is read back, its files are no longer needed
+  files.clear();
+
+  AHTOverflowPartitionIterator iter(&head, &head + 1);
+  merge_fn(query_state, target, &iter);
+  target->owned_entries_.emplace_back(std::move(loaded));
+}
+
+void AggregationHashTable::FreeTableOverPartition(const uint32_t partition_idx) {
+  partition_tables_[partition_idx]->~AggregationHashTable();
+  memory_->Deallocate(partition_tables_[partition_idx], sizeof(AggregationHashTable));
+  partition_tables_[partition_idx] = nullptr;
+}
+
 AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *query_state,
                                                                          const uint32_t partition_idx) {
   NOISEPAGE_ASSERT(partition_idx < DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
-  NOISEPAGE_ASSERT(partition_heads_[partition_idx] != nullptr,
-                   "Should not build aggregation table over empty partition!");
+  NOISEPAGE_ASSERT(HasOverflowEntries(partition_idx), "Should not build aggregation table over empty partition!");
   NOISEPAGE_ASSERT(merge_partition_fn_ != nullptr,
                    "Merging function was not provided! Did you forget to call TransferMemoryAndPartitions()?");
 
@@ -614,8 +801,7 @@ AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *q
   timer.Start();
 
   // Build it
-  AHTOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
-  merge_partition_fn_(query_state, agg_table, &iter);
+  MergeOverflowPartition(query_state, partition_idx, agg_table, merge_partition_fn_);
 
   timer.Stop();
   EXECUTION_LOG_DEBUG("Overflow Partition {}: estimated size = {}, actual size = {}, build time = {:2f} ms",
@@ -635,11 +821,15 @@ void AggregationHashTable::ExecutePartitionedScan(void *query_state, Aggregation
 
   // Determine the non-empty overflow partitions.
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (HasOverflowEntries(part_idx)) {
       // Get or build the table on the partition.
       auto agg_table_partition = GetOrBuildTableOverPartition(query_state, part_idx);
       // Scan the partition.
       scan_fn(query_state, nullptr, agg_table_partition);
+      // Only keep one partition in memory at a time if we spilled.
+      if (IsSpilled()) {
+        FreeTableOverPartition(part_idx);
+      }
     }
   }
 }
@@ -662,11 +852,16 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t i = 0; i < DEFAULT_NUM_PARTITIONS; i++) {
-    if (partition_heads_[i] != nullptr) {
+    if (HasOverflowEntries(i)) {
       nonempty_parts.push_back(i);
     }
   }
 
+  // If we spilled, the partitions are read back from disk one at a time per
+  // thread, and each table is released as soon as it has been scanned.
+  const bool release_tables = IsSpilled();
+  std::atomic<uint64_t> tuple_count{0};
+
   util::Timer<std::milli> timer;
   timer.Start();
 
@@ -688,18 +883,19 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
 
     // Scan the partition
     scan_fn(query_state, thread_state, agg_table_partition);
+
+    tuple_count += agg_table_partition->GetTupleCount();
+    if (release_tables) {
+      FreeTableOverPartition(part_idx);
+    }
   });
 
   exec_ctx_->SetNumConcurrentEstimate(0);
   timer.Stop();
 
-  const uint64_t tuple_count =
-      std::accumulate(nonempty_parts.begin(), nonempty_parts.end(), uint64_t{0},
-                      [&](const auto curr, const auto idx) { return curr + partition_tables_[idx]->GetTupleCount(); });
-
-  UNUSED_ATTRIBUTE double tps = (tuple_count / timer.GetElapsed()) / 1000.0;
+  UNUSED_ATTRIBUTE double tps = (tuple_count.load() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("Built and scanned {} tables totalling {} tuples in {:.2f} ms ({:.2f} mtps)",
-                      nonempty_parts.size(), tuple_count, timer.GetElapsed(), tps);
+                      nonempty_parts.size(), tuple_count.load(), timer.GetElapsed(), tps);
 }
 
 void AggregationHashTable::BuildAllPartitions(void *query_state) {
@@ -710,7 +906,7 @@ void AggregationHashTable::BuildAllPartitions(void *query_state) {
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (HasOverflowEntries(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
@@ -733,20 +929,9 @@ void AggregationHashTable::Repartition() {
   // First, flush all hash table partitions to their own overflow buckets.
   tbb::parallel_for_each(nonempty_tables, [&](auto table) { table->FlushToOverflowPartitions(); });
 
-  // Now, transfer each hash table partition's overflow buckets to us.
+  // Now, transfer each hash table partition's overflow buckets and memory to us.
   for (auto *table : nonempty_tables) {
-    for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-      if (table->partition_heads_[part_idx] != nullptr) {
-        table->partition_tails_[part_idx]->next_ = partition_heads_[part_idx];
-        partition_heads_[part_idx] = table->partition_heads_[part_idx];
-        if (partition_tails_[part_idx] == nullptr) {
-          partition_tails_[part_idx] = table->partition_tails_[part_idx];
-        }
-      }
-    }
-
-    // Move partitioned hash table memory into this main hash table.
-    owned_entries_.emplace_back(std::move(table->entries_));
+    TakeOverflowPartitions(table);
   }
 }
 
@@ -760,7 +945,7 @@ void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *q
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (HasOverflowEntries(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
@@ -771,8 +956,7 @@ void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *q
     auto agg_table_partition = target->GetOrBuildTableOverPartition(query_state, part_idx);
 
     // Merge our overflow partition into target table.
-    AHTOverflowPartitionIterator iter(partition_heads_ + part_idx, partition_heads_ + part_idx + 1);
-    merge_func(query_state, agg_table_partition, &iter);
+    MergeOverflowPartition(query_state, part_idx, agg_table_partition, merge_func);
   });
 
   // Move our memory to the target.
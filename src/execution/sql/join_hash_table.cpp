@@ -1,14 +1,20 @@
 #include "execution/sql/join_hash_table.h"
 
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MathExtras.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
 #include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/memory_pool.h"
@@ -23,7 +29,7 @@
 namespace noisepage::execution::sql {
 
 JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings, exec::ExecutionContext *exec_ctx,
-                             uint32_t tuple_size, bool use_concise_ht)
+                             uint32_t tuple_size, bool use_concise_ht, uint32_t probe_tuple_size)
     : exec_settings_(exec_settings),
       exec_ctx_(exec_ctx),
       entries_(HashTableEntry::ComputeEntrySize(tuple_size), MemoryPoolAllocator<byte>(exec_ctx->GetMemoryPool())),
@@ -32,7 +38,17 @@ JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings, exec:
       hll_estimator_(libcount::HLL::Create(DEFAULT_HLL_PRECISION)),
       built_(false),
       use_concise_ht_(use_concise_ht),
-      tracker_(exec_ctx->GetMemoryPool()->GetTracker()) {}
+      tracker_(exec_ctx->GetMemoryPool()->GetTracker()),
+      probe_tuple_size_(probe_tuple_size),
+      // Only chaining tables whose prober can spill probe tuples may spill
+      memory_budget_(probe_tuple_size == 0 || use_concise_ht ? 0 : exec_settings.GetJoinMemoryBudget()),
+      spilled_(false),
+      num_spilled_tuples_(0),
+      radix_partition_cache_size_(CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE)),
+      num_merge_partitions_(0),
+      current_probe_idx_(0),
+      probe_block_begin_(0),
+      probe_block_size_(0) {}
 
 // Needed because we forward-declared HLL from libcount
 JoinHashTable::~JoinHashTable() = default;
@@ -41,6 +57,12 @@ byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   // Add to unique_count estimation
   hll_estimator_->Update(hash);
 
+  // Spill the buffered tuples if they have outgrown the memory budget
+  if (memory_budget_ != 0 && !entries_.empty() && entries_.size() % SPILL_CHECK_INTERVAL == 0 &&
+      IsOverMemoryBudget()) {
+    SpillBuildTuples();
+  }
+
   // Allocate space for a new tuple
   auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
   entry->hash_ = hash;
@@ -48,6 +70,198 @@ byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   return entry->payload_;
 }
 
+namespace {
+
+// Call f on every record of the given spill file, in order.
+template <typename F>
+void ForEachSpilledRecord(const SpillFile &file, F &&f) {
+  const uint32_t record_size = file.GetRecordSize();
+  const auto block = std::make_unique<byte[]>(file.GetRecordsPerBlock() * record_size);
+  for (uint64_t first = 0, n; (n = file.ReadBlock(first, block.get())) != 0; first += n) {
+    for (uint64_t i = 0; i < n; i++) {
+      f(block.get() + i * record_size);
+    }
+  }
+}
+
+}  // namespace
+
+uint32_t JoinHashTable::GetProbeRecordSize() const {
+  // Keep the probe tuples that follow the hash aligned
+  return sizeof(hash_t) + common::MathUtil::AlignTo(probe_tuple_size_, alignof(hash_t));
+}
+
+void JoinHashTable::SpillBuildTuples() {
+  if (!spilled_) {
+    EXECUTION_LOG_DEBUG("JHT: {} bytes of buffered tuples exceed the budget of {} bytes, spilling",
+                        GetBufferedTupleMemoryUsage(), memory_budget_);
+    spilled_partitions_.resize(NUM_SPILL_PARTITIONS);
+    spilled_ = true;
+  }
+
+  const uint32_t entry_size = entries_.ElementSize();
+  for (auto iter = entries_.begin(), end = entries_.end(); iter != end; ++iter) {
+    const auto *entry = reinterpret_cast<const HashTableEntry *>(*iter);
+    auto &partition = spilled_partitions_[SpillPartitionOf(entry->hash_, 0)];
+    if (partition.build_.empty()) {
+      partition.build_.emplace_back(std::make_unique<SpillFile>(entry_size, tracker_));
+    }
+    std::memcpy(partition.build_.back()->Append(), *iter, entry_size);
+  }
+
+  // The chunks are kept, and reused until the next spill
+  num_spilled_tuples_ += entries_.size();
+  entries_.clear();
+}
+
+void JoinHashTable::SpillProbeTuple(const hash_t hash, const byte *probe_tuple) {
+  NOISEPAGE_ASSERT(IsSpilled(), "Only spilled tables spill probe tuples");
+  const uint32_t partition_idx = SpillPartitionOf(hash, 0);
+  auto &partition = spilled_partitions_[partition_idx];
+
+  common::SpinLatch::ScopedSpinLatch latch(&spilled_probe_latches_[partition_idx]);
+  if (partition.probe_ == nullptr) {
+    partition.probe_ = std::make_unique<SpillFile>(GetProbeRecordSize(), tracker_);
+  }
+  byte *record = partition.probe_->Append();
+  *reinterpret_cast<hash_t *>(record) = hash;
+  std::memcpy(record + sizeof(hash_t), probe_tuple, probe_tuple_size_);
+}
+
+void JoinHashTable::RepartitionSpilled(SpilledPartition *partition) {
+  const uint32_t level = partition->level_ + 1;
+  EXECUTION_LOG_DEBUG("JHT: splitting a spilled partition into level {}", level);
+
+  std::vector<SpilledPartition> children(NUM_SPILL_PARTITIONS);
+  for (auto &child : children) {
+    child.level_ = level;
+  }
+
+  // Scatter build entries, then probe records, dropping each input file as soon as it is consumed
+  for (auto &file : partition->build_) {
+    ForEachSpilledRecord(*file, [&](const byte *record) {
+      auto &child = children[SpillPartitionOf(reinterpret_cast<const HashTableEntry *>(record)->hash_, level)];
+      if (child.build_.empty()) {
+        child.build_.emplace_back(std::make_unique<SpillFile>(file->GetRecordSize(), tracker_));
+      }
+      std::memcpy(child.build_.back()->Append(), record, file->GetRecordSize());
+    });
+    file.reset();
+  }
+  if (partition->probe_ != nullptr) {
+    const auto &file = partition->probe_;
+    ForEachSpilledRecord(*file, [&](const byte *record) {
+      auto &child = children[SpillPartitionOf(*reinterpret_cast<const hash_t *>(record), level)];
+      if (child.probe_ == nullptr) {
+        child.probe_ = std::make_unique<SpillFile>(file->GetRecordSize(), tracker_);
+      }
+      std::memcpy(child.probe_->Append(), record, file->GetRecordSize());
+    });
+    partition->probe_.reset();
+  }
+
+  // Queue the children so that the first one is processed next
+  for (auto iter = children.rbegin(); iter != children.rend(); ++iter) {
+    pending_partitions_.emplace_back(std::move(*iter));
+  }
+}
+
+void JoinHashTable::LoadSpilledPartition(SpilledPartition *partition) {
+  entries_.clear();
+  for (const auto &file : partition->build_) {
+    ForEachSpilledRecord(
+        *file, [this](const byte *record) { std::memcpy(entries_.Append(), record, entries_.ElementSize()); });
+  }
+  BuildChainingHashTable();
+
+  current_probe_ = std::move(partition->probe_);
+  current_probe_idx_ = 0;
+  probe_block_begin_ = 0;
+  probe_block_size_ = 0;
+}
+
+bool JoinHashTable::NextSpilledPartition() {
+  NOISEPAGE_ASSERT(IsSpilled(), "Only spilled tables are processed partition-wise");
+
+  // On the first call, all probe tuples have been spilled; queue up the top-level partitions
+  if (!spilled_partitions_.empty()) {
+    for (auto iter = spilled_partitions_.rbegin(); iter != spilled_partitions_.rend(); ++iter) {
+      pending_partitions_.emplace_back(std::move(*iter));
+    }
+    spilled_partitions_.clear();
+  }
+
+  while (!pending_partitions_.empty()) {
+    SpilledPartition partition = std::move(pending_partitions_.back());
+    pending_partitions_.pop_back();
+
+    uint64_t build_size = 0;
+    for (const auto &file : partition.build_) {
+      file->Finish();
+      build_size += file->GetRecordCount() * file->GetRecordSize();
+    }
+    if (partition.probe_ != nullptr) {
+      partition.probe_->Finish();
+    }
+
+    // Build tuples without probe tuples must still be loaded, as outer joins emit them unmatched
+    if (build_size == 0 && partition.probe_ == nullptr) {
+      continue;
+    }
+
+    // Split partitions that don't fit, unless they are already so small that their keys must repeat
+    if (build_size > memory_budget_ && partition.level_ + 1 < MAX_SPILL_DEPTH) {
+      RepartitionSpilled(&partition);
+      continue;
+    }
+
+    LoadSpilledPartition(&partition);
+    return true;
+  }
+
+  // All partitions were processed
+  entries_.clear();
+  current_probe_.reset();
+  probe_block_.reset();
+  return false;
+}
+
+const byte *JoinHashTable::NextSpilledProbeTuple() {
+  if (current_probe_ == nullptr) {
+    return nullptr;
+  }
+
+  // Read ahead the next block once the current one is exhausted
+  if (current_probe_idx_ == probe_block_begin_ + probe_block_size_) {
+    if (probe_block_ == nullptr) {
+      probe_block_ = std::make_unique<byte[]>(current_probe_->GetRecordsPerBlock() * current_probe_->GetRecordSize());
+    }
+    probe_block_begin_ = current_probe_idx_;
+    probe_block_size_ = current_probe_->ReadBlock(current_probe_idx_, probe_block_.get());
+    if (probe_block_size_ == 0) {
+      return nullptr;
+    }
+  }
+
+  const byte *record =
+      probe_block_.get() + (current_probe_idx_++ - probe_block_begin_) * current_probe_->GetRecordSize();
+  return record + sizeof(hash_t);
+}
+
+void JoinHashTable::MergeSpilled(JoinHashTable *source) {
+  NOISEPAGE_ASSERT(source->IsSpilled(), "Only spilled tables can be merged as spilled");
+  if (!spilled_) {
+    spilled_partitions_.resize(NUM_SPILL_PARTITIONS);
+    spilled_ = true;
+  }
+  for (uint32_t idx = 0; idx < NUM_SPILL_PARTITIONS; idx++) {
+    auto &files = source->spilled_partitions_[idx].build_;
+    std::move(files.begin(), files.end(), std::back_inserter(spilled_partitions_[idx].build_));
+    files.clear();
+  }
+  num_spilled_tuples_ += source->num_spilled_tuples_;
+}
+
 void JoinHashTable::BuildChainingHashTable() {
   // Perfectly size the generic hash table in preparation for bulk-load.
   chaining_hash_table_.SetSize(GetTupleCount(), tracker_);
@@ -500,6 +714,11 @@ void JoinHashTable::Build() {
   util::Timer<> timer;
   timer.Start();
 
+  // A spilled table spills the rest of its tuples too, leaving its index empty until a partition is loaded
+  if (IsSpilled()) {
+    SpillBuildTuples();
+  }
+
   // Build
   if (UsingConciseHashTable()) {
     BuildConciseHashTable();
@@ -518,6 +737,15 @@ void JoinHashTable::Build() {
 // TODO(pmenon): Implement prefetching.
 
 void JoinHashTable::LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const {
+  // A vectorized probe cannot be partitioned like the build without materializing the whole probe
+  // input. Instead, when the directory is out of cache, prefetch the chain heads of the whole batch
+  // first, so that their cache misses overlap.
+  if (chaining_hash_table_.GetTotalMemoryUsage() > CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE)) {
+    const auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+    VectorOps::Exec(hashes,
+                    [&](uint64_t i, uint64_t k) { chaining_hash_table_.PrefetchChainHead<true>(raw_hashes[i]); });
+  }
+
   UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
       exec_settings_, hashes,
       results, [&](const hash_t hash_val) noexcept { return chaining_hash_table_.FindChainHead(hash_val); });
@@ -553,11 +781,141 @@ void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
   owned_.emplace_back(std::move(source->entries_));
 }
 
+uint32_t JoinHashTable::ComputeRadixPartitionBits() const {
+  const uint64_t cache_size = radix_partition_cache_size_;
+  const uint64_t directory_size = chaining_hash_table_.GetTotalMemoryUsage();
+  if (cache_size == 0 || directory_size <= cache_size) {
+    return 0;
+  }
+  // Both sizes are rounded to powers of two, the directory's already is
+  const auto bits = llvm::Log2_64(directory_size) - llvm::Log2_64(common::MathUtil::PowerOf2Floor(cache_size));
+  return std::min(bits, MAX_RADIX_PARTITION_BITS);
+}
+
+namespace {
+
+// Scatter pointers to the given entries into their partitions of the output array, each entry
+// going to the position of its partition given by 'positions', which is advanced past it. Pointers
+// are staged in a cache line sized write-combining buffer per partition, and written out a full
+// line at a time, so that the scatter keeps only one line per partition in cache instead of one
+// per entry. Lines at the boundaries of a partition's range are only partially written.
+template <typename Entries, typename F>
+void ScatterToPartitions(const Entries &entries, F &&partition_of, std::vector<uint64_t> *positions,
+                         HashTableEntry **out) {
+  constexpr uint32_t entries_per_line = common::Constants::CACHELINE_SIZE / sizeof(HashTableEntry *);
+  struct alignas(common::Constants::CACHELINE_SIZE) Line {
+    HashTableEntry *entries_[entries_per_line];
+  };
+
+  const std::vector<uint64_t> begins(*positions);
+  std::vector<Line> buffers(positions->size());
+
+  // Write the buffered pointers of the line that ends at 'end' in the given partition
+  const auto flush = [&](const uint32_t part, const uint64_t end) {
+    const uint64_t line_begin = (end - 1) / entries_per_line * entries_per_line;
+    const uint64_t from = std::max(line_begin, begins[part]);
+    std::memcpy(out + from, &buffers[part].entries_[from - line_begin], (end - from) * sizeof(HashTableEntry *));
+  };
+
+  for (auto iter = entries.begin(), end = entries.end(); iter != end; ++iter) {
+    auto *entry = reinterpret_cast<HashTableEntry *>(*iter);
+    const uint32_t part = partition_of(entry->hash_);
+    const uint64_t pos = (*positions)[part]++;
+    buffers[part].entries_[pos % entries_per_line] = entry;
+    if ((pos + 1) % entries_per_line == 0) {
+      flush(part, pos + 1);
+    }
+  }
+
+  // Write out the partially filled lines
+  for (uint32_t part = 0; part < positions->size(); part++) {
+    if (const uint64_t end = (*positions)[part]; end != begins[part] && end % entries_per_line != 0) {
+      flush(part, end);
+    }
+  }
+}
+
+}  // namespace
+
+void JoinHashTable::MergePartitioned(const std::vector<JoinHashTable *> &tl_join_tables, const uint32_t radix_bits) {
+  // A partition is a contiguous range of buckets of the directory, i.e., the top bits of the
+  // bucket position of its entries
+  const uint32_t num_partitions = 1u << radix_bits;
+  num_merge_partitions_ = num_partitions;
+  const uint64_t bucket_mask = chaining_hash_table_.GetCapacity() - 1;
+  const uint32_t shift = llvm::Log2_64(chaining_hash_table_.GetCapacity()) - radix_bits;
+  const auto partition_of = [=](const hash_t hash) { return static_cast<uint32_t>((hash & bucket_mask) >> shift); };
+
+  // First, count the entries of each thread-local table in each partition
+  std::vector<std::vector<uint64_t>> positions(tl_join_tables.size(), std::vector<uint64_t>(num_partitions, 0));
+  tbb::parallel_for(std::size_t{0}, tl_join_tables.size(), [&](const std::size_t idx) {
+    const auto &entries = tl_join_tables[idx]->entries_;
+    for (auto iter = entries.begin(), end = entries.end(); iter != end; ++iter) {
+      positions[idx][partition_of(reinterpret_cast<const HashTableEntry *>(*iter)->hash_)]++;
+    }
+  });
+
+  // Lay partitions out contiguously, each thread-local table writing its own range of each
+  // partition, and turn the counts into the positions each table starts writing at
+  std::vector<uint64_t> partition_begins(num_partitions + 1);
+  uint64_t num_entries = 0;
+  for (uint32_t part = 0; part < num_partitions; part++) {
+    partition_begins[part] = num_entries;
+    for (auto &table_positions : positions) {
+      num_entries += std::exchange(table_positions[part], num_entries);
+    }
+  }
+  partition_begins[num_partitions] = num_entries;
+
+  if (num_entries != 0) {
+    auto *partitioned = util::Memory::TrackMallocHugeArray<HashTableEntry *>(tracker_, num_entries, false);
+
+    // Scatter every thread-local table's entries into the partitions
+    tbb::parallel_for(std::size_t{0}, tl_join_tables.size(), [&](const std::size_t idx) {
+      ScatterToPartitions(tl_join_tables[idx]->entries_, partition_of, &positions[idx], partitioned);
+    });
+
+    // Insert each partition into its own range of the directory. No two threads touch the same
+    // buckets, so no atomics are needed.
+    tbb::parallel_for(uint32_t{0}, num_partitions, [&](const uint32_t part) {
+      const uint64_t begin = partition_begins[part], end = partition_begins[part + 1];
+      chaining_hash_table_.InsertBatch<false>(partitioned + begin, end - begin);
+    });
+
+    util::Memory::TrackFreeHugeArray(tracker_, partitioned, num_entries);
+  }
+
+  // Take ownership of the thread-local tables' memory
+  common::SpinLatch::ScopedSpinLatch latch(&owned_latch_);
+  for (auto *source : tl_join_tables) {
+    owned_.emplace_back(std::move(source->entries_));
+  }
+}
+
 void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container, const std::size_t jht_offset) {
   // Collect thread-local hash tables
   std::vector<JoinHashTable *> tl_join_tables;
   thread_state_container->CollectThreadLocalStateElementsAs(&tl_join_tables, jht_offset);
 
+  // If any thread-local table spilled, the build side does not fit in memory. Then, every table
+  // spills the rest of its tuples in parallel, and this table takes all their partitions instead of
+  // merging them in memory.
+  if (std::any_of(tl_join_tables.begin(), tl_join_tables.end(), [](auto *jht) { return jht->IsSpilled(); })) {
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+    auto *tls = thread_state_container->AccessCurrentThreadState();
+    exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+    tbb::parallel_for_each(tl_join_tables, [](auto *source) { source->SpillBuildTuples(); });
+    llvm::for_each(tl_join_tables, [this](auto *source) { MergeSpilled(source); });
+    BuildChainingHashTable();
+
+    exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_spilled_tuples_));
+    EXECUTION_LOG_TRACE("JHT: merged {} spilled JHTs with {} tuples", tl_join_tables.size(), num_spilled_tuples_);
+    built_ = true;
+    return;
+  }
+
   // Combine HLL counts to get a global estimate
   for (auto *jht : tl_join_tables) {
     hll_estimator_->Merge(jht->hll_estimator_.get());
@@ -576,6 +934,8 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
   timer.Start();
 
   const bool use_serial_build = num_elem_estimate < DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE;
+  const uint32_t radix_bits =
+      exec_settings_.GetIsJoinRadixPartitioningEnabled() && !use_serial_build ? ComputeRadixPartitionBits() : 0;
   if (use_serial_build) {
     // TODO(pmenon): Switch to parallel-mode if estimate is wrong.
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements < {} element parallel threshold. Using serial merge.",
@@ -588,6 +948,18 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
 
     llvm::for_each(tl_join_tables, [this](auto *source) { MergeIncomplete<false>(source); });
 
+    exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_elem_estimate));
+  } else if (radix_bits != 0) {
+    EXECUTION_LOG_TRACE("JHT: Directory of {} bytes exceeds the L2 cache. Using parallel merge on {} partitions.",
+                        chaining_hash_table_.GetTotalMemoryUsage(), 1u << radix_bits);
+
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+    auto *tls = thread_state_container->AccessCurrentThreadState();
+    exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+    MergePartitioned(tl_join_tables, radix_bits);
+
     exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_elem_estimate));
   } else {
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements >= {} element parallel threshold. Using parallel merge.",
@@ -614,8 +986,9 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
 
   UNUSED_ATTRIBUTE const double tps = (chaining_hash_table_.GetElementCount() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("JHT: {} merged {} JHTs. Estimated {}, actual {}. Time: {:.2f} ms ({:.2f} mtps)",
-                      use_serial_build ? "Serial" : "Parallel", tl_join_tables.size(), num_elem_estimate,
-                      chaining_hash_table_.GetElementCount(), timer.GetElapsed(), tps);
+                      use_serial_build ? "Serial" : (radix_bits != 0 ? "Partitioned" : "Parallel"),
+                      tl_join_tables.size(), num_elem_estimate, chaining_hash_table_.GetElementCount(),
+                      timer.GetElapsed(), tps);
 
   built_ = true;
 }
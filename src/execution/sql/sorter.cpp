@@ -10,6 +10,8 @@
 #include <vector>
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/memory_tracker.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -25,24 +27,69 @@ namespace noisepage::execution::sql {
 //
 //===----------------------------------------------------------------------===//
 
-Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint32_t tuple_size)
+Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint32_t tuple_size, uint32_t key_size)
     : exec_ctx_(exec_ctx),
       memory_(exec_ctx->GetMemoryPool()),
       tuple_storage_(tuple_size, MemoryPoolAllocator<byte>(exec_ctx->GetMemoryPool())),
       owned_tuples_(exec_ctx->GetMemoryPool()),
       cmp_fn_(cmp_fn),
+      key_size_(key_size),
       tuples_(exec_ctx->GetMemoryPool()),
-      sorted_(false) {}
+      memory_budget_(exec_ctx->GetExecutionSettings().GetSortMemoryBudget()),
+      num_spilled_tuples_(0),
+      sorted_(false) {
+  NOISEPAGE_ASSERT(key_size <= tuple_size, "Normalized key must fit in the tuple");
+}
 
 Sorter::~Sorter() = default;
 
 byte *Sorter::AllocInputTuple() {
+  // Spill what was buffered once it takes up more than the budget. Like hash joins, the budget is
+  // only checked periodically rather than on every insertion.
+  if (memory_budget_ != 0 && tuples_.size() >= MIN_TUPLES_PER_SPILLED_RUN &&
+      tuples_.size() % SPILL_CHECK_INTERVAL == 0 && IsOverMemoryBudget()) {
+    SpillRun();
+  }
+
+  byte *ret = tuple_storage_.Append();
+  tuples_.push_back(ret);
+  return ret;
+}
+
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) {
+  // Top-K only retains K tuples, so it never spills
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+void Sorter::SpillRun() {
+  if (tuples_.empty()) {
+    return;
+  }
+
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  SortInMemory();
+  // Gather the scattered tuples into blocks, so that the run is written sequentially in large writes. The written
+  // bytes are counted in the thread's tracker, like the spills of joins and aggregations.
+  const uint32_t tuple_size = tuple_storage_.ElementSize();
+  auto run = std::make_unique<SpillFile>(tuple_size, memory_->GetTracker(), SPILLED_RUN_BLOCK_SIZE);
+  for (const byte *tuple : tuples_) {
+    std::memcpy(run->Append(), tuple, tuple_size);
+  }
+  run->Finish();
+  spilled_runs_.emplace_back(std::move(run));
+  num_spilled_tuples_ += tuples_.size();
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Spilled run of {} tuples in {} ms", tuples_.size(), timer.GetElapsed());
+
+  // Release the memory of the spilled tuples, so that the sorter is back under budget
+  tuple_storage_ = decltype(tuple_storage_)(tuple_storage_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+  decltype(tuples_)(memory_).swap(tuples_);
+}
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done.
@@ -66,7 +113,7 @@ void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
 
   const byte *heap_top = tuples_.front();
 
-  if (cmp_fn_(last_insert, heap_top) <= 0) {
+  if (Compare(last_insert, heap_top) <= 0) {
     // The last insertion belongs in the top-k. Swap it with the current maximum
     // and sift it down.
     tuples_.front() = last_insert;
@@ -75,7 +122,7 @@ void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
 }
 
 void Sorter::BuildHeap() {
-  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  const auto compare = [this](const byte *left, const byte *right) { return Compare(left, right) < 0; };
   std::make_heap(tuples_.begin(), tuples_.end(), compare);
 }
 
@@ -92,11 +139,11 @@ void Sorter::HeapSiftDown() {
       break;
     }
 
-    if (child + 1 < size && cmp_fn_(tuples_[child], tuples_[child + 1]) < 0) {
+    if (child + 1 < size && Compare(tuples_[child], tuples_[child + 1]) < 0) {
       child++;
     }
 
-    if (cmp_fn_(top, tuples_[child]) >= 0) {
+    if (Compare(top, tuples_[child]) >= 0) {
       break;
     }
 
@@ -122,9 +169,8 @@ void Sorter::Sort() {
   util::Timer<std::milli> timer;
   timer.Start();
 
-  // Sort the sucker
-  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
-  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  // Sort the sucker. If runs were spilled, iterators merge them with these tuples.
+  SortInMemory();
 
   timer.Stop();
 
@@ -135,6 +181,56 @@ void Sorter::Sort() {
   sorted_ = true;
 }
 
+void Sorter::SortInMemory() {
+  if (key_size_ > 0) {
+    MemPoolVector<const byte *> scratch(tuples_.size(), memory_);
+    RadixSort(tuples_.data(), scratch.data(), tuples_.size(), 0);
+  } else {
+    const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  }
+}
+
+void Sorter::RadixSort(const byte **tuples, const byte **scratch, const uint64_t n, uint32_t depth) const {
+  // Skip over the bytes all tuples share. If the keys are exhausted, only the comparison function
+  // can order what remains.
+  uint64_t counts[256];
+  while (true) {
+    if (n < MIN_TUPLES_FOR_RADIX_SORT || depth == key_size_) {
+      std::sort(tuples, tuples + n,
+                [this, depth](const byte *left, const byte *right) { return Compare(left, right, depth) < 0; });
+      return;
+    }
+    std::fill(std::begin(counts), std::end(counts), 0);
+    for (uint64_t i = 0; i < n; i++) {
+      counts[static_cast<uint8_t>(tuples[i][depth])]++;
+    }
+    if (counts[static_cast<uint8_t>(tuples[0][depth])] != n) {
+      break;
+    }
+    depth++;
+  }
+
+  // Scatter the tuples into their buckets, then copy them back
+  uint64_t offsets[256];
+  uint64_t offset = 0;
+  for (uint32_t bucket = 0; bucket < 256; bucket++) {
+    offsets[bucket] = offset;
+    offset += counts[bucket];
+  }
+  for (uint64_t i = 0; i < n; i++) {
+    scratch[offsets[static_cast<uint8_t>(tuples[i][depth])]++] = tuples[i];
+  }
+  std::copy(scratch, scratch + n, tuples);
+
+  // Sort each bucket on the next byte
+  for (uint64_t bucket = 0, start = 0; bucket < 256; start += counts[bucket++]) {
+    if (counts[bucket] > 1) {
+      RadixSort(tuples + start, scratch + start, counts[bucket], depth + 1);
+    }
+  }
+}
+
 namespace {
 
 // Structure we use to track a package of merging work.
@@ -151,7 +247,7 @@ struct MergeWork {
 }  // namespace
 
 void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::size_t sorter_offset) {
-  const auto comp = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  const auto comp = [this](const byte *left, const byte *right) { return Compare(left, right) < 0; };
 
   // -------------------------------------------------------
   // First, collect all non-empty thread-local sorters
@@ -167,6 +263,13 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
     return;
   }
 
+  // If any thread-local sorter spilled, the thread-local sorters can't be merged in memory
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(),
+                  [](const Sorter *sorter) { return !sorter->spilled_runs_.empty(); })) {
+    SortParallelSpilled(thread_state_container, tl_sorters);
+    return;
+  }
+
   const uint64_t num_tuples =
       std::accumulate(tl_sorters.begin(), tl_sorters.end(), uint64_t(0),
                       [](const auto partial, const auto *sorter) { return partial + sorter->GetTupleCount(); });
@@ -356,7 +459,7 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   timer.EnterStage("Parallel Merge");
 
   auto heap_cmp = [this](const MergeWorkType::Range &l, const MergeWorkType::Range &r) {
-    return cmp_fn_(*l.first, *r.first) >= 0;
+    return Compare(*l.first, *r.first) >= 0;
   };
 
   {
@@ -421,6 +524,40 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   }
 }
 
+void Sorter::SortParallelSpilled(ThreadStateContainer *thread_state_container,
+                                 const std::vector<Sorter *> &tl_sorters) {
+  util::Timer<std::milli> timer;
+  timer.Start();
+
+  // Spill what's left in each thread-local sorter, so that all tuples are in runs that iterators
+  // merge lazily, and memory stays within budget
+  tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
+    auto *tls = thread_state_container->AccessCurrentThreadState();
+    auto *exec_ctx = this->exec_ctx_;
+    exec_ctx->InvokeHook(pre_hook, tls, nullptr);
+
+    sorter->SpillRun();
+
+    exec_ctx->InvokeHook(post_hook, tls, nullptr);
+  });
+
+  // Take ownership of all runs
+  for (auto *tl_sorter : tl_sorters) {
+    std::move(tl_sorter->spilled_runs_.begin(), tl_sorter->spilled_runs_.end(), std::back_inserter(spilled_runs_));
+    num_spilled_tuples_ += tl_sorter->num_spilled_tuples_;
+    tl_sorter->spilled_runs_.clear();
+    tl_sorter->num_spilled_tuples_ = 0;
+  }
+
+  sorted_ = true;
+
+  timer.Stop();
+  EXECUTION_LOG_DEBUG("Sort Stats: {} tuples in {} spilled runs ({} ms)", GetTupleCount(), spilled_runs_.size(),
+                      timer.GetElapsed());
+}
+
 void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k) {
   // Parallel sort
   SortParallel(thread_state_container, sorter_offset);
@@ -437,9 +574,20 @@ void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint
 //
 //===----------------------------------------------------------------------===//
 
-SorterIterator::SorterIterator(const Sorter &sorter) : iter_(sorter.tuples_.begin()), end_(sorter.tuples_.end()) {}
+SorterIterator::SorterIterator(const Sorter &sorter)
+    : iter_(sorter.tuples_.begin()),
+      end_(sorter.tuples_.end()),
+      merger_(sorter.spilled_runs_.empty() ? nullptr : std::make_unique<SortRunMerger>(sorter)) {}
+
+SorterIterator::~SorterIterator() = default;
 
 void SorterIterator::AdvanceBy(uint64_t n) {
+  if (merger_ != nullptr) {
+    for (n = std::min(n, NumRemaining()); n > 0; n--) {
+      merger_->Next();
+    }
+    return;
+  }
   if (n > NumRemaining()) {
     iter_ = end_;
     return;
@@ -447,4 +595,95 @@ void SorterIterator::AdvanceBy(uint64_t n) {
   iter_ += n;
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Sort Run Merger
+//
+//===----------------------------------------------------------------------===//
+
+SortRunMerger::SortRunMerger(const Sorter &sorter)
+    : sorter_(sorter),
+      tuple_size_(sorter.tuple_storage_.ElementSize()),
+      output_(std::make_unique<byte[]>(common::Constants::K_DEFAULT_VECTOR_SIZE * tuple_size_)),
+      output_slot_(0),
+      current_(nullptr),
+      num_remaining_(sorter.GetTupleCount()) {
+  // Read ahead the first block of every run
+  inputs_.resize(sorter.spilled_runs_.size() + 1);
+  for (uint64_t i = 0; i < sorter.spilled_runs_.size(); i++) {
+    const SpillFile *run = sorter.spilled_runs_[i].get();
+    NOISEPAGE_ASSERT(run->GetRecordSize() == tuple_size_, "Spilled run has a different tuple size");
+    inputs_[i].run_ = run;
+    inputs_[i].block_ = std::make_unique<byte[]>(run->GetRecordsPerBlock() * tuple_size_);
+    Advance(&inputs_[i]);
+  }
+  inputs_.back().mem_pos_ = sorter.tuples_.data();
+  inputs_.back().mem_end_ = sorter.tuples_.data() + sorter.tuples_.size();
+
+  // Heapify all non-empty inputs
+  for (uint32_t i = 0; i < inputs_.size(); i++) {
+    const Input &input = inputs_[i];
+    if (input.run_ == nullptr ? input.mem_pos_ != input.mem_end_ : input.block_pos_ != input.block_end_) {
+      heap_.push_back(i);
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), [this](uint32_t l, uint32_t r) { return HeadGreater(l, r); });
+
+  if (num_remaining_ > 0) {
+    PopSmallest();
+  }
+}
+
+SortRunMerger::~SortRunMerger() = default;
+
+bool SortRunMerger::Advance(Input *input) const {
+  // In-memory tuples
+  if (input->run_ == nullptr) {
+    return ++input->mem_pos_ != input->mem_end_;
+  }
+
+  // Tuples in the current block; the block is empty before the first read
+  if (input->block_pos_ != input->block_end_ && (input->block_pos_ += tuple_size_) != input->block_end_) {
+    return true;
+  }
+
+  // Read the next block ahead
+  const uint64_t n = input->run_->ReadBlock(input->next_in_run_, input->block_.get());
+  input->next_in_run_ += n;
+  input->block_pos_ = input->block_.get();
+  input->block_end_ = input->block_.get() + n * tuple_size_;
+  return n > 0;
+}
+
+void SortRunMerger::PopSmallest() {
+  const auto heap_cmp = [this](uint32_t l, uint32_t r) { return HeadGreater(l, r); };
+
+  NOISEPAGE_ASSERT(!heap_.empty(), "No more tuples to merge");
+  std::pop_heap(heap_.begin(), heap_.end(), heap_cmp);
+  Input &input = inputs_[heap_.back()];
+
+  // In-memory tuples are stable, but blocks are overwritten as runs are read ahead
+  if (input.run_ == nullptr) {
+    current_ = *input.mem_pos_;
+  } else {
+    byte *slot = output_.get() + output_slot_ * tuple_size_;
+    std::memcpy(slot, input.block_pos_, tuple_size_);
+    output_slot_ = (output_slot_ + 1) % common::Constants::K_DEFAULT_VECTOR_SIZE;
+    current_ = slot;
+  }
+
+  if (Advance(&input)) {
+    std::push_heap(heap_.begin(), heap_.end(), heap_cmp);
+  } else {
+    heap_.pop_back();
+  }
+}
+
+void SortRunMerger::Next() {
+  NOISEPAGE_ASSERT(num_remaining_ > 0, "Invalid iterator");
+  if (--num_remaining_ > 0) {
+    PopSmallest();
+  }
+}
+
 }  // namespace noisepage::execution::sql
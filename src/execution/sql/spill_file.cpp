@@ -0,0 +1,57 @@
+#include "execution/sql/spill_file.h"
+
+#include <string>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/sql/memory_tracker.h"
+
+namespace noisepage::execution::sql {
+
+SpillFile::SpillFile(const uint32_t record_size, const common::ManagedPointer<MemoryTracker> tracker,
+                     const uint64_t block_size)
+    : tracker_(tracker), record_size_(record_size), block_size_(block_size), num_records_(0), num_buffered_(0) {}
+
+void SpillFile::FlushBlock() {
+  if (num_buffered_ == 0) {
+    return;
+  }
+
+  if (!file_.IsOpen()) {
+    file_.CreateTemp(true);
+    if (file_.HasError()) {
+      throw EXECUTION_EXCEPTION(
+          "Could not create a file to spill into: " + util::File::ErrorToString(file_.GetErrorIndicator()),
+          common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+  }
+
+  const auto len = static_cast<int32_t>(num_buffered_ * record_size_);
+  if (file_.WriteFull(buffer_.get(), len) != len) {
+    throw EXECUTION_EXCEPTION("Could not spill to disk, the disk may be full.", common::ErrorCode::ERRCODE_DISK_FULL);
+  }
+  if (tracker_ != nullptr) {
+    tracker_->IncrementSpilled(len);
+  }
+  num_buffered_ = 0;
+}
+
+void SpillFile::Finish() {
+  FlushBlock();
+  buffer_.reset();
+}
+
+uint64_t SpillFile::ReadBlock(const uint64_t first, byte *buffer) const {
+  NOISEPAGE_ASSERT(num_buffered_ == 0, "Spill file must be finished before it is read");
+  if (first >= num_records_) {
+    return 0;
+  }
+  const uint64_t n = std::min(GetRecordsPerBlock(), num_records_ - first);
+  const auto len = static_cast<int32_t>(n * record_size_);
+  if (file_.ReadFullFromPosition(first * record_size_, buffer, len) != len) {
+    throw EXECUTION_EXCEPTION("Could not read back spilled data.", common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+  return n;
+}
+
+}  // namespace noisepage::execution::sql
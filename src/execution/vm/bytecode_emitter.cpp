@@ -344,8 +344,8 @@ void BytecodeEmitter::EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, L
 }
 
 void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn,
-                                     LocalVar tuple_size) {
-  EmitAll(bytecode, sorter, exec_ctx, cmp_fn, tuple_size);
+                                     LocalVar tuple_size, LocalVar key_size) {
+  EmitAll(bytecode, sorter, exec_ctx, cmp_fn, tuple_size, key_size);
 }
 
 #if 0
@@ -14,6 +14,7 @@
 #include "execution/vm/bytecode_label.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/control_flow_builders.h"
+#include "execution/vm/superinstructions.h"
 #include "loggers/execution_logger.h"
 #include "spdlog/fmt/fmt.h"
 
@@ -1439,7 +1440,15 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
     case ast::Builtin::JoinHashTableInit: {
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
       LocalVar entry_size = VisitExpressionForRValue(call->Arguments()[2]);
-      GetEmitter()->Emit(Bytecode::JoinHashTableInit, join_hash_table, exec_ctx, entry_size);
+      // The probe tuple size is optional, and defaults to zero (i.e., the table never spills)
+      LocalVar probe_size;
+      if (call->NumArgs() > 3) {
+        probe_size = VisitExpressionForRValue(call->Arguments()[3]);
+      } else {
+        probe_size = GetCurrentFunction()->NewLocal(call->Arguments()[2]->GetType());
+        GetEmitter()->EmitAssignImm4(probe_size, 0);
+      }
+      GetEmitter()->Emit(Bytecode::JoinHashTableInit, join_hash_table, exec_ctx, entry_size, probe_size);
       break;
     }
     case ast::Builtin::JoinHashTableInsert: {
@@ -1471,6 +1480,30 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::JoinHashTableLookup, join_hash_table, ht_entry_iter, hash);
       break;
     }
+    case ast::Builtin::JoinHashTableIsSpilled: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableIsSpilled, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar probe_tuple = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableSpillProbe, join_hash_table, hash, probe_tuple);
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextPartition: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableNextPartition, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableNextSpilledProbe: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::JoinHashTableNextSpilledProbe, dest, join_hash_table);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       GetEmitter()->Emit(Bytecode::JoinHashTableFree, join_hash_table);
       break;
@@ -1550,8 +1583,16 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
       const std::string cmp_func_name = call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().GetData();
       LocalVar entry_size = VisitExpressionForRValue(call->Arguments()[3]);
+      // The normalized key size is optional, and defaults to zero (i.e., no normalized key)
+      LocalVar key_size;
+      if (call->NumArgs() > 4) {
+        key_size = VisitExpressionForRValue(call->Arguments()[4]);
+      } else {
+        key_size = GetCurrentFunction()->NewLocal(call->Arguments()[3]->GetType());
+        GetEmitter()->EmitAssignImm4(key_size, 0);
+      }
       GetEmitter()->EmitSorterInit(Bytecode::SorterInit, sorter, exec_ctx, LookupFuncIdByName(cmp_func_name),
-                                   entry_size);
+                                   entry_size, key_size);
       break;
     }
     case ast::Builtin::SorterGetTupleCount: {
@@ -1654,6 +1695,34 @@ void BytecodeGenerator::VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Bui
   }
 }
 
+void BytecodeGenerator::VisitBuiltinSortKeyWriteCall(ast::CallExpr *call) {
+  LocalVar key = VisitExpressionForRValue(call->Arguments()[0]);
+  LocalVar input = VisitExpressionForSQLValue(call->Arguments()[1]);
+  LocalVar descending = VisitExpressionForRValue(call->Arguments()[2]);
+  switch (call->Arguments()[1]->GetType()->As<ast::BuiltinType>()->GetKind()) {
+    case ast::BuiltinType::Boolean:
+      GetEmitter()->Emit(Bytecode::SortKeyWriteBool, key, input, descending);
+      break;
+    case ast::BuiltinType::Integer:
+      GetEmitter()->Emit(Bytecode::SortKeyWriteInteger, key, input, descending);
+      break;
+    case ast::BuiltinType::Real:
+      GetEmitter()->Emit(Bytecode::SortKeyWriteReal, key, input, descending);
+      break;
+    case ast::BuiltinType::Date:
+      GetEmitter()->Emit(Bytecode::SortKeyWriteDate, key, input, descending);
+      break;
+    case ast::BuiltinType::Timestamp:
+      GetEmitter()->Emit(Bytecode::SortKeyWriteTimestamp, key, input, descending);
+      break;
+    case ast::BuiltinType::StringVal:
+      GetEmitter()->Emit(Bytecode::SortKeyWriteString, key, input, descending);
+      break;
+    default:
+      UNREACHABLE("Sort keys of this type aren't supported!");
+  }
+}
+
 void BytecodeGenerator::VisitResultBufferCall(ast::CallExpr *call, ast::Builtin builtin) {
   LocalVar input = VisitExpressionForRValue(call->Arguments()[0]);
   switch (builtin) {
@@ -2902,6 +2971,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel:
     case ast::Builtin::JoinHashTableLookup:
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableNextPartition:
+    case ast::Builtin::JoinHashTableNextSpilledProbe:
     case ast::Builtin::JoinHashTableFree: {
       VisitBuiltinJoinHashTableCall(call, builtin);
       break;
@@ -2940,6 +3013,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinSorterIterCall(call, builtin);
       break;
     }
+    case ast::Builtin::SortKeyWrite: {
+      VisitBuiltinSortKeyWriteCall(call);
+      break;
+    }
     case ast::Builtin::ResultBufferNew:
     case ast::Builtin::ResultBufferAllocOutRow:
     case ast::Builtin::ResultBufferFinalize:
@@ -3943,10 +4020,15 @@ Bytecode BytecodeGenerator::GetFloatTypedBytecode(Bytecode bytecode, ast::Type *
 }
 
 // static
-std::unique_ptr<BytecodeModule> BytecodeGenerator::Compile(ast::AstNode *root, const std::string &name) {
+std::unique_ptr<BytecodeModule> BytecodeGenerator::Compile(ast::AstNode *root, const std::string &name,
+                                                           bool fuse_superinstructions) {
   BytecodeGenerator generator{};
   generator.Visit(root);
 
+  if (fuse_superinstructions) {
+    Superinstructions::Fuse(&generator.code_, generator.functions_);
+  }
+
   // Create the bytecode module. Note that we move the bytecode and functions
   // array from the generator into the module.
   return std::make_unique<BytecodeModule>(name, std::move(generator.code_), std::move(generator.data_),
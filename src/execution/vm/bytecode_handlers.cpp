@@ -155,9 +155,10 @@ void OpFilterManagerFree(noisepage::execution::sql::FilterManager *filter_manage
 // ---------------------------------------------------------
 
 void OpJoinHashTableInit(noisepage::execution::sql::JoinHashTable *join_hash_table,
-                         noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t tuple_size) {
-  new (join_hash_table)
-      noisepage::execution::sql::JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, tuple_size);
+                         noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t tuple_size,
+                         uint32_t probe_tuple_size) {
+  new (join_hash_table) noisepage::execution::sql::JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx,
+                                                                 tuple_size, false, probe_tuple_size);
 }
 
 void OpJoinHashTableBuild(noisepage::execution::sql::JoinHashTable *join_hash_table) { join_hash_table->Build(); }
@@ -168,6 +169,20 @@ void OpJoinHashTableBuildParallel(noisepage::execution::sql::JoinHashTable *join
   join_hash_table->MergeParallel(thread_state_container, jht_offset);
 }
 
+void OpJoinHashTableSpillProbe(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                               const noisepage::hash_t hash_val, const noisepage::byte *probe_tuple) {
+  join_hash_table->SpillProbeTuple(hash_val, probe_tuple);
+}
+
+void OpJoinHashTableNextPartition(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->NextSpilledPartition();
+}
+
+void OpJoinHashTableNextSpilledProbe(const noisepage::byte **result,
+                                     noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->NextSpilledProbeTuple();
+}
+
 void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table) {
   join_hash_table->~JoinHashTable();
 }
@@ -236,8 +251,9 @@ void OpAggregationHashTableIteratorFree(noisepage::execution::sql::AHTIterator *
 
 void OpSorterInit(noisepage::execution::sql::Sorter *const sorter,
                   noisepage::execution::exec::ExecutionContext *const exec_ctx,
-                  const noisepage::execution::sql::Sorter::ComparisonFunction cmp_fn, const uint32_t tuple_size) {
-  new (sorter) noisepage::execution::sql::Sorter(exec_ctx, cmp_fn, tuple_size);
+                  const noisepage::execution::sql::Sorter::ComparisonFunction cmp_fn, const uint32_t tuple_size,
+                  const uint32_t key_size) {
+  new (sorter) noisepage::execution::sql::Sorter(exec_ctx, cmp_fn, tuple_size, key_size);
 }
 
 void OpSorterSort(noisepage::execution::sql::Sorter *sorter) { sorter->Sort(); }
@@ -4,6 +4,7 @@
 
 #include "execution/vm/bytecode_function_info.h"
 #include "execution/vm/bytecode_traits.h"
+#include "execution/vm/superinstructions.h"
 
 namespace noisepage::execution::vm {
 
@@ -15,9 +16,18 @@ BytecodeIterator::BytecodeIterator(const std::vector<uint8_t> &bytecode)
 
 Bytecode BytecodeIterator::CurrentBytecode() const {
   auto raw_code = *reinterpret_cast<const std::underlying_type_t<Bytecode> *>(&bytecodes_[curr_offset_]);
+  // Superinstructions leave the bytecodes they fuse in place, so present them as their first bytecode
+  if (Superinstructions::IsSuperinstruction(raw_code)) {
+    return Superinstructions::GetFirst(Superinstructions::FromByte(raw_code));
+  }
   return Bytecodes::FromByte(raw_code);
 }
 
+bool BytecodeIterator::IsSuperinstruction() const {
+  auto raw_code = *reinterpret_cast<const std::underlying_type_t<Bytecode> *>(&bytecodes_[curr_offset_]);
+  return Superinstructions::IsSuperinstruction(raw_code);
+}
+
 bool BytecodeIterator::Done() const { return curr_offset_ >= end_offset_; }
 
 void BytecodeIterator::Advance() { curr_offset_ += CurrentBytecodeSize(); }
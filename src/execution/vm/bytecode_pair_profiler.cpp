@@ -0,0 +1,66 @@
+#include "execution/vm/bytecode_pair_profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace noisepage::execution::vm {
+
+BytecodePairProfiler::BytecodePairProfiler()
+    : counts_(std::make_unique<std::atomic<uint64_t>[]>(Bytecodes::NumBytecodes() * Bytecodes::NumBytecodes())) {
+  Reset();
+}
+
+// static
+BytecodePairProfiler *BytecodePairProfiler::Instance() {
+  static BytecodePairProfiler instance;
+  return &instance;
+}
+
+std::vector<BytecodePairProfiler::PairCount> BytecodePairProfiler::GetTopPairs(const std::size_t n) const {
+  std::vector<PairCount> pairs;
+  for (uint32_t first = 0; first < Bytecodes::NumBytecodes(); first++) {
+    for (uint32_t second = 0; second < Bytecodes::NumBytecodes(); second++) {
+      const uint64_t count = counts_[first * Bytecodes::NumBytecodes() + second].load(std::memory_order_relaxed);
+      if (count > 0) {
+        pairs.push_back({Bytecodes::FromByte(first), Bytecodes::FromByte(second), count});
+      }
+    }
+  }
+
+  const auto top = std::min(n, pairs.size());
+  std::partial_sort(pairs.begin(), pairs.begin() + top, pairs.end(),
+                    [](const PairCount &a, const PairCount &b) { return a.count_ > b.count_; });
+  pairs.resize(top);
+  return pairs;
+}
+
+void BytecodePairProfiler::Dump(std::ostream &os, const std::size_t n) const {
+  const auto pairs = GetTopPairs(n);
+
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < Bytecodes::NumBytecodes() * Bytecodes::NumBytecodes(); i++) {
+    total += counts_[i].load(std::memory_order_relaxed);
+  }
+
+  const auto name_width = Bytecodes::MaxBytecodeNameLength();
+  os << "Top " << pairs.size() << " of " << total << " executed bytecode pairs:" << std::endl;
+  for (const auto &pair : pairs) {
+    Superinstruction superinstruction;
+    const bool fused = Superinstructions::Lookup(pair.first_, pair.second_, &superinstruction);
+    os << "  " << std::setw(name_width) << std::left << Bytecodes::ToString(pair.first_) << " -> "
+       << std::setw(name_width) << std::left << Bytecodes::ToString(pair.second_) << std::setw(14) << std::right
+       << pair.count_ << std::setw(8) << std::fixed << std::setprecision(2)
+       << 100.0 * static_cast<double>(pair.count_) / static_cast<double>(total) << "%"
+       << (fused ? " (fused)" : "") << std::endl;
+  }
+}
+
+void BytecodePairProfiler::Reset() {
+  for (uint32_t i = 0; i < Bytecodes::NumBytecodes() * Bytecodes::NumBytecodes(); i++) {
+    counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace noisepage::execution::vm
@@ -0,0 +1,188 @@
+#include "execution/vm/compiled_module_cache.h"
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>  // NOLINT
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::vm {
+
+namespace {
+
+// Temporary files untouched for this long are left over from a crashed writer even if their pid was reused
+constexpr std::chrono::minutes STALE_TEMP_FILE_AGE{10};
+
+// Whether the given temporary file, named "<entry>.<pid>.<counter>.tmp" by Insert(), can no longer be published
+bool IsStaleTempFile(const std::filesystem::path &path, const std::filesystem::file_time_type last_write) {
+  if (std::filesystem::file_time_type::clock::now() - last_write > STALE_TEMP_FILE_AGE) {
+    return true;
+  }
+  // Strip the counter, leaving the pid as the extension
+  const std::string pid = path.stem().stem().extension().string();
+  if (pid.size() < 2 || pid.find_first_not_of("0123456789", 1) != std::string::npos) {
+    return false;
+  }
+  return ::kill(static_cast<pid_t>(std::stoll(pid.substr(1))), 0) != 0 && errno == ESRCH;
+}
+
+}  // namespace
+
+CompiledModuleCache::CompiledModuleCache(std::string directory, uint64_t size_limit, std::string engine_fingerprint)
+    : directory_(std::move(directory)), size_limit_(size_limit), engine_fingerprint_(std::move(engine_fingerprint)) {
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  if (error) {
+    EXECUTION_LOG_ERROR("Could not create compiled module cache directory '{}': {}", directory_, error.message());
+    return;
+  }
+
+  // Adopt whatever previous runs left behind, trimming it down if the limit has shrunk since. This also removes the
+  // temporary files of writers that crashed before publishing their entry.
+  std::lock_guard<std::mutex> guard(latch_);
+  EvictUntil(size_limit_);
+  EXECUTION_LOG_INFO("Compiled module cache at '{}' holds {} bytes", directory_, GetSize());
+}
+
+std::string CompiledModuleCache::GetEntryPath(const std::string &key) const {
+  return (std::filesystem::path(directory_) / (key + OBJECT_FILE_EXTENSION)).string();
+}
+
+std::unique_ptr<llvm::MemoryBuffer> CompiledModuleCache::Lookup(const std::string &key) {
+  const std::string path = GetEntryPath(key);
+
+  auto file_buffer = llvm::MemoryBuffer::getFile(path, -1, false);
+  if (!file_buffer) {
+    num_misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  // Refresh the entry's recency. The entry may have been evicted concurrently, which is harmless since we already
+  // hold its contents.
+  std::error_code error;
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+  num_hits_.fetch_add(1, std::memory_order_relaxed);
+  return std::move(file_buffer.get());
+}
+
+void CompiledModuleCache::Insert(const std::string &key, const llvm::MemoryBuffer &object_code) {
+  const std::string path = GetEntryPath(key);
+
+  // Write to a private temporary file first and rename it into place, so that readers never observe a partial entry
+  const std::string temp_path = fmt::format("{}.{}.{}{}", path, ::getpid(),
+                                            num_temp_files_.fetch_add(1, std::memory_order_relaxed),
+                                            TEMP_FILE_EXTENSION);
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(object_code.getBufferStart(), object_code.getBufferSize());
+    out.close();
+    if (out.fail()) {
+      EXECUTION_LOG_ERROR("Could not write compiled module cache entry '{}'", temp_path);
+      std::error_code error;
+      std::filesystem::remove(temp_path, error);
+      return;
+    }
+  }
+
+  // An existing entry is replaced by the rename, so its size must not be counted twice
+  std::error_code error;
+  uint64_t replaced_size = std::filesystem::file_size(path, error);
+  if (error) {
+    replaced_size = 0;
+  }
+
+  std::filesystem::rename(temp_path, path, error);
+  if (error) {
+    EXECUTION_LOG_ERROR("Could not publish compiled module cache entry '{}': {}", path, error.message());
+    std::filesystem::remove(temp_path, error);
+    return;
+  }
+
+  // A concurrent rescan may already have accounted for the new entry, so never let the size wrap around
+  uint64_t size = size_.load(std::memory_order_relaxed);
+  uint64_t new_size;
+  do {
+    new_size = size + object_code.getBufferSize();
+    new_size = new_size > replaced_size ? new_size - replaced_size : 0;
+  } while (!size_.compare_exchange_weak(size, new_size, std::memory_order_relaxed));
+  size = new_size;
+  if (size > size_limit_) {
+    std::lock_guard<std::mutex> guard(latch_);
+    // Someone else may have made room while we waited
+    if (GetSize() > size_limit_) {
+      EvictUntil(size_limit_);
+    }
+  }
+}
+
+void CompiledModuleCache::Clear() {
+  std::lock_guard<std::mutex> guard(latch_);
+  EvictUntil(0);
+}
+
+void CompiledModuleCache::EvictUntil(const uint64_t target_size) {
+  struct Entry {
+    std::filesystem::path path_;
+    std::filesystem::file_time_type last_use_;
+    uint64_t size_;
+  };
+
+  // The directory is the source of truth: it may be shared with other processes, or modified by hand
+  std::vector<Entry> entries;
+  uint64_t total_size = 0;
+  std::error_code error;
+  for (std::filesystem::directory_iterator iter(directory_, error), end; !error && iter != end; iter.increment(error)) {
+    const auto &path = iter->path();
+    std::error_code entry_error;
+    if (!iter->is_regular_file(entry_error)) {
+      continue;
+    }
+    if (path.extension() == TEMP_FILE_EXTENSION) {
+      const auto last_write = iter->last_write_time(entry_error);
+      if (!entry_error && IsStaleTempFile(path, last_write) && std::filesystem::remove(path, entry_error)) {
+        EXECUTION_LOG_INFO("Removed stale compiled module cache file '{}'", path.string());
+      }
+      continue;
+    }
+    if (path.extension() != OBJECT_FILE_EXTENSION) {
+      continue;
+    }
+    const uint64_t size = iter->file_size(entry_error);
+    const auto last_use = iter->last_write_time(entry_error);
+    if (entry_error) {
+      continue;
+    }
+    entries.push_back({path, last_use, size});
+    total_size += size;
+  }
+
+  if (total_size > target_size) {
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.last_use_ < b.last_use_; });
+    for (const auto &entry : entries) {
+      if (total_size <= target_size) {
+        break;
+      }
+      std::error_code remove_error;
+      if (std::filesystem::remove(entry.path_, remove_error)) {
+        num_evictions_.fetch_add(1, std::memory_order_relaxed);
+      }
+      // Entries removed concurrently by another process count as freed as well
+      total_size -= entry.size_;
+    }
+  }
+
+  size_.store(total_size, std::memory_order_relaxed);
+}
+
+}  // namespace noisepage::execution::vm
@@ -1,9 +1,11 @@
 #include "execution/vm/llvm_engine.h"
 
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/RuntimeDyld.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
 #include <llvm/IR/IRBuilder.h>
@@ -13,6 +15,7 @@
 #include <llvm/MC/MCContext.h>
 #include <llvm/Support/DynamicLibrary.h>
 #include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
@@ -23,7 +26,9 @@
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Scalar/GVN.h>
+#include <llvm/Transforms/Utils.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -386,8 +391,10 @@ class LLVMEngine::CompiledModuleBuilder {
   // Optimize the generate code
   void Optimize();
 
-  // Perform finalization logic and create a compiled module
-  std::unique_ptr<CompiledModule> Finalize();
+  // Perform finalization logic and create a compiled module. If a cache key is
+  // provided, the generated object code is also stored in the compiled module
+  // cache under that key.
+  std::unique_ptr<CompiledModule> Finalize(const std::string &cache_key);
 
   // Print the contents of the module to a string and return it
   std::string DumpModuleIR();
@@ -468,14 +475,18 @@ LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &
 
     EXECUTION_LOG_TRACE("LLVM: Discovered CPU features: {}", target_features.getString());
 
-    // Both relocation=PIC or JIT=true work. Use the latter for now.
+    // Both relocation=PIC or JIT=true work. Use the latter for now. Baseline
+    // code trades code quality for compilation speed: no backend optimization
+    // and fast instruction selection.
     llvm::TargetOptions target_options;
     llvm::Optional<llvm::Reloc::Model> reloc;
-    const llvm::CodeGenOpt::Level opt_level = llvm::CodeGenOpt::Aggressive;
+    const bool baseline = options.GetTier() == CompilationTier::Baseline;
+    const llvm::CodeGenOpt::Level opt_level = baseline ? llvm::CodeGenOpt::None : llvm::CodeGenOpt::Aggressive;
     target_machine_.reset(target->createTargetMachine(target_triple, llvm::sys::getHostCPUName(),
                                                       target_features.getString(), target_options, reloc, {}, opt_level,
                                                       true));
     NOISEPAGE_ASSERT(target_machine_ != nullptr, "LLVM: Unable to find a suitable target machine!");
+    target_machine_->setFastISel(baseline);
   }
 
   //
@@ -956,6 +967,20 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   // Add the appropriate TargetTransformInfo.
   function_passes.add(llvm::createTargetTransformInfoWrapperPass(target_machine_->getTargetIRAnalysis()));
 
+  // Baseline code only promotes the frame's locals into registers, which is
+  // cheap and removes most of the memory traffic of the bytecode's frame. No
+  // inlining beyond the hot bytecode handlers happens in this tier.
+  if (options_.GetTier() == CompilationTier::Baseline) {
+    function_passes.add(llvm::createPromoteMemoryToRegisterPass());
+    function_passes.add(llvm::createCFGSimplificationPass());
+    function_passes.doInitialization();
+    for (llvm::Function &func : *llvm_module_) {
+      function_passes.run(func);
+    }
+    function_passes.doFinalization();
+    return;
+  }
+
   // Build up optimization pipeline.
   llvm::PassManagerBuilder pm_builder;
   uint32_t opt_level = 3;
@@ -981,13 +1006,17 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   function_passes.doFinalization();
 }
 
-std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize() {
+std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize(const std::string &cache_key) {
   std::unique_ptr<llvm::MemoryBuffer> obj = EmitObject();
 
   if (options_.ShouldPersistObjectFile()) {
     PersistObjectToFile(*obj);
   }
 
+  if (!cache_key.empty() && obj != nullptr) {
+    GetCompiledModuleCache()->Insert(cache_key, *obj);
+  }
+
   return std::make_unique<CompiledModule>(std::move(obj));
 }
 
@@ -1157,15 +1186,119 @@ void LLVMEngine::Initialize(std::unique_ptr<const Settings> &&settings) {
   llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
 
   engine_settings = std::move(settings);
+
+  // Set up the on-disk cache of compiled modules, if requested
+  if (!engine_settings->GetCompiledModuleCachePath().empty()) {
+    if (auto fingerprint = ComputeEngineFingerprint(*engine_settings); !fingerprint.empty()) {
+      compiled_module_cache = std::make_unique<CompiledModuleCache>(engine_settings->GetCompiledModuleCachePath(),
+                                                                    engine_settings->GetCompiledModuleCacheSize(),
+                                                                    std::move(fingerprint));
+    }
+  }
 }
 
 void LLVMEngine::Shutdown() {
+  compiled_module_cache.reset();
   engine_settings.reset();
   llvm::llvm_shutdown();
 }
 
+std::string LLVMEngine::ComputeEngineFingerprint(const Settings &settings) {
+  // Every module is linked against the bytecode handlers, so their contents
+  // determine the generated code as much as the module itself does
+  auto handlers = llvm::MemoryBuffer::getFile(settings.GetBytecodeHandlersBcPath());
+  if (std::error_code error = handlers.getError()) {
+    EXECUTION_LOG_ERROR("LLVMEngine: Compiled module cache disabled, cannot read bytecode handlers: {}",
+                        error.message());
+    return "";
+  }
+  const auto handlers_digest = llvm::SHA1::hash(llvm::ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(handlers.get()->getBufferStart()), handlers.get()->getBufferSize()));
+
+  // The builder enables exactly the features of the host CPU. Sort them, since
+  // the iteration order of the feature map is unspecified.
+  llvm::StringMap<bool> feature_map;
+  llvm::sys::getHostCPUFeatures(feature_map);
+  std::vector<std::string> features;
+  for (const auto &entry : feature_map) {
+    features.emplace_back((entry.getValue() ? "+" : "-") + entry.getKey().str());
+  }
+  std::sort(features.begin(), features.end());
+
+  return fmt::format("llvm={};triple={};cpu={};features={};opt=O3;handlers={}", LLVM_VERSION_STRING,
+                     llvm::sys::getProcessTriple(), llvm::sys::getHostCPUName().str(),
+                     llvm::join(features.begin(), features.end(), ","), llvm::toHex(handlers_digest, true));
+}
+
+std::string LLVMEngine::ComputeCacheKey(const BytecodeModule &module, const CompilerOptions &options) {
+  llvm::SHA1 hasher;
+
+  // Strings are hashed with their terminator so that adjacent fields cannot
+  // be confused with one another
+  const auto hash_string = [&](const std::string &str) { hasher.update(llvm::StringRef(str.c_str(), str.size() + 1)); };
+  const auto hash_int = [&](const uint64_t val) {
+    hasher.update(llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(&val), sizeof(val)));
+  };
+  const auto hash_local = [&](const LocalInfo &local) {
+    hash_string(local.GetName());
+    hash_string(ast::Type::ToString(local.GetType()));
+    hash_int(local.GetOffset());
+    hash_int(local.GetSize());
+  };
+
+  hash_string(compiled_module_cache->GetEngineFingerprint());
+  hash_int(static_cast<uint64_t>(options.GetTier()));
+
+  // The raw code and data sections
+  hash_int(module.code_.size());
+  hasher.update(module.code_);
+  hash_int(module.data_.size());
+  hasher.update(module.data_);
+
+  // The metadata that code generation relies on to type and lay out functions.
+  // The module name is deliberately left out: it only names the object file.
+  for (const auto &func : module.GetFunctionsInfo()) {
+    hash_string(func.GetName());
+    hash_string(ast::Type::ToString(func.GetFuncType()));
+    hash_int(func.GetBytecodeRange().first);
+    hash_int(func.GetBytecodeRange().second);
+    hash_int(func.GetFrameSize());
+    hash_int(func.GetParamsStartPos());
+    hash_int(func.GetParamsSize());
+    hash_int(func.GetParamsCount());
+    hash_int(func.GetLocals().size());
+    for (const auto &local : func.GetLocals()) {
+      hash_local(local);
+    }
+  }
+  for (const auto &local : module.GetStaticLocalsInfo()) {
+    hash_local(local);
+  }
+
+  return llvm::toHex(hasher.final(), true);
+}
+
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule &module,
                                                                 const CompilerOptions &options) {
+  //
+  // If this exact module was compiled before by an identical engine, possibly
+  // in a previous run, its object code is in the compiled module cache and we
+  // only need to load and link it.
+  //
+
+  std::string cache_key;
+  if (compiled_module_cache != nullptr) {
+    cache_key = ComputeCacheKey(module, options);
+    if (auto object_code = compiled_module_cache->Lookup(cache_key); object_code != nullptr) {
+      auto compiled_module = std::make_unique<CompiledModule>(std::move(object_code));
+      compiled_module->Load(module);
+      if (compiled_module->IsLoaded()) {
+        return compiled_module;
+      }
+      EXECUTION_LOG_WARN("LLVMEngine: Cached object code for module '{}' is unusable, recompiling", module.GetName());
+    }
+  }
+
   CompiledModuleBuilder builder(options, module);
 
   builder.DeclareStaticLocals();
@@ -1180,7 +1313,7 @@ std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeMo
 
   builder.Optimize();
 
-  auto compiled_module = builder.Finalize();
+  auto compiled_module = builder.Finalize(cache_key);
 
   compiled_module->Load(module);
 
@@ -1192,4 +1325,6 @@ const LLVMEngine::Settings *LLVMEngine::GetEngineSettings() {
   return engine_settings.get();
 }
 
+CompiledModuleCache *LLVMEngine::GetCompiledModuleCache() { return compiled_module_cache.get(); }
+
 }  // namespace noisepage::execution::vm
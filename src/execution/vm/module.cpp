@@ -2,6 +2,7 @@
 
 #include <tbb/task.h>  // NOLINT
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
@@ -22,18 +23,19 @@ namespace noisepage::execution::vm {
 class Module::AsyncCompileTask : public tbb::task {
  public:
   // Construct an asynchronous compilation task to compile the the module
-  explicit AsyncCompileTask(Module *module) : module_(module) {}
+  AsyncCompileTask(Module *module, CompilationTier tier) : module_(module), tier_(tier) {}
 
   // Execute
   tbb::task *execute() override {
     // This simply invokes Module::CompileToMachineCode() asynchronously.
-    module_->CompileToMachineCode();
+    module_->CompileToMachineCode(tier_);
     // Done. There's no next task, so return null.
     return nullptr;
   }
 
  private:
   Module *module_;
+  CompilationTier tier_;
 };
 
 // ---------------------------------------------------------
@@ -68,6 +70,8 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
       auto func_info = bytecode_module_->GetFuncInfoById(idx);
       functions_[idx] = jit_module_->GetFunctionPointer(func_info->GetName());
     }
+    requested_tier_ = CompilationTier::Optimized;
+    compiled_tier_ = CompilationTier::Optimized;
   }
 }
 
@@ -265,32 +269,82 @@ void Module::CreateFunctionTrampoline(FunctionId func_id) {
   bytecode_trampolines_[func_id] = std::move(trampoline);
 }
 
-void Module::CompileToMachineCode() {
-  std::call_once(compiled_flag_, [this]() {
-    // Exit if the module has already been compiled. This might happen if
-    // requested to execute in adaptive mode by concurrent threads.
-    if (jit_module_ != nullptr) {
+void Module::CompileToMachineCode(const CompilationTier tier) {
+  NOISEPAGE_ASSERT(tier != CompilationTier::Interpreted, "Bytecode needs no compilation");
+  std::lock_guard<std::mutex> guard(compile_latch_);
+
+  // Exit if the module has already been compiled into this tier or better.
+  // This might happen if requested to execute in adaptive mode by concurrent
+  // threads.
+  if (GetCompiledTier() >= tier) {
+    return;
+  }
+
+  // JIT the module.
+  const auto start = std::chrono::high_resolution_clock::now();
+  LLVMEngine::CompilerOptions options;
+  options.SetTier(tier);
+  auto compiled_module = LLVMEngine::Compile(*bytecode_module_, options);
+  const auto elapsed = std::chrono::high_resolution_clock::now() - start;
+  compile_time_us_[static_cast<uint8_t>(tier)] =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  EXECUTION_LOG_DEBUG("Compiled module '{}' into tier {} in {} us", bytecode_module_->GetName(),
+                      static_cast<uint32_t>(tier), compile_time_us_[static_cast<uint8_t>(tier)]);
+
+  // JIT completed successfully. For each function in the module, pull out its
+  // compiled implementation into the function cache, atomically replacing any
+  // previous implementation.
+  for (const auto &func_info : bytecode_module_->GetFunctionsInfo()) {
+    auto *jit_function = compiled_module->GetFunctionPointer(func_info.GetName());
+    NOISEPAGE_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
+    functions_[func_info.GetId()].store(jit_function, std::memory_order_relaxed);
+  }
+
+  if (tier == CompilationTier::Baseline) {
+    baseline_module_ = std::move(compiled_module);
+  } else {
+    jit_module_ = std::move(compiled_module);
+  }
+  compiled_tier_.store(tier, std::memory_order_release);
+}
+
+void Module::CompileToMachineCodeAsync(const CompilationTier tier) {
+  // Only the first request for a tier triggers a compilation
+  CompilationTier requested = requested_tier_.load(std::memory_order_relaxed);
+  do {
+    if (requested >= tier) {
       return;
     }
+  } while (!requested_tier_.compare_exchange_weak(requested, tier));
 
-    // JIT the module.
-    LLVMEngine::CompilerOptions options;
-    jit_module_ = LLVMEngine::Compile(*bytecode_module_, options);
-
-    // JIT completed successfully. For each function in the module, pull out its
-    // compiled implementation into the function cache, atomically replacing any
-    // previous implementation.
-    for (const auto &func_info : bytecode_module_->GetFunctionsInfo()) {
-      auto *jit_function = jit_module_->GetFunctionPointer(func_info.GetName());
-      NOISEPAGE_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
-      functions_[func_info.GetId()].store(jit_function, std::memory_order_relaxed);
-    }
-  });
+  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this, tier);
+  tbb::task::enqueue(*compile_task);
 }
 
-void Module::CompileToMachineCodeAsync() {
-  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
-  tbb::task::enqueue(*compile_task);
+void Module::TierUp() {
+  const uint64_t num_invocations = num_adaptive_invocations_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  switch (GetCompiledTier()) {
+    case CompilationTier::Interpreted: {
+      // Get machine code as quickly as possible, unless the interpreter has
+      // already shown the module to be hot.
+      const bool hot = num_interpreted_loop_iterations_.load(std::memory_order_relaxed) >=
+                       TIER_UP_LOOP_ITERATION_THRESHOLD;
+      CompileToMachineCodeAsync(hot ? CompilationTier::Optimized : CompilationTier::Baseline);
+      break;
+    }
+    case CompilationTier::Baseline: {
+      const bool hot = num_invocations >= TIER_UP_INVOCATION_THRESHOLD ||
+                       num_interpreted_loop_iterations_.load(std::memory_order_relaxed) >=
+                           TIER_UP_LOOP_ITERATION_THRESHOLD;
+      if (hot) {
+        CompileToMachineCodeAsync(CompilationTier::Optimized);
+      }
+      break;
+    }
+    case CompilationTier::Optimized:
+      break;
+  }
 }
 
 }  // namespace noisepage::execution::vm
@@ -0,0 +1,110 @@
+#include "execution/vm/superinstructions.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/vm/bytecode_function_info.h"
+#include "execution/vm/bytecode_iterator.h"
+
+namespace noisepage::execution::vm {
+
+// static
+const char *Superinstructions::superinstruction_names[] = {
+#define ENTRY(name, ...) #name,
+    SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+};
+
+// static
+const Bytecode Superinstructions::superinstruction_firsts[] = {
+#define ENTRY(name, first, second) Bytecode::first,
+    SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+};
+
+// static
+const Bytecode Superinstructions::superinstruction_seconds[] = {
+#define ENTRY(name, first, second) Bytecode::second,
+    SUPERINSTRUCTION_LIST(ENTRY)
+#undef ENTRY
+};
+
+namespace {
+
+uint64_t PairKey(Bytecode first, Bytecode second) {
+  return (static_cast<uint64_t>(Bytecodes::ToByte(first)) << 32u) | Bytecodes::ToByte(second);
+}
+
+}  // namespace
+
+// static
+bool Superinstructions::Lookup(Bytecode first, Bytecode second, Superinstruction *superinstruction) {
+  static const std::unordered_map<uint64_t, Superinstruction> superinstructions = [] {
+    std::unordered_map<uint64_t, Superinstruction> result;
+    for (uint32_t i = 0; i < NumSuperinstructions(); i++) {
+      const auto fused = static_cast<Superinstruction>(i);
+      result.emplace(PairKey(GetFirst(fused), GetSecond(fused)), fused);
+    }
+    return result;
+  }();
+
+  const auto iter = superinstructions.find(PairKey(first, second));
+  if (iter == superinstructions.end()) {
+    return false;
+  }
+  *superinstruction = iter->second;
+  return true;
+}
+
+// static
+uint32_t Superinstructions::Fuse(std::vector<uint8_t> *code, const std::vector<FunctionInfo> &functions) {
+  uint32_t num_fused = 0;
+
+  for (const auto &func_info : functions) {
+    const auto [start, end] = func_info.GetBytecodeRange();
+
+    // Collect all jump targets first. Fusing a bytecode that is jumped to into its predecessor would skip it.
+    std::unordered_set<std::size_t> jump_targets;
+    for (BytecodeIterator iter(*code, start, end); !iter.Done(); iter.Advance()) {
+      const Bytecode bytecode = iter.CurrentBytecode();
+      if (Bytecodes::IsJump(bytecode)) {
+        const uint32_t offset_operand = Bytecodes::IsUnconditionalJump(bytecode) ? 0 : 1;
+        jump_targets.insert(iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, offset_operand) +
+                            iter.GetJumpOffsetOperand(offset_operand));
+      }
+    }
+
+    // Now fuse pairs greedily from the top. A bytecode that was fused as the second of a pair cannot start another.
+    bool has_prev = false;
+    std::size_t prev_pos = 0;
+    Bytecode prev_bytecode = Bytecode::Return;
+    for (BytecodeIterator iter(*code, start, end); !iter.Done(); iter.Advance()) {
+      const Bytecode bytecode = iter.CurrentBytecode();
+      const std::size_t pos = iter.GetPosition();
+
+      Superinstruction superinstruction;
+      bool fuse = has_prev && jump_targets.count(pos) == 0 && Lookup(prev_bytecode, bytecode, &superinstruction);
+      if (fuse && Bytecodes::IsConditionalJump(bytecode)) {
+        // The branch must test the result of the first bytecode, which is then passed along in a register
+        BytecodeIterator prev_iter(*code, start, end);
+        prev_iter.SetPosition(prev_pos);
+        fuse = prev_iter.GetLocalOperand(0).GetOffset() == iter.GetLocalOperand(0).GetOffset();
+      }
+
+      if (fuse) {
+        *reinterpret_cast<std::underlying_type_t<Bytecode> *>(&(*code)[start + prev_pos]) = ToByte(superinstruction);
+        num_fused++;
+        has_prev = false;
+      } else {
+        has_prev = true;
+        prev_pos = pos;
+        prev_bytecode = bytecode;
+      }
+    }
+  }
+
+  return num_fused;
+}
+
+}  // namespace noisepage::execution::vm
@@ -7,7 +7,9 @@
 #include "execution/util/memory.h"
 #include "execution/vm/bytecode_function_info.h"
 #include "execution/vm/bytecode_handlers.h"
+#include "execution/vm/bytecode_pair_profiler.h"
 #include "execution/vm/module.h"
+#include "execution/vm/superinstructions.h"
 #include "loggers/execution_logger.h"
 
 namespace noisepage::execution::vm {
@@ -111,6 +113,11 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   Frame frame(raw_frame, frame_size);
   vm.Interpret(module->GetBytecodeModule()->AccessBytecodeForFunctionRaw(*func_info), &frame);
 
+  // Report the loops we ran, to help decide whether the module is worth compiling
+  if (vm.num_loop_iterations_ > 0) {
+    module->RecordInterpretedLoopIterations(vm.num_loop_iterations_);
+  }
+
   // Done. Now, let's cleanup.
   if (used_heap) {
     std::free(raw_frame);
@@ -143,18 +150,30 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   static void *kDispatchTable[] = {
 #define ENTRY(name, ...) &&op_##name,
       BYTECODE_LIST(ENTRY)
+      // Superinstructions are encoded after all regular bytecodes
+      SUPERINSTRUCTION_LIST(ENTRY)
 #undef ENTRY
   };
 
 #ifdef TPL_DEBUG_TRACE_INSTRUCTIONS
 #define DEBUG_TRACE_INSTRUCTIONS(op)                                                                                   \
   do {                                                                                                                 \
-    auto bytecode = Bytecodes::FromByte(op);                                                                           \
-    bytecode_counts_[op]++;                                                                                            \
-    EXECUTION_LOG_DEBUG("{0:p}: {1:s}", ip - sizeof(std::underlying_type_t<Bytecode>), Bytecodes::ToString(bytecode)); \
+    /* Superinstruction opcodes are past the last bytecode, so they have to be decoded separately */                   \
+    auto name = Superinstructions::IsSuperinstruction(op)                                                              \
+                    ? Superinstructions::ToString(Superinstructions::FromByte(op))                                     \
+                    : Bytecodes::ToString(Bytecodes::FromByte(op));                                                    \
+    EXECUTION_LOG_DEBUG("{0:p}: {1:s}", ip - sizeof(std::underlying_type_t<Bytecode>), name);                          \
   } while (false)
 #else
 #define DEBUG_TRACE_INSTRUCTIONS(op) (void)op
+#endif
+
+#ifdef NOISEPAGE_PROFILE_BYTECODE_PAIRS
+  auto *const pair_profiler = BytecodePairProfiler::Instance();
+  auto last_bytecode = BytecodePairProfiler::NO_BYTECODE;
+#define PROFILE_BYTECODE_PAIR(op) last_bytecode = pair_profiler->Record(last_bytecode, op)
+#else
+#define PROFILE_BYTECODE_PAIR(op) (void)op
 #endif
 
   // TODO(pmenon): Should these READ/PEEK macros take in a vm::OperandType so
@@ -180,6 +199,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   do {                            \
     auto op = READ_OP();          \
     DEBUG_TRACE_INSTRUCTIONS(op); \
+    PROFILE_BYTECODE_PAIR(op);    \
     goto *kDispatchTable[op];     \
   } while (false)
 
@@ -329,6 +349,8 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   OP(Jump) : {
     auto skip = PEEK_JMP_OFFSET();
     if (LIKELY(OpJump())) {
+      // Loops close with an unconditional backward jump to their header
+      num_loop_iterations_ += static_cast<uint64_t>(skip < 0);
       ip += skip;
     }
     DISPATCH_NEXT();
@@ -1727,7 +1749,8 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
     auto tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
-    OpJoinHashTableInit(join_hash_table, exec_ctx, tuple_size);
+    auto probe_tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpJoinHashTableInit(join_hash_table, exec_ctx, tuple_size, probe_tuple_size);
     DISPATCH_NEXT();
   }
 
@@ -1768,6 +1791,35 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableIsSpilled) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableIsSpilled(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableSpillProbe) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    auto *probe_tuple = frame->LocalAt<const byte *>(READ_LOCAL_ID());
+    OpJoinHashTableSpillProbe(join_hash_table, hash_val, probe_tuple);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableNextPartition) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableNextPartition(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableNextSpilledProbe) : {
+    auto *result = frame->LocalAt<const byte **>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableNextSpilledProbe(result, join_hash_table);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableFree) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     OpJoinHashTableFree(join_hash_table);
@@ -1830,9 +1882,10 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *exec_ctx = frame->LocalAt<noisepage::execution::exec::ExecutionContext *>(READ_LOCAL_ID());
     auto cmp_func_id = READ_FUNC_ID();
     auto tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto key_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
 
     auto cmp_fn = reinterpret_cast<sql::Sorter::ComparisonFunction>(module_->GetRawFunctionImpl(cmp_func_id));
-    OpSorterInit(sorter, exec_ctx, cmp_fn, tuple_size);
+    OpSorterInit(sorter, exec_ctx, cmp_fn, tuple_size, key_size);
     DISPATCH_NEXT();
   }
 
@@ -1934,6 +1987,23 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+#define GEN_SORT_KEY_WRITE(NAME, CPP_TYPE)                         \
+  OP(SortKeyWrite##NAME) : {                                       \
+    auto *key = frame->LocalAt<byte *>(READ_LOCAL_ID());           \
+    auto *input = frame->LocalAt<const CPP_TYPE *>(READ_LOCAL_ID());\
+    auto descending = frame->LocalAt<bool>(READ_LOCAL_ID());       \
+    OpSortKeyWrite##NAME(key, input, descending);                  \
+    DISPATCH_NEXT();                                               \
+  }
+
+  GEN_SORT_KEY_WRITE(Bool, sql::BoolVal)
+  GEN_SORT_KEY_WRITE(Integer, sql::Integer)
+  GEN_SORT_KEY_WRITE(Real, sql::Real)
+  GEN_SORT_KEY_WRITE(Date, sql::DateVal)
+  GEN_SORT_KEY_WRITE(Timestamp, sql::TimestampVal)
+  GEN_SORT_KEY_WRITE(String, sql::StringVal)
+#undef GEN_SORT_KEY_WRITE
+
   // -------------------------------------------------------
   // Output
   // -------------------------------------------------------
@@ -2761,6 +2831,112 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  // -------------------------------------------------------
+  // Superinstructions
+  // -------------------------------------------------------
+
+  // A superinstruction runs its first bytecode, steps over the opcode of the
+  // second one, and then runs the second bytecode without a dispatch. The
+  // operands of both bytecodes are laid out as if they were not fused.
+#define SKIP_FUSED_OP() ip += sizeof(std::underlying_type_t<Bytecode>) /* NOLINT */
+
+  // Branch on a condition computed by the first bytecode of a superinstruction.
+  // The condition operand is the local the first bytecode wrote the condition
+  // into, so the value is taken from a register instead of the frame.
+#define FUSED_BRANCH(jump, cond)    \
+  do {                              \
+    SKIP_FUSED_OP();                \
+    READ_LOCAL_ID();                \
+    auto skip = PEEK_JMP_OFFSET();  \
+    if (Op##jump(cond)) {           \
+      ip += skip;                   \
+    } else {                        \
+      READ_JMP_OFFSET();            \
+    }                               \
+    DISPATCH_NEXT();                \
+  } while (false)
+
+#define DO_GEN_FUSED_COMPARISON_AND_JUMP(op, type, jump)  \
+  OP(op##_##type##_##jump) : {                            \
+    auto *dest = frame->LocalAt<bool *>(READ_LOCAL_ID()); \
+    auto lhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    auto rhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    Op##op##_##type(dest, lhs, rhs);                      \
+    const bool cond = *dest;                              \
+    FUSED_BRANCH(jump, cond);                             \
+  }
+#define GEN_FUSED_COMPARISON_AND_JUMP(type, jump)                  \
+  DO_GEN_FUSED_COMPARISON_AND_JUMP(GreaterThan, type, jump)      \
+  DO_GEN_FUSED_COMPARISON_AND_JUMP(GreaterThanEqual, type, jump) \
+  DO_GEN_FUSED_COMPARISON_AND_JUMP(Equal, type, jump)            \
+  DO_GEN_FUSED_COMPARISON_AND_JUMP(LessThan, type, jump)         \
+  DO_GEN_FUSED_COMPARISON_AND_JUMP(LessThanEqual, type, jump)    \
+  DO_GEN_FUSED_COMPARISON_AND_JUMP(NotEqual, type, jump)
+
+  ALL_TYPES(GEN_FUSED_COMPARISON_AND_JUMP, JumpIfFalse)
+  ALL_TYPES(GEN_FUSED_COMPARISON_AND_JUMP, JumpIfTrue)
+#undef GEN_FUSED_COMPARISON_AND_JUMP
+#undef DO_GEN_FUSED_COMPARISON_AND_JUMP
+
+#define GEN_FUSED_FORCE_BOOL_TRUTH_AND_JUMP(jump)                      \
+  OP(ForceBoolTruth_##jump) : {                                        \
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());            \
+    auto *sql_bool = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());  \
+    OpForceBoolTruth(result, sql_bool);                                \
+    const bool cond = *result;                                         \
+    FUSED_BRANCH(jump, cond);                                          \
+  }
+
+  GEN_FUSED_FORCE_BOOL_TRUTH_AND_JUMP(JumpIfFalse)
+  GEN_FUSED_FORCE_BOOL_TRUTH_AND_JUMP(JumpIfTrue)
+#undef GEN_FUSED_FORCE_BOOL_TRUTH_AND_JUMP
+
+#define GEN_FUSED_ADD_AND_JUMP(type, ...)                 \
+  OP(Add_##type##_Jump) : {                               \
+    auto *dest = frame->LocalAt<type *>(READ_LOCAL_ID()); \
+    auto lhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    auto rhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
+    OpAdd_##type(dest, lhs, rhs);                         \
+    SKIP_FUSED_OP();                                      \
+    goto OP(Jump);                                        \
+  }
+
+  INT_TYPES(GEN_FUSED_ADD_AND_JUMP)
+#undef GEN_FUSED_ADD_AND_JUMP
+
+  OP(VPIHasNext_JumpIfFalse) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    OpVPIHasNext(has_more, iter);
+    const bool cond = *has_more;
+    FUSED_BRANCH(JumpIfFalse, cond);
+  }
+
+  OP(VPIHasNextFiltered_JumpIfFalse) : {
+    auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    OpVPIHasNextFiltered(has_more, iter);
+    const bool cond = *has_more;
+    FUSED_BRANCH(JumpIfFalse, cond);
+  }
+
+  OP(VPIAdvance_Jump) : {
+    auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    OpVPIAdvance(iter);
+    SKIP_FUSED_OP();
+    goto OP(Jump);
+  }
+
+  OP(VPIAdvanceFiltered_Jump) : {
+    auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    OpVPIAdvanceFiltered(iter);
+    SKIP_FUSED_OP();
+    goto OP(Jump);
+  }
+
+#undef FUSED_BRANCH
+#undef SKIP_FUSED_OP
+
   // Impossible
   UNREACHABLE("Impossible to reach end of interpreter loop. Bad code!");
 }  // NOLINT(readability/fn_size)
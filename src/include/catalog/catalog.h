@@ -113,6 +113,13 @@ class Catalog {
    */
   db_oid_t GetDatabaseOid(common::ManagedPointer<transaction::TransactionContext> txn, const std::string &name);
 
+  /**
+   * Lists every database visible to the transaction.
+   * @param txn for the catalog query
+   * @return OIDs of all of the databases
+   */
+  std::vector<db_oid_t> GetDatabaseOids(common::ManagedPointer<transaction::TransactionContext> txn);
+
   /**
    * Gets the database-specific catalog object.
    * @param txn for the catalog query
@@ -113,6 +113,10 @@ class DatabaseCatalog {
   /** @brief Get the name of the specified index */
   std::string_view GetIndexName(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index);
 
+  /** @brief Get the OIDs and storage pointers of every table, including catalog tables. @see PgCoreImpl::GetTables */
+  std::vector<std::pair<table_oid_t, common::ManagedPointer<storage::SqlTable>>> GetTables(
+      common::ManagedPointer<transaction::TransactionContext> txn);
+
   /** @brief Get the schema for the specified table. */
   const Schema &GetSchema(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
   /** @brief Get the index schema for the specified index. */
@@ -134,6 +134,14 @@ class PgCoreImpl {
    */
   std::vector<std::pair<uint32_t, PgClass::RelKind>> GetNamespaceClassOids(
       common::ManagedPointer<transaction::TransactionContext> txn, namespace_oid_t ns_oid);
+  /**
+   * @brief Get the OIDs and storage pointers of every table in pg_class, including the catalog tables.
+   *
+   * @param txn     The transaction to use for the operation.
+   * @return        A list of all table OIDs and their SqlTable pointers visible to the transaction.
+   */
+  std::vector<std::pair<table_oid_t, common::ManagedPointer<storage::SqlTable>>> GetTables(
+      common::ManagedPointer<transaction::TransactionContext> txn);
 
   /**
    * @brief Insert the provided pointer into the specified pg_class column.
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/macros.h"
+
+namespace noisepage::common {
+
+/**
+ * Utility class for compressing blocks of bytes and detecting corruption in them.
+ *
+ * Compress produces the LZ4 block format: a sequence of (literals, match) pairs, where a match copies bytes from up to
+ * 64KB back in the decompressed output. It favors speed over compression ratio, and is meant for small blocks that are
+ * compressed once and rarely decompressed, such as log buffers.
+ */
+class CompressionUtil {
+ public:
+  /** This class cannot be instantiated. */
+  DISALLOW_INSTANTIATION(CompressionUtil);
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(CompressionUtil);
+
+  /**
+   * @param size number of bytes to compress
+   * @return the largest number of bytes Compress can produce for the given input size
+   */
+  static constexpr uint32_t MaxCompressedSize(const uint32_t size) { return size + size / 255 + 16; }
+
+  /**
+   * Compresses a block of bytes.
+   * @param src bytes to compress
+   * @param size number of bytes to compress
+   * @param[out] dst location to write the compressed bytes to, must have room for MaxCompressedSize(size) bytes
+   * @return number of compressed bytes written to dst. This can be larger than size if the input is incompressible.
+   */
+  static uint32_t Compress(const void *src, uint32_t size, void *dst);
+
+  /**
+   * Decompresses a block of bytes produced by Compress.
+   * @param src compressed bytes
+   * @param src_size number of compressed bytes
+   * @param[out] dst location to write the decompressed bytes to
+   * @param dst_size number of bytes the block decompresses to
+   * @return true if the block was decompressed, false if it is malformed or does not decompress to exactly dst_size
+   * bytes. dst is never written past dst_size bytes.
+   */
+  static bool Decompress(const void *src, uint32_t src_size, void *dst, uint32_t dst_size);
+
+  /**
+   * Computes the CRC32C (Castagnoli) checksum of a block of bytes using the SSE4.2 crc32 instruction.
+   * @param data bytes to checksum
+   * @param size number of bytes to checksum
+   * @param crc checksum of the bytes preceding data, to checksum a block in pieces
+   * @return checksum of the bytes
+   */
+  static uint32_t Crc32c(const void *data, uint64_t size, uint32_t crc = 0);
+};
+
+}  // namespace noisepage::common
@@ -126,5 +126,43 @@ struct Constants {
    * Flag indicating if static partitioner is used
    */
   static constexpr const bool IS_STATIC_PARTITIONER_ENABLED = false;
+
+  /**
+   * Flag indicating if sorts use normalized (binary-comparable) key prefixes
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const bool IS_SORT_NORMALIZED_KEYS_ENABLED = false;
+
+  /**
+   * Bytes of input tuples a sort may buffer in each thread before it spills to disk, 0 if sorts never spill
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t SORT_MEMORY_BUDGET = 0;
+
+  /**
+   * Bytes of build-side tuples a hash join may buffer before partitioning both of its inputs to disk, 0 if joins
+   * never spill
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t JOIN_MEMORY_BUDGET = 0;
+
+  /**
+   * Bytes of overflow partitions an aggregation hash table may buffer before spilling them to disk, 0 if aggregations
+   * never spill
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint64_t AGG_MEMORY_BUDGET = 0;
+
+  /**
+   * Flag indicating if partitioned aggregations stop pre-aggregating batches that barely reduce into fewer groups
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const bool IS_AGG_ADAPTIVE_PREAGGREGATION_ENABLED = true;
+
+  /**
+   * Flag indicating if parallel hash join builds radix-partition their tuples before inserting them
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const bool IS_JOIN_RADIX_PARTITIONING_ENABLED = false;
 };
 }  // namespace noisepage::common
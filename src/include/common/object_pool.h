@@ -73,6 +73,16 @@ class ObjectPool {
   ObjectPool(uint64_t size_limit, uint64_t reuse_limit)
       : size_limit_(size_limit), reuse_limit_(reuse_limit), current_size_(0) {}
 
+  /**
+   * Initializes a new object pool that constructs and destructs objects with the given allocator.
+   *
+   * @param size_limit the maximum number of objects the object pool controls
+   * @param reuse_limit the maximum number of reusable objects
+   * @param alloc the allocator to use
+   */
+  ObjectPool(uint64_t size_limit, uint64_t reuse_limit, Allocator alloc)
+      : alloc_(std::move(alloc)), size_limit_(size_limit), reuse_limit_(reuse_limit), current_size_(0) {}
+
   /**
    * Destructs the memory pool. Frees any memory it holds.
    *
@@ -191,6 +191,10 @@ namespace noisepage::execution::ast {
   F(JoinHashTableBuildParallel, joinHTBuildParallel)                    \
   F(JoinHashTableGetTupleCount, joinHTGetTupleCount)                    \
   F(JoinHashTableLookup, joinHTLookup)                                  \
+  F(JoinHashTableIsSpilled, joinHTIsSpilled)                            \
+  F(JoinHashTableSpillProbe, joinHTSpillProbe)                          \
+  F(JoinHashTableNextPartition, joinHTNextPartition)                    \
+  F(JoinHashTableNextSpilledProbe, joinHTNextSpilledProbe)              \
   F(JoinHashTableFree, joinHTFree)                                      \
                                                                         \
   /* Hash Table Entry Iterator (for hash joins) */                      \
@@ -219,6 +223,7 @@ namespace noisepage::execution::ast {
   F(SorterIterSkipRows, sorterIterSkipRows)                             \
   F(SorterIterGetRow, sorterIterGetRow)                                 \
   F(SorterIterClose, sorterIterClose)                                   \
+  F(SortKeyWrite, sortKeyWrite)                                         \
                                                                         \
   /* Output */                                                          \
   F(ResultBufferNew, resultBufferNew)                                   \
@@ -228,6 +228,9 @@ class CodeGen {
   /** @return An expression representing "arr[idx]". */
   ast::Expr *ArrayAccess(ast::Identifier arr, uint64_t idx);
 
+  /** @return An expression representing "arr[idx]". */
+  ast::Expr *ArrayAccess(ast::Expr *arr, uint64_t idx);
+
   /**
    * Convert a SQL type into a type representation expression.
    * @param type The SQL type.
@@ -918,10 +921,13 @@ class CodeGen {
    * @param join_hash_table The join hash table.
    * @param exec_ctx The execution context.
    * @param build_row_type_name The name of the materialized build-side row in the hash table.
+   * @param probe_row_type_name The name of the probe-side row the table spills if it exceeds the
+   *                            join memory budget, or empty if the table may never spill.
    * @return The call.
    */
   [[nodiscard]] ast::Expr *JoinHashTableInit(ast::Expr *join_hash_table, ast::Expr *exec_ctx,
-                                             ast::Identifier build_row_type_name);
+                                             ast::Identifier build_row_type_name,
+                                             ast::Identifier probe_row_type_name = ast::Identifier());
 
   /**
    * Call \@joinHTInsert(). Allocates a new tuple in the join hash table with the given hash value.
@@ -966,6 +972,43 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *entry_iter, ast::Expr *hash_val);
 
+  /**
+   * Call \@joinHTIsSpilled(). Determine if the provided join hash table spilled its build side, and
+   * must be probed partition-wise.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableIsSpilled(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTSpillProbe(). Spill the provided probe row into the partition of the spilled join
+   * hash table matching the provided hash value.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @param probe_row A pointer to the probe row.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableSpillProbe(ast::Expr *join_hash_table, ast::Expr *hash_val,
+                                                   ast::Expr *probe_row);
+
+  /**
+   * Call \@joinHTNextPartition(). Load the build side of the next partition of the spilled join hash
+   * table.
+   * @param join_hash_table The join hash table.
+   * @return The call, evaluating to false once all partitions have been processed.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableNextPartition(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTNextSpilledProbe(). Read the next spilled probe row of the partition currently
+   * loaded into the join hash table.
+   * @param join_hash_table The join hash table.
+   * @param probe_row_type_name The name of the probe-side row.
+   * @return The call, evaluating to a pointer to the probe row, or nil once the partition is exhausted.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableNextSpilledProbe(ast::Expr *join_hash_table,
+                                                         ast::Identifier probe_row_type_name);
+
   /**
    * Call \@joinHTFree(). Cleanup and destroy the provided join hash table instance.
    * @param join_hash_table The join hash table.
@@ -1239,10 +1282,11 @@ class CodeGen {
    * @param exec_ctx The execution context that we are running in.
    * @param cmp_func_name The name of the comparison function to use.
    * @param sort_row_type_name The name of the materialized sort-row type.
+   * @param key_size The size of the normalized key at the start of the sort-row, or 0 if it has none.
    * @return The call.
    */
   [[nodiscard]] ast::Expr *SorterInit(ast::Expr *sorter, ast::Expr *exec_ctx, ast::Identifier cmp_func_name,
-                                      ast::Identifier sort_row_type_name);
+                                      ast::Identifier sort_row_type_name, uint32_t key_size = 0);
 
   /**
    * Call \@sorterInsert(). Prepare an insert into the provided sorter whose type is the given type.
@@ -1352,6 +1396,15 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *SorterIterClose(ast::Expr *iter);
 
+  /**
+   * Call \@sortKeyWrite(). Encode a SQL value into a normalized sort key.
+   * @param key A pointer to the key bytes the value is written into.
+   * @param val The SQL value.
+   * @param descending True if the key sorts in descending order.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *SortKeyWrite(ast::Expr *key, ast::Expr *val, bool descending);
+
   /**
    * Call \@like(). Implements the SQL LIKE() operation.
    * @param str The input string.
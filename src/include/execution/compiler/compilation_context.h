@@ -130,6 +130,12 @@ class CompilationContext {
   /** @return True if we should record pipeline metrics */
   bool IsPipelineMetricsEnabled() const { return pipeline_metrics_enabled_; }
 
+  /** @return True if sorts should materialize normalized key prefixes. */
+  bool IsSortNormalizedKeysEnabled() const { return sort_normalized_keys_enabled_; }
+
+  /** @return True if hash joins should be able to spill to disk when over the join memory budget. */
+  bool IsJoinSpillingEnabled() const { return join_spilling_enabled_; }
+
   /** @return Query Id associated with the query */
   query_id_t GetQueryId() const { return query_id_; }
 
@@ -187,6 +193,12 @@ class CompilationContext {
 
   // Whether pipeline metrics are enabled.
   bool pipeline_metrics_enabled_;
+
+  // Whether sorts use normalized key prefixes.
+  bool sort_normalized_keys_enabled_;
+
+  // Whether hash joins can spill.
+  bool join_spilling_enabled_;
 };
 
 }  // namespace noisepage::execution::compiler
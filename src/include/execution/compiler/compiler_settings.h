@@ -9,15 +9,20 @@ class CompilerSettings {
   void SetShouldCaptureTPL(bool should_capture_tpl) { should_capture_tpl_ = should_capture_tpl; }
   /** Set whether TBC should be captured during compilation. */
   void SetShouldCaptureTBC(bool should_capture_tbc) { should_capture_tbc_ = should_capture_tbc; }
+  /** Set whether frequent bytecode pairs should be fused into interpreter superinstructions. */
+  void SetShouldFuseSuperinstructions(bool should_fuse) { should_fuse_superinstructions_ = should_fuse; }
 
   /** @return True if TPL should be captured. */
   [[nodiscard]] bool ShouldCaptureTPL() const noexcept { return should_capture_tpl_; }
   /** @return True if TBC should be captured. */
   [[nodiscard]] bool ShouldCaptureTBC() const noexcept { return should_capture_tbc_; }
+  /** @return True if bytecode should be fused into superinstructions. */
+  [[nodiscard]] bool ShouldFuseSuperinstructions() const noexcept { return should_fuse_superinstructions_; }
 
  private:
   bool should_capture_tpl_{false};
   bool should_capture_tbc_{false};
+  bool should_fuse_superinstructions_{true};
 };
 
 }  // namespace noisepage::execution::compiler
@@ -8,6 +8,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "execution/ast/ast_fwd.h"
+#include "execution/exec/execution_settings.h"
 #include "execution/exec_defs.h"
 #include "execution/vm/vm_defs.h"
 #include "transaction/transaction_defs.h"
@@ -23,7 +24,6 @@ class PilotUtil;
 namespace execution {
 namespace exec {
 class ExecutionContext;
-class ExecutionSettings;
 }  // namespace exec
 
 namespace sema {
@@ -58,6 +58,10 @@ class CompilationContext;
 
 /**
  * An compiled and executable query object.
+ *
+ * Once set up, an executable query is immutable: it holds the compiled code of the query, while all state of an
+ * execution lives in the query state allocated by Run() and in the provided execution context. A single executable
+ * query can therefore be shared by all connections running the same plan, and be run by many threads at once.
  */
 class ExecutableQuery {
  public:
@@ -96,6 +100,12 @@ class ExecutableQuery {
     /** @return The metadata of this module. */
     const vm::ModuleMetadata &GetModuleMetadata() const;
 
+    /** @return The size of the bytecode of this fragment, in bytes. */
+    std::size_t GetCodeSize() const;
+
+    /** @return The module that contains the functions of this fragment. */
+    const vm::Module *GetModule() const { return module_.get(); }
+
    private:
     // The functions that must be run (in the provided order) to execute this
     // query fragment.
@@ -138,12 +148,12 @@ class ExecutableQuery {
              std::unique_ptr<selfdriving::PipelineOperatingUnits> pipeline_operating_units);
 
   /**
-   * Execute the query.
+   * Execute the query. This is thread-safe, as long as every concurrent execution uses its own execution context.
    * @param exec_ctx The context in which to execute the query.
    * @param mode The execution mode to use when running the query. By default, its interpreted.
    */
   void Run(common::ManagedPointer<exec::ExecutionContext> exec_ctx,
-           vm::ExecutionMode mode = vm::ExecutionMode::Interpret);
+           vm::ExecutionMode mode = vm::ExecutionMode::Interpret) const;
 
   /**
    * @return The physical plan this executable query implements.
@@ -167,16 +177,20 @@ class ExecutableQuery {
   }
 
   /** @return The Query Identifier */
-  query_id_t GetQueryId() { return query_id_; }
+  query_id_t GetQueryId() const { return query_id_; }
 
   /** @return The query fragments in this module. */
   const std::vector<std::unique_ptr<Fragment>> &GetFragments() const { return fragments_; }
 
+  /** @return The size of the bytecode of all fragments, in bytes. */
+  std::size_t GetCodeSize() const;
+
  private:
   // The plan.
   const planner::AbstractPlanNode &plan_;
-  // The execution settings used for code generation.
-  const exec::ExecutionSettings &exec_settings_;
+  // The execution settings used for code generation. These are copied since the query may outlive the settings it
+  // was compiled with, e.g., when it is shared across connections.
+  const exec::ExecutionSettings exec_settings_;
   // The start timestamp of the transaction that generates this ExecutableQuery
   const transaction::timestamp_t timestamp_;
   std::unique_ptr<util::Region> errors_region_;
@@ -38,8 +38,8 @@ class HashJoinTranslator : public OperatorTranslator {
 
   /**
    * Declare the build-row struct used to materialize tuples from the build side of the join. In the
-   * case of left outer joins additionally declare a probe-row struct which lets us
-   * materialize tuples from the probe side of the join.
+   * case of left outer joins, or joins that may spill, additionally declare a probe-row struct which
+   * lets us materialize tuples from the probe side of the join.
    * @param decls The top-level declarations for the query. The declared structs will be registered
    *              here after they've been constructed.
    */
@@ -47,7 +47,8 @@ class HashJoinTranslator : public OperatorTranslator {
 
   /**
    * Only for left outer joins - declare a function joinConsumer which encapsulates the parent translator's
-   * functionality
+   * functionality. Only for joins that may spill - declare a function joinProbeSpilled which probes the
+   * join hash table with a spilled probe row.
    * @param decls
    */
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
@@ -152,9 +153,18 @@ class HashJoinTranslator : public OperatorTranslator {
   // Input the tuple(s) in the provided context into the join hash table.
   void InsertIntoJoinHashTable(WorkContext *ctx, FunctionBuilder *function) const;
 
-  // Probe the join hash table with the input tuple(s).
+  // Can the join hash table spill to disk? Then, the probe side must be able to spill too.
+  bool IsSpillingEnabled() const;
+
+  // Probe the join hash table with the input tuple(s), or spill them if the table spilled.
   void ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *function) const;
 
+  // Lookup the input tuple(s) with the given hash value in the join hash table.
+  void LookupJoinHashTable(WorkContext *ctx, FunctionBuilder *function, ast::Expr *hash_val) const;
+
+  // If the join hash table spilled, join the spilled partitions one at a time.
+  void JoinSpilledPartitions(FunctionBuilder *function) const;
+
   // Check the right mark.
   void CheckRightMark(WorkContext *ctx, FunctionBuilder *function, ast::Identifier right_mark) const;
 
@@ -190,6 +200,9 @@ class HashJoinTranslator : public OperatorTranslator {
   // The name of the function which encapuslates the join conumser
   ast::Identifier join_consumer_;
 
+  // The name of the function which probes the join hash table with a spilled probe row
+  ast::Identifier join_probe_spilled_;
+
   // The left build-side pipeline.
   Pipeline left_pipeline_;
 
@@ -155,6 +155,9 @@ class SortTranslator : public OperatorTranslator, public PipelineDriver {
   // Insert tuple data into the provided sort row.
   void FillSortRow(WorkContext *ctx, FunctionBuilder *function) const;
 
+  // Write the normalized key of the tuple into the provided sort row.
+  void FillSortKey(WorkContext *ctx, FunctionBuilder *function) const;
+
   // Called to insert the tuple in the context into the sorter instance.
   void InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const;
 
@@ -182,6 +185,11 @@ class SortTranslator : public OperatorTranslator, public PipelineDriver {
   enum class CurrentRow { Child, Lhs, Rhs };
   CurrentRow current_row_;
 
+  // The size of the normalized key at the start of each sort row, and the number of leading sort
+  // keys encoded in it. The key size is zero if sort rows have no normalized key.
+  uint32_t key_size_;
+  std::size_t num_key_columns_;
+
   // For minirunners.
   ast::StructDecl *struct_decl_;
 
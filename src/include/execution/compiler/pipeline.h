@@ -148,6 +148,11 @@ class Pipeline {
    */
   bool IsParallel() const { return parallelism_ == Parallelism ::Parallel; }
 
+  /**
+   * @return True if this pipeline is nested, i.e., run by another pipeline; false otherwise.
+   */
+  bool IsNested() const { return nested_; }
+
   /**
    * @return True if this pipeline is fully vectorized; false otherwise.
    */
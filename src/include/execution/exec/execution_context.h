@@ -201,6 +201,17 @@ class EXPORT ExecutionContext {
    */
   void SetExecutionMode(uint8_t mode) { execution_mode_ = mode; }
 
+  /**
+   * Set the JIT tier that the code of this execution runs at, along with how long it took to compile the code to that
+   * tier. Like the execution mode, this is only recorded for metrics collection.
+   * @param tier the integer value of the vm::CompilationTier to record
+   * @param compile_time_us the compilation time in microseconds, or 0 if the code is interpreted
+   */
+  void SetExecutionTier(uint8_t tier, uint64_t compile_time_us) {
+    execution_tier_ = tier;
+    compile_time_us_ = compile_time_us;
+  }
+
   /**
    * Set the accessor
    * @param accessor The catalog accessor.
@@ -357,6 +368,8 @@ class EXPORT ExecutionContext {
   common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
   common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> params_;
   uint8_t execution_mode_;
+  uint8_t execution_tier_ = 0;
+  uint64_t compile_time_us_ = 0;
   uint32_t rows_affected_ = 0;
 
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
@@ -11,6 +11,10 @@ namespace noisepage::settings {
 class SettingsManager;
 }  // namespace noisepage::settings
 
+namespace noisepage {
+class JoinHashTableBenchmark;
+}  // namespace noisepage
+
 namespace noisepage::runner {
 class ExecutionRunners;
 }  // namespace noisepage::runner
@@ -94,6 +98,24 @@ class EXPORT ExecutionSettings {
   /** @return True if static partitioner is enabled. */
   constexpr bool GetIsStaticPartitionerEnabled() const { return is_static_partitioner_enabled_; }
 
+  /** @return True if sorts should radix sort on normalized key prefixes. */
+  bool GetIsSortNormalizedKeysEnabled() const { return is_sort_normalized_keys_enabled_; }
+
+  /** @return The bytes of input tuples a sort may buffer before spilling, 0 if sorts never spill. */
+  uint64_t GetSortMemoryBudget() const { return sort_memory_budget_; }
+
+  /** @return The bytes of build-side tuples a hash join may buffer before spilling, 0 if joins never spill. */
+  uint64_t GetJoinMemoryBudget() const { return join_memory_budget_; }
+
+  /** @return The bytes of overflow partitions an aggregation may buffer before spilling, 0 if it never spills. */
+  uint64_t GetAggMemoryBudget() const { return agg_memory_budget_; }
+
+  /** @return True if partitioned aggregations partition input directly when pre-aggregation barely reduces it. */
+  bool GetIsAggAdaptivePreAggregationEnabled() const { return is_agg_adaptive_preaggregation_enabled_; }
+
+  /** @return True if parallel hash join builds radix-partition their tuples before inserting them. */
+  bool GetIsJoinRadixPartitioningEnabled() const { return is_join_radix_partitioning_enabled_; }
+
  private:
   double select_opt_threshold_{common::Constants::SELECT_OPT_THRESHOLD};
   double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
@@ -104,10 +126,17 @@ class EXPORT ExecutionSettings {
   bool is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
   int number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
   bool is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+  bool is_sort_normalized_keys_enabled_{common::Constants::IS_SORT_NORMALIZED_KEYS_ENABLED};
+  uint64_t sort_memory_budget_{common::Constants::SORT_MEMORY_BUDGET};
+  uint64_t join_memory_budget_{common::Constants::JOIN_MEMORY_BUDGET};
+  uint64_t agg_memory_budget_{common::Constants::AGG_MEMORY_BUDGET};
+  bool is_agg_adaptive_preaggregation_enabled_{common::Constants::IS_AGG_ADAPTIVE_PREAGGREGATION_ENABLED};
+  bool is_join_radix_partitioning_enabled_{common::Constants::IS_JOIN_RADIX_PARTITIONING_ENABLED};
   compiler::CompilerSettings compiler_settings_{};  ///< The settings for compiling the TPL input.
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
   friend class noisepage::runner::ExecutionRunners;
+  friend class noisepage::JoinHashTableBenchmark;
   friend class noisepage::tpch::Workload;
   friend class noisepage::execution::SqlBasedTest;
   friend class noisepage::optimizer::IdxJoinTest_SimpleIdxJoinTest_Test;
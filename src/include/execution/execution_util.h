@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string_view>
 #include <utility>
@@ -17,10 +18,15 @@ class ExecutionUtil {
 
   /**
    * Initialize all TPL subsystems
+   * @param bytecode_handlers_path The path to the bytecode handlers bitcode file.
+   * @param compiled_module_cache_path The directory of the on-disk compiled module cache, empty to disable it.
+   * @param compiled_module_cache_size The maximum size of the on-disk compiled module cache, in bytes.
    */
-  static void InitTPL(std::string_view bytecode_handlers_path) {
+  static void InitTPL(std::string_view bytecode_handlers_path, std::string_view compiled_module_cache_path = "",
+                      uint64_t compiled_module_cache_size = 0) {
     execution::CpuInfo::Instance();
-    auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path);
+    auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(
+        bytecode_handlers_path, compiled_module_cache_path, compiled_module_cache_size);
     execution::vm::LLVMEngine::Initialize(std::move(settings));
   }
 
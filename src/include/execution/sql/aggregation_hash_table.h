@@ -9,6 +9,7 @@
 #include "common/managed_pointer.h"
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_projection.h"
 #include "execution/util/chunked_vector.h"
@@ -41,6 +42,12 @@ class AHTOverflowPartitionIterator;
 
 /**
  * The hash table used when performing aggregations.
+ *
+ * In partitioned mode, aggregates are flushed into overflow partitions once the main table reaches
+ * its cache-sized flush threshold. If the entries buffered in the overflow partitions exceed the
+ * aggregation memory budget, they are spilled to one file per partition and read back, one block
+ * at a time, when the partition is merged into its own table. Only the fixed-size entries are
+ * spilled; out-of-line data they point to, e.g., the contents of long strings, stays in memory.
  */
 class EXPORT AggregationHashTable {
  public:
@@ -64,6 +71,18 @@ class EXPORT AggregationHashTable {
   /** The default precision used to configure the HyperLogLog instances. Set to optimize accuracy and space manually. */
   static constexpr uint32_t DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * The ratio of groups to input tuples at or above which pre-aggregating batches in partitioned
+   * mode is considered not worth it, and batches are partitioned directly instead.
+   */
+  static constexpr float PREAGG_BYPASS_RATIO = 0.9f;
+
+  /**
+   * The number of flush thresholds' worth of tuples that are partitioned directly before batches
+   * are pre-aggregated again to check whether the ratio of groups to tuples has improved.
+   */
+  static constexpr uint32_t PREAGG_BYPASS_RESAMPLE_FACTOR = 16;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -114,6 +133,10 @@ class EXPORT AggregationHashTable {
     uint64_t num_flushes_ = 0;
     /** Number of times that the hash table has been inserted into. */
     uint64_t num_inserts_ = 0;
+    /** Number of times that the overflow partitions have been spilled to disk. */
+    uint64_t num_spills_ = 0;
+    /** Number of input tuples partitioned directly, without pre-aggregation. */
+    uint64_t num_bypassed_tuples_ = 0;
   };
 
   // -------------------------------------------------------
@@ -185,6 +208,13 @@ class EXPORT AggregationHashTable {
 
   /**
    * Ingest and process a batch of input into the aggregation table.
+   *
+   * In partitioned mode, the ratio of groups to input tuples is sampled every time the table is
+   * flushed. While it is at least PREAGG_BYPASS_RATIO, and adaptive pre-aggregation is enabled,
+   * batches skip the hash table: every tuple gets an aggregate of its own that is linked straight
+   * into its overflow partition, and duplicates are combined when the partitions are merged.
+   * Pre-aggregation is resumed periodically to check whether the ratio has improved.
+   *
    * @param input_batch The vector projection to process.
    * @param key_indexes The ordered list of key indexes in the input batch.
    * @param init_agg_fn Function to initialize a new aggregate.
@@ -280,6 +310,17 @@ class EXPORT AggregationHashTable {
    */
   const Stats *GetStatistics() const { return &stats_; }
 
+  /**
+   * @return True if this table spilled overflow partitions to disk, or took over spilled partitions
+   *         from another table.
+   */
+  bool IsSpilled() const { return !spilled_partitions_.empty(); }
+
+  /**
+   * @return The number of aggregates this table spilled to disk, or took over spilled.
+   */
+  uint64_t GetSpilledTupleCount() const { return num_spilled_tuples_; }
+
   // Specialized hash table mapping hash values to group IDs
   class HashToGroupIdMap;
 
@@ -306,9 +347,47 @@ class EXPORT AggregationHashTable {
   // partitions.
   void FlushToOverflowPartitions();
 
+  // Link the given entry into the overflow partition its hash belongs to.
+  void LinkIntoOverflowPartition(HashTableEntry *entry);
+
+  // Called from ProcessBatch() before flushing a partitioned table to decide
+  // whether subsequent batches should bypass pre-aggregation.
+  void SamplePreAggregationReduction();
+
+  // Called from ProcessBatch() in place of pre-aggregation to create an
+  // aggregate for every tuple in the batch, directly in its overflow partition.
+  void PartitionBatch(VectorProjectionIterator *input_batch, VectorInitAggFn init_agg_fn,
+                      VectorAdvanceAggFn advance_agg_fn);
+
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Should the overflow partitions be spilled? Only checked once all entries are in the overflow
+  // partitions, i.e., after a flush, and before any of them is handed out to be updated again.
+  bool NeedsToSpill() const noexcept {
+    return memory_budget_ != 0 && hash_table_.GetElementCount() == 0 &&
+           entries_.size() * entries_.ElementSize() > memory_budget_;
+  }
+
+  // Append all entries in the overflow partitions to their spill files and release them.
+  void SpillOverflowPartitions();
+
+  // Link in the overflow partitions, in memory and spilled, of the given table, and take over the
+  // memory of its entries.
+  void TakeOverflowPartitions(AggregationHashTable *source);
+
+  // Does the given overflow partition have any entries, in memory or spilled?
+  bool HasOverflowEntries(uint32_t partition_idx) const {
+    return partition_heads_[partition_idx] != nullptr ||
+           (IsSpilled() && !spilled_partitions_[partition_idx].empty());
+  }
+
+  // Invoke the merging function with iterators over all entries of the given overflow partition.
+  // Spilled entries are read back into memory owned by the target table, and their files are
+  // released.
+  void MergeOverflowPartition(void *query_state, uint32_t partition_idx, AggregationHashTable *target,
+                              MergePartitionFn merge_fn);
+
   // Called from ProcessBatch() to compute hash values for tuples in batch.
   void ComputeHash(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes);
 
@@ -338,6 +417,9 @@ class EXPORT AggregationHashTable {
   // table over a single partition.
   AggregationHashTable *GetOrBuildTableOverPartition(void *query_state, uint32_t partition_idx);
 
+  // Destroy the aggregation hash table built over a single partition.
+  void FreeTableOverPartition(uint32_t partition_idx);
+
  private:
   // A helper class containing various data structures used during batch processing.
   class BatchProcessState {
@@ -427,6 +509,26 @@ class EXPORT AggregationHashTable {
   // The number of bits to shift the hash value to determine the overflow
   // partition an entry is linked into.
   uint64_t partition_shift_bits_;
+  // The bytes of entries that can be buffered before the overflow partitions
+  // are spilled, 0 if they never are.
+  uint64_t memory_budget_;
+  // The spill files of each overflow partition, one per table that spilled
+  // into the partition. Empty until the table spills.
+  std::vector<std::vector<std::unique_ptr<SpillFile>>> spilled_partitions_;
+  // The number of aggregates spilled.
+  uint64_t num_spilled_tuples_;
+
+  // -------------------------------------------------------
+  // Adaptive pre-aggregation
+  // -------------------------------------------------------
+
+  // Whether partitioned batches may bypass pre-aggregation.
+  bool adaptive_preaggregation_;
+  // Whether partitioned batches currently bypass pre-aggregation.
+  bool bypass_preaggregation_;
+  // The number of tuples pre-aggregated into the main table since the last
+  // flush, or the number of tuples left to bypass while bypassing.
+  uint64_t preagg_tuple_count_;
 
   // Runtime stats.
   Stats stats_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/concise_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/util/chunked_vector.h"
 
 namespace libcount {
@@ -46,6 +48,32 @@ class Vector;
  * In parallel mode, thread-local join hash tables are lazily built and merged in parallel into a
  * global join hash table through a call to JoinHashTable::MergeParallel(). After this call, the
  * global table takes ownership of all thread-local allocated memory and hash index.
+ *
+ * If radix partitioning is enabled in the execution settings and the global table's directory
+ * does not fit in the L2 cache, the parallel merge is radix-partitioned instead of inserting all
+ * thread-local tuples concurrently into the whole directory. The directory is split into 2^k
+ * contiguous, cache-sized ranges of buckets; the thread-local tuples are first scattered into one
+ * partition per range through software write-combining buffers, and each partition is then
+ * inserted by a single thread without atomics, touching only its own range.
+ *
+ * A table constructed with a probe tuple size spills to disk once its buffered build tuples exceed
+ * the join memory budget, turning the join into a Grace hash join. All build tuples are then
+ * partitioned on their hash values into NUM_SPILL_PARTITIONS partitions on disk, and probe tuples
+ * must be spilled into the matching partitions through SpillProbeTuple() instead of being looked
+ * up. Once all probe tuples are spilled, each pair of partitions is joined in turn:
+ *
+ * @code
+ * while (jht.NextSpilledPartition()) {
+ *   // The build side of the partition is loaded and built, probe its spilled probe tuples
+ *   for (const byte *probe; (probe = jht.NextSpilledProbeTuple()) != nullptr;) {
+ *     ... jht.Lookup(...) ...
+ *   }
+ * }
+ * @endcode
+ *
+ * Partitions whose build side still exceeds the budget are recursively re-partitioned, up to
+ * MAX_SPILL_DEPTH levels deep. Only the fixed-size tuples are spilled; out-of-line data they point
+ * to stays in memory.
  */
 class EXPORT JoinHashTable {
  public:
@@ -63,6 +91,21 @@ class EXPORT JoinHashTable {
   /** Minimum number of expected elements to merge before triggering a parallel merge. */
   static constexpr uint32_t DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE = 1024;
 
+  /** The maximum number of hash bits a radix-partitioned parallel merge partitions on. */
+  static constexpr uint32_t MAX_RADIX_PARTITION_BITS = 10;
+
+  /** The number of hash bits a spilled table is partitioned on per level. */
+  static constexpr uint32_t SPILL_PARTITION_BITS = 6;
+
+  /** The number of partitions a spilled table, or a partition that is too large, is split into. */
+  static constexpr uint32_t NUM_SPILL_PARTITIONS = 1u << SPILL_PARTITION_BITS;
+
+  /** The maximum number of times a partition is split, to give up on partitions of duplicate keys. */
+  static constexpr uint32_t MAX_SPILL_DEPTH = 4;
+
+  /** The number of insertions between two checks of the memory budget. */
+  static constexpr uint64_t SPILL_CHECK_INTERVAL = 256;
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the injected @em memory,
    * and thus, are ephemeral.
@@ -70,9 +113,11 @@ class EXPORT JoinHashTable {
    * @param exec_ctx ExecutionContext
    * @param tuple_size The size of the tuple stored in this join hash table.
    * @param use_concise_ht Whether to use a concise or fatter chaining join index.
+   * @param probe_tuple_size The size of the probe tuples the table spills if it exceeds the join
+   *                         memory budget; 0 if the table may never spill.
    */
   explicit JoinHashTable(const exec::ExecutionSettings &exec_settings, exec::ExecutionContext *exec_ctx,
-                         uint32_t tuple_size, bool use_concise_ht = false);
+                         uint32_t tuple_size, bool use_concise_ht = false, uint32_t probe_tuple_size = 0);
 
   /**
    * This class cannot be copied or moved.
@@ -100,6 +145,29 @@ class EXPORT JoinHashTable {
    */
   void Build();
 
+  /**
+   * Copy a probe tuple into the spilled partition matching its hash value @em hash. This function
+   * is thread-safe, but may only be called after the table has been built.
+   * @pre IsSpilled() is true.
+   * @param hash The hash value of the probe tuple.
+   * @param probe_tuple The probe tuple to spill, of the probe tuple size this table was created with.
+   */
+  void SpillProbeTuple(hash_t hash, const byte *probe_tuple);
+
+  /**
+   * Load and build the build side of the next spilled partition, replacing the current one. Lookups
+   * then find the tuples of that partition, and NextSpilledProbeTuple() returns its probe tuples.
+   * @pre IsSpilled() is true, and all probe tuples have been spilled.
+   * @return True if a partition was loaded; false if all partitions have been processed.
+   */
+  bool NextSpilledPartition();
+
+  /**
+   * @return The next spilled probe tuple of the current partition, valid until the next call to
+   *         this function; nullptr if all probe tuples of the partition have been returned.
+   */
+  const byte *NextSpilledProbeTuple();
+
   /**
    * Lookup a single entry with hash value @em hash returning an iterator.
    * @tparam UseCHT Should the lookup use the concise or general table.
@@ -156,7 +224,8 @@ class EXPORT JoinHashTable {
   bool HasBloomFilter() const { return !bloom_filter_.IsEmpty(); }
 
   /**
-   * @return The total number of elements in the table, including duplicates.
+   * @return The total number of elements in the table, including duplicates. If the table spilled,
+   *         only the elements of the partition currently loaded are counted.
    */
   uint64_t GetTupleCount() const {
     // We don't know if this hash table was built in parallel. To be safe, we
@@ -179,6 +248,16 @@ class EXPORT JoinHashTable {
    */
   bool IsBuilt() const { return built_; }
 
+  /**
+   * @return True if the table spilled its build side to disk, and must be probed partition-wise.
+   */
+  bool IsSpilled() const { return spilled_; }
+
+  /**
+   * @return The number of build tuples the table spilled to disk.
+   */
+  uint64_t GetSpilledTupleCount() const { return num_spilled_tuples_; }
+
   /**
    * @return True if this join hash table uses a concise table under the hood.
    */
@@ -193,6 +272,7 @@ class EXPORT JoinHashTable {
   friend class JoinHashTableIterator;
   FRIEND_TEST(JoinHashTableTest, LazyInsertionTest);
   FRIEND_TEST(JoinHashTableTest, PerfTest);
+  FRIEND_TEST(JoinHashTableTest, RadixPartitionedParallelBuildTest);
 
   // Access a stored entry by index
   HashTableEntry *EntryAt(const uint64_t idx) { return reinterpret_cast<HashTableEntry *>(entries_[idx]); }
@@ -225,6 +305,48 @@ class EXPORT JoinHashTable {
   template <bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // The number of hash bits to radix-partition a parallel merge on so that each partition's range
+  // of the directory fits in radix_partition_cache_size_; 0 if the whole directory already does.
+  uint32_t ComputeRadixPartitionBits() const;
+
+  // Merge the thread-local tables (which aren't built yet) into this one by radix-partitioning
+  // their entries on the given number of bits, then inserting each partition in parallel.
+  void MergePartitioned(const std::vector<JoinHashTable *> &tl_join_tables, uint32_t radix_bits);
+
+  // A spilled partition: the build and probe tuples whose hashes share the partition's bits.
+  struct SpilledPartition {
+    // The files of build-side entries, one per table that spilled into the partition
+    std::vector<std::unique_ptr<SpillFile>> build_;
+    // The file of probe-side records, each the probe tuple's hash followed by the tuple
+    std::unique_ptr<SpillFile> probe_;
+    // The number of times the partition has been split
+    uint32_t level_;
+  };
+
+  // The partition at the given level a hash value falls into. The bits above those used to pick a
+  // chain and below the tags of the chaining table are used, so that neither degrades.
+  static uint32_t SpillPartitionOf(const hash_t hash, const uint32_t level) {
+    return (hash >> (24 + level * SPILL_PARTITION_BITS)) & (NUM_SPILL_PARTITIONS - 1);
+  }
+
+  // The size in bytes of a spilled probe record
+  uint32_t GetProbeRecordSize() const;
+
+  // Should the table spill its buffered entries?
+  bool IsOverMemoryBudget() const { return GetBufferedTupleMemoryUsage() > memory_budget_; }
+
+  // Append all buffered entries to the spilled build partitions and clear them.
+  void SpillBuildTuples();
+
+  // Split the given partition into the next level of partitions.
+  void RepartitionSpilled(SpilledPartition *partition);
+
+  // Build a table from the build side of the given partition.
+  void LoadSpilledPartition(SpilledPartition *partition);
+
+  // Take the spilled partitions of the source table after it spilled all its entries.
+  void MergeSpilled(JoinHashTable *source);
+
  private:
   // The execution context to run with.
   const exec::ExecutionSettings &exec_settings_;
@@ -261,6 +383,43 @@ class EXPORT JoinHashTable {
 
   // MemoryTracker
   common::ManagedPointer<MemoryTracker> tracker_;
+
+  // The size of spilled probe tuples, 0 if the table may not spill.
+  uint32_t probe_tuple_size_;
+
+  // The bytes of buffered entries above which the table spills, 0 if it never does.
+  uint64_t memory_budget_;
+
+  // Has the table spilled?
+  bool spilled_;
+
+  // The number of build tuples spilled.
+  uint64_t num_spilled_tuples_;
+
+  // The cache size that the directory ranges of a radix-partitioned merge are sized to fit, the L2
+  // cache size by default. 0 if unknown, which disables radix partitioning.
+  uint64_t radix_partition_cache_size_;
+
+  // The number of partitions the last parallel merge was radix-partitioned into, 0 if it wasn't.
+  uint32_t num_merge_partitions_;
+
+  // The top-level partitions while build and probe tuples are spilled.
+  std::vector<SpilledPartition> spilled_partitions_;
+
+  // To protect concurrent spilling of probe tuples into each top-level partition.
+  std::array<common::SpinLatch, NUM_SPILL_PARTITIONS> spilled_probe_latches_;
+
+  // The partitions not yet processed, the next one at the back.
+  std::vector<SpilledPartition> pending_partitions_;
+
+  // The probe tuples of the partition currently loaded, and the next one to return.
+  std::unique_ptr<SpillFile> current_probe_;
+  uint64_t current_probe_idx_;
+
+  // The block of probe records read ahead, and the index of its first record.
+  std::unique_ptr<byte[]> probe_block_;
+  uint64_t probe_block_begin_;
+  uint64_t probe_block_size_;
 };
 
 // ---------------------------------------------------------
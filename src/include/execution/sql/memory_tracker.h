@@ -6,14 +6,18 @@ namespace noisepage::execution::sql {
 
 /**
  * Class for tracking memory on a per-thread granularity.
- * Currently tracks allocation size in bytes during thread's execution.
+ * Currently tracks allocation size and the bytes spilled to disk during thread's execution.
  */
 class EXPORT MemoryTracker {
  public:
   /**
    * Reset tracker
    */
-  void Reset() { stats_.local().allocated_bytes_ = 0; }
+  void Reset() {
+    auto &stats = stats_.local();
+    stats.allocated_bytes_ = 0;
+    stats.spilled_bytes_ = 0;
+  }
 
   /**
    * @returns number of allocated bytes
@@ -32,6 +36,17 @@ class EXPORT MemoryTracker {
    */
   void Decrement(size_t size) { stats_.local().allocated_bytes_ -= size; }
 
+  /**
+   * @returns number of bytes spilled to disk
+   */
+  size_t GetSpilledSize() { return stats_.local().spilled_bytes_; }
+
+  /**
+   * Increments number of bytes spilled to disk
+   * @param size number to increment by
+   */
+  void IncrementSpilled(size_t size) { stats_.local().spilled_bytes_ += size; }
+
  private:
   /**
    * Struct to store per-thread tracking data.
@@ -39,6 +54,8 @@ class EXPORT MemoryTracker {
   struct Stats {
     // Number of bytes allocated
     size_t allocated_bytes_ = 0;
+    // Number of bytes spilled to disk
+    size_t spilled_bytes_ = 0;
   };
   tbb::enumerable_thread_specific<Stats> stats_;
 };
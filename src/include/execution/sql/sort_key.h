@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "common/macros.h"
+#include "execution/sql/sql.h"
+#include "execution/sql/value.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * Encodes SQL values into normalized sort keys: fixed-size byte strings whose lexicographic (i.e., memcmp()) order is
+ * the sort order of the values they encode. A Sorter whose tuples begin with such a key can compare tuples with a
+ * single memcmp() and radix sort them, only calling into the generated comparison function on ties.
+ *
+ * Every encoded value begins with a null byte, which is 0 for non-NULL values and 1 for NULLs, so that NULLs sort
+ * after all other values in ascending order and before them in descending order. The value's bytes follow in
+ * big-endian order with the sign bit flipped. Descending keys invert every byte of their encoding.
+ *
+ * Strings are encoded as a zero-padded prefix of STRING_PREFIX_SIZE bytes. Two different strings may share a key, so a
+ * string must be the last value encoded into a key; the comparison function breaks such ties.
+ */
+class SortKey {
+ public:
+  /** The number of bytes of a string encoded into a key. */
+  static constexpr uint32_t STRING_PREFIX_SIZE = 16;
+
+  /**
+   * @param type The SQL type of a sort key.
+   * @return The number of key bytes values of the given type are encoded into, or 0 if the type cannot be encoded.
+   */
+  static constexpr uint32_t EncodedSize(TypeId type) {
+    switch (type) {
+      case TypeId::Boolean:
+        return 1 + sizeof(uint8_t);
+      case TypeId::TinyInt:
+      case TypeId::SmallInt:
+      case TypeId::Integer:
+      case TypeId::BigInt:
+        return 1 + sizeof(int64_t);
+      case TypeId::Float:
+      case TypeId::Double:
+        return 1 + sizeof(double);
+      case TypeId::Date:
+        return 1 + sizeof(uint32_t);
+      case TypeId::Timestamp:
+        return 1 + sizeof(uint64_t);
+      case TypeId::Varchar:
+      case TypeId::Varbinary:
+        return 1 + STRING_PREFIX_SIZE;
+      default:
+        return 0;
+    }
+  }
+
+  /**
+   * @param type The SQL type of a sort key.
+   * @return True if the key of the given type is truncated, and no other value can be encoded after it.
+   */
+  static constexpr bool IsTruncated(TypeId type) { return type == TypeId::Varchar || type == TypeId::Varbinary; }
+
+  /**
+   * Encode a boolean into EncodedSize(TypeId::Boolean) bytes at @em dst.
+   */
+  static void WriteBool(byte *dst, const BoolVal &val, bool descending) {
+    dst[1] = static_cast<byte>(val.is_null_ ? 0 : static_cast<uint8_t>(val.val_));
+    Finish(dst, EncodedSize(TypeId::Boolean), val.is_null_, descending);
+  }
+
+  /**
+   * Encode an integer into EncodedSize(TypeId::BigInt) bytes at @em dst.
+   */
+  static void WriteInteger(byte *dst, const Integer &val, bool descending) {
+    WriteBigEndian(dst + 1, val.is_null_ ? 0 : FlipSign(static_cast<uint64_t>(val.val_)));
+    Finish(dst, EncodedSize(TypeId::BigInt), val.is_null_, descending);
+  }
+
+  /**
+   * Encode a real into EncodedSize(TypeId::Double) bytes at @em dst.
+   */
+  static void WriteReal(byte *dst, const Real &val, bool descending) {
+    uint64_t bits = 0;
+    if (!val.is_null_) {
+      // Normalize -0.0 to 0.0 so that both share a key, as they compare equal
+      const double d = val.val_ == 0.0 ? 0.0 : val.val_;
+      std::memcpy(&bits, &d, sizeof(bits));
+      // Positive numbers only need their sign bit set; negative numbers must also reverse their magnitude
+      bits = (bits & SIGN_BIT) != 0 ? ~bits : bits | SIGN_BIT;
+    }
+    WriteBigEndian(dst + 1, bits);
+    Finish(dst, EncodedSize(TypeId::Double), val.is_null_, descending);
+  }
+
+  /**
+   * Encode a date into EncodedSize(TypeId::Date) bytes at @em dst.
+   */
+  static void WriteDate(byte *dst, const DateVal &val, bool descending) {
+    const auto native = val.is_null_ ? 0 : static_cast<uint32_t>(val.val_.ToNative());
+    WriteBigEndian(dst + 1, val.is_null_ ? 0 : native ^ (uint32_t{1} << 31u));
+    Finish(dst, EncodedSize(TypeId::Date), val.is_null_, descending);
+  }
+
+  /**
+   * Encode a timestamp into EncodedSize(TypeId::Timestamp) bytes at @em dst.
+   */
+  static void WriteTimestamp(byte *dst, const TimestampVal &val, bool descending) {
+    WriteBigEndian(dst + 1, val.is_null_ ? 0 : val.val_.ToNative());
+    Finish(dst, EncodedSize(TypeId::Timestamp), val.is_null_, descending);
+  }
+
+  /**
+   * Encode the prefix of a string into EncodedSize(TypeId::Varchar) bytes at @em dst.
+   */
+  static void WriteString(byte *dst, const StringVal &val, bool descending) {
+    std::memset(dst + 1, 0, STRING_PREFIX_SIZE);
+    if (!val.is_null_) {
+      std::memcpy(dst + 1, val.val_.Content(), std::min(val.val_.Size(), STRING_PREFIX_SIZE));
+    }
+    Finish(dst, EncodedSize(TypeId::Varchar), val.is_null_, descending);
+  }
+
+ private:
+  static constexpr uint64_t SIGN_BIT = uint64_t{1} << 63u;
+
+  static constexpr uint64_t FlipSign(uint64_t val) { return val ^ SIGN_BIT; }
+
+  template <typename T>
+  static void WriteBigEndian(byte *dst, T val) {
+    for (uint32_t i = 0; i < sizeof(T); i++) {
+      dst[i] = static_cast<byte>(val >> (8 * (sizeof(T) - 1 - i)));
+    }
+  }
+
+  static void Finish(byte *dst, uint32_t size, bool is_null, bool descending) {
+    dst[0] = static_cast<byte>(is_null ? 1 : 0);
+    if (descending) {
+      for (uint32_t i = 0; i < size; i++) {
+        dst[i] = static_cast<byte>(~static_cast<uint8_t>(dst[i]));
+      }
+    }
+  }
+};
+
+}  // namespace noisepage::execution::sql
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/constants.h"
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/util/chunked_vector.h"
@@ -15,6 +17,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SpillFile;
 class ThreadStateContainer;
 class VectorProjection;
 class VectorProjectionIterator;
@@ -67,6 +70,17 @@ class VectorProjectionIterator;
  * thread-local Sorter, but <b>without calling</b> Sorter::Sort(). When all insertions are complete
  * across all threads, the primary thread uses Sorter::SortParallel() or Sorter::SortTopKParallel()
  * for parallel sort and parallel Top-K, respectively.
+ *
+ * Sorters optionally support normalized keys. If a Sorter is instantiated with a non-zero key size,
+ * every tuple must begin with a key of that many bytes whose memcmp() order agrees with the
+ * comparison function, e.g., as written by SortKey. Tuples are then radix sorted on their keys and
+ * compared with memcmp(), falling back to the comparison function only when two keys are equal.
+ *
+ * Sorters spill to disk when the execution settings give sorts a memory budget. Once the tuples a
+ * Sorter buffered in memory take up more than the budget, the Sorter sorts them and writes them out
+ * as a run into a SpillFile. Sorter::Sort() only sorts
+ * the tuples still in memory; iterators merge them with all spilled runs as they go. Top-K never
+ * spills, since it only retains K tuples.
  */
 class EXPORT Sorter {
  public:
@@ -96,14 +110,39 @@ class EXPORT Sorter {
    */
   using ComparisonFunction = int32_t (*)(const void *lhs, const void *rhs);
 
+  /**
+   * Minimum number of tuples in a range before radix sorting it on the next byte of the normalized
+   * key. Smaller ranges are sorted by comparison.
+   */
+  static constexpr uint64_t MIN_TUPLES_FOR_RADIX_SORT = 64;
+
+  /**
+   * Number of tuple insertions between two checks of the memory budget.
+   */
+  static constexpr uint64_t SPILL_CHECK_INTERVAL = 256;
+
+  /**
+   * Minimum number of tuples buffered in memory before spilling them to a run. This bounds the
+   * number of runs when the budget is smaller than a few tuples.
+   */
+  static constexpr uint64_t MIN_TUPLES_PER_SPILLED_RUN = 1024;
+
+  /**
+   * The size in bytes of the blocks spilled runs are written in, and read ahead in while merging.
+   * Larger than a SpillFile's default, since a merge reads from every run at once.
+   */
+  static constexpr uint64_t SPILLED_RUN_BLOCK_SIZE = 256 * common::Constants::KB;
+
   /**
    * Construct a sorter using @em memory as the memory allocator, storing tuples @em tuple_size
    * size in bytes, and using the comparison function @em cmp_fn.
    * @param exec_ctx The ExecutionContext used for executing the query
    * @param cmp_fn The sorting comparison function
    * @param tuple_size The sizes of the input tuples in bytes
+   * @param key_size The size in bytes of the normalized key at the start of each tuple, or 0 if
+   *                 tuples have no normalized key
    */
-  Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint32_t tuple_size);
+  Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint32_t tuple_size, uint32_t key_size = 0);
 
   /**
    * Destructor.
@@ -168,7 +207,7 @@ class EXPORT Sorter {
   /**
    * @return The number of tuples currently in this sorter.
    */
-  uint64_t GetTupleCount() const noexcept { return tuples_.size(); }
+  uint64_t GetTupleCount() const noexcept { return tuples_.size() + num_spilled_tuples_; }
 
   /**
    * @return True if this sorter contains no tuples; false otherwise.
@@ -180,7 +219,50 @@ class EXPORT Sorter {
    */
   bool IsSorted() const noexcept { return sorted_; }
 
+  /**
+   * @return The size in bytes of the normalized key at the start of each tuple; 0 if there is none.
+   */
+  uint32_t GetKeySize() const noexcept { return key_size_; }
+
+  /**
+   * @return The number of sorted runs this sorter spilled to disk.
+   */
+  uint64_t GetSpilledRunCount() const noexcept { return spilled_runs_.size(); }
+
  private:
+  // Compare two tuples, first on their normalized keys starting at byte 'depth', then using the
+  // comparison function
+  int32_t Compare(const byte *left, const byte *right, uint32_t depth = 0) const {
+    if (depth < key_size_) {
+      if (const int32_t result = std::memcmp(left + depth, right + depth, key_size_ - depth); result != 0) {
+        return result;
+      }
+    }
+    return cmp_fn_(left, right);
+  }
+
+  // MSD radix sort the 'n' tuples in 'tuples' whose keys agree on the first 'depth' bytes, using
+  // 'scratch' as a temporary buffer of the same size
+  void RadixSort(const byte **tuples, const byte **scratch, uint64_t n, uint32_t depth) const;
+
+  // Sort the tuples buffered in memory
+  void SortInMemory();
+
+  // Memory taken up by the tuples buffered in memory and by the pointers to them
+  uint64_t GetBufferedTupleMemoryUsage() const {
+    return tuple_storage_.size() * tuple_storage_.ElementSize() + tuples_.capacity() * sizeof(const byte *);
+  }
+
+  // Do the tuples buffered in memory take up more than the sorter's budget?
+  bool IsOverMemoryBudget() const { return GetBufferedTupleMemoryUsage() > memory_budget_; }
+
+  // Sort the tuples buffered in memory, write them out as a new spilled run and release their memory
+  void SpillRun();
+
+  // Finish a parallel sort where some thread-local sorters spilled: every thread-local sorter spills
+  // what it has left in parallel, and this sorter takes ownership of all runs
+  void SortParallelSpilled(ThreadStateContainer *thread_state_container, const std::vector<Sorter *> &tl_sorters);
+
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
 
@@ -189,6 +271,7 @@ class EXPORT Sorter {
   void HeapSiftDown();
 
  private:
+  friend class SortRunMerger;
   friend class SorterIterator;
   friend class SorterVectorIterator;
 
@@ -205,13 +288,111 @@ class EXPORT Sorter {
   // The function used to compare two tuples
   ComparisonFunction cmp_fn_;
 
+  // The size of the normalized key prefixing each tuple, or 0 if there is none
+  uint32_t key_size_;
+
   // Vector of pointers to each entry. This is the vector that's sorted.
   MemPoolVector<const byte *> tuples_;
 
+  // The number of bytes the tuples buffered in memory may take up before spilling, or 0 to never spill
+  uint64_t memory_budget_;
+
+  // The sorted runs spilled to disk, and the total number of tuples in them
+  std::vector<std::unique_ptr<SpillFile>> spilled_runs_;
+  uint64_t num_spilled_tuples_;
+
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
 };
 
+/**
+ * Merges the runs a sorter spilled to disk with the tuples it kept in memory, producing all of its
+ * tuples in order. Runs are read ahead one Sorter::SPILLED_RUN_BLOCK_SIZE block at a time. Rows read from runs
+ * are copied into an output buffer, so that a row remains valid for K_DEFAULT_VECTOR_SIZE - 1
+ * further calls to Next(), as SorterVectorIterator requires.
+ */
+class SortRunMerger {
+ public:
+  /**
+   * Create a merger over all tuples in the given sorted sorter.
+   * @param sorter The sorter instance.
+   */
+  explicit SortRunMerger(const Sorter &sorter);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SortRunMerger);
+
+  /**
+   * Destructor.
+   */
+  ~SortRunMerger();
+
+  /**
+   * @return True if the merger has more rows; false otherwise.
+   */
+  bool HasNext() const { return num_remaining_ > 0; }
+
+  /**
+   * Advance to the next row in sort order.
+   */
+  void Next();
+
+  /**
+   * @return The number of rows remaining, including the current one.
+   */
+  uint64_t NumRemaining() const { return num_remaining_; }
+
+  /**
+   * @return A pointer to the current row.
+   */
+  const byte *GetRow() const { return current_; }
+
+ private:
+  // A sorted input of the merge: a spilled run or the sorter's in-memory tuples
+  struct Input {
+    // The spilled run, or null for the in-memory tuples
+    const SpillFile *run_{nullptr};
+    // The block of the run read ahead, and the index in the run of the tuple following it
+    std::unique_ptr<byte[]> block_;
+    uint64_t next_in_run_{0};
+    // The remaining in-memory tuples, or tuples in the block
+    const byte *const *mem_pos_{nullptr};
+    const byte *const *mem_end_{nullptr};
+    const byte *block_pos_{nullptr};
+    const byte *block_end_{nullptr};
+  };
+
+  // The smallest tuple remaining in the given input
+  const byte *Head(const Input &input) const { return input.run_ == nullptr ? *input.mem_pos_ : input.block_pos_; }
+
+  // Does the head of input 'l' sort after the head of input 'r'? This orders 'heap_' as a min-heap.
+  bool HeadGreater(uint32_t l, uint32_t r) const { return sorter_.Compare(Head(inputs_[l]), Head(inputs_[r])) > 0; }
+
+  // Advance the given input past its head; return false if the input is exhausted
+  bool Advance(Input *input) const;
+
+  // Remove the smallest tuple among all inputs, and make it the current row
+  void PopSmallest();
+
+ private:
+  // The merged sorter
+  const Sorter &sorter_;
+  // The size of each tuple
+  uint32_t tuple_size_;
+  // All non-empty inputs
+  std::vector<Input> inputs_;
+  // The indexes of the non-exhausted inputs, as a min-heap on their heads
+  std::vector<uint32_t> heap_;
+  // The ring buffer rows read from runs are copied into, and the slot the next row goes into
+  std::unique_ptr<byte[]> output_;
+  uint32_t output_slot_;
+  // The current row, and the number of rows remaining including it
+  const byte *current_;
+  uint64_t num_remaining_;
+};
+
 /**
  * An iterator over the elements in a sorter instance.
  */
@@ -225,15 +406,26 @@ class SorterIterator {
    */
   explicit SorterIterator(const Sorter &sorter);
 
+  /**
+   * Destructor.
+   */
+  ~SorterIterator();
+
   /**
    * @return True if the iterator has more data; false otherwise.
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return merger_ == nullptr ? iter_ != end_ : merger_->HasNext(); }
 
   /**
    * Advance the iterator by one tuple.
    */
-  void Next() { ++iter_; }
+  void Next() {
+    if (merger_ == nullptr) {
+      ++iter_;
+    } else {
+      merger_->Next();
+    }
+  }
 
   /**
    * Advance the iterator by @em n rows. If there are fewer than @em n rows remaining in this
@@ -245,14 +437,14 @@ class SorterIterator {
   /**
    * @return The number of tuples remaining in the iterator.
    */
-  uint64_t NumRemaining() const { return std::distance(iter_, end_); }
+  uint64_t NumRemaining() const { return merger_ == nullptr ? std::distance(iter_, end_) : merger_->NumRemaining(); }
 
   /**
    * @return A pointer to the current row. It assumed the called has checked the iterator is valid.
    */
   const byte *GetRow() const {
-    NOISEPAGE_ASSERT(iter_ != end_, "Invalid iterator");
-    return *iter_;
+    NOISEPAGE_ASSERT(HasNext(), "Invalid iterator");
+    return merger_ == nullptr ? *iter_ : merger_->GetRow();
   }
 
   /**
@@ -286,6 +478,8 @@ class SorterIterator {
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+  // The merger over the sorter's spilled runs and in-memory tuples, if the sorter spilled
+  std::unique_ptr<SortRunMerger> merger_;
 };
 
 /**
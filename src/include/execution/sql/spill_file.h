@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "execution/sql/sql.h"
+#include "execution/util/file.h"
+
+namespace noisepage::execution::sql {
+
+class MemoryTracker;
+
+/**
+ * An append-only temporary file of fixed-size records that operators, i.e., sorts and hash joins, spill into after
+ * exceeding their memory budget. Records are appended into an in-memory block that is written out whenever it fills
+ * up, and read back in blocks once Finish() has been called. The file is only created when the first block is written,
+ * and is unlinked as soon as it is created, so that its space is reclaimed when the spill file is destroyed.
+ *
+ * Records are written verbatim. Out-of-line data they point to, e.g., the contents of long strings, is not spilled and
+ * must outlive the file.
+ *
+ * If a memory tracker is provided, the bytes written out are counted as spilled by the writing thread, so that they
+ * show up in the metrics of the pipeline that spilled them.
+ */
+class SpillFile {
+ public:
+  /** The default size in bytes of the blocks records are written and read in. */
+  static constexpr uint64_t BLOCK_SIZE = 64 * common::Constants::KB;
+
+  /**
+   * Create an empty spill file.
+   * @param record_size The size of each record in bytes.
+   * @param tracker The tracker to count the bytes written out in, if any.
+   * @param block_size The size in bytes of the blocks records are written and read in.
+   */
+  explicit SpillFile(uint32_t record_size, common::ManagedPointer<MemoryTracker> tracker = nullptr,
+                     uint64_t block_size = BLOCK_SIZE);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Allocate space for a new record at the end of the file.
+   * @return A buffer of GetRecordSize() bytes to write the record into, valid until the next call to Append().
+   * @throw ExecutionException If a full block could not be written out, e.g., because the disk is full.
+   */
+  byte *Append() {
+    if (num_buffered_ == GetRecordsPerBlock()) {
+      FlushBlock();
+    }
+    if (buffer_ == nullptr) {
+      buffer_ = std::make_unique<byte[]>(GetRecordsPerBlock() * record_size_);
+    }
+    num_records_++;
+    return buffer_.get() + record_size_ * num_buffered_++;
+  }
+
+  /**
+   * Write out all buffered records and release the write buffer. No records may be appended afterwards.
+   * @throw ExecutionException If the records could not be written.
+   */
+  void Finish();
+
+  /**
+   * @return The number of records in the file.
+   */
+  uint64_t GetRecordCount() const noexcept { return num_records_; }
+
+  /**
+   * @return The size of each record in bytes.
+   */
+  uint32_t GetRecordSize() const noexcept { return record_size_; }
+
+  /**
+   * @return The number of records in a block.
+   */
+  uint64_t GetRecordsPerBlock() const noexcept { return std::max(uint64_t{1}, block_size_ / record_size_); }
+
+  /**
+   * Read at most one block's worth of records into @em buffer, starting from the record at index @em first.
+   * @pre Finish() has been called.
+   * @param first The index of the first record to read.
+   * @param[out] buffer The buffer to read into, with room for GetRecordsPerBlock() records.
+   * @return The number of records read; 0 if @em first is past the end of the file.
+   * @throw ExecutionException If the file could not be read.
+   */
+  uint64_t ReadBlock(uint64_t first, byte *buffer) const;
+
+ private:
+  // Write the buffered records to the end of the file
+  void FlushBlock();
+
+ private:
+  // The temporary file, created lazily
+  util::File file_;
+  // The tracker to count written bytes in, if any
+  common::ManagedPointer<MemoryTracker> tracker_;
+  // The size of each record, and of the blocks they are written and read in
+  uint32_t record_size_;
+  uint64_t block_size_;
+  // The number of records appended, including buffered ones
+  uint64_t num_records_;
+  // The block records are appended into
+  std::unique_ptr<byte[]> buffer_;
+  // The number of records in the block
+  uint64_t num_buffered_;
+};
+
+}  // namespace noisepage::execution::sql
@@ -353,7 +353,8 @@ class BytecodeEmitter {
                                                FunctionId scan_part_fn);
 
   /** Initialize a sorter instance. */
-  void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn, LocalVar tuple_size);
+  void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn, LocalVar tuple_size,
+                      LocalVar key_size);
 
   /** Initialize a CSV reader. */
   // void EmitCSVReaderInit(LocalVar creader, LocalVar file_name, uint32_t file_name_len);
@@ -49,9 +49,11 @@ class BytecodeGenerator final : public ast::AstVisitor<BytecodeGenerator> {
    * Main entry point to convert a valid (i.e., parsed and type-checked) AST into a bytecode module.
    * @param root The root of the AST.
    * @param name The (optional) name of the program.
+   * @param fuse_superinstructions True if frequent bytecode pairs should be fused into superinstructions.
    * @return A compiled bytecode module.
    */
-  static std::unique_ptr<BytecodeModule> Compile(ast::AstNode *root, const std::string &name);
+  static std::unique_ptr<BytecodeModule> Compile(ast::AstNode *root, const std::string &name,
+                                                 bool fuse_superinstructions = true);
 
   /**
    * @return The emitter used by this generator to write bytecode.
@@ -97,6 +99,7 @@ class BytecodeGenerator final : public ast::AstVisitor<BytecodeGenerator> {
   void VisitBuiltinJoinHashTableIteratorCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinSorterIterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinSortKeyWriteCall(ast::CallExpr *call);
   void VisitResultBufferCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitCSVReaderCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitExecutionContextCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -20,6 +20,7 @@
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/join_hash_table.h"
 #include "execution/sql/operators/hash_operators.h"
+#include "execution/sql/sort_key.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/sql_def.h"
 #include "execution/sql/storage_interface.h"
@@ -1352,7 +1353,8 @@ GEN_BINARY_AGGREGATE(TimestampVal, TimestampHistogramAggregate);
 // ---------------------------------------------------------
 
 VM_OP void OpJoinHashTableInit(noisepage::execution::sql::JoinHashTable *join_hash_table,
-                               noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t tuple_size);
+                               noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t tuple_size,
+                               uint32_t probe_tuple_size);
 
 VM_OP_HOT void OpJoinHashTableAllocTuple(noisepage::byte **result,
                                          noisepage::execution::sql::JoinHashTable *join_hash_table,
@@ -1377,6 +1379,18 @@ VM_OP_HOT void OpJoinHashTableLookup(noisepage::execution::sql::JoinHashTable *j
   *ht_entry_iter = join_hash_table->Lookup<false>(hash_val);
 }
 
+VM_OP_HOT void OpJoinHashTableIsSpilled(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  *result = join_hash_table->IsSpilled();
+}
+
+VM_OP void OpJoinHashTableSpillProbe(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                     const noisepage::hash_t hash_val, const noisepage::byte *probe_tuple);
+
+VM_OP void OpJoinHashTableNextPartition(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP void OpJoinHashTableNextSpilledProbe(const noisepage::byte **result,
+                                           noisepage::execution::sql::JoinHashTable *join_hash_table);
+
 VM_OP void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table);
 
 VM_OP_HOT void OpHashTableEntryIteratorHasNext(bool *has_next,
@@ -1411,7 +1425,8 @@ VM_OP void OpJoinHashTableIteratorFree(noisepage::execution::sql::JoinHashTableI
 
 VM_OP void OpSorterInit(noisepage::execution::sql::Sorter *sorter,
                         noisepage::execution::exec::ExecutionContext *exec_ctx,
-                        noisepage::execution::sql::Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size);
+                        noisepage::execution::sql::Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size,
+                        uint32_t key_size);
 
 VM_OP_HOT void OpSorterGetTupleCount(uint32_t *result, noisepage::execution::sql::Sorter *sorter) {
   *result = sorter->GetTupleCount();
@@ -1459,6 +1474,37 @@ VM_OP_WARM void OpSorterIteratorSkipRows(noisepage::execution::sql::SorterIterat
   iter->AdvanceBy(n);
 }
 
+VM_OP_HOT void OpSortKeyWriteBool(noisepage::byte *key, const noisepage::execution::sql::BoolVal *const input,
+                                  const bool descending) {
+  noisepage::execution::sql::SortKey::WriteBool(key, *input, descending);
+}
+
+VM_OP_HOT void OpSortKeyWriteInteger(noisepage::byte *key, const noisepage::execution::sql::Integer *const input,
+                                     const bool descending) {
+  noisepage::execution::sql::SortKey::WriteInteger(key, *input, descending);
+}
+
+VM_OP_HOT void OpSortKeyWriteReal(noisepage::byte *key, const noisepage::execution::sql::Real *const input,
+                                  const bool descending) {
+  noisepage::execution::sql::SortKey::WriteReal(key, *input, descending);
+}
+
+VM_OP_HOT void OpSortKeyWriteDate(noisepage::byte *key, const noisepage::execution::sql::DateVal *const input,
+                                  const bool descending) {
+  noisepage::execution::sql::SortKey::WriteDate(key, *input, descending);
+}
+
+VM_OP_HOT void OpSortKeyWriteTimestamp(noisepage::byte *key,
+                                       const noisepage::execution::sql::TimestampVal *const input,
+                                       const bool descending) {
+  noisepage::execution::sql::SortKey::WriteTimestamp(key, *input, descending);
+}
+
+VM_OP_HOT void OpSortKeyWriteString(noisepage::byte *key, const noisepage::execution::sql::StringVal *const input,
+                                    const bool descending) {
+  noisepage::execution::sql::SortKey::WriteString(key, *input, descending);
+}
+
 VM_OP void OpSorterIteratorFree(noisepage::execution::sql::SorterIterator *iter);
 
 // ---------------------------------------------------------
@@ -43,10 +43,16 @@ class BytecodeIterator {
   explicit BytecodeIterator(const std::vector<uint8_t> &bytecode);
 
   /**
-   * @return The current bytecode instruction.
+   * @return The current bytecode instruction. For a superinstruction, this is the first bytecode it fuses; the second
+   *         one follows as the next instruction.
    */
   Bytecode CurrentBytecode() const;
 
+  /**
+   * @return True if the current bytecode was fused with the next one into a superinstruction.
+   */
+  bool IsSuperinstruction() const;
+
   /**
    * @return True if iteration is complete; false otherwise.
    */
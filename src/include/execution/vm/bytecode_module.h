@@ -84,6 +84,11 @@ class BytecodeModule {
    */
   std::size_t GetInstructionCount() const;
 
+  /**
+   * @return The size of the bytecode and static data in this module, in bytes.
+   */
+  std::size_t GetCodeSize() const { return code_.size() + data_.size(); }
+
   /**
    * @return The name of the module.
    */
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/vm/bytecodes.h"
+#include "execution/vm/superinstructions.h"
+
+namespace noisepage::execution::vm {
+
+/**
+ * Counts how often each pair of bytecodes executes back-to-back in the interpreter, across all threads. The most
+ * frequent pairs are the candidates for new superinstructions.
+ *
+ * The interpreter only reports to the profiler in builds with NOISEPAGE_PROFILE_BYTECODE_PAIRS defined, since doing
+ * so sits on its dispatch path. Superinstructions are counted as the two bytecodes they fuse, so profiles are the same
+ * whether or not bytecode was fused.
+ */
+class BytecodePairProfiler {
+ public:
+  /** Raw opcode standing in for "no previous bytecode", e.g., at the start of a function. */
+  static constexpr const std::underlying_type_t<Bytecode> NO_BYTECODE =
+      std::numeric_limits<std::underlying_type_t<Bytecode>>::max();
+
+  /** The number of executions of a pair of bytecodes. */
+  struct PairCount {
+    /** The bytecode executed first. */
+    Bytecode first_;
+    /** The bytecode executed right after the first. */
+    Bytecode second_;
+    /** The number of times the pair executed. */
+    uint64_t count_;
+  };
+
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(BytecodePairProfiler);
+
+  /**
+   * @return True if the interpreter was built to report to the profiler.
+   */
+  static constexpr bool IsEnabled() {
+#ifdef NOISEPAGE_PROFILE_BYTECODE_PAIRS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @return The process-wide profiler.
+   */
+  static BytecodePairProfiler *Instance();
+
+  /**
+   * Record the execution of an opcode.
+   * @param prev The last bytecode executed before, or NO_BYTECODE.
+   * @param curr The raw opcode executed, which may be a superinstruction.
+   * @return The last bytecode executed by @em curr, to pass as @em prev with the next opcode.
+   */
+  std::underlying_type_t<Bytecode> Record(std::underlying_type_t<Bytecode> prev,
+                                          std::underlying_type_t<Bytecode> curr) {
+    if (Superinstructions::IsSuperinstruction(curr)) {
+      const auto superinstruction = Superinstructions::FromByte(curr);
+      const auto first = Bytecodes::ToByte(Superinstructions::GetFirst(superinstruction));
+      const auto second = Bytecodes::ToByte(Superinstructions::GetSecond(superinstruction));
+      Count(prev, first);
+      Count(first, second);
+      return second;
+    }
+    Count(prev, curr);
+    return curr;
+  }
+
+  /**
+   * @param n The maximum number of pairs to return.
+   * @return The @em n most frequently executed pairs, most frequent first.
+   */
+  std::vector<PairCount> GetTopPairs(std::size_t n) const;
+
+  /**
+   * Print the @em n most frequently executed pairs, marking those that already have a superinstruction.
+   * @param os The stream to print into.
+   * @param n The maximum number of pairs to print.
+   */
+  void Dump(std::ostream &os, std::size_t n) const;
+
+  /** Reset all counts to zero. */
+  void Reset();
+
+ private:
+  BytecodePairProfiler();
+
+  void Count(std::underlying_type_t<Bytecode> first, std::underlying_type_t<Bytecode> second) {
+    if (first != NO_BYTECODE) {
+      counts_[first * Bytecodes::NumBytecodes() + second].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // A dense NumBytecodes() x NumBytecodes() matrix of counts
+  std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+};
+
+}  // namespace noisepage::execution::vm
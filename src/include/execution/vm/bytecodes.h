@@ -555,12 +555,16 @@ namespace noisepage::execution::vm {
   F(TimestampHistogramAggregateFree, OperandType::Local)                                                              \
                                                                                                                       \
   /* Hash Joins */                                                                                                    \
-  F(JoinHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local)                                    \
+  F(JoinHashTableInit, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                \
   F(JoinHashTableAllocTuple, OperandType::Local, OperandType::Local, OperandType::Local)                              \
   F(JoinHashTableGetTupleCount, OperandType::Local, OperandType::Local)                                               \
   F(JoinHashTableBuild, OperandType::Local)                                                                           \
   F(JoinHashTableBuildParallel, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(JoinHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local)                                  \
+  F(JoinHashTableIsSpilled, OperandType::Local, OperandType::Local)                                                   \
+  F(JoinHashTableSpillProbe, OperandType::Local, OperandType::Local, OperandType::Local)                              \
+  F(JoinHashTableNextPartition, OperandType::Local, OperandType::Local)                                               \
+  F(JoinHashTableNextSpilledProbe, OperandType::Local, OperandType::Local)                                            \
   F(JoinHashTableFree, OperandType::Local)                                                                            \
   F(HashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)                                            \
   F(HashTableEntryIteratorGetRow, OperandType::Local, OperandType::Local)                                             \
@@ -571,7 +575,8 @@ namespace noisepage::execution::vm {
   F(JoinHashTableIteratorFree, OperandType::Local)                                                                    \
                                                                                                                       \
   /* Sorting */                                                                                                       \
-  F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local)                  \
+  F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local,                  \
+    OperandType::Local)                                                                                               \
   F(SorterGetTupleCount, OperandType::Local, OperandType::Local)                                                      \
   F(SorterAllocTuple, OperandType::Local, OperandType::Local)                                                         \
   F(SorterAllocTupleTopK, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
@@ -586,6 +591,12 @@ namespace noisepage::execution::vm {
   F(SorterIteratorNext, OperandType::Local)                                                                           \
   F(SorterIteratorSkipRows, OperandType::Local, OperandType::Local)                                                   \
   F(SorterIteratorFree, OperandType::Local)                                                                           \
+  F(SortKeyWriteBool, OperandType::Local, OperandType::Local, OperandType::Local)                                     \
+  F(SortKeyWriteInteger, OperandType::Local, OperandType::Local, OperandType::Local)                                  \
+  F(SortKeyWriteReal, OperandType::Local, OperandType::Local, OperandType::Local)                                     \
+  F(SortKeyWriteDate, OperandType::Local, OperandType::Local, OperandType::Local)                                     \
+  F(SortKeyWriteTimestamp, OperandType::Local, OperandType::Local, OperandType::Local)                                \
+  F(SortKeyWriteString, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
                                                                                                                       \
   /* Output */                                                                                                        \
   F(ResultBufferNew, OperandType::Local, OperandType::Local)                                                          \
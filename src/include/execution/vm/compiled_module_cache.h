@@ -0,0 +1,107 @@
+#pragma once
+
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+
+#include "common/macros.h"
+
+namespace noisepage::execution::vm {
+
+/**
+ * A persistent, content-addressed cache of the object code that the LLVM engine generates for TPL bytecode modules.
+ *
+ * Each entry is a single object file named after its key in the cache directory. Keys are digests over both the
+ * contents of the bytecode module and the engine fingerprint provided at construction (LLVM version, target triple,
+ * CPU and its features, and the bytecode handlers), so an entry is only ever reused by an engine that would generate
+ * the exact same machine code for it. Entries are published atomically, which makes the directory safe to share across
+ * threads and processes.
+ *
+ * The total size of the directory is bounded. When an insertion pushes the directory over the limit, entries are
+ * evicted in least-recently-used order; reads refresh the modification time of an entry to track its recency.
+ */
+class CompiledModuleCache {
+ public:
+  /** File extension of the object files stored in the cache. */
+  static constexpr const char *OBJECT_FILE_EXTENSION = ".o";
+  /** File extension of the files that entries are written to before they are published. */
+  static constexpr const char *TEMP_FILE_EXTENSION = ".tmp";
+
+  /**
+   * Create a cache over the given directory, creating the directory if it does not exist yet. Entries left behind by
+   * previous runs are kept, and evicted if they exceed the size limit. Temporary files of crashed writers are removed.
+   * @param directory The directory holding the cached object files.
+   * @param size_limit The maximum total size of the cached object files, in bytes.
+   * @param engine_fingerprint A description of everything outside of the bytecode module that affects code generation.
+   */
+  CompiledModuleCache(std::string directory, uint64_t size_limit, std::string engine_fingerprint);
+
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(CompiledModuleCache);
+
+  /**
+   * Look up the object code stored under the given key.
+   * @param key The key of the module.
+   * @return The object code, or nullptr if it is not cached.
+   */
+  std::unique_ptr<llvm::MemoryBuffer> Lookup(const std::string &key);
+
+  /**
+   * Store object code under the given key, replacing any existing entry, and evict entries if the cache grew too big.
+   * Failures to write are logged and otherwise ignored; the cache is only an optimization.
+   * @param key The key of the module.
+   * @param object_code The object code generated for the module.
+   */
+  void Insert(const std::string &key, const llvm::MemoryBuffer &object_code);
+
+  /** Remove all entries from the cache. */
+  void Clear();
+
+  /** @return The fingerprint of the engine that all keys of this cache are derived from. */
+  const std::string &GetEngineFingerprint() const { return engine_fingerprint_; }
+
+  /** @return The directory holding the cached object files. */
+  const std::string &GetDirectory() const { return directory_; }
+
+  /** @return The maximum total size of the cached object files, in bytes. */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+  /** @return The total size of the cached object files, in bytes, as last observed by this process. */
+  uint64_t GetSize() const { return size_.load(std::memory_order_relaxed); }
+
+  /** @return The number of lookups that found an entry. */
+  uint64_t GetNumHits() const { return num_hits_.load(std::memory_order_relaxed); }
+
+  /** @return The number of lookups that did not find an entry. */
+  uint64_t GetNumMisses() const { return num_misses_.load(std::memory_order_relaxed); }
+
+  /** @return The number of entries evicted, either to stay within the size limit or by Clear(). */
+  uint64_t GetNumEvictions() const { return num_evictions_.load(std::memory_order_relaxed); }
+
+ private:
+  // The path of the object file for the given key
+  std::string GetEntryPath(const std::string &key) const;
+
+  // Rescan the directory, remove stale temporary files and evict the least recently used entries until the cache fits
+  // within the given size. Must be called with the latch held.
+  void EvictUntil(uint64_t target_size);
+
+  const std::string directory_;
+  const uint64_t size_limit_;
+  const std::string engine_fingerprint_;
+
+  // Serializes evictions and clears. Lookups and insertions of single entries rely on atomic renames instead.
+  std::mutex latch_;
+
+  std::atomic<uint64_t> size_{0};
+  std::atomic<uint64_t> num_hits_{0};
+  std::atomic<uint64_t> num_misses_{0};
+  std::atomic<uint64_t> num_evictions_{0};
+  std::atomic<uint64_t> num_temp_files_{0};
+};
+
+}  // namespace noisepage::execution::vm
@@ -2,6 +2,7 @@
 
 #include <llvm/Support/MemoryBuffer.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -9,6 +10,8 @@
 
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
+#include "execution/vm/compiled_module_cache.h"
+#include "execution/vm/vm_defs.h"
 
 namespace noisepage::execution::ast {
 class Type;
@@ -65,6 +68,11 @@ class LLVMEngine {
    */
   static const Settings *GetEngineSettings();
 
+  /**
+   * @return The on-disk cache of compiled modules, or nullptr if the engine was configured without one.
+   */
+  static CompiledModuleCache *GetCompiledModuleCache();
+
   // -------------------------------------------------------
   // Compiler Options
   // -------------------------------------------------------
@@ -125,10 +133,27 @@ class LLVMEngine {
      */
     const std::string &GetOutputObjectFileName() const { return output_file_name_; }
 
+    /**
+     * Set the tier of machine code to generate
+     * @param tier Either CompilationTier::Baseline or CompilationTier::Optimized
+     * @return the updated object
+     */
+    CompilerOptions &SetTier(CompilationTier tier) {
+      NOISEPAGE_ASSERT(tier != CompilationTier::Interpreted, "The LLVM engine only generates machine code");
+      tier_ = tier;
+      return *this;
+    }
+
+    /**
+     * @return the tier of machine code to generate
+     */
+    CompilationTier GetTier() const { return tier_; }
+
    private:
     bool debug_{false};
     bool write_obj_file_{false};
     std::string output_file_name_;
+    CompilationTier tier_{CompilationTier::Optimized};
   };
 
   // -------------------------------------------------------
@@ -206,16 +231,34 @@ class LLVMEngine {
     /**
      * Construct a settings instance from the relevant configuration parameters.
      * @param bytecode_handlers_path The path to the bytecode handlers bitcode file.
+     * @param compiled_module_cache_path The directory of the on-disk compiled module cache, empty to disable it.
+     * @param compiled_module_cache_size The maximum size of the on-disk compiled module cache, in bytes.
      */
-    explicit Settings(std::string_view bytecode_handlers_path) : bytecode_handlers_path_{bytecode_handlers_path} {}
+    explicit Settings(std::string_view bytecode_handlers_path, std::string_view compiled_module_cache_path = "",
+                      uint64_t compiled_module_cache_size = 0)
+        : bytecode_handlers_path_{bytecode_handlers_path},
+          compiled_module_cache_path_{compiled_module_cache_path},
+          compiled_module_cache_size_{compiled_module_cache_size} {}
 
     /**
      * @return The path to the bytecode handlers bitcode file.
      */
     const std::string &GetBytecodeHandlersBcPath() const noexcept { return bytecode_handlers_path_; }
 
+    /**
+     * @return The directory of the on-disk compiled module cache, empty if the cache is disabled.
+     */
+    const std::string &GetCompiledModuleCachePath() const noexcept { return compiled_module_cache_path_; }
+
+    /**
+     * @return The maximum size of the on-disk compiled module cache, in bytes.
+     */
+    uint64_t GetCompiledModuleCacheSize() const noexcept { return compiled_module_cache_size_; }
+
    private:
     const std::string bytecode_handlers_path_;
+    const std::string compiled_module_cache_path_;
+    const uint64_t compiled_module_cache_size_;
   };
 
   // -------------------------------------------------------
@@ -246,6 +289,18 @@ class LLVMEngine {
    *   the LLVMEngine because that is the natural ownership relationship
    */
   inline static std::unique_ptr<const Settings> engine_settings;  // NOLINT
+
+  /**
+   * Process-wide on-disk cache of compiled modules, created from the engine settings. Null if disabled.
+   */
+  inline static std::unique_ptr<CompiledModuleCache> compiled_module_cache;  // NOLINT
+
+ private:
+  // Compute the key under which the object code of the given module is stored in the compiled module cache
+  static std::string ComputeCacheKey(const BytecodeModule &module, const CompilerOptions &options);
+
+  // Describe everything besides the module itself that determines the generated object code
+  static std::string ComputeEngineFingerprint(const Settings &settings);
 };
 
 }  // namespace noisepage::execution::vm
@@ -106,6 +106,45 @@ class Module {
   /** @return The non-essential metadata for this module. */
   const ModuleMetadata &GetMetadata() const { return metadata_; }
 
+  /**
+   * @return The most optimized tier of code that is available for this module's functions.
+   */
+  CompilationTier GetCompiledTier() const { return compiled_tier_.load(std::memory_order_acquire); }
+
+  /**
+   * @param exec_mode The mode functions of this module are requested in.
+   * @return The tier of code that functions requested in the given mode currently run in.
+   */
+  CompilationTier GetExecutionTier(ExecutionMode exec_mode) const {
+    return exec_mode == ExecutionMode::Interpret ? CompilationTier::Interpreted : GetCompiledTier();
+  }
+
+  /**
+   * @param tier A tier of compiled code.
+   * @return The time it took to compile this module into the given tier in microseconds, or 0 if it was not compiled
+   *         into that tier (yet).
+   */
+  uint64_t GetCompileTimeUs(CompilationTier tier) const {
+    if (tier == CompilationTier::Interpreted || GetCompiledTier() < tier) {
+      return 0;
+    }
+    return compile_time_us_[static_cast<uint8_t>(tier)];
+  }
+
+  /**
+   * Account for loop iterations the interpreter executed in this module's functions. Used to detect hot modules.
+   * @param num_iterations The number of backward jumps taken.
+   */
+  void RecordInterpretedLoopIterations(uint64_t num_iterations) const {
+    num_interpreted_loop_iterations_.fetch_add(num_iterations, std::memory_order_relaxed);
+  }
+
+  /** Number of adaptive invocations of a module's functions after which it is compiled into optimized code. */
+  static constexpr uint64_t TIER_UP_INVOCATION_THRESHOLD = 16;
+
+  /** Number of interpreted loop iterations after which a module is compiled into optimized code. */
+  static constexpr uint64_t TIER_UP_LOOP_ITERATION_THRESHOLD = 1UL << 20;
+
  private:
   friend class VM;                            // For the VM to access raw bytecode.
   friend class test::BytecodeTrampolineTest;  // For the tests to check private methods.
@@ -143,25 +182,35 @@ class Module {
 
   // Access the compiled implementation of the function with the given ID.
   void *GetCompiledImpl(const FunctionId func_id) const {
-    if (jit_module_ == nullptr) {
+    if (GetCompiledTier() == CompilationTier::Interpreted) {
       return nullptr;
     }
-    const auto *func_info = GetFuncInfoById(func_id);
-    return jit_module_->GetFunctionPointer(func_info->GetName());
+    return functions_[func_id].load(std::memory_order_relaxed);
   }
 
-  // Compile this module into machine code. This is a blocking call.
-  void CompileToMachineCode();
+  // Compile this module into machine code of the given tier, unless code of
+  // that tier or better already exists. This is a blocking call.
+  void CompileToMachineCode(CompilationTier tier = CompilationTier::Optimized);
+
+  // Compile this module into machine code of the given tier. This is a
+  // non-blocking call that triggers a compilation in the background, unless
+  // one for that tier or better was already triggered.
+  void CompileToMachineCodeAsync(CompilationTier tier = CompilationTier::Optimized);
 
-  // Compile this module into machine code. This is a non-blocking call that
-  // triggers a compilation in the background.
-  void CompileToMachineCodeAsync();
+  // Count an adaptive invocation of one of this module's functions, and move
+  // the module up a tier when it has become hot enough.
+  void TierUp();
 
  private:
   // The module containing all TBC (i.e., bytecode) for the TPL program.
   std::unique_ptr<BytecodeModule> bytecode_module_;
 
-  // The module containing compiled machine code for the TPL program.
+  // The module containing baseline machine code for the TPL program. It's kept
+  // alive after the optimized code is swapped in, since concurrent callers may
+  // still be running it.
+  std::unique_ptr<LLVMEngine::CompiledModule> baseline_module_;
+
+  // The module containing optimized machine code for the TPL program.
   std::unique_ptr<LLVMEngine::CompiledModule> jit_module_;
 
   // Function pointers for all functions defined in the TPL program. Pointers
@@ -173,8 +222,20 @@ class Module {
   // program. Initially, all function pointers point into these trampolines.
   std::unique_ptr<Trampoline[]> bytecode_trampolines_;
 
-  // Flag to indicate if the JIT compilation has occurred.
-  std::once_flag compiled_flag_;
+  // Serializes compilations of this module.
+  std::mutex compile_latch_;
+
+  // The best tier of code that has been compiled, and that has been requested.
+  std::atomic<CompilationTier> compiled_tier_{CompilationTier::Interpreted};
+  std::atomic<CompilationTier> requested_tier_{CompilationTier::Interpreted};
+
+  // Compilation time of each tier in microseconds. Written before the tier is
+  // published in compiled_tier_.
+  uint64_t compile_time_us_[3]{0, 0, 0};
+
+  // Counters used to decide when to move up a tier in adaptive execution.
+  std::atomic<uint64_t> num_adaptive_invocations_{0};
+  mutable std::atomic<uint64_t> num_interpreted_loop_iterations_{0};
 
   ModuleMetadata metadata_;  ///< Non-essential metadata about the TPL module.
 };
@@ -217,8 +278,28 @@ inline bool Module::GetFunction(const std::string &name, const ExecutionMode exe
 
   switch (exec_mode) {
     case ExecutionMode::Adaptive: {
-      CompileToMachineCodeAsync();
-      FALLTHROUGH;
+      // Run the best code available at the time of each call
+      *func = [this, func_info](ArgTypes... args) -> Ret {
+        TierUp();
+        if (GetCompiledTier() != CompilationTier::Interpreted) {
+          void *raw_func = functions_[func_info->GetId()].load(std::memory_order_relaxed);
+          auto *jit_f = reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func);
+          return jit_f(args...);
+        }
+        if constexpr (std::is_void_v<Ret>) {
+          uint8_t arg_buffer[(0ul + ... + sizeof(args))];
+          detail::CopyAll(arg_buffer, args...);
+          VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
+          return;
+        } else {  // NOLINT
+          Ret rv{};
+          uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
+          detail::CopyAll(arg_buffer, &rv, args...);
+          VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
+          return rv;
+        }
+      };
+      break;
     }
     case ExecutionMode::Interpret: {
       *func = [this, func_info](ArgTypes... args) -> Ret {
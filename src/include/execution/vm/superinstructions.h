@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "execution/util/execution_common.h"
+#include "execution/vm/bytecodes.h"
+
+namespace noisepage::execution::vm {
+
+class FunctionInfo;
+
+// Fuses each primitive comparison on the given type with a conditional jump on its result
+#define FUSE_COMPARISON_AND_JUMP(type, F, jump)                          \
+  F(GreaterThan_##type##_##jump, GreaterThan_##type, jump)               \
+  F(GreaterThanEqual_##type##_##jump, GreaterThanEqual_##type, jump)     \
+  F(Equal_##type##_##jump, Equal_##type, jump)                           \
+  F(LessThan_##type##_##jump, LessThan_##type, jump)                     \
+  F(LessThanEqual_##type##_##jump, LessThanEqual_##type, jump)           \
+  F(NotEqual_##type##_##jump, NotEqual_##type, jump)
+
+// Fuses an addition on the given type with an unconditional jump, i.e., the increment closing a loop
+#define FUSE_ADD_AND_JUMP(type, F) F(Add_##type##_Jump, Add_##type, Jump)
+
+/**
+ * The master list of all superinstructions, along with the two bytecodes each of them fuses.
+ */
+#define SUPERINSTRUCTION_LIST(F)                                               \
+  /* Branches on primitive comparisons */                                      \
+  ALL_TYPES(FUSE_COMPARISON_AND_JUMP, F, JumpIfFalse)                          \
+  ALL_TYPES(FUSE_COMPARISON_AND_JUMP, F, JumpIfTrue)                           \
+  /* Branches on SQL predicates */                                             \
+  F(ForceBoolTruth_JumpIfFalse, ForceBoolTruth, JumpIfFalse)                   \
+  F(ForceBoolTruth_JumpIfTrue, ForceBoolTruth, JumpIfTrue)                     \
+  /* Loop latches */                                                           \
+  INT_TYPES(FUSE_ADD_AND_JUMP, F)                                              \
+  /* Vector Projection Iterator (VPI) loops */                                 \
+  F(VPIHasNext_JumpIfFalse, VPIHasNext, JumpIfFalse)                           \
+  F(VPIHasNextFiltered_JumpIfFalse, VPIHasNextFiltered, JumpIfFalse)           \
+  F(VPIAdvance_Jump, VPIAdvance, Jump)                                         \
+  F(VPIAdvanceFiltered_Jump, VPIAdvanceFiltered, Jump)
+
+/**
+ * The enumeration listing all superinstructions.
+ */
+enum class Superinstruction : uint32_t {
+#define DECLARE_OP(inst, ...) inst,
+  SUPERINSTRUCTION_LIST(DECLARE_OP)
+#undef DECLARE_OP
+#define COUNT_OP(inst, ...) +1
+      Last = -1 SUPERINSTRUCTION_LIST(COUNT_OP)
+#undef COUNT_OP
+};
+
+/**
+ * A superinstruction executes a pair of bytecodes that frequently run back-to-back with a single dispatch. When the
+ * second bytecode branches on the result of the first, the result is kept in a register rather than read back from
+ * the frame.
+ *
+ * Fusion happens in place: the opcode of the first bytecode is overwritten with the opcode of the superinstruction,
+ * while the operands of both bytecodes, and the opcode of the second one, stay where they are. Code size, jump offsets
+ * and function boundaries are therefore unaffected, and a BytecodeIterator still sees the original instruction stream.
+ * Only the interpreter ever dispatches on superinstruction opcodes, which are encoded past all regular bytecodes.
+ */
+class Superinstructions {
+ public:
+  /** The total number of superinstructions. */
+  static constexpr const uint32_t SUPERINSTRUCTION_COUNT = static_cast<uint32_t>(Superinstruction::Last) + 1;
+
+  /**
+   * @return The total number of superinstructions.
+   */
+  static constexpr uint32_t NumSuperinstructions() { return SUPERINSTRUCTION_COUNT; }
+
+  /**
+   * @return The string representation of the given superinstruction.
+   */
+  static const char *ToString(Superinstruction superinstruction) {
+    return superinstruction_names[static_cast<uint32_t>(superinstruction)];
+  }
+
+  /**
+   * @return The first of the two bytecodes that the given superinstruction fuses.
+   */
+  static Bytecode GetFirst(Superinstruction superinstruction) {
+    return superinstruction_firsts[static_cast<uint32_t>(superinstruction)];
+  }
+
+  /**
+   * @return The second of the two bytecodes that the given superinstruction fuses.
+   */
+  static Bytecode GetSecond(Superinstruction superinstruction) {
+    return superinstruction_seconds[static_cast<uint32_t>(superinstruction)];
+  }
+
+  /**
+   * @return True if the raw encoded opcode @em val is a superinstruction rather than a regular bytecode.
+   */
+  static constexpr bool IsSuperinstruction(std::underlying_type_t<Bytecode> val) {
+    return val >= Bytecodes::NumBytecodes();
+  }
+
+  /**
+   * Converts the superinstruction @em superinstruction into a raw encoded opcode.
+   * @param superinstruction The superinstruction to convert.
+   * @return The raw encoded opcode for the superinstruction.
+   */
+  static constexpr std::underlying_type_t<Bytecode> ToByte(Superinstruction superinstruction) {
+    NOISEPAGE_ASSERT(superinstruction <= Superinstruction::Last, "Invalid superinstruction");
+    return Bytecodes::NumBytecodes() + static_cast<std::underlying_type_t<Bytecode>>(superinstruction);
+  }
+
+  /**
+   * Decode and convert the raw opcode @em val into a superinstruction.
+   * @param val The value to convert.
+   * @return The superinstruction associated with the given value.
+   */
+  static constexpr Superinstruction FromByte(std::underlying_type_t<Bytecode> val) {
+    NOISEPAGE_ASSERT(IsSuperinstruction(val), "Not a superinstruction");
+    auto superinstruction = static_cast<Superinstruction>(val - Bytecodes::NumBytecodes());
+    NOISEPAGE_ASSERT(superinstruction <= Superinstruction::Last, "Invalid superinstruction");
+    return superinstruction;
+  }
+
+  /**
+   * Look up the superinstruction fusing the given pair of bytecodes.
+   * @param first The first bytecode of the pair.
+   * @param second The second bytecode of the pair.
+   * @param[out] superinstruction The superinstruction fusing the pair, if any.
+   * @return True if there is a superinstruction for the pair; false otherwise.
+   */
+  static bool Lookup(Bytecode first, Bytecode second, Superinstruction *superinstruction);
+
+  /**
+   * Fuse all eligible pairs of bytecodes in the given functions into superinstructions, in place. A pair is fused when
+   * it has a superinstruction, its second bytecode is not the target of any jump, and, if the second bytecode is a
+   * conditional jump, it branches on the value written by the first one.
+   * @param code The raw bytecode of all functions.
+   * @param functions The functions whose bytecode should be fused.
+   * @return The number of pairs that were fused.
+   */
+  static uint32_t Fuse(std::vector<uint8_t> *code, const std::vector<FunctionInfo> &functions);
+
+ private:
+  static const char *superinstruction_names[];
+  static const Bytecode superinstruction_firsts[];
+  static const Bytecode superinstruction_seconds[];
+};
+
+}  // namespace noisepage::execution::vm
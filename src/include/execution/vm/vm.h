@@ -36,6 +36,8 @@ class VM {
  private:
   // The module
   const Module *module_;
+  // The number of loop iterations executed, across all calls made by this VM
+  uint64_t num_loop_iterations_{0};
 };
 
 }  // namespace noisepage::execution::vm
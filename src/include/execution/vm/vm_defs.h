@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace noisepage::execution::vm {
 
 /**
@@ -16,4 +18,19 @@ enum class ExecutionMode : uint8_t {
   Compiled
 };
 
+/**
+ * The tiers of code that functions in a module can run in, ordered from the
+ * cheapest to produce to the fastest to run. In adaptive execution, a module
+ * moves up the tiers as it gets hot.
+ */
+enum class CompilationTier : uint8_t {
+  // The bytecode, run by the interpreter
+  Interpreted,
+  // Machine code generated with minimal optimization and fast instruction
+  // selection, available within milliseconds
+  Baseline,
+  // Machine code generated with the full optimization pipeline
+  Optimized
+};
+
 }  // namespace noisepage::execution::vm
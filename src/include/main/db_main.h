@@ -13,6 +13,7 @@
 #include "metrics/metrics_defs.h"
 #include "metrics/metrics_thread.h"
 #include "network/connection_handle_factory.h"
+#include "network/execution_scheduler.h"
 #include "network/noisepage_server.h"
 #include "network/postgres/postgres_command_factory.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
@@ -25,6 +26,8 @@
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/recovery/checkpoint_manager.h"
+#include "storage/recovery/checkpoint_thread.h"
 #include "storage/recovery/recovery_manager.h"
 #include "task/task_manager.h"
 #include "traffic_cop/traffic_cop.h"
@@ -150,23 +153,27 @@ class DBMain {
      * @param txn_layer arguments to the GarbageCollector
      * @param block_store_size_limit argument to the BlockStore
      * @param block_store_reuse_limit argument to the BlockStore
+     * @param block_allocator allocator the BlockStore allocates blocks with
      * @param use_gc enable GarbageCollector
+     * @param gc_num_workers number of threads the GarbageCollector works with
      * @param log_manager needed for safe destruction of StorageLayer
      * @param empty_buffer_queue The common buffer queue that all empty buffers are pulled from and returned to.
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
-                 const uint64_t block_store_reuse_limit, const bool use_gc,
+                 const uint64_t block_store_reuse_limit, storage::BlockAllocator block_allocator, const bool use_gc,
+                 const uint32_t gc_num_workers,
                  const common::ManagedPointer<storage::LogManager> log_manager,
                  std::unique_ptr<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue)
         : empty_buffer_queue_(std::move(empty_buffer_queue)),
           deferred_action_manager_(txn_layer->GetDeferredActionManager()),
           log_manager_(log_manager) {
       if (use_gc)
-        garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
-                                                                         txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
+        garbage_collector_ = std::make_unique<storage::GarbageCollector>(
+            txn_layer->GetTimestampManager(), txn_layer->GetDeferredActionManager(),
+            txn_layer->GetTransactionManager(), DISABLED, gc_num_workers);
 
-      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
+      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit,
+                                                           std::move(block_allocator));
     }
 
     ~StorageLayer() {
@@ -293,24 +300,29 @@ class DBMain {
   };
 
   /**
-   * ConnectionHandleFactory, CommandFactory, ProtocolInterpreterProvider, Server
+   * ConnectionHandleFactory, ExecutionScheduler, CommandFactory, ProtocolInterpreterProvider, Server
    */
   class NetworkLayer {
    public:
     /**
-     * @param thread_registry argument to the TerrierServer
+     * @param thread_registry argument to the TerrierServer and ExecutionScheduler
      * @param traffic_cop argument to the ConnectionHandleFactor
      * @param port argument to TerrierServer
      * @param connection_thread_count argument to TerrierServer
+     * @param execution_thread_count argument to ExecutionScheduler, 0 to execute on the connection threads instead
      * @param socket_directory argument to TerrierServer
      */
     NetworkLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                  const common::ManagedPointer<trafficcop::TrafficCop> traffic_cop, const uint16_t port,
-                 const uint16_t connection_thread_count, const std::string &socket_directory) {
+                 const uint16_t connection_thread_count, const uint16_t execution_thread_count,
+                 const std::string &socket_directory) {
       connection_handle_factory_ = std::make_unique<network::ConnectionHandleFactory>(traffic_cop);
+      if (execution_thread_count > 0) {
+        execution_scheduler_ = std::make_unique<network::ExecutionScheduler>(thread_registry, execution_thread_count);
+      }
       command_factory_ = std::make_unique<network::PostgresCommandFactory>();
-      provider_ =
-          std::make_unique<network::PostgresProtocolInterpreter::Provider>(common::ManagedPointer(command_factory_));
+      provider_ = std::make_unique<network::PostgresProtocolInterpreter::Provider>(
+          common::ManagedPointer(command_factory_), common::ManagedPointer(execution_scheduler_));
       server_ = std::make_unique<network::TerrierServer>(
           common::ManagedPointer(provider_), common::ManagedPointer(connection_handle_factory_), thread_registry, port,
           connection_thread_count, socket_directory);
@@ -321,12 +333,21 @@ class DBMain {
      */
     common::ManagedPointer<network::TerrierServer> GetServer() const { return common::ManagedPointer(server_); }
 
+    /**
+     * @return ManagedPointer to the component, can be nullptr if queries execute on the connection threads
+     */
+    common::ManagedPointer<network::ExecutionScheduler> GetExecutionScheduler() const {
+      return common::ManagedPointer(execution_scheduler_);
+    }
+
    private:
-    // Order matters here for destruction order
+    // Order matters here for destruction order. The ExecutionScheduler goes first so that no worker is still running a
+    // command against a ConnectionHandle when the server is torn down.
     std::unique_ptr<network::ConnectionHandleFactory> connection_handle_factory_;
     std::unique_ptr<network::PostgresCommandFactory> command_factory_;
     std::unique_ptr<network::ProtocolInterpreterProvider> provider_;
     std::unique_ptr<network::TerrierServer> server_;
+    std::unique_ptr<network::ExecutionScheduler> execution_scheduler_;
   };
 
   /**
@@ -337,8 +358,11 @@ class DBMain {
    public:
     /**
      * @param bytecode_handlers_path path to the bytecode handlers bitcode file
+     * @param compiled_module_cache_path directory of the on-disk compiled module cache, empty to disable it
+     * @param compiled_module_cache_size maximum size of the on-disk compiled module cache in bytes
      */
-    explicit ExecutionLayer(const std::string &bytecode_handlers_path);
+    ExecutionLayer(const std::string &bytecode_handlers_path, const std::string &compiled_module_cache_path,
+                   uint64_t compiled_module_cache_size);
     ~ExecutionLayer();
   };
 
@@ -421,6 +445,13 @@ class DBMain {
         }
       }
 
+      if (use_checkpoints_) {
+        NOISEPAGE_ASSERT(use_logging_, "Checkpoints truncate the log, so they need logging.");
+        // A crash may have left the log behind the latest checkpoint. This truncation has to happen before the
+        // LogManager opens the log for appending, later ones go through the running LogManager.
+        storage::CheckpointManager(checkpoint_directory_).TruncateLog(wal_file_path_);
+      }
+
       std::unique_ptr<storage::LogManager> log_manager = DISABLED;
       if (use_logging_) {
         auto rep_manager_ptr = network_identity_ == "primary"
@@ -431,7 +462,11 @@ class DBMain {
             wal_file_path_, wal_num_buffers_, std::chrono::microseconds{wal_serialization_interval_},
             std::chrono::microseconds{wal_persist_interval_}, wal_persist_threshold_,
             common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(empty_buffer_queue), rep_manager_ptr,
-            common::ManagedPointer(thread_registry));
+            common::ManagedPointer(thread_registry),
+            wal_compression_enable_ ? storage::LogBlockFormat::COMPRESSED
+                                    : (wal_checksum_enable_ ? storage::LogBlockFormat::CHECKSUMMED
+                                                            : storage::LogBlockFormat::RAW),
+            wal_io_uring_enable_);
         log_manager->Start();
       }
 
@@ -441,7 +476,10 @@ class DBMain {
 
       auto storage_layer =
           std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager), std::move(empty_buffer_queue));
+                                         storage::BlockAllocator(block_allocation_mode_, block_numa_policy_,
+                                                                 block_numa_node_),
+                                         use_gc_, gc_num_workers_, common::ManagedPointer(log_manager),
+                                         std::move(empty_buffer_queue));
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
@@ -486,7 +524,8 @@ class DBMain {
         recovery_manager = std::make_unique<storage::RecoveryManager>(
             log_provider, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(),
             txn_layer->GetDeferredActionManager(), common::ManagedPointer(replication_manager),
-            common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()));
+            common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()),
+            recovery_replay_threads_);
         recovery_manager->StartRecovery();
       }
 
@@ -499,9 +538,22 @@ class DBMain {
                                                                       common::ManagedPointer(metrics_manager));
       }
 
+      std::unique_ptr<storage::CheckpointManager> checkpoint_manager = DISABLED;
+      std::unique_ptr<storage::CheckpointThread> checkpoint_thread = DISABLED;
+      if (use_checkpoints_) {
+        NOISEPAGE_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED, "Checkpoints need the CatalogLayer.");
+        checkpoint_manager = std::make_unique<storage::CheckpointManager>(
+            checkpoint_directory_, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(),
+            common::ManagedPointer(log_manager));
+        checkpoint_thread = std::make_unique<storage::CheckpointThread>(
+            common::ManagedPointer(checkpoint_manager), std::chrono::seconds{checkpoint_interval_},
+            std::chrono::seconds{checkpoint_max_duration_});
+      }
+
       std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
       if (use_execution_) {
-        execution_layer = std::make_unique<ExecutionLayer>(bytecode_handlers_path_);
+        execution_layer = std::make_unique<ExecutionLayer>(bytecode_handlers_path_, compiled_module_cache_path_,
+                                                           compiled_module_cache_size_);
       }
 
       std::unique_ptr<trafficcop::TrafficCop> traffic_cop = DISABLED;
@@ -514,7 +566,7 @@ class DBMain {
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(),
             common::ManagedPointer(replication_manager), common::ManagedPointer(recovery_manager),
             common::ManagedPointer(settings_manager), common::ManagedPointer(stats_storage), optimizer_timeout_,
-            use_query_cache_, execution_mode_);
+            use_query_cache_, auto_parameterize_, plan_cache_size_, execution_mode_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -522,7 +574,8 @@ class DBMain {
         NOISEPAGE_ASSERT(use_traffic_cop_ && traffic_cop != DISABLED, "NetworkLayer needs TrafficCopLayer.");
         network_layer =
             std::make_unique<NetworkLayer>(common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop),
-                                           network_port_, connection_thread_count_, uds_file_directory_);
+                                           network_port_, connection_thread_count_, network_execution_threads_,
+                                           uds_file_directory_);
       }
 
       std::unique_ptr<modelserver::ModelServerManager> model_server_manager = DISABLED;
@@ -586,6 +639,8 @@ class DBMain {
       db_main->catalog_layer_ = std::move(catalog_layer);
       db_main->recovery_manager_ = std::move(recovery_manager);
       db_main->gc_thread_ = std::move(gc_thread);
+      db_main->checkpoint_manager_ = std::move(checkpoint_manager);
+      db_main->checkpoint_thread_ = std::move(checkpoint_thread);
       db_main->stats_storage_ = std::move(stats_storage);
       db_main->execution_layer_ = std::move(execution_layer);
       db_main->traffic_cop_ = std::move(traffic_cop);
@@ -708,6 +763,78 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalChecksum(const bool value) {
+      wal_checksum_enable_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalCompression(const bool value) {
+      wal_compression_enable_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalIoUring(const bool value) {
+      wal_io_uring_enable_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value RecoveryManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetRecoveryReplayThreads(const uint32_t value) {
+      recovery_replay_threads_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseCheckpoints(const bool value) {
+      use_checkpoints_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointDirectory(const std::string &value) {
+      checkpoint_directory_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointThread argument, in seconds
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointInterval(const uint32_t value) {
+      checkpoint_interval_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value CheckpointThread argument, in seconds, 0 for no limit
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointMaxDuration(const uint32_t value) {
+      checkpoint_max_duration_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -744,6 +871,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value number of threads the GarbageCollector unlinks, deallocates, and collects indexes with
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumWorkers(const uint32_t value) {
+      gc_num_workers_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -798,6 +934,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value number of connection handler threads
+     * @return self reference for chaining
+     */
+    Builder &SetConnectionThreadCount(const uint16_t value) {
+      connection_thread_count_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value number of execution workers to run queries on, 0 runs them on the connection threads
+     * @return self reference for chaining
+     */
+    Builder &SetNetworkExecutionThreads(const uint16_t value) {
+      network_execution_threads_ = value;
+      return *this;
+    }
+
     /**
      * @param port Messenger port
      * @return self reference for chaining
@@ -843,6 +997,26 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value whether the BlockStore backs blocks with huge pages
+     * @return self reference for chaining
+     */
+    Builder &SetBlockStoreHugePages(const bool value) {
+      block_allocation_mode_ = value ? storage::BlockAllocationMode::HUGE_PAGES : storage::BlockAllocationMode::HEAP;
+      return *this;
+    }
+
+    /**
+     * @param policy where the BlockStore places the memory of new blocks
+     * @param node node the memory is placed on with BlockNumaPolicy::PINNED
+     * @return self reference for chaining
+     */
+    Builder &SetBlockStoreNumaPolicy(const storage::BlockNumaPolicy policy, const uint32_t node = 0) {
+      block_numa_policy_ = policy;
+      block_numa_node_ = node;
+      return *this;
+    }
+
     /**
      * @param value TrafficCop argument
      * @return self reference for chaining
@@ -861,6 +1035,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value whether Simple Query protocol replaces literals with parameters to use the query cache
+     * @return self reference for chaining
+     */
+    Builder &SetAutoParameterize(const bool value) {
+      auto_parameterize_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value memory budget of the plans and generated code shared by all connections, 0 disables sharing
+     * @return self reference for chaining
+     */
+    Builder &SetPlanCacheSize(const uint64_t value) {
+      plan_cache_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -915,6 +1107,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value the new directory of the on-disk compiled module cache, empty to disable it
+     * @return self reference for chaining
+     */
+    Builder &SetCompiledModuleCachePath(const std::string &value) {
+      compiled_module_cache_path_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value maximum size of the on-disk compiled module cache in bytes
+     * @return self reference for chaining
+     */
+    Builder &SetCompiledModuleCacheSize(const uint64_t value) {
+      compiled_module_cache_size_ = value;
+      return *this;
+    }
+
    private:
     std::unordered_map<settings::Param, settings::ParamInfo> param_map_;
 
@@ -938,12 +1148,15 @@ class DBMain {
     uint64_t block_store_reuse_ = 1e3;
     uint64_t optimizer_timeout_ = 5000;
     uint64_t forecast_sample_limit_ = 5;
+    uint64_t compiled_module_cache_size_ = 1 << 28;
 
     std::string wal_file_path_ = "wal.log";
+    std::string checkpoint_directory_ = "checkpoints";
     std::string ou_model_save_path_;
     std::string interference_model_save_path_;
     std::string forecast_model_save_path_;
     std::string bytecode_handlers_path_ = "./bytecode_handlers_ir.bc";
+    std::string compiled_module_cache_path_;
     std::string network_identity_ = "primary";
     std::string uds_file_directory_ = "/tmp/";
     std::string replication_hosts_path_ = "./replication.config";
@@ -969,12 +1182,21 @@ class DBMain {
     bool gc_metrics_ = false;
     bool bind_command_metrics_ = false;
     bool execute_command_metrics_ = false;
+    bool plan_cache_metrics_ = false;
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
     int32_t gc_interval_ = 1000;
+    uint32_t gc_num_workers_ = 1;
+    storage::BlockAllocationMode block_allocation_mode_ = storage::BlockAllocationMode::HEAP;
+    storage::BlockNumaPolicy block_numa_policy_ = storage::BlockNumaPolicy::FIRST_TOUCH;
+    uint32_t block_numa_node_ = 0;
     uint32_t task_pool_size_ = 1;
+    uint32_t recovery_replay_threads_ = 1;
+    uint32_t checkpoint_interval_ = 300;
+    uint32_t checkpoint_max_duration_ = 60;
 
     uint16_t connection_thread_count_ = 4;
+    uint16_t network_execution_threads_ = 0;
     uint16_t network_port_ = 15721;
     uint16_t messenger_port_ = 9022;
     uint16_t replication_port_ = 15445;
@@ -983,6 +1205,10 @@ class DBMain {
 
     bool use_logging_ = false;
     bool wal_async_commit_enable_ = false;
+    bool wal_checksum_enable_ = false;
+    bool wal_compression_enable_ = false;
+    bool wal_io_uring_enable_ = false;
+    bool use_checkpoints_ = false;
     bool use_gc_ = false;
     bool use_catalog_ = false;
     bool create_default_database_ = true;
@@ -991,6 +1217,8 @@ class DBMain {
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
     bool use_query_cache_ = true;
+    bool auto_parameterize_ = true;
+    uint64_t plan_cache_size_ = 1 << 26;
     bool use_network_ = false;
     bool use_messenger_ = false;
     bool use_replication_ = false;
@@ -1015,17 +1243,37 @@ class DBMain {
           static_cast<uint64_t>(settings_manager->GetInt(settings::Param::record_buffer_segment_reuse));
       block_store_size_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_size));
       block_store_reuse_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_reuse));
+      SetBlockStoreHugePages(settings_manager->GetBool(settings::Param::block_store_huge_pages));
+      const std::string block_numa_policy = settings_manager->GetString(settings::Param::block_store_numa_policy);
+      if (block_numa_policy == "INTERLEAVE") {
+        block_numa_policy_ = storage::BlockNumaPolicy::INTERLEAVE;
+      } else if (block_numa_policy == "PINNED") {
+        block_numa_policy_ = storage::BlockNumaPolicy::PINNED;
+      } else {
+        block_numa_policy_ = storage::BlockNumaPolicy::FIRST_TOUCH;
+      }
+      block_numa_node_ = settings_manager->GetInt(settings::Param::block_store_numa_node);
 
       use_logging_ = settings_manager->GetBool(settings::Param::wal_enable);
       if (use_logging_) {
         wal_file_path_ = settings_manager->GetString(settings::Param::wal_file_path);
         wal_async_commit_enable_ = settings_manager->GetBool(settings::Param::wal_async_commit_enable);
+        wal_checksum_enable_ = settings_manager->GetBool(settings::Param::wal_checksum_enable);
+        wal_compression_enable_ = settings_manager->GetBool(settings::Param::wal_compression_enable);
+        wal_io_uring_enable_ = settings_manager->GetBool(settings::Param::wal_io_uring_enable);
         wal_num_buffers_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_num_buffers));
         wal_serialization_interval_ = settings_manager->GetInt(settings::Param::wal_serialization_interval);
         wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
         wal_persist_threshold_ =
             static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_persist_threshold));
       }
+      recovery_replay_threads_ = settings_manager->GetInt(settings::Param::recovery_replay_threads);
+      use_checkpoints_ = use_logging_ && settings_manager->GetBool(settings::Param::checkpoint_enable);
+      if (use_checkpoints_) {
+        checkpoint_directory_ = settings_manager->GetString(settings::Param::checkpoint_directory);
+        checkpoint_interval_ = settings_manager->GetInt(settings::Param::checkpoint_interval);
+        checkpoint_max_duration_ = settings_manager->GetInt(settings::Param::checkpoint_max_duration);
+      }
 
       use_metrics_ = settings_manager->GetBool(settings::Param::metrics);
       use_metrics_thread_ = settings_manager->GetBool(settings::Param::use_metrics_thread);
@@ -1033,6 +1281,7 @@ class DBMain {
       pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_workers_ = settings_manager->GetInt(settings::Param::gc_num_workers);
       pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
       forecast_train_interval_ = settings_manager->GetInt64(settings::Param::forecast_train_interval);
       workload_forecast_interval_ = settings_manager->GetInt64(settings::Param::workload_forecast_interval);
@@ -1051,13 +1300,20 @@ class DBMain {
       network_identity_ = settings_manager->GetString(settings::Param::network_identity);
       connection_thread_count_ =
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
+      network_execution_threads_ =
+          static_cast<uint16_t>(settings_manager->GetInt(settings::Param::network_execution_threads));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      auto_parameterize_ = settings_manager->GetBool(settings::Param::auto_parameterize);
+      plan_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::plan_cache_size));
 
       execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
                             ? execution::vm::ExecutionMode::Compiled
                             : execution::vm::ExecutionMode::Interpret;
       bytecode_handlers_path_ = settings_manager->GetString(settings::Param::bytecode_handlers_path);
+      compiled_module_cache_path_ = settings_manager->GetString(settings::Param::compiled_module_cache_path);
+      compiled_module_cache_size_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::compiled_module_cache_size));
 
       query_trace_metrics_ = settings_manager->GetBool(settings::Param::query_trace_metrics_enable);
       query_trace_metrics_output_ = *metrics::MetricsUtil::FromMetricsOutputString(
@@ -1071,6 +1327,7 @@ class DBMain {
       gc_metrics_ = settings_manager->GetBool(settings::Param::gc_metrics_enable);
       bind_command_metrics_ = settings_manager->GetBool(settings::Param::bind_command_metrics_enable);
       execute_command_metrics_ = settings_manager->GetBool(settings::Param::execute_command_metrics_enable);
+      plan_cache_metrics_ = settings_manager->GetBool(settings::Param::plan_cache_metrics_enable);
 
       use_messenger_ = settings_manager->GetBool(settings::Param::messenger_enable);
       messenger_port_ = settings_manager->GetInt(settings::Param::messenger_port);
@@ -1105,6 +1362,7 @@ class DBMain {
       if (gc_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::GARBAGECOLLECTION);
       if (bind_command_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::BIND_COMMAND);
       if (execute_command_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::EXECUTE_COMMAND);
+      if (plan_cache_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::PLAN_CACHE);
 
       return metrics_manager;
     }
@@ -1172,6 +1430,20 @@ class DBMain {
     return common::ManagedPointer(gc_thread_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::CheckpointManager> GetCheckpointManager() const {
+    return common::ManagedPointer(checkpoint_manager_);
+  }
+
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::CheckpointThread> GetCheckpointThread() const {
+    return common::ManagedPointer(checkpoint_thread_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -1242,6 +1514,8 @@ class DBMain {
   std::unique_ptr<CatalogLayer> catalog_layer_;
   std::unique_ptr<storage::GarbageCollectorThread>
       gc_thread_;  // thread needs to die before manual invocations of GC in CatalogLayer and others
+  std::unique_ptr<storage::CheckpointManager> checkpoint_manager_;  // Depends on the catalog and the log manager.
+  std::unique_ptr<storage::CheckpointThread> checkpoint_thread_;  // Depends on the catalog and checkpoint manager.
   std::unique_ptr<optimizer::StatsStorage> stats_storage_;
   std::unique_ptr<ExecutionLayer> execution_layer_;
   std::unique_ptr<trafficcop::TrafficCop> traffic_cop_;
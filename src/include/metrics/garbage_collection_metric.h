@@ -46,7 +46,8 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
 
     for (const auto &data : gc_data_) {
       outfile << data.txns_deallocated_ << ", " << data.txns_unlinked_ << ", " << data.buffer_unlinked_ << ", "
-              << data.readonly_unlinked_ << ", " << data.interval_ << ", ";
+              << data.readonly_unlinked_ << ", " << data.interval_ << ", " << data.version_chains_ << ", "
+              << data.version_chain_length_ << ", " << data.max_version_chain_length_ << ", ";
       data.resource_metrics_.ToCSV(outfile);
       outfile << std::endl;
     }
@@ -62,33 +63,44 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
   static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {
-      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval"};
+      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval, version_chains, "
+      "version_chain_length, max_version_chain_length"};
 
  private:
   friend class GarbageCollectionMetric;
   FRIEND_TEST(MetricsTests, LoggingCSVTest);
 
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, const uint64_t interval,
+                    uint64_t readonly_unlinked, const uint64_t interval, uint64_t version_chains,
+                    uint64_t version_chain_length, uint64_t max_version_chain_length,
                     const common::ResourceTracker::Metrics &resource_metrics) {
     gc_data_.emplace_back(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                          resource_metrics);
+                          version_chains, version_chain_length, max_version_chain_length, resource_metrics);
   }
 
   struct GCData {
     GCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked, uint64_t readonly_unlinked,
-           const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
+           const uint64_t interval, uint64_t version_chains, uint64_t version_chain_length,
+           uint64_t max_version_chain_length, const common::ResourceTracker::Metrics &resource_metrics)
         : txns_deallocated_(txns_deallocated),
           txns_unlinked_(txns_unlinked),
           buffer_unlinked_(buffer_unlinked),
           readonly_unlinked_(readonly_unlinked),
           interval_(interval),
+          version_chains_(version_chains),
+          version_chain_length_(version_chain_length),
+          max_version_chain_length_(max_version_chain_length),
           resource_metrics_(resource_metrics) {}
     const uint64_t txns_deallocated_;
     const uint64_t txns_unlinked_;
     const uint64_t buffer_unlinked_;
     const uint64_t readonly_unlinked_;
     const uint64_t interval_;
+    // Version chains truncated, and the total and maximum number of versions the GC traversed in them. Chains pruned
+    // by transactions as they go are shorter by the time the GC gets to them.
+    const uint64_t version_chains_;
+    const uint64_t version_chain_length_;
+    const uint64_t max_version_chain_length_;
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
@@ -103,10 +115,11 @@ class GarbageCollectionMetric : public AbstractMetric<GarbageCollectionMetricRaw
   friend class MetricsStore;
 
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, uint64_t interval,
+                    uint64_t readonly_unlinked, uint64_t interval, uint64_t version_chains,
+                    uint64_t version_chain_length, uint64_t max_version_chain_length,
                     const common::ResourceTracker::Metrics &resource_metrics) {
     GetRawData()->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                               resource_metrics);
+                               version_chains, version_chain_length, max_version_chain_length, resource_metrics);
   }
 };
 }  // namespace noisepage::metrics
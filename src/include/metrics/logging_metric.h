@@ -4,6 +4,8 @@
 #include <chrono>  //NOLINT
 #include <fstream>
 #include <list>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -31,6 +33,9 @@ class LoggingMetricRawData : public AbstractRawData {
     if (!other_db_metric->recovery_data_.empty()) {
       recovery_data_.splice(recovery_data_.cend(), other_db_metric->recovery_data_);
     }
+    if (!other_db_metric->group_commit_data_.empty()) {
+      group_commit_data_.splice(group_commit_data_.cend(), other_db_metric->group_commit_data_);
+    }
   }
 
   /**
@@ -51,6 +56,7 @@ class LoggingMetricRawData : public AbstractRawData {
     auto &serializer_outfile = (*outfiles)[0];
     auto &consumer_outfile = (*outfiles)[1];
     auto &recovery_outfile = (*outfiles)[2];
+    auto &group_commit_outfile = (*outfiles)[3];
 
     for (const auto &data : serializer_data_) {
       serializer_outfile << data.num_bytes_ << ", " << data.num_records_ << ", " << data.num_txns_ << ", "
@@ -68,26 +74,38 @@ class LoggingMetricRawData : public AbstractRawData {
       data.resource_metrics_.ToCSV(recovery_outfile);
       recovery_outfile << std::endl;
     }
+    for (const auto &data : group_commit_data_) {
+      group_commit_outfile << data.num_commits_ << ", " << data.persist_us_ << ", " << data.target_group_size_ << ", "
+                           << data.max_group_wait_us_ << ", " << data.GetLatencyHistogramString() << ", ";
+      data.resource_metrics_.ToCSV(group_commit_outfile);
+      group_commit_outfile << std::endl;
+    }
     serializer_data_.clear();
     consumer_data_.clear();
     recovery_data_.clear();
+    group_commit_data_.clear();
   }
 
   /**
    * Files to use for writing to CSV.
    */
-  static constexpr std::array<std::string_view, 3> FILES = {"./log_serializer_task.csv", "./disk_log_consumer_task.csv",
-                                                            "./recovery_manager.csv"};
+  static constexpr std::array<std::string_view, 4> FILES = {"./log_serializer_task.csv", "./disk_log_consumer_task.csv",
+                                                            "./recovery_manager.csv", "./log_group_commit.csv"};
   /**
    * Columns to use for writing to CSV.
    * Note: This includes the columns for the input feature, but not the output (resource counters)
+   * commit_latency_histogram is a ';'-separated list of commit counts, see
+   * DiskLogConsumerTask::NUM_COMMIT_LATENCY_BUCKETS. The resource counters of a group commit only cover the persist,
+   * writing the buffers is counted by the disk log consumer task.
    */
-  static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS = {
-      "num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, interval", "num_records, num_txns"};
+  static constexpr std::array<std::string_view, 4> FEATURE_COLUMNS = {
+      "num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, interval", "num_records, num_txns",
+      "num_commits, persist_us, target_group_size, max_group_wait_us, commit_latency_histogram"};
 
  private:
   friend class LoggingMetric;
   FRIEND_TEST(MetricsTests, LoggingCSVTest);
+  FRIEND_TEST(MetricsTests, LoggingGroupCommitTest);
 
   void RecordSerializerData(const uint64_t num_bytes, const uint64_t num_records, const uint64_t num_txns,
                             const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
@@ -104,6 +122,13 @@ class LoggingMetricRawData : public AbstractRawData {
     recovery_data_.emplace_back(num_records, num_txns, resource_metrics);
   }
 
+  void RecordGroupCommitData(const uint64_t num_commits, const uint64_t persist_us, const uint64_t target_group_size,
+                             const uint64_t max_group_wait_us, const std::vector<uint64_t> &latency_histogram,
+                             const common::ResourceTracker::Metrics &resource_metrics) {
+    group_commit_data_.emplace_back(num_commits, persist_us, target_group_size, max_group_wait_us, latency_histogram,
+                                    resource_metrics);
+  }
+
   struct SerializerData {
     SerializerData(const uint64_t num_bytes, const uint64_t num_records, const uint64_t num_txns,
                    const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
@@ -138,9 +163,38 @@ class LoggingMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
+  struct GroupCommitData {
+    GroupCommitData(const uint64_t num_commits, const uint64_t persist_us, const uint64_t target_group_size,
+                    const uint64_t max_group_wait_us, std::vector<uint64_t> latency_histogram,
+                    const common::ResourceTracker::Metrics &resource_metrics)
+        : num_commits_(num_commits),
+          persist_us_(persist_us),
+          target_group_size_(target_group_size),
+          max_group_wait_us_(max_group_wait_us),
+          latency_histogram_(std::move(latency_histogram)),
+          resource_metrics_(resource_metrics) {}
+
+    std::string GetLatencyHistogramString() const {
+      std::stringstream sstream;
+      for (auto itr = latency_histogram_.begin(); itr != latency_histogram_.end(); itr++) {
+        if (itr != latency_histogram_.begin()) sstream << ";";
+        sstream << *itr;
+      }
+      return sstream.str();
+    }
+
+    const uint64_t num_commits_;
+    const uint64_t persist_us_;
+    const uint64_t target_group_size_;
+    const uint64_t max_group_wait_us_;
+    const std::vector<uint64_t> latency_histogram_;
+    const common::ResourceTracker::Metrics resource_metrics_;
+  };
+
   std::list<SerializerData> serializer_data_;
   std::list<ConsumerData> consumer_data_;
   std::list<RecoveryData> recovery_data_;
+  std::list<GroupCommitData> group_commit_data_;
 };
 
 /**
@@ -163,5 +217,11 @@ class LoggingMetric : public AbstractMetric<LoggingMetricRawData> {
                           const common::ResourceTracker::Metrics &resource_metrics) {
     GetRawData()->RecordRecoveryData(num_records, num_txns, resource_metrics);
   }
+  void RecordGroupCommitData(const uint64_t num_commits, const uint64_t persist_us, const uint64_t target_group_size,
+                             const uint64_t max_group_wait_us, const std::vector<uint64_t> &latency_histogram,
+                             const common::ResourceTracker::Metrics &resource_metrics) {
+    GetRawData()->RecordGroupCommitData(num_commits, persist_us, target_group_size, max_group_wait_us,
+                                        latency_histogram, resource_metrics);
+  }
 };
 }  // namespace noisepage::metrics
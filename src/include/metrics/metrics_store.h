@@ -20,6 +20,7 @@
 #include "metrics/logging_metric.h"
 #include "metrics/metrics_defs.h"
 #include "metrics/pipeline_metric.h"
+#include "metrics/plan_cache_metric.h"
 #include "metrics/query_trace_metric.h"
 #include "metrics/transaction_metric.h"
 #include "parser/expression/constant_value_expression.h"
@@ -89,6 +90,27 @@ class MetricsStore {
     logging_metric_->RecordRecoveryData(num_records, num_txns, resource_metrics);
   }
 
+  /**
+   * Record metrics for a commit group persisted by the LogConsumerTask
+   * @param num_commits first entry of metrics datapoint
+   * @param persist_us second entry of metrics datapoint
+   * @param target_group_size third entry of metrics datapoint
+   * @param max_group_wait_us fourth entry of metrics datapoint
+   * @param latency_histogram fifth entry of metrics datapoint
+   * @param resource_metrics sixth entry of metrics datapoint
+   */
+  void RecordGroupCommitData(const uint64_t num_commits, const uint64_t persist_us, const uint64_t target_group_size,
+                             const uint64_t max_group_wait_us, const std::vector<uint64_t> &latency_histogram,
+                             const common::ResourceTracker::Metrics &resource_metrics) {
+    if (!ComponentEnabled(MetricsComponent::LOGGING))
+      METRICS_LOG_WARN(
+          "RecordGroupCommitData() called without logging metrics enabled. Was it recently disabled and the component "
+          "is just lagging?");
+    NOISEPAGE_ASSERT(logging_metric_ != nullptr, "LoggingMetric not allocated. Check MetricsStore constructor.");
+    logging_metric_->RecordGroupCommitData(num_commits, persist_us, target_group_size, max_group_wait_us,
+                                           latency_histogram, resource_metrics);
+  }
+
   /**
    * Record metrics from GC
    * @param txns_deallocated first entry of metrics datapoint
@@ -96,10 +118,14 @@ class MetricsStore {
    * @param buffer_unlinked third entry of metrics datapoint
    * @param readonly_unlinked fourth entry of metrics datapoint
    * @param interval fifth entry of metrics datapoint
-   * @param resource_metrics sixth entry of metrics datapoint
+   * @param version_chains sixth entry of metrics datapoint
+   * @param version_chain_length seventh entry of metrics datapoint
+   * @param max_version_chain_length eighth entry of metrics datapoint
+   * @param resource_metrics ninth entry of metrics datapoint
    */
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, uint64_t interval,
+                    uint64_t readonly_unlinked, uint64_t interval, uint64_t version_chains,
+                    uint64_t version_chain_length, uint64_t max_version_chain_length,
                     const common::ResourceTracker::Metrics &resource_metrics) {
     if (!ComponentEnabled(MetricsComponent::GARBAGECOLLECTION))
       METRICS_LOG_WARN(
@@ -107,7 +133,7 @@ class MetricsStore {
           "lagging?");
     NOISEPAGE_ASSERT(gc_metric_ != nullptr, "GarbageCollectionMetric not allocated. Check MetricsStore constructor.");
     gc_metric_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                             resource_metrics);
+                             version_chains, version_chain_length, max_version_chain_length, resource_metrics);
   }
 
   /**
@@ -157,16 +183,21 @@ class MetricsStore {
    * @param query_id Query Identifier
    * @param pipeline_id Pipeline Identifier
    * @param execution_mode Execution Mode
+   * @param compilation_tier The vm::CompilationTier that the pipeline ran at
+   * @param compile_time_us Time spent JIT compiling the pipeline's module to that tier, in microseconds
+   * @param spilled_bytes Bytes the pipeline spilled to disk
    * @param features Feature Vector
    * @param resource_metrics Metrics
    */
   void RecordPipelineData(execution::query_id_t query_id, execution::pipeline_id_t pipeline_id, uint8_t execution_mode,
+                          uint8_t compilation_tier, uint64_t compile_time_us, uint64_t spilled_bytes,
                           std::vector<selfdriving::ExecutionOperatingUnitFeature> &&features,
                           const common::ResourceTracker::Metrics &resource_metrics) {
     if (!ComponentEnabled(MetricsComponent::EXECUTION_PIPELINE))
       METRICS_LOG_WARN("RecordPipelineData() called without pipepline metrics enabled.");
     NOISEPAGE_ASSERT(pipeline_metric_ != nullptr, "PipelineMetric not allocated. Check MetricsStore constructor.");
-    pipeline_metric_->RecordPipelineData(query_id, pipeline_id, execution_mode, std::move(features), resource_metrics);
+    pipeline_metric_->RecordPipelineData(query_id, pipeline_id, execution_mode, compilation_tier, compile_time_us,
+                                         spilled_bytes, std::move(features), resource_metrics);
   }
 
   /**
@@ -225,6 +256,18 @@ class MetricsStore {
     query_trace_metric_->RecordQueryTrace(db_oid, query_id, timestamp, param);
   }
 
+  /**
+   * Record lookups in and evictions from the plan cache
+   * @param hits number of lookups that found a plan
+   * @param misses number of lookups that did not find a plan
+   * @param evictions number of plans evicted to stay within the memory budget
+   */
+  void RecordPlanCacheData(const uint64_t hits, const uint64_t misses, const uint64_t evictions) {
+    NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::PLAN_CACHE), "PlanCacheMetric not enabled.");
+    NOISEPAGE_ASSERT(plan_cache_metric_ != nullptr, "PlanCacheMetric not allocated. Check MetricsStore constructor.");
+    plan_cache_metric_->RecordPlanCacheData(hits, misses, evictions);
+  }
+
   /**
    * @param component metrics component to test
    * @return true if metrics enabled for this component, false otherwise
@@ -274,6 +317,7 @@ class MetricsStore {
   std::unique_ptr<PipelineMetric> pipeline_metric_;
   std::unique_ptr<BindCommandMetric> bind_command_metric_;
   std::unique_ptr<ExecuteCommandMetric> execute_command_metric_;
+  std::unique_ptr<PlanCacheMetric> plan_cache_metric_;
 
   const std::bitset<NUM_COMPONENTS> &enabled_metrics_;
   const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask_;
@@ -73,22 +73,47 @@ class PipelineMetricRawData : public AbstractRawData {
 
       data.resource_metrics_.ToCSV(outfile);
       outfile << std::endl;
+
+      auto &tier_outfile = (*outfiles)[1];
+      tier_outfile << data.query_id_.UnderlyingValue() << ", ";
+      tier_outfile << data.pipeline_id_.UnderlyingValue() << ", ";
+      tier_outfile << static_cast<uint32_t>(data.execution_mode_) << ", ";
+      tier_outfile << static_cast<uint32_t>(data.compilation_tier_) << ", ";
+      tier_outfile << data.compile_time_us_ << ", ";
+
+      data.resource_metrics_.ToCSV(tier_outfile);
+      tier_outfile << std::endl;
+
+      if (data.spilled_bytes_ != 0) {
+        auto &spill_outfile = (*outfiles)[2];
+        spill_outfile << data.query_id_.UnderlyingValue() << ", ";
+        spill_outfile << data.pipeline_id_.UnderlyingValue() << ", ";
+        spill_outfile << static_cast<uint32_t>(data.execution_mode_) << ", ";
+        spill_outfile << data.spilled_bytes_ << ", ";
+
+        data.resource_metrics_.ToCSV(spill_outfile);
+        spill_outfile << std::endl;
+      }
     }
     pipeline_data_.clear();
   }
 
   /**
    * Files to use for writing to CSV.
+   * The JIT tier of every pipeline goes to a separate file so that the model features in pipeline.csv stay unchanged.
+   * So do the bytes spilled to disk, which are only written for pipelines that spilled.
    */
-  static constexpr std::array<std::string_view, 1> FILES = {"./pipeline.csv"};
+  static constexpr std::array<std::string_view, 3> FILES = {"./pipeline.csv", "./jit_tier.csv", "./pipeline_spill.csv"};
 
   /**
    * Columns to use for writing to CSV.
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
-  static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {
+  static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS = {
       "query_id, pipeline_id, num_features, features, cpu_freq, exec_mode, num_rows, key_sizes, num_keys, "
-      "est_cardinalities, mem_factor, num_loops, num_concurrent, specific_feature0, specific_feature1"};
+      "est_cardinalities, mem_factor, num_loops, num_concurrent, specific_feature0, specific_feature1",
+      "query_id, pipeline_id, exec_mode, exec_tier, compile_time_us",
+      "query_id, pipeline_id, exec_mode, spilled_bytes"};
 
  private:
   friend class PipelineMetric;
@@ -98,18 +123,24 @@ class PipelineMetricRawData : public AbstractRawData {
   struct PipelineData;
 
   void RecordPipelineData(execution::query_id_t query_id, execution::pipeline_id_t pipeline_id, uint8_t execution_mode,
+                          uint8_t compilation_tier, uint64_t compile_time_us, uint64_t spilled_bytes,
                           std::vector<selfdriving::ExecutionOperatingUnitFeature> &&features,
                           const common::ResourceTracker::Metrics &resource_metrics) {
-    pipeline_data_.emplace_back(query_id, pipeline_id, execution_mode, std::move(features), resource_metrics);
+    pipeline_data_.emplace_back(query_id, pipeline_id, execution_mode, compilation_tier, compile_time_us,
+                                spilled_bytes, std::move(features), resource_metrics);
   }
 
   struct PipelineData {
     PipelineData(execution::query_id_t query_id, execution::pipeline_id_t pipeline_id, uint8_t execution_mode,
+                 uint8_t compilation_tier, uint64_t compile_time_us, uint64_t spilled_bytes,
                  std::vector<selfdriving::ExecutionOperatingUnitFeature> &&features,
                  const common::ResourceTracker::Metrics &resource_metrics)
         : query_id_(query_id),
           pipeline_id_(pipeline_id),
           execution_mode_(execution_mode),
+          compilation_tier_(compilation_tier),
+          compile_time_us_(compile_time_us),
+          spilled_bytes_(spilled_bytes),
           features_(features),
           resource_metrics_(resource_metrics) {}
 
@@ -209,6 +240,9 @@ class PipelineMetricRawData : public AbstractRawData {
     const execution::query_id_t query_id_;
     const execution::pipeline_id_t pipeline_id_;
     const uint8_t execution_mode_;
+    const uint8_t compilation_tier_;
+    const uint64_t compile_time_us_;
+    const uint64_t spilled_bytes_;
     const std::vector<selfdriving::ExecutionOperatingUnitFeature> features_;
     const common::ResourceTracker::Metrics resource_metrics_;
   };
@@ -224,9 +258,11 @@ class PipelineMetric : public AbstractMetric<PipelineMetricRawData> {
   friend class MetricsStore;
 
   void RecordPipelineData(execution::query_id_t query_id, execution::pipeline_id_t pipeline_id, uint8_t execution_mode,
+                          uint8_t compilation_tier, uint64_t compile_time_us, uint64_t spilled_bytes,
                           std::vector<selfdriving::ExecutionOperatingUnitFeature> &&features,
                           const common::ResourceTracker::Metrics &resource_metrics) {
-    GetRawData()->RecordPipelineData(query_id, pipeline_id, execution_mode, std::move(features), resource_metrics);
+    GetRawData()->RecordPipelineData(query_id, pipeline_id, execution_mode, compilation_tier, compile_time_us,
+                                     spilled_bytes, std::move(features), resource_metrics);
   }
 };
 }  // namespace noisepage::metrics
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "common/resource_tracker.h"
+#include "metrics/abstract_metric.h"
+#include "metrics/metrics_util.h"
+
+namespace noisepage::metrics {
+
+/**
+ * Raw data object for holding the hit and miss counters of the plan cache shared by all connections
+ */
+class PlanCacheMetricRawData : public AbstractRawData {
+ public:
+  void Aggregate(AbstractRawData *const other) override {
+    auto other_db_metric = dynamic_cast<PlanCacheMetricRawData *>(other);
+    hits_ += other_db_metric->hits_;
+    misses_ += other_db_metric->misses_;
+    evictions_ += other_db_metric->evictions_;
+  }
+
+  /**
+   * @return the type of the metric this object is holding the data for
+   */
+  MetricsComponent GetMetricType() const override { return MetricsComponent::PLAN_CACHE; }
+
+  /**
+   * Writes the data out to ofstreams
+   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   */
+  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
+    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
+    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
+                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
+                     "Not all files are open.");
+
+    auto &outfile = (*outfiles)[0];
+
+    if (hits_ + misses_ + evictions_ > 0) {
+      // One row per interval of the metrics thread. Lookups are too short to track resources for, the columns are
+      // left empty to keep the layout of the other metrics files.
+      outfile << MetricsUtil::Now() << ", " << hits_ << ", " << misses_ << ", " << evictions_ << ", ";
+      common::ResourceTracker::Metrics{}.ToCSV(outfile);
+      outfile << std::endl;
+    }
+    hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+  }
+
+  /**
+   * Files to use for writing to CSV.
+   */
+  static constexpr std::array<std::string_view, 1> FILES = {"./plan_cache.csv"};
+
+  /**
+   * Columns to use for writing to CSV.
+   * Note: This includes the columns for the input feature, but not the output (resource counters)
+   */
+  static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {"timestamp, hits, misses, evictions"};
+
+ private:
+  friend class PlanCacheMetric;
+
+  void RecordPlanCacheData(const uint64_t hits, const uint64_t misses, const uint64_t evictions) {
+    hits_ += hits;
+    misses_ += misses;
+    evictions_ += evictions;
+  }
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+/**
+ * Metrics for the plan cache of the TrafficCop
+ */
+class PlanCacheMetric : public AbstractMetric<PlanCacheMetricRawData> {
+ private:
+  friend class MetricsStore;
+
+  void RecordPlanCacheData(const uint64_t hits, const uint64_t misses, const uint64_t evictions) {
+    GetRawData()->RecordPlanCacheData(hits, misses, evictions);
+  }
+};
+}  // namespace noisepage::metrics
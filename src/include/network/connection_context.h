@@ -208,8 +208,8 @@ class ConnectionContext {
   std::unique_ptr<catalog::CatalogAccessor> accessor_ = nullptr;
 
   /**
-   * ConnectionHandle callback stuff to issue a libevent wakeup in the event of WAIT_ON_NOISEPAGE state. Currently
-   * not used, but may in the future for asynchronous execution.
+   * ConnectionHandle callback stuff to issue a libevent wakeup in the event of WAIT_ON_NOISEPAGE state. Invoked by
+   * the execution worker that ran a command offloaded by the protocol interpreter.
    */
   network::NetworkCallback callback_;
   void *callback_arg_;
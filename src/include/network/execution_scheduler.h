@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#include <queue>
+#include <vector>
+
+#include "common/dedicated_thread_owner.h"
+#include "common/managed_pointer.h"
+
+namespace noisepage::network {
+
+class ConnectionContext;
+class ExecutionWorkerTask;
+
+/**
+ * @brief ExecutionScheduler runs network commands on a pool of execution workers instead of on the network threads.
+ *
+ * ConnectionHandlerTasks only decode packets. Commands that parse, optimize, compile or run queries are handed to this
+ * scheduler, and the connection stops listening for network events until the command completes. The worker that ran
+ * the command then wakes the connection back up through its ConnectionContext callback, so one long-running query no
+ * longer stalls every other connection that shares its handler thread.
+ *
+ * Work is handed out in FIFO order. The workers are dedicated threads, so they are registered with the metrics
+ * manager the same way the network threads are.
+ */
+class ExecutionScheduler : public common::DedicatedThreadOwner {
+ public:
+  /** A unit of work submitted by a connection. */
+  using Work = std::function<void()>;
+
+  /**
+   * Constructor
+   * @param thread_registry ThreadRegistry to request the worker threads from
+   * @param num_workers number of execution workers, must be at least 1
+   */
+  ExecutionScheduler(common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry, uint32_t num_workers);
+
+  /** Destructor. Stops waking up connections, waits for all submitted work to run, then stops the workers. */
+  ~ExecutionScheduler() override;
+
+  /**
+   * Submit work to be run by one of the execution workers.
+   * @param work work to run
+   */
+  void Submit(Work work);
+
+  /**
+   * Wake up the connection that submitted some work, once that work is done. Does nothing after StopWakeUps.
+   * @param context state of the connection to wake up
+   */
+  void WakeUp(common::ManagedPointer<ConnectionContext> context);
+
+  /**
+   * Stop waking up connections. The events that wake up a connection belong to its ConnectionHandlerTask, so this has
+   * to be called before the network threads are stopped. Work that is still queued or running afterwards runs to
+   * completion without touching them.
+   */
+  void StopWakeUps();
+
+  /**
+   * Block until all of the work submitted so far has been run.
+   */
+  void WaitForFlush();
+
+  /** @return number of execution workers */
+  uint32_t NumWorkers() const { return static_cast<uint32_t>(workers_.size()); }
+
+  /**
+   * The thread registry doesn't currently rebalance threads, so these are never exercised.
+   * @see TaskManager
+   */
+  bool OnThreadOffered() override { return false; }
+
+  /** @see OnThreadOffered */
+  bool OnThreadRemoval(common::ManagedPointer<common::DedicatedThreadTask> task) override { return true; }
+
+ private:
+  friend class ExecutionWorkerTask;
+
+  /**
+   * Gets the next unit of work, blocking until there is some or the kill flag is set.
+   * @param kill flag used to indicate the caller is shutting down
+   * @return true if work was written to the output parameter, false if the caller should exit
+   */
+  bool GetWorkWithKillFlag(bool const *kill, Work *work);
+
+  /**
+   * Marks a kill flag previously passed into GetWorkWithKillFlag and wakes up any worker blocked on it.
+   * @param kill flag to update
+   */
+  void MarkTerminateFlag(bool *kill);
+
+  /** Called by an ExecutionWorkerTask once it has finished running work retrieved from GetWorkWithKillFlag. */
+  void FinishWork();
+
+  /** Number of workers currently running work */
+  uint32_t busy_workers_ = 0;
+  /** Mutex protecting queue_ and busy_workers_ */
+  std::mutex queue_mutex_;
+  /** Condition variable for notifying queue updates or kill flag updates */
+  std::condition_variable queue_cv_;
+  /** Condition variable for notifying WaitForFlush() waiters */
+  std::condition_variable notify_cv_;
+  /** Queue of work waiting for a worker */
+  std::queue<Work> queue_;
+
+  /** Mutex protecting wake_ups_stopped_, held while waking up a connection */
+  std::mutex wake_up_mutex_;
+  /** Whether StopWakeUps has been called */
+  bool wake_ups_stopped_ = false;
+
+  std::vector<common::ManagedPointer<ExecutionWorkerTask>> workers_;
+};
+
+}  // namespace noisepage::network
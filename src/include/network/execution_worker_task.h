@@ -0,0 +1,37 @@
+#pragma once
+
+#include "common/dedicated_thread_task.h"
+#include "common/managed_pointer.h"
+
+namespace noisepage::network {
+
+class ExecutionScheduler;
+
+/**
+ * Worker (i.e., thread) of the ExecutionScheduler that runs network commands submitted by the connection handlers.
+ */
+class ExecutionWorkerTask : public common::DedicatedThreadTask {
+ public:
+  /**
+   * Constructs a new ExecutionWorkerTask instance
+   * @param scheduler ExecutionScheduler that owns this worker
+   */
+  explicit ExecutionWorkerTask(common::ManagedPointer<ExecutionScheduler> scheduler) : scheduler_(scheduler) {}
+
+  /**
+   * Runs the work loop.
+   */
+  void RunTask() override;
+
+  /**
+   * Terminate running of the work loop
+   */
+  void Terminate() override;
+
+ private:
+  /** Kill flag for indicating that the worker should be shut down */
+  bool kill_ = false;
+  common::ManagedPointer<ExecutionScheduler> scheduler_;
+};
+
+}  // namespace noisepage::network
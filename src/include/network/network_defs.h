@@ -32,6 +32,21 @@ constexpr int INVALID_TYPE_ID = 0;
 //===--------------------------------------------------------------------===//
 #define SOCKET_BUFFER_CAPACITY 8192
 
+// Maximum number of WriteBuffers gathered into a single writev when flushing a WriteQueue
+#define WRITE_QUEUE_MAX_IOVECS 64
+
+// Capacity of the WriteBuffers a WriteQueue appends once its first buffer is full, e.g., when streaming a large result
+#define WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY (64 * 1024)
+
+// Number of overflow WriteBuffers a WriteQueue keeps around for reuse once it has been flushed, until it goes idle
+#define WRITE_QUEUE_MAX_SPARE_BUFFERS 8
+
+// Number of unflushed bytes past which a WriteQueue starts writing a result out while it is still being produced
+#define WRITE_QUEUE_STREAM_THRESHOLD (256 * 1024)
+
+// Number of auto-parameterized Simple Query protocol statements a connection keeps in its StatementCache
+#define STATEMENT_CACHE_MAX_PARAMETERIZED_STATEMENTS 256
+
 /* byte type */
 using uchar = unsigned char;
 
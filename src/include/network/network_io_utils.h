@@ -1,9 +1,12 @@
 #pragma once
 
 #include <arpa/inet.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
+#include <cerrno>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -324,6 +327,16 @@ class ReadBuffer : public Buffer {
  */
 class WriteBuffer : public Buffer {
  public:
+  /**
+   * Instantiates a new buffer of the default socket buffer capacity.
+   */
+  WriteBuffer() = default;
+
+  /**
+   * Instantiates a new buffer and reserve capacity many bytes.
+   */
+  explicit WriteBuffer(size_t capacity) : Buffer(capacity) {}
+
   /**
    * Write as many bytes as possible using Posix write to fd
    * @param fd File descriptor to write out to
@@ -388,6 +401,13 @@ class WriteBuffer : public Buffer {
  * A WriteQueue is a series of WriteBuffers that can buffer an uncapped amount
  * of writes without the need to copy and resize.
  *
+ * The first buffer is socket sized, which is plenty for most responses. Once it
+ * fills up (large results), larger overflow buffers are appended, and these are
+ * pooled across flushes until the connection goes idle. A queue that knows its
+ * socket streams a large result out while it is still being produced, see
+ * StreamOut. This keeps the queue short as long as the client keeps up, but
+ * nothing waits for a slow client, so its queue still grows with the result.
+ *
  * It is expected that a specific protocol will wrap this to expose a better
  * API for protocol-specific behavior.
  */
@@ -395,13 +415,16 @@ class WriteQueue {
  public:
   /**
    * Instantiates a new WriteQueue. By default this holds one buffer.
+   * @param stream_fd socket that StreamOut writes to, or -1 if results are only written out by explicit flushes
    */
-  WriteQueue() { Reset(); }
+  explicit WriteQueue(int stream_fd = -1) : stream_fd_(stream_fd) { Reset(); }
 
   /**
-   * Reset the write queue to its default state.
+   * Reset the write queue to its default state. The overflow buffers are kept around (up to
+   * WRITE_QUEUE_MAX_SPARE_BUFFERS of them) so that streaming the next large result does not allocate them again.
    */
   void Reset() {
+    for (size_t i = 1; i < buffers_.size(); i++) RecycleBuffer(std::move(buffers_[i]));
     buffers_.resize(1);
     offset_ = 0;
     flush_ = false;
@@ -424,6 +447,57 @@ class WriteQueue {
    */
   void MarkHeadFlushed() { offset_++; }
 
+  /**
+   * Free the spare overflow buffers. Called once the connection goes idle, so that idle connections do not hold on to
+   * the buffers of the last large result they streamed.
+   */
+  void ReleaseSpareBuffers() { spare_buffers_.clear(); }
+
+  /**
+   * @return The number of overflow buffers kept around for reuse
+   */
+  size_t GetNumSpareBuffers() const { return spare_buffers_.size(); }
+
+  /**
+   * @return The number of buffered bytes that have not been written out yet
+   */
+  size_t GetNumUnflushedBytes() const {
+    size_t num_bytes = 0;
+    for (size_t i = offset_; i < buffers_.size(); i++) num_bytes += buffers_[i]->size_ - buffers_[i]->offset_;
+    return num_bytes;
+  }
+
+  /**
+   * Write a result out to the stream socket while it is still being produced. Once WRITE_QUEUE_STREAM_THRESHOLD bytes
+   * are waiting, as many of them as the socket takes without blocking are written out, and the overflow buffers that
+   * went out are recycled. Whatever the socket does not take right away stays buffered, so for a client that reads
+   * slower than the result is produced the queue keeps growing. This must only be called between packets, since the
+   * length of an unfinished packet is filled in after its contents are buffered. Write errors are left for the next
+   * regular flush to deal with.
+   */
+  void StreamOut() {
+    if (stream_fd_ < 0 || GetNumUnflushedBytes() < WRITE_QUEUE_STREAM_THRESHOLD) return;
+    while (FlushHead() != nullptr) {
+      const auto bytes_written = WriteOutTo(stream_fd_);
+      if (bytes_written < 0 && errno == EINTR) continue;
+      if (bytes_written <= 0) break;
+    }
+
+    if (FlushHead() == nullptr) {
+      // Everything went out, including the tail buffer that the next packets would be appended to
+      const bool flush = flush_;
+      Reset();
+      flush_ = flush;
+      return;
+    }
+    // The first buffer stays in place, since Reset reuses it
+    for (size_t i = 1; i < offset_; i++) RecycleBuffer(std::move(buffers_[i]));
+    if (offset_ > 1) {
+      buffers_.erase(buffers_.begin() + 1, buffers_.begin() + static_cast<std::ptrdiff_t>(offset_));
+      offset_ = 1;
+    }
+  }
+
   /**
    * Force this WriteQueue to be flushed next time the network layer
    * is available to do so.
@@ -439,6 +513,41 @@ class WriteQueue {
    */
   bool ShouldFlush() { return flush_ || buffers_.size() > 1; }
 
+  /**
+   * Write as many bytes as possible using a single Posix writev to fd, gathering every buffer that has not been
+   * flushed yet (up to WRITE_QUEUE_MAX_IOVECS of them). Buffers that were written out completely are marked as
+   * flushed, and the cursor of a partially written buffer is advanced past the bytes that went out.
+   * @param fd File descriptor to write out to
+   * @return return value of Posix writev, or 0 if there was nothing left to write
+   */
+  ssize_t WriteOutTo(int fd) {
+    // Skip empty buffers (e.g. in a queue that was only forced to flush), writev would never get past them
+    while (FlushHead() != nullptr && !FlushHead()->HasMore()) MarkHeadFlushed();
+    if (FlushHead() == nullptr) return 0;
+
+    std::array<iovec, WRITE_QUEUE_MAX_IOVECS> iov;
+    int iovcnt = 0;
+    for (size_t i = offset_; i < buffers_.size() && iovcnt < WRITE_QUEUE_MAX_IOVECS; i++, iovcnt++) {
+      WriteBuffer &buf = *buffers_[i];
+      iov[iovcnt].iov_base = &buf.buf_[buf.offset_];
+      iov[iovcnt].iov_len = buf.size_ - buf.offset_;
+    }
+
+    const ssize_t bytes_written = writev(fd, iov.data(), iovcnt);
+    if (bytes_written <= 0) return bytes_written;
+
+    auto remaining = static_cast<size_t>(bytes_written);
+    while (FlushHead() != nullptr) {
+      WriteBuffer &head = *buffers_[offset_];
+      const size_t consumed = std::min(remaining, head.size_ - head.offset_);
+      head.offset_ += consumed;
+      remaining -= consumed;
+      if (head.HasMore()) break;
+      MarkHeadFlushed();
+    }
+    return bytes_written;
+  }
+
   /**
    * Write len many bytes starting from src into the write queue, allocating
    * a new buffer if need be. The write is split up between two buffers
@@ -455,7 +564,7 @@ class WriteQueue {
       // Only write partially if we are allowed to
       size_t written = breakup ? tail.RemainingCapacity() : 0;
       tail.AppendRaw(src, written);
-      buffers_.push_back(std::make_unique<WriteBuffer>());
+      AppendBuffer();
       BufferWriteRaw(reinterpret_cast<const uchar *>(src) + written, len - written);
     }
   }
@@ -476,9 +585,35 @@ class WriteQueue {
 
  private:
   friend class PacketWriter;
+
+  /**
+   * Append an overflow buffer to the queue, reusing a spare one if there is any.
+   */
+  void AppendBuffer() {
+    if (spare_buffers_.empty()) {
+      buffers_.push_back(std::make_unique<WriteBuffer>(WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY));
+    } else {
+      buffers_.push_back(std::move(spare_buffers_.back()));
+      spare_buffers_.pop_back();
+    }
+  }
+
+  /**
+   * Keep a flushed overflow buffer for reuse, unless there are enough spare buffers already.
+   */
+  void RecycleBuffer(std::unique_ptr<WriteBuffer> buffer) {
+    if (spare_buffers_.size() >= WRITE_QUEUE_MAX_SPARE_BUFFERS) return;
+    buffer->Reset();
+    spare_buffers_.push_back(std::move(buffer));
+  }
+
   std::vector<std::unique_ptr<WriteBuffer>> buffers_;
+  // Flushed overflow buffers that are ready to be reused
+  std::vector<std::unique_ptr<WriteBuffer>> spare_buffers_;
   size_t offset_ = 0;
   bool flush_ = false;
+  // Socket that large results are streamed out to, -1 if none
+  const int stream_fd_;
 };
 
 /**
@@ -9,7 +9,6 @@
 namespace noisepage::network {
 
 class ReadBuffer;
-class WriteBuffer;
 class WriteQueue;
 
 /**
@@ -41,12 +40,6 @@ class NetworkIoWrapper {
    */
   bool ShouldFlush();
 
-  /**
-   * @brief Flushes the write buffer of this IOWrapper to the assigned fd
-   * @return The next transition for this client's state machine
-   */
-  Transition FlushWriteBuffer(common::ManagedPointer<WriteBuffer> wbuf);
-
   /**
    * @brief Flushes all writes to this IOWrapper
    * @return The next transition for this client's state machine
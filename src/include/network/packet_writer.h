@@ -167,6 +167,15 @@ class PacketWriter {
     EndPacket();
   }
 
+  /**
+   * Write the finished packets out early if the queue has grown large, see WriteQueue::StreamOut.
+   * No packet may be in progress.
+   */
+  void StreamOut() {
+    NOISEPAGE_ASSERT(IsPacketEmpty(), "packet length is not null");
+    queue_->StreamOut();
+  }
+
   /**
    * End the packet. A packet write must be in progress and said write is not
    * well-formed until this method is called.
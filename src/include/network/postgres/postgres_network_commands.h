@@ -1,14 +1,14 @@
 #pragma once
 #include "network/network_command.h"
 
-#define DEFINE_POSTGRES_COMMAND(name, flush)                                                           \
-  class name : public PostgresNetworkCommand {                                                         \
-   public:                                                                                             \
-    explicit name(const common::ManagedPointer<InputPacket> in) : PostgresNetworkCommand(in, flush) {} \
-    Transition Exec(common::ManagedPointer<ProtocolInterpreter> interpreter,                           \
-                    common::ManagedPointer<PostgresPacketWriter> out,                                  \
-                    common::ManagedPointer<trafficcop::TrafficCop> t_cop,                              \
-                    common::ManagedPointer<ConnectionContext> connection) override;                    \
+#define DEFINE_POSTGRES_COMMAND(name, flush, offload)                                                           \
+  class name : public PostgresNetworkCommand {                                                                  \
+   public:                                                                                                      \
+    explicit name(const common::ManagedPointer<InputPacket> in) : PostgresNetworkCommand(in, flush, offload) {} \
+    Transition Exec(common::ManagedPointer<ProtocolInterpreter> interpreter,                                    \
+                    common::ManagedPointer<PostgresPacketWriter> out,                                           \
+                    common::ManagedPointer<trafficcop::TrafficCop> t_cop,                                       \
+                    common::ManagedPointer<ConnectionContext> connection) override;                             \
   }
 
 namespace noisepage::network {
@@ -32,24 +32,37 @@ class PostgresNetworkCommand : public NetworkCommand {
                           common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                           common::ManagedPointer<ConnectionContext> connection) = 0;
 
+  /**
+   * @return Whether or not this command should run on an execution worker when an ExecutionScheduler is available.
+   * Commands that parse, optimize, compile, run queries or wait on commit are offloaded, cheap bookkeeping commands are
+   * not.
+   */
+  bool OffloadToWorker() const { return offload_to_worker_; }
+
  protected:
   /**
    * Constructor for a PostgresNetworkCommand instance
    * @param in The input packets to this command
    * @param flush Whether or not to flush the output packets on completion
+   * @param offload Whether or not to run this command on an execution worker
    */
-  PostgresNetworkCommand(const common::ManagedPointer<InputPacket> in, bool flush) : NetworkCommand(in, flush) {}
+  PostgresNetworkCommand(const common::ManagedPointer<InputPacket> in, bool flush, bool offload)
+      : NetworkCommand(in, flush), offload_to_worker_(offload) {}
+
+ private:
+  bool offload_to_worker_;
 };
 
 // Set all to force flush for now
-DEFINE_POSTGRES_COMMAND(SimpleQueryCommand, true);
-DEFINE_POSTGRES_COMMAND(ParseCommand, false);
-DEFINE_POSTGRES_COMMAND(BindCommand, false);
-DEFINE_POSTGRES_COMMAND(DescribeCommand, false);
-DEFINE_POSTGRES_COMMAND(ExecuteCommand, false);
-DEFINE_POSTGRES_COMMAND(SyncCommand, true);
-DEFINE_POSTGRES_COMMAND(CloseCommand, true);
-DEFINE_POSTGRES_COMMAND(TerminateCommand, true);
-DEFINE_POSTGRES_COMMAND(EmptyCommand, true);  // (Matt): This seems to be only for testing? Not a big fan of that.
+DEFINE_POSTGRES_COMMAND(SimpleQueryCommand, true, true);
+DEFINE_POSTGRES_COMMAND(ParseCommand, false, true);
+DEFINE_POSTGRES_COMMAND(BindCommand, false, true);
+DEFINE_POSTGRES_COMMAND(DescribeCommand, false, false);
+DEFINE_POSTGRES_COMMAND(ExecuteCommand, false, true);
+DEFINE_POSTGRES_COMMAND(SyncCommand, true, true);
+DEFINE_POSTGRES_COMMAND(CloseCommand, true, false);
+DEFINE_POSTGRES_COMMAND(TerminateCommand, true, false);
+// (Matt): This seems to be only for testing? Not a big fan of that.
+DEFINE_POSTGRES_COMMAND(EmptyCommand, true, false);
 
 }  // namespace noisepage::network
@@ -177,6 +177,20 @@ class PostgresPacketWriter : public PacketWriter {
   void WriteDataRow(const byte *tuple, const std::vector<planner::OutputSchema::Column> &columns,
                     const std::vector<FieldFormat> &field_formats);
 
+  /**
+   * Write a batch of rows from an OutputBuffer in the execution engine back to the client, one data row each. The
+   * position and format of every attribute is worked out once for the whole batch rather than once per row. Once the
+   * result has grown large, the rows are streamed out to the client right away.
+   * @param tuples pointer to the start of the first row
+   * @param num_tuples number of rows in the batch
+   * @param tuple_size size of each row
+   * @param columns OutputSchema describing the tuples
+   * @param field_formats vector formats for the attributes to write
+   */
+  void WriteDataRows(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size,
+                     const std::vector<planner::OutputSchema::Column> &columns,
+                     const std::vector<FieldFormat> &field_formats);
+
  private:
   template <class native_type, class val_type>
   void WriteBinaryVal(const execution::sql::Val *val, execution::sql::SqlTypeId type);
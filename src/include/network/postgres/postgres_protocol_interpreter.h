@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "loggers/network_logger.h"
 #include "network/connection_context.h"
@@ -18,6 +19,8 @@
 
 namespace noisepage::network {
 
+class ExecutionScheduler;
+
 constexpr uint32_t INITIAL_BACKOFF_TIME = 2;
 constexpr uint32_t BACKOFF_FACTOR = 2;
 constexpr uint32_t MAX_BACKOFF_TIME = 20;
@@ -36,27 +39,32 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     /**
      * Constructs a new provider
      * @param command_factory The command factory to use for the constructed protocol interpreters
+     * @param execution_scheduler The scheduler to run commands on, nullptr to run them on the network threads
      */
-    explicit Provider(common::ManagedPointer<PostgresCommandFactory> command_factory)
-        : command_factory_(command_factory) {}
+    explicit Provider(common::ManagedPointer<PostgresCommandFactory> command_factory,
+                      common::ManagedPointer<ExecutionScheduler> execution_scheduler = nullptr)
+        : command_factory_(command_factory), execution_scheduler_(execution_scheduler) {}
 
     /**
      * @return an instance of the protocol interpreter
      */
     std::unique_ptr<ProtocolInterpreter> Get() override {
-      return std::make_unique<PostgresProtocolInterpreter>(command_factory_);
+      return std::make_unique<PostgresProtocolInterpreter>(command_factory_, execution_scheduler_);
     }
 
    private:
     common::ManagedPointer<PostgresCommandFactory> command_factory_;
+    common::ManagedPointer<ExecutionScheduler> execution_scheduler_;
   };
 
   /**
    * Creates the interpreter for Postgres
    * @param command_factory to convert packet into commands
+   * @param execution_scheduler to run expensive commands on, nullptr to run every command on the network thread
    */
-  explicit PostgresProtocolInterpreter(common::ManagedPointer<PostgresCommandFactory> command_factory)
-      : command_factory_(command_factory) {}
+  explicit PostgresProtocolInterpreter(common::ManagedPointer<PostgresCommandFactory> command_factory,
+                                       common::ManagedPointer<ExecutionScheduler> execution_scheduler = nullptr)
+      : command_factory_(command_factory), execution_scheduler_(execution_scheduler) {}
 
   /**
    * @see ProtocolIntepreter::Process
@@ -81,14 +89,13 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
                 common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                 common::ManagedPointer<ConnectionContext> context) override;
 
-  // TODO(Tianyu): Fill in the following documentation at some point
   /**
-   * (Matt): I think this was used in Peloton for asynchronous execution, after a callback wakeup the ConnectionHandle
-   * would call to the protocol interpreter to get the state of the asynchronous query after the output was already
-   * complete.
-   * @param out
+   * Collects the transition of the commands that were running on an execution worker. The worker has already written
+   * all of their output to the WriteQueue by the time the ConnectionHandle is woken up.
+   * @param out buffer the command wrote its results to
+   * @return next transition for ConnectionHandle's state machine
    */
-  void GetResult(const common::ManagedPointer<WriteQueue> out) override {}
+  Transition GetResult(common::ManagedPointer<WriteQueue> out) override;
 
   /**
    * Used to clear the waiting for sync, explicit txn block, and portals. Call whenever a transaction is ended.
@@ -163,6 +170,22 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
    */
   void AddStatementToCache(std::unique_ptr<network::Statement> &&statement) { cache_.Add(std::move(statement)); }
 
+  /**
+   * @param key key of an auto-parameterized statement, see StatementCache::ParameterizedKey
+   * @param statement statement to take ownership of
+   */
+  void AddParameterizedStatementToCache(const std::string &key, std::unique_ptr<network::Statement> &&statement) {
+    cache_.AddParameterized(key, std::move(statement));
+  }
+
+  /**
+   * @param key key of an auto-parameterized statement, see StatementCache::ParameterizedKey
+   * @return Statement if it exists in the cache, otherwise nullptr
+   */
+  common::ManagedPointer<network::Statement> LookupParameterizedStatementInCache(const std::string &key) {
+    return cache_.LookupParameterized(key);
+  }
+
   /**
    * @param query_text key to look up
    * @return Statement if it exists in the cache, otherwise nullptr
@@ -235,6 +258,15 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   bool explicit_txn_block_ = false;
 
   common::ManagedPointer<PostgresCommandFactory> command_factory_;
+  common::ManagedPointer<ExecutionScheduler> execution_scheduler_;
+
+  // commands decoded from the read buffer that have not finished running yet, tagged with their message type. This is
+  // usually one command, or a pipelined batch of extended query commands up to and including its Sync.
+  std::vector<std::pair<NetworkMessageType, std::unique_ptr<PostgresNetworkCommand>>> pending_commands_;
+  // whether the current input packet holds the (extended) buffer the pending commands read from
+  bool pending_packet_owned_ = false;
+  // transition the pending commands returned after running on an execution worker
+  Transition pending_transition_ = Transition::NONE;
 
   StatementCache cache_;
 
@@ -244,6 +276,59 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   // name to portal
   std::unordered_map<std::string, std::unique_ptr<network::Portal>> portals_;
 
+  /**
+   * Decodes the current input packet into a command. For extended query messages, keeps decoding every following
+   * packet that is already complete in the read buffer, up to and including the next Sync. Pipelining clients such as
+   * pgjdbc and libpq's pipeline mode send whole batches of Parse/Bind/Execute messages before a Sync, and the batch
+   * then executes back to back and has its output flushed once.
+   * @param in buffer to read packets from
+   * @param out buffer the commands will write their results to
+   */
+  void DecodePendingCommands(common::ManagedPointer<ReadBuffer> in, common::ManagedPointer<WriteQueue> out);
+
+  /**
+   * Runs the pending commands in order. Commands other than Sync are discarded once an error puts the interpreter in
+   * the waiting for Sync state.
+   * @param out buffer to send results back out on
+   * @param t_cop non-owning pointer to the traffic cop to pass down to the command layer
+   * @param context connection-specific (not protocol) state
+   * @return next transition for ConnectionHandle's state machine
+   */
+  Transition ExecutePendingCommands(common::ManagedPointer<WriteQueue> out,
+                                    common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                    common::ManagedPointer<ConnectionContext> context);
+
+  /**
+   * Replaces whatever the pending commands wrote with a fatal ErrorResponse, and has the connection terminate once it
+   * is woken up. Used when the commands fail on an execution worker with an error that isn't a NetworkProcessException.
+   * @param out buffer to send the error back out on
+   * @param message description of the error
+   */
+  void TerminateOnUnexpectedError(common::ManagedPointer<WriteQueue> out, const std::string &message);
+
+  /**
+   * Releases the pending commands once they have run, along with the input packet they were read from if need be.
+   */
+  void ClearPendingCommands();
+
+  /**
+   * @param type message type of a packet
+   * @return whether the message can be decoded as part of a pipelined batch of extended query messages
+   */
+  static bool IsPipelinedMessage(NetworkMessageType type) {
+    switch (type) {
+      case NetworkMessageType::PG_PARSE_COMMAND:
+      case NetworkMessageType::PG_BIND_COMMAND:
+      case NetworkMessageType::PG_DESCRIBE_COMMAND:
+      case NetworkMessageType::PG_EXECUTE_COMMAND:
+      case NetworkMessageType::PG_CLOSE_COMMAND:
+      case NetworkMessageType::PG_SYNC_COMMAND:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   /**
    * close all Portals constructed from a Statement. We don't care about return value since it's not an error to call
    * Close on non-existent statement
@@ -10,6 +10,7 @@
 #include "network/postgres/statement.h"
 #include "parser/postgresparser.h"
 #include "planner/plannodes/abstract_plan_node.h"
+#include "traffic_cop/plan_cache.h"
 #include "traffic_cop/traffic_cop_util.h"
 
 namespace noisepage::network {
@@ -22,7 +23,8 @@ namespace noisepage::network {
  *
  * For caching purposes, it also takes ownership of the physical plan and the ExecutableQuery after code generation.
  * This allows for a single fingerprint to reference this prepared statement be bound and executed with different
- * parameters multiple times.
+ * parameters multiple times. The plan and the ExecutableQuery may be shared with the Statements of other connections
+ * through the TrafficCop's PlanCache.
  */
 class Statement {
  public:
@@ -79,7 +81,7 @@ class Statement {
    * @return the optimize result of the query
    */
   common::ManagedPointer<optimizer::OptimizeResult> OptimizeResult() const {
-    return common::ManagedPointer(optimize_result_);
+    return common::ManagedPointer(optimize_result_.get());
   }
 
   /**
@@ -88,10 +90,10 @@ class Statement {
   common::ManagedPointer<planner::AbstractPlanNode> PhysicalPlan() const { return optimize_result_->GetPlanNode(); }
 
   /**
-   * @return the compiled executable query
+   * @return the compiled executable query, which is immutable since it may be shared with other connections
    */
-  common::ManagedPointer<execution::compiler::ExecutableQuery> GetExecutableQuery() const {
-    return common::ManagedPointer(executable_query_);
+  common::ManagedPointer<const execution::compiler::ExecutableQuery> GetExecutableQuery() const {
+    return common::ManagedPointer<const execution::compiler::ExecutableQuery>(executable_query_.get());
   }
 
   /**
@@ -108,6 +110,19 @@ class Statement {
     executable_query_ = std::move(executable_query);
   }
 
+  /**
+   * @return the optimize result and executable query to share them with other connections
+   */
+  trafficcop::CachedPlan GetCachedPlan() const { return {optimize_result_, executable_query_}; }
+
+  /**
+   * @param cached_plan optimize result and executable query shared by another connection
+   */
+  void SetCachedPlan(const trafficcop::CachedPlan &cached_plan) {
+    optimize_result_ = cached_plan.optimize_result_;
+    executable_query_ = cached_plan.executable_query_;
+  }
+
   /**
    * Stash desired parameter types to avoid having to do a full binding pass for prepared statements
    * @param desired_param_types output from the binder if Statement has parameters to fast-path convert for future
@@ -145,9 +160,12 @@ class Statement {
   // The following objects can be "cached" in Statement objects for future statement invocations. Though they don't
   // relate to the Postgres Statement concept, these objects should be compatible with future queries that match the
   // same query text. The exception to this that DDL changes can break these cached objects.
-  std::unique_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
-  std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
-  std::vector<execution::sql::SqlTypeId> desired_param_types_;                        // generated in the Bind phase
+  // The optimize result and the executable query are shared with other connections, see trafficcop::CachedPlan.
+  common::SanctionedSharedPtr<optimizer::OptimizeResult>::Ptr optimize_result_ =
+      nullptr;  // generated in the Bind phase
+  common::SanctionedSharedPtr<execution::compiler::ExecutableQuery>::Ptr executable_query_ =
+      nullptr;                                                  // generated in the Execute phase
+  std::vector<execution::sql::SqlTypeId> desired_param_types_;  // generated in the Bind phase
 };
 
 }  // namespace noisepage::network
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "common/managed_pointer.h"
+#include "network/network_defs.h"
 #include "network/postgres/statement.h"
+#include "parser/expression/constant_value_expression.h"
 #include "xxHash/xxh3.h"
 
 namespace noisepage::network {
@@ -15,9 +19,20 @@ namespace noisepage::network {
  * Simple statement cache. It contains a map from query string to Statement objects, allowing for reuse of bound parser
  * result, physical plan, and codegen'd executable query if appropriate. Can be extended in the future to have a maximum
  * size, replacement policy, etc.
+ *
+ * Statements of auto-parameterized Simple Query protocol queries are kept apart from the others. A client can send any
+ * number of distinct queries, so these are bounded and evicted in LRU order. They are only used while the query that
+ * looked them up runs, so evicting them is always safe, unlike the statements of the Extended Query protocol that
+ * named statements point to.
  */
 class StatementCache {
  public:
+  /**
+   * @param max_parameterized_statements maximum number of auto-parameterized statements to keep
+   */
+  explicit StatementCache(const size_t max_parameterized_statements = STATEMENT_CACHE_MAX_PARAMETERIZED_STATEMENTS)
+      : max_parameterized_statements_(max_parameterized_statements) {}
+
   /**
    * Check if a Statement for a query string exists
    * @param query_text key to look up
@@ -37,6 +52,59 @@ class StatementCache {
     cache_[statement->GetQueryText()] = std::move(statement);
   }
 
+  /**
+   * Check if an auto-parameterized Statement exists, and mark it as the most recently used one if it does
+   * @param key key built by ParameterizedKey to look up
+   * @return pointer to Statement object if it already exists, nullptr otherwise
+   */
+  common::ManagedPointer<Statement> LookupParameterized(const std::string &key) {
+    const auto it = parameterized_cache_.find(key);
+    if (it == parameterized_cache_.end()) return nullptr;
+    parameterized_lru_.splice(parameterized_lru_.begin(), parameterized_lru_, it->second.second);
+    return common::ManagedPointer(it->second.first);
+  }
+
+  /**
+   * Transfer ownership of an auto-parameterized Statement to the cache, evicting the least recently used ones beyond
+   * the maximum
+   * @param key key built by ParameterizedKey to add the statement under
+   * @param statement object to take ownership of
+   */
+  void AddParameterized(const std::string &key, std::unique_ptr<network::Statement> &&statement) {
+    const auto it = parameterized_cache_.find(key);
+    if (it != parameterized_cache_.end()) {
+      it->second.first = std::move(statement);
+      parameterized_lru_.splice(parameterized_lru_.begin(), parameterized_lru_, it->second.second);
+      return;
+    }
+    // The statement being added is about to be used, so it is never the one evicted
+    while (!parameterized_lru_.empty() && parameterized_cache_.size() >= max_parameterized_statements_) {
+      parameterized_cache_.erase(parameterized_lru_.back());
+      parameterized_lru_.pop_back();
+    }
+    parameterized_lru_.push_front(key);
+    parameterized_cache_.emplace(key, std::make_pair(std::move(statement), parameterized_lru_.begin()));
+  }
+
+  /** @return number of auto-parameterized statements in the cache */
+  size_t NumParameterized() const { return parameterized_cache_.size(); }
+
+  /**
+   * Build the key of a statement whose literals were replaced with parameters by the parser. The types of the literals
+   * are part of it since the plan is generated for them. The key can't collide with a query text.
+   * @param normalized_query_text query text with the literals written as parameters
+   * @param parameters values of the literals
+   * @return key to look up and add the statement with
+   */
+  static std::string ParameterizedKey(const std::string &normalized_query_text,
+                                      const std::vector<parser::ConstantValueExpression> &parameters) {
+    std::string key;
+    key.reserve(normalized_query_text.size() + 1 + parameters.size());
+    key.append(normalized_query_text).push_back('\0');
+    for (const auto &parameter : parameters) key.push_back(static_cast<char>(parameter.GetReturnValueType()));
+    return key;
+  }
+
  private:
   /**
    * We'll use xxHash for the keys since it's a fast hash algorithm for strings.
@@ -46,6 +114,14 @@ class StatementCache {
   };
 
   std::unordered_map<std::string, std::unique_ptr<Statement>, FastStringHasher> cache_;
+
+  const size_t max_parameterized_statements_;
+  // auto-parameterized statements and their position in parameterized_lru_
+  std::unordered_map<std::string, std::pair<std::unique_ptr<Statement>, std::list<std::string>::iterator>,
+                     FastStringHasher>
+      parameterized_cache_;
+  // keys of the auto-parameterized statements from the most to the least recently used
+  std::list<std::string> parameterized_lru_;
 };
 
 }  // namespace noisepage::network
@@ -43,10 +43,12 @@ class ProtocolInterpreter {
                         common::ManagedPointer<ConnectionContext> context) = 0;
 
   /**
-   * Sends a result
+   * Collects the result of a command that Process handed off with Transition::NEED_RESULT, once the connection has
+   * been woken back up through its ConnectionContext callback
    * @param out The WriteQueue to communicate with the client through
+   * @return The next transition for the client's associated state machine
    */
-  virtual void GetResult(common::ManagedPointer<WriteQueue> out) = 0;
+  virtual Transition GetResult(common::ManagedPointer<WriteQueue> out) = 0;
 
   /**
    * Default destructor for ProtocolInterpreter
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "common/managed_pointer.h"
+#include "parser/expression/constant_value_expression.h"
 
 namespace noisepage::parser {
 
@@ -88,9 +90,70 @@ class ParseResult {
    */
   std::vector<std::unique_ptr<AbstractExpression>> &&TakeExpressionsOwnership() { return std::move(expressions_); }
 
+  /**
+   * @return true if the parser replaces literals with parameters while it builds this parse result
+   */
+  bool ParameterizeLiterals() const { return parameterize_literals_; }
+
+  /**
+   * @param parameterize_literals whether the parser should replace literals with parameters
+   */
+  void SetParameterizeLiterals(const bool parameterize_literals) { parameterize_literals_ = parameterize_literals; }
+
+  /**
+   * @return true if the parser is transforming a WHERE or JOIN predicate, whose comparisons can be parameterized
+   */
+  bool InPredicate() const { return in_predicate_; }
+
+  /**
+   * @param in_predicate whether the parser is transforming a WHERE or JOIN predicate
+   */
+  void SetInPredicate(const bool in_predicate) { in_predicate_ = in_predicate; }
+
+  /**
+   * Adds the value of a literal that the parser replaced with a parameter.
+   * @param value value of the literal
+   * @param location offset of the literal in the query text
+   * @return index of the parameter that replaces the literal
+   */
+  uint32_t AddParameter(ConstantValueExpression &&value, const uint32_t location) {
+    parameters_.emplace_back(std::move(value));
+    parameter_locations_.emplace_back(location);
+    return static_cast<uint32_t>(parameters_.size() - 1);
+  }
+
+  /**
+   * @return values of the literals that were replaced with parameters, in the order of the parameter indexes
+   */
+  std::vector<ConstantValueExpression> &GetParameters() { return parameters_; }
+
+  /**
+   * @return offsets of the literals that were replaced with parameters in the query text
+   */
+  const std::vector<uint32_t> &GetParameterLocations() const { return parameter_locations_; }
+
+  /**
+   * @param normalized_query_text query text with the replaced literals written as parameters ($1, $2, ...)
+   */
+  void SetNormalizedQueryText(std::string &&normalized_query_text) {
+    normalized_query_text_ = std::move(normalized_query_text);
+  }
+
+  /**
+   * @return query text with the replaced literals written as parameters, empty if no literals were replaced
+   */
+  const std::string &GetNormalizedQueryText() const { return normalized_query_text_; }
+
  private:
   std::vector<std::unique_ptr<SQLStatement>> statements_;
   std::vector<std::unique_ptr<AbstractExpression>> expressions_;
+
+  // Auto-parameterization of the Simple Query protocol, see PostgresParser::BuildParseTree
+  bool parameterize_literals_ = false;
+  bool in_predicate_ = false;
+  std::vector<ConstantValueExpression> parameters_;
+  std::vector<uint32_t> parameter_locations_;
+  std::string normalized_query_text_;
 };
 
 }  // namespace noisepage::parser
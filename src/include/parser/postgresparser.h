@@ -41,10 +41,20 @@ class PostgresParser {
 
   /**
    * Builds the parse tree for the given query string.
+   *
+   * With auto-parameterization, the literals that are operands of comparisons in WHERE and JOIN predicates, values of
+   * INSERT or assigned by UPDATE in a single SELECT, INSERT, UPDATE or DELETE statement are replaced with
+   * ParameterValueExpressions. Their values are available from ParseResult::GetParameters(), and the query text with
+   * the literals written as parameters from ParseResult::GetNormalizedQueryText(). Queries that only differ in such
+   * literals then share the same normalized text. Literals that are written in a way the parser cannot locate in the
+   * text stay constants.
+   *
    * @param query_string query string to be parsed
+   * @param parameterize_literals whether to replace literals with parameters
    * @return unique pointer to parse tree
    */
-  static std::unique_ptr<parser::ParseResult> BuildParseTree(const std::string &query_string);
+  static std::unique_ptr<parser::ParseResult> BuildParseTree(const std::string &query_string,
+                                                             bool parameterize_literals = false);
 
  private:
   static FKConstrActionType CharToActionType(const char &type) {
@@ -88,6 +98,20 @@ class PostgresParser {
    */
   static void ListTransform(ParseResult *parse_result, List *root);
 
+  /**
+   * @param root list of parsed nodes
+   * @return true if the literals in the parsed nodes can be replaced with parameters
+   */
+  static bool IsParameterizable(List *root);
+
+  /**
+   * Writes the literals that were replaced with parameters as $1, $2, ... into the query text.
+   * @param query_string query string that was parsed
+   * @param[in,out] parse_result the parse result, which will be updated with the normalized query text
+   * @return false if a replaced literal could not be located in the query string
+   */
+  static bool NormalizeQueryText(const std::string &query_string, ParseResult *parse_result);
+
   /**
    * Transforms a single node in the parse list into a noisepage SQLStatement object.
    * @param[in,out] parse_result the current parse result, which will be updated
@@ -97,6 +121,7 @@ class PostgresParser {
   static std::unique_ptr<SQLStatement> NodeTransform(ParseResult *parse_result, Node *node);
 
   static std::unique_ptr<AbstractExpression> ExprTransform(ParseResult *parse_result, Node *node, char *alias);
+  static std::unique_ptr<AbstractExpression> ParameterizableExprTransform(ParseResult *parse_result, Node *node);
   static ExpressionType StringToExpressionType(const std::string &parser_str);
   static std::unique_ptr<AbstractExpression> AExprTransform(ParseResult *parse_result, A_Expr *root);
   static std::unique_ptr<AbstractExpression> BoolExprTransform(ParseResult *parse_result, BoolExpr *root);
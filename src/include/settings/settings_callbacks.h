@@ -88,6 +88,10 @@ class Callbacks {
   static void MetricsExecuteCommand(void *old_value, void *new_value, DBMain *db_main,
                                     common::ManagedPointer<common::ActionContext> action_context);
 
+  /** Enable or disable metrics collection for the plan cache. */
+  static void MetricsPlanCache(void *old_value, void *new_value, DBMain *db_main,
+                               common::ManagedPointer<common::ActionContext> action_context);
+
   /** Enable or disable metrics collection for Query Trace component. */
   static void MetricsQueryTrace(void *old_value, void *new_value, DBMain *db_main,
                                 common::ManagedPointer<common::ActionContext> action_context);
@@ -104,6 +108,10 @@ class Callbacks {
   static void ClearQueryCache(void *old_value, void *new_value, DBMain *db_main,
                               common::ManagedPointer<common::ActionContext> action_context);
 
+  /** Change the memory budget of the plan cache in TrafficCop */
+  static void PlanCacheSize(void *old_value, void *new_value, DBMain *db_main,
+                            common::ManagedPointer<common::ActionContext> action_context);
+
   /** Set the forecast sample limit. */
   static void ForecastSampleLimit(void *old_value, void *new_value, DBMain *db_main,
                                   common::ManagedPointer<common::ActionContext> action_context);
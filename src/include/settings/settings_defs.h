@@ -33,6 +33,18 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Execution worker threads that network commands are offloaded to
+SETTING_int(
+    network_execution_threads,
+    "Execution worker threads that run queries for the connection handler threads. 0 runs queries on the connection "
+    "handler threads (default: 0)",
+    0,
+    0,
+    256,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Path to socket file for Unix domain sockets
 SETTING_string(
     uds_file_directory,
@@ -86,6 +98,35 @@ SETTING_int(
     noisepage::settings::Callbacks::BlockStoreReuseLimit
 )
 
+// BlockStore huge pages
+SETTING_bool(
+    block_store_huge_pages,
+    "Whether storage blocks are backed by 2 MB huge pages, and kept mapped once freed (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// BlockStore NUMA placement
+SETTING_string(
+    block_store_numa_policy,
+    "Where the memory of new storage blocks is placed (default: FIRST_TOUCH, values: FIRST_TOUCH, INTERLEAVE, PINNED)",
+    "FIRST_TOUCH",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// BlockStore NUMA node for the PINNED policy
+SETTING_int(
+    block_store_numa_node,
+    "The NUMA node storage blocks are placed on with the PINNED policy (default: 0)",
+    0,
+    0,
+    1023,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Garbage collector thread interval
 SETTING_int(
     gc_interval,
@@ -97,6 +138,17 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Garbage collector workers
+SETTING_int(
+    gc_num_workers,
+    "Number of threads the garbage collector unlinks, deallocates, and collects indexes with (default: 1)",
+    1,
+    1,
+    128,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Write ahead logging
 SETTING_bool(
     wal_enable,
@@ -166,6 +218,84 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Log file block checksums
+SETTING_bool(
+    wal_checksum_enable,
+    "Write log buffers as blocks with a CRC32C checksum to detect torn writes (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Log file block compression
+SETTING_bool(
+    wal_compression_enable,
+    "Compress checksummed log blocks, implies wal_checksum_enable (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Log file io_uring backend
+SETTING_bool(
+    wal_io_uring_enable,
+    "Write the log file through io_uring, falling back to blocking writes where unavailable (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Recovery replay threads
+SETTING_int(
+    recovery_replay_threads,
+    "Number of threads used to replay committed transactions during recovery (default: 1)",
+    1,
+    1,
+    128,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Periodic checkpoints
+SETTING_bool(
+    checkpoint_enable,
+    "Take checkpoints periodically and truncate the WAL to each one (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint directory
+SETTING_string(
+    checkpoint_directory,
+    "The directory checkpoint files are written to (default: checkpoints)",
+    "checkpoints",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint interval
+SETTING_int(
+    checkpoint_interval,
+    "Time between checkpoints (s) (default: 300)",
+    300,
+    1,
+    86400,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Checkpoint duration bound
+SETTING_int(
+    checkpoint_max_duration,
+    "Time after which a checkpoint is abandoned so it stops holding back GC, 0 for no limit (s) (default: 60)",
+    60,
+    0,
+    86400,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
@@ -397,6 +527,14 @@ SETTING_bool(
     noisepage::settings::Callbacks::MetricsExecuteCommand
 )
 
+SETTING_bool(
+    plan_cache_metrics_enable,
+    "Metrics collection for the plan cache shared by all connections (default: false).",
+    false,
+    true,
+    noisepage::settings::Callbacks::MetricsPlanCache
+)
+
 SETTING_bool(
     use_query_cache,
     "Extended Query protocol caches physical plans and generated code after first execution. Warning: bugs with DDL changes.",
@@ -405,6 +543,24 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_bool(
+    auto_parameterize,
+    "Simple Query protocol replaces the literals compared, inserted or assigned by DML with parameters, so that it can cache physical plans and generated code like Extended Query protocol (default: true).",
+    true,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    plan_cache_size,
+    "Memory budget of the physical plans and generated code shared by all connections, 0 disables sharing (bytes) (default: 64MB)",
+    (1 << 26) /* 64MB */,
+    0,
+    (1LL << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::PlanCacheSize
+)
+
 SETTING_bool(
     compiled_query_execution,
     "Compile queries to native machine code using LLVM, rather than relying on TPL interpretation (default: false).",
@@ -456,6 +612,60 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_bool(
+    sort_normalized_keys_enable,
+    "Whether sorts materialize binary-comparable key prefixes and radix sort on them (default: false)",
+    false,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    sort_memory_budget,
+    "The memory a sort may use in each thread to buffer its input before spilling sorted runs to disk, 0 disables spilling (bytes) (default: 0)",
+    0,
+    0,
+    (1LL << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    join_memory_budget,
+    "The memory a hash join may use for build-side tuples before partitioning both inputs to disk, 0 disables spilling (bytes) (default: 0)",
+    0,
+    0,
+    (1LL << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    agg_memory_budget,
+    "The memory a partitioned aggregation may use for overflow partitions before spilling them to disk, 0 disables spilling (bytes) (default: 0)",
+    0,
+    0,
+    (1LL << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    agg_adaptive_preaggregation_enable,
+    "Whether partitioned aggregations partition their input directly, without pre-aggregating it, while almost every input tuple forms its own group (default: true)",
+    true,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    join_radix_partitioning_enable,
+    "Whether parallel hash join builds radix-partition their tuples so that each partition is inserted into a cache-sized part of the table (default: false)",
+    false,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     messenger_enable,
     "Whether to enable the messenger (default: false)",
@@ -578,6 +788,24 @@ SETTING_string(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_string(
+    compiled_module_cache_path,
+    "The directory in which compiled query modules are cached across restarts, empty disables the cache (default: empty)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    compiled_module_cache_size,
+    "The maximum size of the compiled query module cache on disk (bytes) (default: 256MB)",
+    (1 << 28) /* 256MB */,
+    (1 << 20) /* 1MB */,
+    (1LL << 40) /* 1TB */,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     train_forecast_model,
     "Train the forecast model (the value is not relevant and has no effect during startup).",
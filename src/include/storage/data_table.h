@@ -381,7 +381,14 @@ class DataTable {
 
   // Compares and swaps the version pointer to be the undo record, only if its value is equal to the expected one.
   bool CompareAndSwapVersionPtr(TupleSlot slot, const TupleAccessStrategy &accessor, UndoRecord *expected,
-                                UndoRecord *desired);
+                                UndoRecord *desired) const;
+
+  // Unlinks version_ptr and the rest of the version chain after it if version_ptr is older than the given horizon, i.e.
+  // no running transaction can see it anymore. prev is the version before version_ptr, or nullptr if it is the head.
+  // This is done cooperatively by readers and writers walking the version chain, so that version chains on hot tuples
+  // stay short even if the GC falls behind.
+  void PruneVersionChain(TupleSlot slot, UndoRecord *prev, UndoRecord *version_ptr,
+                         transaction::timestamp_t horizon) const;
 
   // Allocates a new block to be used as insertion head.
   RawBlock *NewBlock();
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
+#include "common/worker_pool.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -31,6 +35,10 @@ class Index;
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * The GC can spread its work over several workers. Version chains are partitioned by the tuple slot they belong to, so
+ * that every version chain is still truncated by a single worker. Reclaiming the records of transactions and
+ * deallocating transactions are partitioned by transaction, and indexes are collected one worker per index.
  */
 class GarbageCollector {
  public:
@@ -44,12 +52,14 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_workers number of threads to spread the work of a GC invocation over, including the one invoking it
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer);
+                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   uint32_t num_workers = 1);
 
   ~GarbageCollector() {
     NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
@@ -111,14 +121,27 @@ class GarbageCollector {
 
   void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record) const;
 
-  void TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
+  /** @return number of versions traversed to find where to truncate the version chain */
+  uint32_t TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
 
   void ProcessIndexes();
 
+  /**
+   * Invokes the task once for every worker, with the id of the worker, and waits for all of them to return. The
+   * calling thread acts as worker 0.
+   */
+  void ForEachWorker(const std::function<void(uint32_t)> &task);
+
+  /** @return the worker that owns the version chain of the slot */
+  uint32_t SlotPartition(TupleSlot slot) const;
+
   const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
   const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager_;
   const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   AccessObserver *observer_;
+  const uint32_t num_workers_;
+  // Threads of the workers other than worker 0, nullptr if the GC only has a single worker
+  std::unique_ptr<common::WorkerPool> worker_pool_;
   // timestamp of the last time GC unlinked anything. We need this to know when unlinked versions are safe to deallocate
   transaction::timestamp_t last_unlinked_;
   // queue of txns that have been unlinked, and should possible be deleted on next GC run
@@ -130,6 +153,12 @@ class GarbageCollector {
   common::SharedLatch indexes_latch_;
 
   uint64_t gc_interval_{0};
+
+  // Number of version chains truncated by the last unlink pass, and the total and maximum number of versions traversed
+  // in them. Reported to metrics.
+  uint64_t version_chains_ = 0;
+  uint64_t version_chain_length_ = 0;
+  uint64_t max_version_chain_length_ = 0;
 };
 
 }  // namespace noisepage::storage
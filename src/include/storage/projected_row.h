@@ -197,6 +197,7 @@ class PACKED ProjectedRow {
  private:
   friend class ProjectedRowInitializer;
   friend class LogSerializerTask;
+  friend class CheckpointManager;
   uint32_t size_;
   uint16_t num_cols_;
   byte varlen_contents_[0];
@@ -1,8 +1,12 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <vector>
 
 #include "common/constants.h"
+#include "common/container/concurrent_queue.h"
 #include "common/object_pool.h"
+#include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/undo_record.h"
 
@@ -57,6 +61,7 @@ class RecordBufferSegment {
   friend class IterableBufferSegment;
 
   friend class UndoBuffer;
+  friend class RecordBufferSegmentPool;
 
   byte bytes_[common::Constants::BUFFER_SEGMENT_SIZE];
   uint32_t size_ = 0;
@@ -178,9 +183,105 @@ class RecordBufferSegmentAllocator {
 };
 
 /**
- * Type alias for an object pool handing out buffer segments
+ * Pool of buffer segments, shared by the undo and redo buffers of all transactions.
+ *
+ * Every thread gets and releases segments through a cache of its own, so that transactions do not serialize on a
+ * single latch. A cache that grows too large hands a batch of segments over to a shared queue, and an empty cache
+ * refills with a whole batch from it. This matters because segments are mostly released on other threads than the
+ * ones that got them: undo segments by the GC, and redo segments once the log manager serialized them. Segments
+ * released by a thread are reused by the same thread first, which keeps their memory local to it.
+ *
+ * Like common::ObjectPool, the pool controls at most size_limit segments, and keeps at most reuse_limit of them for
+ * reuse (in the caches and the shared queue combined).
+ *
+ * Thread-safe.
  */
-using RecordBufferSegmentPool = common::ObjectPool<RecordBufferSegment, RecordBufferSegmentAllocator>;
+class RecordBufferSegmentPool {
+ public:
+  /** Number of thread caches. Threads map to them round-robin, so a cache is only shared if there are more threads. */
+  static constexpr uint32_t NUM_CACHES = 64;
+  /** Number of segments moved between a thread cache and the shared queue at once. */
+  static constexpr uint32_t BATCH_SIZE = 32;
+
+  /**
+   * Initializes a new pool with the given limits.
+   * @param size_limit the maximum number of segments the pool controls
+   * @param reuse_limit the maximum number of segments kept for reuse
+   */
+  RecordBufferSegmentPool(uint64_t size_limit, uint64_t reuse_limit)
+      : size_limit_(size_limit), reuse_limit_(reuse_limit) {}
+
+  DISALLOW_COPY_AND_MOVE(RecordBufferSegmentPool)
+
+  /**
+   * Frees the segments kept for reuse. Segments that were handed out and not released are not freed.
+   */
+  ~RecordBufferSegmentPool();
+
+  /**
+   * @throw NoMoreObjectException if the pool controls size_limit segments and none of them is free
+   * @throw AllocatorFailureException if a new segment could not be allocated
+   * @return an empty segment
+   */
+  RecordBufferSegment *Get();
+
+  /**
+   * Releases the given segment to the pool, to be reused or freed. It is unsafe to access the segment after this call.
+   * @param segment segment to release
+   */
+  void Release(RecordBufferSegment *segment);
+
+  /**
+   * Sets the pool's size limit. Fails if the pool already controls more segments than the new limit.
+   * @param new_size the new size limit
+   * @return true if the limit was changed
+   */
+  bool SetSizeLimit(uint64_t new_size);
+
+  /**
+   * Sets the pool's reuse limit, and frees segments kept for reuse until they are within it.
+   * @param new_reuse_limit the new reuse limit
+   */
+  void SetReuseLimit(uint64_t new_reuse_limit);
+
+  /**
+   * @return size limit of the pool
+   */
+  uint64_t GetSizeLimit() const { return size_limit_.load(); }
+
+ private:
+  /** Free segments of the threads mapped to one cache. */
+  struct alignas(common::Constants::CACHELINE_SIZE) SegmentCache {
+    common::SpinLatch latch_;
+    std::vector<RecordBufferSegment *> segments_;
+  };
+
+  /** @return index of the cache the calling thread uses */
+  static uint32_t ThreadCache();
+
+  /** @return the next segment of the batch the given segment is in, stored in its otherwise unused bytes */
+  static RecordBufferSegment *&NextInBatch(RecordBufferSegment *const segment) {
+    return *reinterpret_cast<RecordBufferSegment **>(segment->bytes_);
+  }
+
+  RecordBufferSegment *TakeFromCache(SegmentCache *cache);
+  RecordBufferSegment *TakeFromBatch(SegmentCache *cache);
+  RecordBufferSegment *Allocate();
+  void Free(RecordBufferSegment *segment);
+
+  RecordBufferSegmentAllocator alloc_;
+  std::array<SegmentCache, NUM_CACHES> caches_;
+  // Batches of free segments handed over between the caches, chained through NextInBatch
+  common::ConcurrentQueue<RecordBufferSegment *> batches_;
+  std::atomic<uint64_t> size_limit_;
+  std::atomic<uint64_t> reuse_limit_;
+  // Serializes changes to the limits, which are rare. Getting and releasing segments never takes it.
+  common::SpinLatch limits_latch_;
+  // Number of segments the pool controls, including the ones handed out
+  std::atomic<uint64_t> current_size_{0};
+  // Number of free segments in the caches and in the batches
+  std::atomic<uint64_t> num_reusable_{0};
+};
 
 // TODO(Tianyu): Not thread-safe. We can probably just allocate thread-local buffers (or segments) if we ever want
 // multiple workers on the same transaction.
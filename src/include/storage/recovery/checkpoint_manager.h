@@ -0,0 +1,153 @@
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <utility>
+
+#include "common/managed_pointer.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::catalog {
+class Catalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+class BufferedLogWriter;
+class LogManager;
+class LogRecord;
+enum class LogBlockFormat : uint8_t;
+
+/**
+ * Checkpoint Manager
+ *
+ * Takes fuzzy checkpoints of the user tables, and uses them to bound the size of the write ahead log and the amount of
+ * it that the RecoveryManager has to replay.
+ *
+ * A checkpoint is taken inside a read-only transaction, so it captures a transactionally consistent snapshot as of the
+ * transaction's start timestamp (the checkpoint timestamp) without blocking concurrent transactions. The snapshot is
+ * written in the log's own serialization format, as a single transaction that inserts every visible tuple tagged with
+ * the tuple slot it lives in, so that later log records which reference that slot are mapped during recovery. The file
+ * is named after the checkpoint timestamp, ends with a CheckpointRecord, and is only renamed into place once it is
+ * persisted.
+ *
+ * TruncateLog splices the latest checkpoint into the log: transactions that committed before the checkpoint timestamp
+ * are dropped, except for their changes to the catalog tables, which recovery needs to rebuild the tables and indexes
+ * the checkpoint is loaded into. Everything that committed after the checkpoint timestamp, or did not finish yet,
+ * follows the checkpoint. The truncated log is replayed by the RecoveryManager like any other log.
+ *
+ * Given the LogManager, every checkpoint is spliced into the log it is writing as soon as it is taken, through
+ * LogManager::RewriteLogFile. This only happens once every transaction that started before the checkpoint timestamp
+ * has been handed to the LogManager, since one that commits before the checkpoint timestamp would otherwise follow the
+ * checkpoint in the truncated log. A transaction that runs for longer than the checkpoint therefore postpones the
+ * truncation to the next checkpoint.
+ *
+ * The checkpoint transaction holds back garbage collection for as long as it runs, since every version it can see has
+ * to be kept around. Splitting the checkpoint into one transaction per table would release versions earlier, but the
+ * tables would then be snapshots at different timestamps, which neither the slot-tagged log tail nor the catalog
+ * records kept by TruncateLog can be replayed on top of. Instead, TakeCheckpoint can be given a maximum duration after
+ * which it gives up, which bounds how long garbage collection is delayed.
+ */
+class CheckpointManager {
+ public:
+  /**
+   * @param checkpoint_dir directory to write checkpoint files to, created if it does not exist
+   * @param catalog system catalog to find the tables to checkpoint
+   * @param txn_manager txn manager to begin the checkpoint transaction with
+   * @param log_manager log manager whose log is truncated to every checkpoint as soon as it is taken, nullptr to only
+   * truncate the log with TruncateLog
+   */
+  CheckpointManager(std::string checkpoint_dir, const common::ManagedPointer<catalog::Catalog> catalog,
+                    const common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    const common::ManagedPointer<LogManager> log_manager = nullptr)
+      : checkpoint_dir_(std::move(checkpoint_dir)),
+        catalog_(catalog),
+        txn_manager_(txn_manager),
+        log_manager_(log_manager) {}
+
+  /**
+   * Creates a CheckpointManager that can only look up checkpoints and truncate the log with them, e.g. at startup
+   * before the catalog exists.
+   * @param checkpoint_dir directory to read checkpoint files from
+   */
+  explicit CheckpointManager(std::string checkpoint_dir)
+      : CheckpointManager(std::move(checkpoint_dir), nullptr, nullptr) {}
+
+  /**
+   * Writes a checkpoint of every user table, then removes any older checkpoints in the checkpoint directory and, given
+   * the LogManager, truncates its log to the checkpoint. A failed truncation is logged and retried with the next
+   * checkpoint.
+   * @param max_duration time after which the checkpoint is abandoned, zero for no limit
+   * @return the checkpoint timestamp, every transaction that committed before it is contained in the checkpoint.
+   * INVALID_TXN_TIMESTAMP if the checkpoint was abandoned, in which case no checkpoint file is left behind.
+   */
+  transaction::timestamp_t TakeCheckpoint(std::chrono::milliseconds max_duration = std::chrono::milliseconds::zero());
+
+  /**
+   * @return timestamp of the newest checkpoint in the checkpoint directory, INVALID_TXN_TIMESTAMP if there is none
+   */
+  transaction::timestamp_t GetLatestCheckpoint() const;
+
+  /**
+   * @param checkpoint_ts timestamp of a checkpoint
+   * @return path to the file for the checkpoint
+   */
+  std::string GetCheckpointFilePath(transaction::timestamp_t checkpoint_ts) const {
+    return checkpoint_dir_ + "/" + CHECKPOINT_FILE_PREFIX + std::to_string(checkpoint_ts.UnderlyingValue()) +
+           CHECKPOINT_FILE_SUFFIX;
+  }
+
+  /**
+   * Rewrites the log file so that it starts from the latest checkpoint. Truncating more than once with the same
+   * checkpoint is a no-op.
+   * @warning The log file must not be appended to concurrently, i.e. it must be called before the LogManager writing to
+   * the log file is started, or after it is stopped. A running LogManager is truncated by TakeCheckpoint instead.
+   * @param log_file_path path to the log file to truncate
+   * @return false if there is no checkpoint to truncate the log with, true otherwise
+   */
+  bool TruncateLog(const std::string &log_file_path) const;
+
+ private:
+  static constexpr const char *CHECKPOINT_FILE_PREFIX = "checkpoint_";
+  static constexpr const char *CHECKPOINT_FILE_SUFFIX = ".log";
+
+  const std::string checkpoint_dir_;
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<LogManager> log_manager_;
+
+  /**
+   * Rewrites the log file so that it starts from the given checkpoint.
+   * @param log_file_path path to the log file to truncate
+   * @param checkpoint_ts timestamp of the checkpoint to truncate the log with
+   * @param format how the buffers flushed to the log file are laid out, which the truncated log file keeps
+   */
+  void TruncateLog(const std::string &log_file_path, transaction::timestamp_t checkpoint_ts,
+                   LogBlockFormat format) const;
+
+  /**
+   * Truncates the log of the running LogManager to the given checkpoint, unless a transaction that started before the
+   * checkpoint is still running.
+   * @param checkpoint_ts timestamp of the checkpoint that was just taken
+   */
+  void TruncateRunningLog(transaction::timestamp_t checkpoint_ts) const;
+
+  /**
+   * Serializes the redo record of a live tuple in the same format as the LogSerializerTask.
+   * @warning If the serialization format of logs ever changes, this function will need to be updated.
+   * @param out writer to serialize the record to
+   * @param record redo record whose tuple slot points to the tuple it was read from
+   */
+  static void SerializeRedoRecord(BufferedLogWriter *out, const LogRecord &record);
+
+  /**
+   * @param name name of a file in the checkpoint directory
+   * @return timestamp of the checkpoint in the file, INVALID_TXN_TIMESTAMP if it is not named like a checkpoint
+   */
+  static transaction::timestamp_t ParseCheckpointFileName(const std::string &name);
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>              //NOLINT
+#include <condition_variable>  //NOLINT
+#include <mutex>               //NOLINT
+#include <thread>              //NOLINT
+
+#include "common/managed_pointer.h"
+
+namespace noisepage::storage {
+class CheckpointManager;
+
+/**
+ * Class for spinning off a thread that takes a checkpoint at a fixed interval. Given the LogManager, the
+ * CheckpointManager truncates the log to every checkpoint it takes.
+ */
+class CheckpointThread {
+ public:
+  /**
+   * @param checkpoint_manager pointer to the checkpoint manager to take checkpoints with
+   * @param checkpoint_period sleep time between checkpoints
+   * @param checkpoint_max_duration time after which a checkpoint is abandoned, zero for no limit
+   */
+  CheckpointThread(common::ManagedPointer<CheckpointManager> checkpoint_manager,
+                   std::chrono::milliseconds checkpoint_period, std::chrono::milliseconds checkpoint_max_duration);
+
+  ~CheckpointThread() { StopCheckpoints(); }
+
+  /**
+   * Kill the checkpoint thread, waiting for a checkpoint that is being taken to finish.
+   */
+  void StopCheckpoints();
+
+ private:
+  const common::ManagedPointer<CheckpointManager> checkpoint_manager_;
+  const std::chrono::milliseconds checkpoint_period_;
+  const std::chrono::milliseconds checkpoint_max_duration_;
+  std::mutex mutex_;
+  std::condition_variable stop_cv_;
+  bool run_checkpoints_ = true;
+  std::thread checkpoint_thread_;
+
+  void CheckpointThreadLoop();
+};
+
+}  // namespace noisepage::storage
@@ -18,6 +18,7 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/shared_latch.h"
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/sql_table.h"
 
@@ -83,6 +84,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param replication_manager replication manager to acknowledge applied changes
    * @param thread_registry thread registry to register tasks
    * @param store block store used for SQLTable creation during recovery
+   * @param replay_threads number of threads used to replay committed transactions, 1 replays everything serially
    */
   explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider> log_provider,
                            const common::ManagedPointer<catalog::Catalog> catalog,
@@ -90,14 +92,16 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                            const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                            const common::ManagedPointer<replication::ReplicationManager> replication_manager,
                            const common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry,
-                           const common::ManagedPointer<BlockStore> store)
+                           const common::ManagedPointer<BlockStore> store, const uint32_t replay_threads = 1)
       : DedicatedThreadOwner(thread_registry),
         log_provider_(log_provider),
         catalog_(catalog),
         txn_manager_(txn_manager),
         deferred_action_manager_(deferred_action_manager),
         replication_manager_(replication_manager),
-        block_store_(store) {
+        block_store_(store),
+        replay_threads_(replay_threads) {
+    NOISEPAGE_ASSERT(replay_threads_ > 0, "Recovery needs at least one replay thread.");
     // Initialize catalog_table_schemas_ map
     catalog_table_schemas_[catalog::postgres::PgClass::CLASS_TABLE_OID] =
         catalog::postgres::Builder::GetClassTableSchema();
@@ -125,6 +129,9 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   /** @return The ID of the last transaction that was applied. */
   transaction::timestamp_t GetLastAppliedTransactionId() const { return last_applied_txn_id_; }
 
+  /** @return The number of threads used to replay committed transactions. */
+  uint32_t GetReplayThreads() const { return replay_threads_; }
+
  private:
   FRIEND_TEST(RecoveryTests, DoubleRecoveryTest);
   friend class RecoveryTests;
@@ -150,10 +157,22 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // tables during recovery
   const common::ManagedPointer<BlockStore> block_store_;
 
+  // Number of threads used to replay committed transactions. Transactions that only modify user tables are grouped into
+  // lanes that touch disjoint sets of tables, and lanes are replayed concurrently. Transactions that modify the catalog
+  // are always replayed serially.
+  const uint32_t replay_threads_;
+
+  // When replaying from disk with multiple threads, committed transactions are buffered until at least this many per
+  // replay thread are ready, so that each parallel batch has enough work to spread across the lanes.
+  static constexpr uint32_t REPLAY_BATCH_TXNS_PER_THREAD = 256;
+
   // Used during recovery from log. Maps old tuple slot to new tuple slot
   // TODO(Gus): This map may get huge, benchmark whether this becomes a problem and if we need a more sophisticated data
   // structure
   std::unordered_map<TupleSlot, TupleSlot> tuple_slot_map_;
+  // Protects tuple_slot_map_ from concurrent replay threads. Special case catalog records are only replayed while no
+  // other replay thread is running, so they access the map without the latch.
+  mutable common::SharedLatch tuple_slot_map_latch_;
 
   // Used during recovery from log. Stores deferred transactions in sorted sorted order to be able to execute them in
   // serial order. Transactions are defered when there is an older active transaction at the time it committed. Even
@@ -205,6 +224,36 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    */
   uint32_t ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+  /**
+   * Replays the buffered changes of a committed transaction in a new transaction and commits it. This is safe to call
+   * concurrently for transactions that modify disjoint sets of user tables.
+   * @param buffered_changes buffered log records of the committed transaction
+   * @return number of records replayed
+   */
+  uint32_t ReplayCommittedTransaction(std::vector<std::pair<LogRecord *, std::vector<byte *>>> *buffered_changes);
+
+  /**
+   * Cleans up the buffered changes of a replayed transaction and acknowledges it. Must be called serially, in order.
+   * @param txn_id start timestamp for the replayed transaction
+   */
+  void FinishCommittedTransaction(transaction::timestamp_t txn_id);
+
+  /**
+   * Replays a batch of committed transactions using replay_threads_ threads. Transactions that only touch user tables
+   * are partitioned into lanes that modify disjoint sets of tables. Each lane is replayed in order, and different lanes
+   * are replayed concurrently. Transactions that modify catalog tables act as barriers and are replayed serially.
+   * @param txns start timestamps of the committed transactions, in replay order
+   * @return number of records replayed
+   */
+  uint32_t ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txns);
+
+  /**
+   * Replays the given lanes concurrently, then finishes their transactions in timestamp order.
+   * @param lanes lanes of transactions, each in replay order, that modify disjoint sets of user tables
+   * @return number of records replayed
+   */
+  uint32_t ReplayLanes(std::vector<std::vector<transaction::timestamp_t>> *lanes);
+
   /**
    * Defers log records deletes with the transaction manager
    * @param txn_id txn_id for txn who's records to delete
@@ -226,8 +275,17 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @return new tuple slot
    */
   TupleSlot GetTupleSlotMapping(TupleSlot slot) {
+    common::SharedLatch::ScopedSharedLatch guard(&tuple_slot_map_latch_);
     NOISEPAGE_ASSERT(tuple_slot_map_.find(slot) != tuple_slot_map_.end(), "No tuple slot mapping exists");
-    return tuple_slot_map_[slot];
+    return tuple_slot_map_.at(slot);
+  }
+
+  /**
+   * @param table_oid oid of a table
+   * @return true if the table is one of the catalog tables
+   */
+  static bool IsCatalogTable(catalog::table_oid_t table_oid) {
+    return table_oid.UnderlyingValue() < catalog::START_OID;
   }
 
   /**
@@ -245,6 +303,23 @@ class RecoveryManager : public common::DedicatedThreadOwner {
     return db_catalog_ptr;
   }
 
+  /**
+   * Fetches the database catalog needed to replay a change to a table. Only changes to catalog tables take the DDL lock
+   * of the database, which allows transactions that modify user tables to be replayed concurrently.
+   * @param txn txn for catalog lookup
+   * @param db_oid oid for database we want
+   * @param table_oid oid of the table being modified
+   * @return pointer to database catalog
+   */
+  common::ManagedPointer<catalog::DatabaseCatalog> GetDatabaseCatalogForTable(transaction::TransactionContext *txn,
+                                                                              catalog::db_oid_t db_oid,
+                                                                              catalog::table_oid_t table_oid) {
+    if (IsCatalogTable(table_oid)) return GetDatabaseCatalog(txn, db_oid);
+    auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    NOISEPAGE_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
+    return db_catalog_ptr;
+  }
+
   /**
    * @param txn transaction to use for catalog lookup
    * @param db_oid database oid for requested table
@@ -316,6 +391,7 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @return true if record is an insert redo, false if it is an update redo
    */
   bool IsInsertRecord(const RedoRecord *record) const {
+    common::SharedLatch::ScopedSharedLatch guard(&tuple_slot_map_latch_);
     return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
   }
 
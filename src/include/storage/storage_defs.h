@@ -5,6 +5,7 @@
 #include <ostream>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "common/constants.h"
@@ -164,16 +165,72 @@ class TupleSlot {
   uintptr_t bytes_;
 };
 
+/**
+ * How the memory of blocks is allocated
+ */
+enum class BlockAllocationMode : uint8_t {
+  /** Every block is allocated on the heap, and freed when deleted */
+  HEAP,
+  /**
+   * Blocks are carved out of arenas backed by 2 MB huge pages, which cuts the TLB misses of scans over many blocks.
+   * Explicit huge pages are used if the system reserved any, transparent huge pages otherwise. Deleted blocks are kept
+   * for reuse, and the memory is only returned to the OS when the allocator is destroyed.
+   */
+  HUGE_PAGES
+};
+
+/**
+ * Where the memory of new blocks is placed on machines with several NUMA nodes. Placement is best effort: it is skipped
+ * if the system does not support it, and does not move memory that is already resident.
+ */
+enum class BlockNumaPolicy : uint8_t {
+  /** Memory is placed on the node of the thread that first touches it, which is the default of the OS */
+  FIRST_TOUCH,
+  /** Memory is spread page by page over all nodes the process may use */
+  INTERLEAVE,
+  /**
+   * Memory is placed on one node if it has any left. Tables whose blocks should live on a node are created with a
+   * BlockStore pinned to it.
+   */
+  PINNED
+};
+
 /**
  * Allocator that allocates a block
+ *
+ * Not thread-safe. The BlockStore only uses it under its latch.
  */
 class BlockAllocator {
  public:
+  /** Number of blocks mapped at once in HUGE_PAGES mode */
+  static constexpr uint32_t BLOCKS_PER_ARENA = 32;
+
+  /**
+   * @param mode how the memory of blocks is allocated
+   * @param numa_policy where the memory of new blocks is placed
+   * @param numa_node node the memory is placed on with BlockNumaPolicy::PINNED, ignored otherwise
+   */
+  explicit BlockAllocator(BlockAllocationMode mode = BlockAllocationMode::HEAP,
+                          BlockNumaPolicy numa_policy = BlockNumaPolicy::FIRST_TOUCH, uint32_t numa_node = 0);
+
+  DISALLOW_COPY(BlockAllocator)
+
+  /**
+   * Moves the allocator, which must not have allocated anything yet
+   * @param other allocator to move from
+   */
+  BlockAllocator(BlockAllocator &&other) = default;
+
+  /**
+   * Unmaps all arenas. Blocks still in use from them must not be accessed anymore.
+   */
+  ~BlockAllocator();
+
   /**
    * Allocates a new object by calling its constructor.
-   * @return a pointer to the allocated object.
+   * @return a pointer to the allocated object, or nullptr if no memory could be mapped for it
    */
-  RawBlock *New() { return new RawBlock(); }
+  RawBlock *New();
 
   /**
    * Reuse a reused chunk of memory to be handed out again
@@ -186,13 +243,28 @@ class BlockAllocator {
    * Deletes the object by calling its destructor.
    * @param ptr a pointer to the object to be deleted.
    */
-  void Delete(RawBlock *const ptr) { delete ptr; }
+  void Delete(RawBlock *ptr);
+
+ private:
+  // Maps an arena in HUGE_PAGES mode, and adds its blocks to the free blocks
+  bool MapArena();
+  // Applies the NUMA policy to fresh memory
+  void Place(void *memory, uint64_t size) const;
+
+  BlockAllocationMode mode_;
+  BlockNumaPolicy numa_policy_;
+  // Nodes the memory is placed on, as a bitmask of node ids
+  std::vector<uint64_t> numa_nodes_;
+  // Arenas mapped in HUGE_PAGES mode, and their blocks that are not handed out
+  std::vector<void *> arenas_;
+  std::vector<RawBlock *> free_blocks_;
 };
 
 /**
  * A block store is essentially an object pool. However, all blocks should be
  * aligned, so we will need to use the default constructor instead of raw
- * malloc.
+ * malloc. How the blocks are allocated is decided by the BlockAllocator it is
+ * constructed with.
  */
 using BlockStore = common::ObjectPool<RawBlock, BlockAllocator>;
 /**
@@ -212,7 +284,7 @@ enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE };
 /**
  * Types of LogRecords
  */
-enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT };
+enum class LogRecordType : uint8_t { REDO = 1, DELETE, COMMIT, ABORT, CHECKPOINT };
 
 }  // namespace noisepage::storage
 
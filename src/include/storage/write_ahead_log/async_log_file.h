@@ -0,0 +1,109 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/macros.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace noisepage::storage {
+
+/**
+ * Appends to the log file through io_uring, so that the DiskLogConsumerTask can keep many buffer writes in flight and
+ * keep writing buffers while the log file is being persisted.
+ *
+ * Writes are issued at explicit offsets past the end of the file as it was when it was opened, so they land in the
+ * order they were issued even though they can complete in any order. A persist is only issued once every write before
+ * it completed, which makes everything written until then durable once the persist completes. Writes issued while a
+ * persist is in flight are not covered by it.
+ *
+ * Only a single thread may use an AsyncLogFile, and nothing else may append to the file while it is open.
+ */
+class AsyncLogFile {
+ public:
+  DISALLOW_COPY_AND_MOVE(AsyncLogFile);
+
+  /**
+   * Opens the log file for appending through io_uring.
+   * @param log_file_path path to the log file, created if it does not exist
+   * @param queue_depth maximum number of writes in flight
+   * @return the opened log file, or nullptr if io_uring is not available (e.g. the kernel is too old or the system call
+   * is blocked), in which case the log file should be written to with blocking writes instead
+   */
+  static std::unique_ptr<AsyncLogFile> Open(const std::string &log_file_path, uint32_t queue_depth);
+
+  /** Waits for all I/O in flight, then closes the log file and the ring. */
+  ~AsyncLogFile();
+
+  /**
+   * Issues a write of the given bytes to the end of the log file. Waits for a write to complete if the ring is full.
+   * @param data bytes to write, which must stay valid until the write completes
+   * @param size number of bytes to write
+   * @param tag handed back by ReapCompletions once the write has completed
+   */
+  void Write(const void *data, uint32_t size, void *tag);
+
+  /**
+   * Waits for all writes in flight to complete and issues a persist of the log file. The persist is in flight until
+   * ReapCompletions reports it completed.
+   * @warning Must not be called while another persist is in flight
+   */
+  void StartPersist();
+
+  /** @return true if a persist was issued that was not yet reported completed by ReapCompletions */
+  bool PersistInFlight() const { return persist_in_flight_ || persist_completed_; }
+
+  /** @return true if any write or persist was issued that did not complete yet */
+  bool IoInFlight() const { return num_in_flight_ > 0; }
+
+  /** Blocks until at least one write or persist completes, if any is in flight. */
+  void WaitForCompletion();
+
+  /**
+   * Collects the I/O that completed since the last call.
+   * @param[out] completed_writes tags of the completed writes are appended to it
+   * @param wait_for_persist if true, block until the persist in flight (if any) completes
+   * @return true if the persist in flight completed
+   * @throws runtime_error if any of the I/O failed
+   */
+  bool ReapCompletions(std::vector<void *> *completed_writes, bool wait_for_persist);
+
+ private:
+  struct PendingWrite;
+
+  AsyncLogFile(int ring_fd, int file_fd, uint64_t file_size, uint32_t queue_depth);
+
+  bool MapRings(uint32_t sq_ring_size, uint32_t cq_ring_size, uint32_t num_sqes, bool single_mmap);
+  io_uring_sqe *NextSqe();
+  void Submit(uint32_t to_submit, uint32_t wait_for);
+  void HandleCompletion(const io_uring_cqe &cqe);
+  void DrainCompletionQueue();
+  void SubmitWrite(PendingWrite *write);
+
+  const int ring_fd_;
+  const int file_fd_;
+  const uint32_t queue_depth_;
+  // Offset the next write is issued at
+  uint64_t next_offset_;
+  // Number of writes and persists that were issued and did not complete yet
+  uint32_t num_in_flight_ = 0;
+  // Whether the persist issued last did not complete yet, and whether it completed but was not reported yet
+  bool persist_in_flight_ = false;
+  bool persist_completed_ = false;
+  // Tags of writes that completed but were not handed back yet
+  std::vector<void *> completed_writes_;
+
+  // Memory mapped rings shared with the kernel
+  void *sq_ring_ = nullptr, *cq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0, cq_ring_size_ = 0;
+  io_uring_sqe *sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  uint32_t *sq_head_, *sq_tail_, *sq_mask_, *sq_array_;
+  uint32_t *cq_head_, *cq_tail_, *cq_mask_;
+  io_uring_cqe *cqes_;
+};
+
+}  // namespace noisepage::storage
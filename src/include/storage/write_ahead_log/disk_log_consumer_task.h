@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>              // NOLINT
 #include <condition_variable>  // NOLINT
+#include <exception>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -8,6 +12,7 @@
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/async_log_file.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::storage {
@@ -15,6 +20,17 @@ namespace noisepage::storage {
 /**
  * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the log
  * manager's filled buffer queue
+ *
+ * Commits are made durable in groups. The task keeps moving averages of the rate at which commits that someone waits
+ * on (i.e. not DurabilityPolicy::ASYNC) arrive and of how long a persist takes. A group is persisted as soon as it
+ * holds as many commits as are expected to arrive during one persist, or once its oldest commit has waited for as long
+ * as one persist takes (but never longer than the persist interval). Under light load every commit is persisted right
+ * away, under heavy load the cost of a persist is spread over the commits that would have queued up behind it anyway.
+ * The callbacks of a group are invoked as soon as it is persisted.
+ *
+ * With an AsyncLogFile, many buffer writes are in flight at once, and a buffer only returns to the empty buffer queue
+ * once its write completed. The persist of a group is in flight while the buffers of the next group are written, and
+ * its callbacks are invoked once it completes.
  */
 class DiskLogConsumerTask : public common::DedicatedThreadTask {
  public:
@@ -25,18 +41,23 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param async_log_file log file to issue writes and persists to asynchronously, or nullptr to write through the
+   * buffers with blocking I/O
    */
   explicit DiskLogConsumerTask(const std::chrono::microseconds persist_interval, uint64_t persist_threshold,
                                std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               AsyncLogFile *async_log_file = nullptr)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
         current_data_written_(0),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        async_log_file_(async_log_file),
+        commit_latency_histogram_(NUM_COMMIT_LATENCY_BUCKETS, 0) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -48,8 +69,18 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    */
   void Terminate() override;
 
+  /**
+   * Number of buckets in the commit-to-durable latency histogram. Bucket 0 counts latencies under 1us, bucket i counts
+   * latencies in [2^(i-1), 2^i) us, and the last bucket also counts everything above it.
+   */
+  static constexpr uint32_t NUM_COMMIT_LATENCY_BUCKETS = 24;
+
  private:
   friend class LogManager;
+  FRIEND_TEST(WriteAheadLoggingTests, GroupCommitDecisionTest);
+  // Weight of the newest sample in the moving averages used to size commit groups
+  static constexpr double GROUP_COMMIT_SMOOTHING = 0.2;
+
   // Flag to signal task to run or stop
   bool run_task_;
   // Stores callbacks for commit records written to disk but not yet persisted
@@ -68,9 +99,36 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue_;
   // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
+  // Log file writes and persists are issued to asynchronously, nullptr if they go through the buffers
+  AsyncLogFile *async_log_file_;
+  // Callbacks of the commits covered by the persist in flight on async_log_file_
+  std::vector<storage::CommitCallback> persisting_callbacks_;
+  // Time the persist in flight on async_log_file_ was issued
+  std::chrono::high_resolution_clock::time_point persist_start_;
+  // Reused to collect the buffers whose writes to async_log_file_ completed
+  std::vector<void *> completed_writes_;
 
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
-  volatile bool force_flush_;
+  volatile bool force_flush_ = false;
+  // Rewrite of the log file requested through LogManager::RewriteLogFile, nullptr if none is pending
+  std::function<void()> rewrite_log_file_;
+  // Exception thrown by the last rewrite of the log file, handed back to whoever requested it
+  std::exception_ptr rewrite_log_file_error_;
+
+  // Number of commit callbacks waiting to be persisted that a client is blocked on
+  uint64_t num_waiting_commits_ = 0;
+  // Creation time of the oldest commit record a client is blocked on. Only meaningful if num_waiting_commits_ > 0
+  std::chrono::high_resolution_clock::time_point oldest_waiting_commit_;
+  // Moving average of the arrival rate of commits a client is blocked on, in commits per microsecond
+  double commit_arrival_rate_ = 0;
+  // Time at which commit_arrival_rate_ was last sampled
+  std::chrono::high_resolution_clock::time_point last_arrival_sample_;
+  // Moving average of the time it takes to persist the log file, in microseconds
+  double persist_latency_us_ = 0;
+  // Time the last persist took, in microseconds, used for metrics
+  uint64_t last_persist_us_ = 0;
+  // Commit-to-durable latencies of the commits in the last persisted group, used for metrics
+  std::vector<uint64_t> commit_latency_histogram_;
 
   // Synchronisation primitives to synchronise persisting buffers to disk
   std::mutex persist_lock_;
@@ -87,14 +145,82 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
 
   /**
    * Flush all buffers in the filled buffers queue to the log file
+   * @return number of commits a client is blocked on that were handed over with the buffers
+   */
+  uint64_t WriteBuffersToLogFile();
+
+  /**
+   * Folds the commits that arrived since the last sample into the moving average of the commit arrival rate
+   * @param num_commits number of commits a client is blocked on that arrived since the last sample
+   * @param now current time
+   */
+  void SampleCommitArrivals(uint64_t num_commits, std::chrono::high_resolution_clock::time_point now);
+
+  /**
+   * @return number of waiting commits at which a group is persisted without waiting any longer
+   */
+  double TargetGroupSize() const { return std::max(1.0, commit_arrival_rate_ * persist_latency_us_); }
+
+  /**
+   * @return longest time the oldest commit of a group waits for more commits to join the group
    */
-  void WriteBuffersToLogFile();
+  std::chrono::microseconds MaxGroupWait() const {
+    return std::min(persist_interval_, std::chrono::microseconds(static_cast<int64_t>(persist_latency_us_)));
+  }
+
+  /**
+   * @param now current time
+   * @return how much longer the current group waits for more commits to join it, zero if it should be persisted now
+   */
+  std::chrono::microseconds RemainingGroupWait(std::chrono::high_resolution_clock::time_point now) const;
 
   /*
    * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-   * were persisted
+   * were persisted. Updates the persist latency estimate and the commit-to-durable latency histogram.
    * @return number of buffers persisted, used for metrics
    */
   uint64_t PersistLogFile();
+
+  /**
+   * Issues a persist of the log file on async_log_file_ covering the current group, after waiting for the persist
+   * already in flight (if any) and calling the callbacks it covers.
+   * @param wait_for_persist if true, also wait for the new persist and call the callbacks it covers
+   * @return number of callbacks called, used for metrics
+   */
+  uint64_t StartPersistLogFile(bool wait_for_persist);
+
+  /**
+   * Writes out and persists the buffers handed over since the last persist, then runs the pending rewrite of the log
+   * file while no I/O on it is in flight. An exception thrown by the rewrite is kept in rewrite_log_file_error_.
+   * @return number of callbacks called, used for metrics
+   */
+  uint64_t RewriteLogFile();
+
+  /**
+   * Releases the buffers whose writes to async_log_file_ completed, and calls the callbacks covered by the persist in
+   * flight if it completed.
+   * @param wait_for_persist if true, wait for the persist in flight to complete
+   * @return number of callbacks called, used for metrics
+   */
+  uint64_t ReapAsyncLogFile(bool wait_for_persist);
+
+  /**
+   * Hands a flushed buffer back to the empty buffer queue if all serializers are done with it
+   * @param buffer buffer that was written to the log file
+   */
+  void ReleaseBuffer(BufferedLogWriter *buffer);
+
+  /**
+   * Calls the given callbacks and counts their commit-to-durable latencies in the histogram
+   * @param callbacks callbacks of commits that were persisted, cleared afterwards
+   * @return number of callbacks called
+   */
+  uint64_t InvokeCommitCallbacks(std::vector<storage::CommitCallback> *callbacks);
+
+  /**
+   * Folds a persist into the persist latency estimate
+   * @param persist_us time the persist took, in microseconds
+   */
+  void RecordPersistLatency(double persist_us);
 };
 }  // namespace noisepage::storage
@@ -8,11 +8,13 @@
 
 #include <atomic>
 #include <cerrno>
+#include <chrono>  // NOLINT
 #include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "common/compression_util.h"
 #include "common/constants.h"
 #include "common/macros.h"
 #include "common/posix_io_wrappers.h"
@@ -25,6 +27,37 @@ class RecordsBatchMsg;
 
 namespace noisepage::storage {
 
+class AsyncLogFile;
+
+/** How a BufferedLogWriter lays out the buffers it flushes in the log file. */
+enum class LogBlockFormat : uint8_t {
+  RAW,          ///< Buffers are written out as they are.
+  CHECKSUMMED,  ///< Every buffer is written out as a block with a CRC32C checksum, so torn writes can be detected.
+  COMPRESSED    ///< Like CHECKSUMMED, but the contents of a block are compressed if that makes them smaller.
+};
+
+/**
+ * Header of every block in a log file that is not in the LogBlockFormat::RAW format. Whether a log file is made of
+ * blocks is told apart by the magic number at the start of the file, which is far larger than any record size a raw log
+ * file would start with. The checksum covers the rest of the header and the stored bytes that follow it.
+ */
+struct LogBlockHeader {
+  /** Magic number every block starts with. */
+  static constexpr uint32_t MAGIC = 0x4B4C424E;
+  /** Flag that is set if the stored bytes of a block are compressed. */
+  static constexpr uint32_t FLAG_COMPRESSED = 1;
+
+  uint32_t magic_;        ///< Always MAGIC.
+  uint32_t checksum_;     ///< CRC32C of the bytes that follow this field, up to the end of the block.
+  uint32_t flags_;        ///< Flags describing the stored bytes.
+  uint32_t raw_size_;     ///< Size of the buffer the block was written from.
+  uint32_t stored_size_;  ///< Number of bytes that follow the header.
+};
+
+/** Largest number of bytes a block of a log buffer can take up in the log file. */
+constexpr uint32_t MAX_LOG_BLOCK_SIZE =
+    sizeof(LogBlockHeader) + common::CompressionUtil::MaxCompressedSize(common::Constants::LOG_BUFFER_SIZE);
+
 // TODO(Tianyu):  we need control over when and what to flush as the log manager. Thus, we need to write our
 // own wrapper around lower level I/O functions. I could be wrong, and in that case we should
 // revert to using STL.
@@ -38,9 +71,14 @@ class BufferedLogWriter {
    *
    * @param log_file_path path to the the log file to write to. New entries are appended to the end of the file if the
    * file already exists; otherwise, a file is created.
+   * @param format how to lay out flushed buffers in the log file. A log file is either entirely raw or entirely made of
+   * blocks, so the format is overridden to match the existing contents of the file.
    */
-  explicit BufferedLogWriter(const char *const log_file_path)
-      : out_(PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR)) {}
+  explicit BufferedLogWriter(const char *const log_file_path, const LogBlockFormat format = LogBlockFormat::RAW)
+      : out_(PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR)),
+        format_(ResolveFormat(log_file_path, format)) {
+    if (format_ != LogBlockFormat::RAW) block_.resize(MAX_LOG_BLOCK_SIZE);
+  }
 
   /**
    * Move constructor.
@@ -50,7 +88,8 @@ class BufferedLogWriter {
    * moved at runtime -- this exists solely so that std::vector's emplace_back requirement of being both MoveInsertable
    * and EmplaceConstructible will be satisfied.
    */
-  BufferedLogWriter(BufferedLogWriter &&other) noexcept : out_(other.out_) {
+  BufferedLogWriter(BufferedLogWriter &&other) noexcept
+      : out_(other.out_), format_(other.format_), block_(std::move(other.block_)) {
     memcpy(buffer_, other.buffer_, common::Constants::LOG_BUFFER_SIZE);
     buffer_size_ = other.buffer_size_;
     serialize_refcount_.store(other.serialize_refcount_.load());
@@ -61,6 +100,16 @@ class BufferedLogWriter {
    */
   void Close() { PosixIoWrappers::Close(out_); }
 
+  /**
+   * Reopens the log file, so that buffers flushed afterwards are written to whatever file is at the path now, e.g.
+   * after the log file was replaced by a rewritten one. Must not be called while the buffer is being flushed.
+   * @param log_file_path path to the log file to write to
+   */
+  void Reopen(const char *const log_file_path) {
+    PosixIoWrappers::Close(out_);
+    out_ = PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+  }
+
   /**
    * Write to the log file the given amount of bytes from the given location in memory, but buffer the write so the
    * update is only written out when the BufferedLogWriter is persisted. Note that this function writes to the buffer
@@ -98,15 +147,32 @@ class BufferedLogWriter {
 
   /**
    * Flush any buffered writes.
-   * @return amount of data flushed
+   * @return amount of data written to the log file
    */
   uint64_t FlushBuffer() {
-    const auto size = buffer_size_;
-    WriteUnsynced(buffer_, buffer_size_);
+    const auto [data, size] = EncodeBuffer();
+    WriteUnsynced(data, size);
     buffer_size_ = 0;
     return size;
   }
 
+  /**
+   * Flush any buffered writes through the given log file instead of this writer's own file descriptor. The write is
+   * tagged with this writer, and the buffer must not be written to again until the log file reports it completed.
+   * @param log_file log file to issue the write to
+   * @return amount of data handed to the log file
+   */
+  uint64_t FlushBuffer(AsyncLogFile *log_file);
+
+  /** @return how flushed buffers are laid out in the log file */
+  LogBlockFormat GetFormat() const { return format_; }
+
+  /**
+   * @param log_file_path path to a log file
+   * @return true if the log file is made of blocks, false if it is raw or empty
+   */
+  static bool IsBlockFormatted(const char *log_file_path);
+
   /**
    * @return if the buffer is full
    */
@@ -158,8 +224,11 @@ class BufferedLogWriter {
  private:
   friend class replication::RecordsBatchMsg;
 
-  const int out_;  // fd of the output files
+  int out_;  // fd of the output files
+  const LogBlockFormat format_;
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
+  // Block the buffer is encoded into before it is written out, empty if the format is raw
+  std::vector<byte> block_;
 
   uint32_t buffer_size_ = 0;
   std::atomic<int8_t> serialize_refcount_ = 0;  ///< The number of would-be serializers that haven't serialized yet.
@@ -167,6 +236,21 @@ class BufferedLogWriter {
   bool CanBuffer(uint32_t size) { return common::Constants::LOG_BUFFER_SIZE - buffer_size_ >= size; }
 
   void WriteUnsynced(const void *data, uint32_t size) { PosixIoWrappers::WriteFully(out_, data, size); }
+
+  /**
+   * Lays out the buffer in the format of the log file. Either way the result is written out in a single write, so a
+   * block is never interleaved with the writes of other BufferedLogWriters appending to the same file.
+   * @return location and size of the bytes to write out
+   */
+  std::pair<const void *, uint32_t> EncodeBuffer() {
+    if (format_ == LogBlockFormat::RAW) return {buffer_, buffer_size_};
+    return {block_.data(), EncodeBlock()};
+  }
+
+  /** @return size of the block the buffer was encoded into */
+  uint32_t EncodeBlock();
+
+  static LogBlockFormat ResolveFormat(const char *log_file_path, LogBlockFormat format);
 };
 
 /**
@@ -178,7 +262,11 @@ class BufferedLogReader {
    * Instantiates a new BufferedLogReader to read from the specified log file.
    * @param log_file_path path to the the log file to read from.
    */
-  explicit BufferedLogReader(const char *log_file_path) : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)) {}
+  explicit BufferedLogReader(const char *log_file_path)
+      : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)),
+        block_formatted_(BufferedLogWriter::IsBlockFormatted(log_file_path)) {
+    if (block_formatted_) block_.resize(MAX_LOG_BLOCK_SIZE);
+  }
 
   /**
    * Closes log file if it has not been closed already. While Read will close the file if it reaches the end, this will
@@ -191,13 +279,20 @@ class BufferedLogReader {
   /**
    * @return if there are contents left in the write ahead log
    */
-  bool HasMore() { return filled_size_ > read_head_ || in_ != -1; }
+  bool HasMore() {
+    // The size of a block formatted file does not tell whether there is another block, so read ahead to find out
+    if (block_formatted_ && read_head_ == filled_size_ && in_ != -1) RefillBuffer();
+    return filled_size_ > read_head_ || in_ != -1;
+  }
 
   /**
    * Read the specified number of bytes into the target location from the write ahead log. The method reads as many as
    * possible if there are not enough bytes in the log and returns false. The underlying log file fd is automatically
    * closed when all remaining bytes are buffered.
    *
+   * Blocks of a block formatted file are verified and decompressed transparently. The log ends at the first block that
+   * is incomplete or fails verification, which is what a write torn by a crash leaves behind.
+   *
    * @param dest pointer location to read into
    * @param size number of bytes to read
    * @return whether the log has the given number of bytes left
@@ -220,8 +315,11 @@ class BufferedLogReader {
 
  private:
   int in_;  // or -1 if closed
+  const bool block_formatted_;
   uint32_t read_head_ = 0, filled_size_ = 0;
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
+  // Stored bytes of the last block read, empty if the file is raw
+  std::vector<byte> block_;
 
   void ReadFromBuffer(void *dest, uint32_t size) {
     NOISEPAGE_ASSERT(read_head_ + size <= filled_size_, "Not enough bytes in buffer for the read");
@@ -230,6 +328,11 @@ class BufferedLogReader {
   }
 
   void RefillBuffer();
+
+  /**
+   * Reads the next block into the buffer. Closes the log file if there is no intact block left.
+   */
+  void RefillBufferFromBlock();
 };
 
 /** A commit callback is of the form fn_(arg_), and is invoked when the corresponding commit record is persisted. */
@@ -238,6 +341,8 @@ struct CommitCallback {
   void *arg_;                                ///< The argument to invoke the commit callback with.
   transaction::timestamp_t txn_start_time_;  ///< (Metadata) The transaction ID that generated this commit callback.
   bool is_from_read_only_;                   ///< True if the commit callback was from a read only commit record.
+  /** (Metadata) When the commit record was created, used to measure commit-to-durable latency. */
+  std::chrono::high_resolution_clock::time_point commit_time_;
 };
 
 /**
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <queue>
 #include <string>
@@ -14,6 +15,7 @@
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/record_buffer.h"
+#include "storage/write_ahead_log/async_log_file.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
 
@@ -61,13 +63,16 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param primary_replication_manager     The replication manager that handles shipping logs over the network.
    *                                        Currently only the primary does this.
    * @param thread_registry                 DedicatedThreadRegistry dependency injection
+   * @param block_format                    How buffers are laid out in the log file
+   * @param use_io_uring                    Whether to write the log file through io_uring, if the kernel supports it
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::microseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
              common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
              common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
-             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry)
+             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+             const LogBlockFormat block_format = LogBlockFormat::RAW, const bool use_io_uring = false)
       : DedicatedThreadOwner(thread_registry),
         run_log_manager_(false),
         log_file_path_(std::move(log_file_path)),
@@ -77,7 +82,9 @@ class LogManager : public common::DedicatedThreadOwner {
         serialization_interval_(serialization_interval),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
-        primary_replication_manager_(primary_replication_manager) {}
+        primary_replication_manager_(primary_replication_manager),
+        block_format_(block_format),
+        use_io_uring_(use_io_uring) {}
 
   /**
    * Starts log manager. Does the following in order:
@@ -95,6 +102,16 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   void ForceFlush();
 
+  /**
+   * Serializes and persists the logs like ForceFlush, then rewrites the log file while nothing is written to it, e.g.
+   * to truncate it to a checkpoint. The log file is reopened afterwards, so the rewrite may replace it with a new file.
+   * Logs that are handed over in the meantime are written to the rewritten log file once the rewrite is done.
+   * @warning This blocks the persist of every commit until the rewrite is done
+   * @param rewrite rewrites the log file at the given path, whose flushed buffers are laid out in the given format
+   * @throws whatever the rewrite threw, in which case the log is appended to whatever file is at the path
+   */
+  void RewriteLogFile(const std::function<void(const std::string &, LogBlockFormat)> &rewrite);
+
   /**
    * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order:
    *    1. Stops LogSerializerTask
@@ -131,7 +148,7 @@ class LogManager : public common::DedicatedThreadOwner {
     if (new_num_buffers >= num_buffers_) {
       // Add in new buffers
       for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-        buffers_.emplace_back(log_file_path_.c_str());
+        buffers_.emplace_back(log_file_path_.c_str(), block_format_);
         empty_buffer_queue_->Enqueue(&buffers_[num_buffers_ + i]);
       }
       num_buffers_ = new_num_buffers;
@@ -189,6 +206,13 @@ class LogManager : public common::DedicatedThreadOwner {
 
   common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager_;
 
+  // How buffers are laid out in the log file
+  const LogBlockFormat block_format_;
+  // Whether to write the log file through io_uring
+  const bool use_io_uring_;
+  // Log file the disk consumer task writes to asynchronously while running, nullptr if it uses blocking writes
+  std::unique_ptr<AsyncLogFile> async_log_file_;
+
   /**
    * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
    * we are in shut down, else we need to keep the task, so we reject the removal
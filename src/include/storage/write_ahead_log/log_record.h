@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>  // NOLINT
+
 #include "storage/data_table.h"
 #include "storage/projected_row.h"
 #include "transaction/timestamp_manager.h"
@@ -305,6 +307,7 @@ class CommitRecord {
     body->timestamp_manager_ = timestamp_manager;
     body->txn_ = txn;
     body->is_read_only_ = is_read_only;
+    body->creation_time_ = std::chrono::high_resolution_clock::now();
     return result;
   }
 
@@ -343,6 +346,12 @@ class CommitRecord {
    */
   bool IsReadOnly() const { return is_read_only_; }
 
+  /**
+   * @return wall clock time at which the commit record was created, used to measure commit-to-durable latency. Not
+   * meaningful if read back in from disk.
+   */
+  std::chrono::high_resolution_clock::time_point CreationTime() const { return creation_time_; }
+
  private:
   transaction::timestamp_t txn_commit_;
   transaction::callback_fn commit_callback_;
@@ -353,6 +362,7 @@ class CommitRecord {
   transaction::TransactionContext *txn_;
   transaction::TimestampManager *timestamp_manager_;
   bool is_read_only_;
+  std::chrono::high_resolution_clock::time_point creation_time_;
 };
 
 /**
@@ -409,4 +419,38 @@ class AbortRecord {
   transaction::TimestampManager *timestamp_manager_;
   transaction::TransactionContext *txn_;
 };
+
+/**
+ * Record body of a Checkpoint. The header is stored in the LogRecord class that would presumably return this
+ * object. A CheckpointRecord is never generated by a running transaction, it only ends the checkpoint files written
+ * by the CheckpointManager, whose records are tagged with the checkpoint timestamp as their begin timestamp. It
+ * commits the checkpoint, and tells recovery that every transaction that committed before the checkpoint timestamp
+ * precedes it.
+ */
+class CheckpointRecord {
+ public:
+  MEM_REINTERPRETATION_ONLY(CheckpointRecord)
+
+  /**
+   * @return type of record this type of body holds
+   */
+  static constexpr LogRecordType RecordType() { return LogRecordType::CHECKPOINT; }
+
+  /**
+   * @return Size of the entire record of this type, in bytes, in memory.
+   */
+  static uint32_t Size() { return static_cast<uint32_t>(sizeof(LogRecord) + sizeof(CheckpointRecord)); }
+
+  /**
+   * Initialize an entire LogRecord (header included) to have an underlying checkpoint record, using the parameters
+   * supplied.
+   *
+   * @param head pointer location to initialize, this is also the returned address (reinterpreted)
+   * @param checkpoint_ts timestamp of the checkpoint
+   * @return pointer to the initialized log record, always equal in value to the given head
+   */
+  static LogRecord *Initialize(byte *const head, const transaction::timestamp_t checkpoint_ts) {
+    return LogRecord::InitializeHeader(head, LogRecordType::CHECKPOINT, Size(), checkpoint_ts);
+  }
+};
 }  // namespace noisepage::storage
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/hash_util.h"
+#include "common/macros.h"
+#include "common/sanctioned_shared_pointer.h"
+#include "common/spin_latch.h"
+#include "execution/sql/sql.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::execution::compiler {
+class ExecutableQuery;
+}  // namespace noisepage::execution::compiler
+
+namespace noisepage::optimizer {
+class OptimizeResult;
+}  // namespace noisepage::optimizer
+
+namespace noisepage::trafficcop {
+
+/**
+ * The physical plan and generated code of a query, as cached in a network::Statement and in the PlanCache.
+ *
+ * Both are shared: a plan is cached once but used by the statements of every connection that runs the query, and an
+ * entry can be evicted or invalidated while statements still execute it. The owners are the PlanCache and any number of
+ * Statements, the plan is freed with the last of them and neither points back at the other. The ExecutableQuery refers
+ * to the plan it was generated from, so the two are always replaced together.
+ */
+struct CachedPlan {
+  /** optimize result containing the physical plan */
+  common::SanctionedSharedPtr<optimizer::OptimizeResult>::Ptr optimize_result_ = nullptr;
+  /** code generated for the physical plan */
+  common::SanctionedSharedPtr<execution::compiler::ExecutableQuery>::Ptr executable_query_ = nullptr;
+};
+
+/**
+ * A cache of physical plans and generated code shared by all connections, so that a query prepared by one connection
+ * does not have to be optimized and compiled again by every other connection that prepares it.
+ *
+ * Plans are keyed by database, query text and the parameter types the query was bound with. They are also keyed by
+ * catalog version, which is the time of the last change to the catalog or to the statistics the optimizer used: every
+ * entry remembers the start time of the transaction that generated it, and is only returned by a lookup if that is not
+ * older than the catalog version. Transactions that started before the version may have seen a different catalog and
+ * neither use nor add entries. A DDL change only becomes visible to other transactions when it commits, so while one is
+ * in flight the cache is bypassed entirely. Under a memory budget, the least recently used entries are evicted first.
+ */
+class PlanCache {
+ public:
+  /** Identifies a plan in the cache */
+  struct Key {
+    /** database the query was bound in */
+    catalog::db_oid_t db_oid_;
+    /** text of the query */
+    std::string query_text_;
+    /** types of the parameters as the binder expects them */
+    std::vector<execution::sql::SqlTypeId> param_types_;
+
+    /** @return true if both keys identify the same plan */
+    bool operator==(const Key &other) const {
+      return db_oid_ == other.db_oid_ && query_text_ == other.query_text_ && param_types_ == other.param_types_;
+    }
+  };
+
+  /**
+   * @param size_limit memory budget of the cache in bytes, 0 disables it
+   */
+  explicit PlanCache(const uint64_t size_limit) : size_limit_(size_limit) {}
+
+  DISALLOW_COPY_AND_MOVE(PlanCache)
+
+  /**
+   * Look up the plan for a query, recording a hit or a miss in the metrics.
+   * @param key identifies the plan
+   * @param start_time start time of the transaction that wants to use the plan
+   * @param[out] plan set to the cached plan if there is one
+   * @return true if the plan was found, false otherwise
+   */
+  bool Lookup(const Key &key, transaction::timestamp_t start_time, CachedPlan *plan);
+
+  /**
+   * Add the plan for a query, evicting the least recently used plans beyond the memory budget. An existing plan for
+   * the same key is replaced.
+   * @param key identifies the plan
+   * @param start_time start time of the transaction that generated the plan
+   * @param plan plan to add
+   * @param size approximate memory consumption of the plan in bytes
+   * @return true if the plan was added, false if it was older than the catalog or larger than the whole budget
+   */
+  bool Insert(Key key, transaction::timestamp_t start_time, CachedPlan plan, uint64_t size);
+
+  /**
+   * Drop all plans because the catalog or the statistics changed
+   * @param timestamp time of the change, transactions that started before it can no longer use the cache
+   */
+  void Invalidate(transaction::timestamp_t timestamp);
+
+  /**
+   * Drop all plans and bypass the cache until EndCatalogChange is called, because a transaction changed the catalog
+   * but has not committed yet.
+   * @param timestamp time of the change
+   */
+  void BeginCatalogChange(transaction::timestamp_t timestamp);
+
+  /**
+   * Finish a change started with BeginCatalogChange, once the transaction that made it committed or aborted
+   * @param timestamp time the transaction finished, transactions that started before it can no longer use the cache
+   */
+  void EndCatalogChange(transaction::timestamp_t timestamp);
+
+  /**
+   * @param start_time start time of the transaction that generated a plan
+   * @return true if the catalog changed since or is being changed, so the plan might no longer be valid
+   */
+  bool Outdated(const transaction::timestamp_t start_time) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return start_time < catalog_version_ || catalog_changes_in_flight_ > 0;
+  }
+
+  /**
+   * Change the memory budget of the cache, evicting plans beyond it
+   * @param size_limit memory budget in bytes, 0 disables the cache
+   */
+  void SetSizeLimit(uint64_t size_limit);
+
+  /** @return memory budget of the cache in bytes */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+  /** @return approximate memory consumption of the cached plans in bytes */
+  uint64_t GetSize() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return size_;
+  }
+
+  /** @return number of cached plans */
+  uint64_t GetNumEntries() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return entries_.size();
+  }
+
+  /** @return number of lookups that found a plan since the cache was created */
+  uint64_t GetNumHits() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return num_hits_;
+  }
+
+  /** @return number of lookups that did not find a plan since the cache was created */
+  uint64_t GetNumMisses() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return num_misses_;
+  }
+
+ private:
+  struct KeyHasher {
+    std::size_t operator()(const Key &key) const {
+      const auto hash = common::HashUtil::CombineHashes(common::HashUtil::Hash(key.query_text_),
+                                                        common::HashUtil::Hash(key.db_oid_.UnderlyingValue()));
+      return common::HashUtil::CombineHashInRange(hash, key.param_types_.cbegin(), key.param_types_.cend());
+    }
+  };
+
+  struct Entry {
+    CachedPlan plan_;
+    uint64_t size_;
+    // start time of the transaction that generated the plan
+    transaction::timestamp_t start_time_;
+    // position of the key in the LRU list
+    std::list<Key>::iterator lru_position_;
+  };
+
+  // Evict the least recently used plans until the cache fits into size_limit_. Caller holds latch_.
+  void EvictToSizeLimit(std::vector<CachedPlan> *evicted);
+
+  // Drop all plans and move the catalog version forward. Caller holds latch_, the plans are returned to be freed later.
+  std::unordered_map<Key, Entry, KeyHasher> DropAll(transaction::timestamp_t timestamp);
+
+  mutable common::SpinLatch latch_;
+  std::unordered_map<Key, Entry, KeyHasher> entries_;
+  // keys from the most to the least recently used
+  std::list<Key> lru_;
+  uint64_t size_limit_;
+  uint64_t size_ = 0;
+  uint64_t num_hits_ = 0;
+  uint64_t num_misses_ = 0;
+  transaction::timestamp_t catalog_version_ = transaction::INITIAL_TXN_TIMESTAMP;
+  // number of catalog changes made by transactions that have not finished yet
+  uint32_t catalog_changes_in_flight_ = 0;
+};
+
+}  // namespace noisepage::trafficcop
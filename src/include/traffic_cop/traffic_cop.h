@@ -9,6 +9,7 @@
 #include "common/managed_pointer.h"
 #include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
+#include "traffic_cop/plan_cache.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -79,6 +80,8 @@ class TrafficCop {
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
+   * @param auto_parameterize whether to replace literals with parameters in Simple Query protocol to cache its plans
+   * @param plan_cache_size memory budget of the physical plans and generated code shared by all connections in bytes
    * @param execution_mode how to run executable queries after code generation
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
@@ -87,7 +90,8 @@ class TrafficCop {
              common::ManagedPointer<storage::RecoveryManager> recovery_manager,
              common::ManagedPointer<settings::SettingsManager> settings_manager,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache, const execution::vm::ExecutionMode execution_mode)
+             bool use_query_cache, bool auto_parameterize, uint64_t plan_cache_size,
+             const execution::vm::ExecutionMode execution_mode)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_manager_(replication_manager),
@@ -96,7 +100,9 @@ class TrafficCop {
         stats_storage_(stats_storage),
         optimizer_timeout_(optimizer_timeout),
         use_query_cache_(use_query_cache),
+        auto_parameterize_(auto_parameterize),
         query_cache_timestamp_(transaction::INITIAL_TXN_TIMESTAMP),
+        plan_cache_(std::make_unique<PlanCache>(plan_cache_size)),
         execution_mode_(execution_mode) {}
 
   virtual ~TrafficCop() = default;
@@ -127,10 +133,12 @@ class TrafficCop {
   /**
    * @param query SQL string to be parsed
    * @param connection_ctx used to maintain state
+   * @param parameterize_literals whether to replace literals with parameters, if auto-parameterization is enabled
    * @return parser's ParseResult, nullptr if failed
    */
   std::variant<std::unique_ptr<parser::ParseResult>, common::ErrorData> ParseQuery(
-      const std::string &query, common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
+      const std::string &query, common::ManagedPointer<network::ConnectionContext> connection_ctx,
+      bool parameterize_literals = false) const;
 
   /**
    * @param connection_ctx context containg txn and catalog accessor to be used
@@ -275,13 +283,46 @@ class TrafficCop {
    */
   bool UseQueryCache() const { return use_query_cache_; }
 
+  /**
+   * @return true if Simple Query protocol replaces literals with parameters to cache physical plans and generated code
+   */
+  bool AutoParameterize() const { return use_query_cache_ && auto_parameterize_; }
+
   /**
    * Update the minimum generation timestamp required for the cached ExecutableQuery (resulting re-compilation for the
    * unsatisfied ExecutableQuery )
    */
   void UpdateQueryCacheTimestamp();
 
+  /**
+   * Use the physical plan and generated code another connection cached for the same query, if there is one. The
+   * statement must be bound already.
+   * @param connection_ctx context of the connection that runs the statement
+   * @param statement statement to set the cached plan for
+   * @return true if the statement now has a physical plan and generated code, false if it has to be optimized
+   */
+  bool LookupCachedPlan(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                        common::ManagedPointer<network::Statement> statement) const;
+
+  /**
+   * @return the physical plans and generated code shared by all connections
+   */
+  common::ManagedPointer<PlanCache> GetPlanCache() const { return common::ManagedPointer(plan_cache_); }
+
  private:
+  // Share the plan of a statement with other connections once it has been compiled
+  void CachePlan(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                 common::ManagedPointer<network::Statement> statement) const;
+
+  // Drop the plans that might depend on the catalog a DDL statement is changing, and bypass the plan cache until the
+  // transaction making the change commits or aborts
+  void InvalidatePlanCache(common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
+
+  // The plans of which query types are shared between connections
+  static bool CacheableQueryType(network::QueryType query_type) {
+    return query_type >= network::QueryType::QUERY_SELECT && query_type <= network::QueryType::QUERY_DELETE;
+  }
+
   common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   common::ManagedPointer<catalog::Catalog> catalog_;
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
@@ -290,7 +331,9 @@ class TrafficCop {
   common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
   uint64_t optimizer_timeout_;
   const bool use_query_cache_;
+  const bool auto_parameterize_;
   transaction::timestamp_t query_cache_timestamp_;
+  std::unique_ptr<PlanCache> plan_cache_;
   execution::vm::ExecutionMode execution_mode_;
 };
 
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <algorithm>
-#include <unordered_set>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <utility>
 #include <vector>
 
+#include "common/constants.h"
+#include "common/macros.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -21,7 +26,8 @@ class TransactionManager;
 class TimestampManager {
  public:
   ~TimestampManager() {
-    NOISEPAGE_ASSERT(curr_running_txns_.empty(),
+    NOISEPAGE_ASSERT(std::all_of(running_txn_shards_.cbegin(), running_txn_shards_.cend(),
+                                 [](const RunningTxnShard &shard) { return shard.txns_.empty(); }),
                      "Destroying the TimestampManager while txns are still running. That seems wrong.");
   }
 
@@ -39,9 +45,8 @@ class TimestampManager {
    * Get the oldest transaction alive (by start timestamp given out by this timestamp manager at this time)
    * Because of concurrent operations, it is not guaranteed that upon return the txn is still alive. However,
    * it is guaranteed that the return timestamp is older than any transactions live.
-   * @warning If logging is enabled, txns are not removed from the txn set until they are serialized. Thus, the active
-   * txn set can grow greatly in size, making this call expensive. Consider using CachedOldestTransactionStartTime for
-   * better performance at the cost of a more stale timestamp.
+   * @note This takes the latch of every running transaction shard once, but does not look at the transactions in them
+   * beyond the oldest one, so it stays cheap even if logging keeps many transactions in the running set.
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t OldestTransactionStartTime();
@@ -56,30 +61,51 @@ class TimestampManager {
    */
   timestamp_t CachedOldestTransactionStartTime();
 
+  /** Number of shards the running transactions are spread over. */
+  static constexpr uint32_t NUM_RUNNING_TXN_SHARDS = 32;
+
  private:
-  // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-  // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-  // along with removing a transaction from the table of active transactions. We need this for correctness
-  // in the deferred action framework when dropping tables.
   friend class TransactionManager;
   friend class storage::LogSerializerTask;
+  FRIEND_TEST(TimestampManagerTests, LongRunningTxnTest);
+
+  /**
+   * The running transactions that began on the threads mapped to one shard. Start timestamps are checked out and
+   * appended under the shard's latch, so they are sorted and the oldest running transaction of the shard is at the
+   * front. A transaction that finishes out of order is marked as finished, and dropped once it reaches either end. A
+   * long-running transaction at the front keeps the ones behind it from ever reaching it, so the finished entries are
+   * compacted away once they make up most of the shard. The shard thus holds at most twice as many entries as there are
+   * running transactions in it, and compacting each entry at most once keeps removal amortized constant time.
+   */
+  struct alignas(common::Constants::CACHELINE_SIZE) RunningTxnShard {
+    common::SpinLatch latch_;
+    // Start timestamps of the transactions, and whether each is still running
+    std::deque<std::pair<timestamp_t, bool>> txns_;
+    // Number of entries in txns_ whose transaction finished
+    uint64_t num_finished_ = 0;
+
+    /**
+     * Marks a transaction in this shard as finished. Requires the latch to be held.
+     * @param timestamp start timestamp of the transaction
+     * @return false if the transaction is not running in this shard
+     */
+    bool Remove(timestamp_t timestamp);
+  };
+
   timestamp_t BeginTransaction() {
-    timestamp_t start_time;
-    {
-      common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
-      // There is a three-way race that needs to be prevented.  Specifically, we
-      // cannot allow both a transaction to commit and the GC to poll for the
-      // oldest running transaction in between this transaction acquiring its
-      // begin timestamp and getting inserted into the current running
-      // transactions list.  Using the current running transactions latch
-      // prevents the GC from polling and stops the race.  This allows us to
-      // replace acquiring a shared instance of the commit latch with a
-      // read-only spin-latch and move the allocation out of a critical section.
-      start_time = time_++;
-
-      const auto ret UNUSED_ATTRIBUTE = curr_running_txns_.emplace(start_time);
-      NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
-    }  // Release latch on current running transactions
+    RunningTxnShard &shard = running_txn_shards_[ThreadShard()];
+    common::SpinLatch::ScopedSpinLatch running_guard(&shard.latch_);
+    // There is a three-way race that needs to be prevented.  Specifically, we
+    // cannot allow both a transaction to commit and the GC to poll for the
+    // oldest running transaction in between this transaction acquiring its
+    // begin timestamp and getting inserted into the current running
+    // transactions list.  Holding the shard latch across both prevents the GC
+    // from polling this shard in between, and OldestTransactionStartTime reads
+    // the current time before polling any shard, so a begin it misses has a
+    // start time no older than that. Threads map to different shards, so this
+    // latch is only contended if there are more threads than shards.
+    const timestamp_t start_time = time_++;
+    shard.txns_.emplace_back(start_time, true);
     return start_time;
   }
 
@@ -90,23 +116,23 @@ class TimestampManager {
   void RemoveTransaction(timestamp_t timestamp);
 
   /**
-   * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
-   * timestamps.
+   * Bulk remove a set of timestamps from the active txn set. Only grabs the latch of every running transaction shard
+   * once for all the timestamps.
    * @param timestamps vector of timestamps to remove
    * @return True if there are no more running transactions after removal. False otherwise.
    */
   bool RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
+  /** @return index of the running transaction shard the calling thread begins transactions in */
+  static uint32_t ThreadShard();
+
   // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
   // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
   std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-  // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
-  // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change, it
-  // can hold many more, since txns are only removed when serialized. We should consider if there is a possible better
-  // data structure
-  std::unordered_set<timestamp_t> curr_running_txns_;
-  mutable common::SpinLatch curr_running_txns_latch_;
+  // With logging, txns are only removed once they are serialized, so the shards can hold many more txns than there
+  // are workers. Only the front of each shard is looked at to find the oldest txn.
+  std::array<RunningTxnShard, NUM_RUNNING_TXN_SHARDS> running_txn_shards_;
 };
 }  // namespace noisepage::transaction
@@ -82,6 +82,14 @@ class TransactionContext {
    */
   timestamp_t FinishTime() const { return finish_time_.load(); }
 
+  /**
+   * @return timestamp that no running transaction was older than when this transaction began. Versions older than it
+   * are not visible to any transaction that may still read them, so this transaction may unlink them from the version
+   * chains it traverses. INITIAL_TXN_TIMESTAMP (never prune) unless the TransactionManager began this transaction with
+   * the GC enabled.
+   */
+  timestamp_t PruneHorizon() const { return prune_horizon_; }
+
   /**
    * Reserve space on this transaction's undo buffer for a record to log the update given
    * @param table pointer to the updated DataTable object
@@ -235,6 +243,7 @@ class TransactionContext {
   friend class storage::RecoveryTests;           // Needs access to redo buffer
   const timestamp_t start_time_;
   std::atomic<timestamp_t> finish_time_;
+  timestamp_t prune_horizon_ = INITIAL_TXN_TIMESTAMP;
   storage::UndoBuffer undo_buffer_;
   storage::RedoBuffer redo_buffer_;
   // TODO(Tianyu): Maybe not so much of a good idea to do this. Make explicit queue in GC?
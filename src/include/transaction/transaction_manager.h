@@ -107,6 +107,9 @@ class TransactionManager {
   /** @return current transaction timestamp without advancing the tick */
   timestamp_t GetCurrentTimestamp() const { return timestamp_manager_->CurrentTime(); }
 
+  /** @return timestamp that is older than any running transaction, @see TimestampManager::OldestTransactionStartTime */
+  timestamp_t GetOldestTransactionStartTime() const { return timestamp_manager_->OldestTransactionStartTime(); }
+
  private:
   const common::ManagedPointer<TimestampManager> timestamp_manager_;
   const common::ManagedPointer<DeferredActionManager> deferred_action_manager_;
@@ -115,6 +118,8 @@ class TransactionManager {
 
   common::Gate txn_gate_;
 
+  // Guards completed_txns_, which every finishing txn adds to and the GC takes from
+  common::SpinLatch completed_txns_latch_;
   TransactionQueue completed_txns_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
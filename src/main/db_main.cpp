@@ -95,14 +95,22 @@ void DBMain::ForceShutdown() {
   (void)task_manager_.reset();
 
   if (network_layer_ != DISABLED && network_layer_->GetServer()->Running()) {
+    const auto execution_scheduler = network_layer_->GetExecutionScheduler();
+    // Commands that finish from here on must not wake up connections whose handler threads are being stopped.
+    if (execution_scheduler != nullptr) execution_scheduler->StopWakeUps();
+    // Stopping the server stops the handler threads, so no new commands are submitted after this.
     network_layer_->GetServer()->StopServer();
+    // Let the commands that are still queued or running finish while their connections are still around.
+    if (execution_scheduler != nullptr) execution_scheduler->WaitForFlush();
   }
 }
 
 DBMain::~DBMain() { ForceShutdown(); }
 
-DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path) {
-  execution::ExecutionUtil::InitTPL(bytecode_handlers_path);
+DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path,
+                                       const std::string &compiled_module_cache_path,
+                                       const uint64_t compiled_module_cache_size) {
+  execution::ExecutionUtil::InitTPL(bytecode_handlers_path, compiled_module_cache_path, compiled_module_cache_size);
 }
 
 DBMain::ExecutionLayer::~ExecutionLayer() { execution::ExecutionUtil::ShutdownTPL(); }
@@ -124,6 +124,11 @@ void MetricsManager::ResetMetric(const MetricsComponent component) const {
         metric->Swap();
         break;
       }
+      case MetricsComponent::PLAN_CACHE: {
+        const auto &metric = metrics_store.second->plan_cache_metric_;
+        metric->Swap();
+        break;
+      }
     }
   }
 }
@@ -206,6 +211,10 @@ void MetricsManager::ToCSV(uint8_t component) const {
       OpenFiles<QueryTraceMetricRawData>(&outfiles);
       break;
     }
+    case MetricsComponent::PLAN_CACHE: {
+      OpenFiles<PlanCacheMetricRawData>(&outfiles);
+      break;
+    }
   }
   aggregated_metrics_[component]->ToCSV(&outfiles);
   for (auto &file : outfiles) {
@@ -21,6 +21,7 @@ MetricsStore::MetricsStore(const common::ManagedPointer<metrics::MetricsManager>
   bind_command_metric_ = std::make_unique<BindCommandMetric>();
   execute_command_metric_ = std::make_unique<ExecuteCommandMetric>();
   query_trace_metric_ = std::make_unique<QueryTraceMetric>();
+  plan_cache_metric_ = std::make_unique<PlanCacheMetric>();
 }
 
 std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDataToAggregate() {
@@ -85,6 +86,13 @@ std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDa
           result[component] = query_trace_metric_->Swap();
           break;
         }
+        case MetricsComponent::PLAN_CACHE: {
+          NOISEPAGE_ASSERT(
+              plan_cache_metric_ != nullptr,
+              "PlanCacheMetric cannot be a nullptr. Check the MetricsStore constructor that it was allocated.");
+          result[component] = plan_cache_metric_->Swap();
+          break;
+        }
       }
     }
   }
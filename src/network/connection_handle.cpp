@@ -185,11 +185,10 @@ Transition ConnectionHandle::Process() {
 }
 
 Transition ConnectionHandle::GetResult() {
-  // Wait until a network event happens.
+  // Resume listening for network events, which were stopped while the command ran on an execution worker.
   EventUtil::EventAdd(network_event_, EventUtil::WAIT_FOREVER);
-  // TODO(WAN): It is not clear to me what this function is doing. If someone figures it out, please update comment.
-  protocol_interpreter_->GetResult(io_wrapper_->GetWriteQueue());
-  return Transition::PROCEED;
+  // The worker has already written its output, so pick up where the command left the state machine.
+  return protocol_interpreter_->GetResult(io_wrapper_->GetWriteQueue());
 }
 
 Transition ConnectionHandle::TryCloseConnection() {
@@ -238,7 +237,7 @@ void ConnectionHandle::UpdateEventFlags(int16_t flags, int timeout_secs) {
 void ConnectionHandle::StopReceivingNetworkEvent() { EventUtil::EventDel(network_event_); }
 
 void ConnectionHandle::Callback(void *callback_args) {
-  // TODO(WAN): this is currently unused.
+  // Invoked by an execution worker once the command that the handle is waiting on has finished.
   auto *const handle = reinterpret_cast<ConnectionHandle *>(callback_args);
   NOISEPAGE_ASSERT(handle->state_machine_.CurrentState() == ConnState::PROCESS,
                    "Should be waking up a ConnectionHandle that's in PROCESS state waiting on query result.");
@@ -256,6 +255,7 @@ void ConnectionHandle::ResetForReuse(connection_id_t connection_id, common::Mana
   network_event_ = nullptr;
   workpool_event_ = nullptr;
   context_.Reset();
+  context_.SetCallback(Callback, this);
   context_.SetConnectionID(connection_id);
 }
 
@@ -0,0 +1,85 @@
+#include "network/execution_scheduler.h"
+
+#include <utility>
+
+#include "common/dedicated_thread_registry.h"
+#include "network/connection_context.h"
+#include "network/execution_worker_task.h"
+
+namespace noisepage::network {
+
+ExecutionScheduler::ExecutionScheduler(common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+                                       uint32_t num_workers)
+    : DedicatedThreadOwner(thread_registry) {
+  NOISEPAGE_ASSERT(num_workers > 0, "ExecutionScheduler requires at least 1 worker");
+  for (uint32_t i = 0; i < num_workers; i++) {
+    workers_.push_back(
+        thread_registry_->RegisterDedicatedThread<ExecutionWorkerTask>(this, common::ManagedPointer(this)));
+  }
+}
+
+ExecutionScheduler::~ExecutionScheduler() {
+  // Let everything that has been submitted run, but the connections may be gone by now so don't wake them up
+  StopWakeUps();
+  WaitForFlush();
+
+  for (auto worker : workers_) {
+    thread_registry_->StopTask(this, worker.CastManagedPointerTo<common::DedicatedThreadTask>());
+  }
+}
+
+void ExecutionScheduler::Submit(Work work) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.push(std::move(work));
+  }
+  queue_cv_.notify_one();
+}
+
+void ExecutionScheduler::WakeUp(const common::ManagedPointer<ConnectionContext> context) {
+  // Holding the latch keeps StopWakeUps from returning, and the network threads from being stopped, mid wake up
+  std::lock_guard<std::mutex> lock(wake_up_mutex_);
+  if (!wake_ups_stopped_) context->Callback()(context->CallbackArg());
+}
+
+void ExecutionScheduler::StopWakeUps() {
+  std::lock_guard<std::mutex> lock(wake_up_mutex_);
+  wake_ups_stopped_ = true;
+}
+
+void ExecutionScheduler::WaitForFlush() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  notify_cv_.wait(lock, [&] { return busy_workers_ == 0 && queue_.empty(); });
+}
+
+bool ExecutionScheduler::GetWorkWithKillFlag(bool const *kill, Work *work) {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  queue_cv_.wait(lock, [&] { return (*kill) || !queue_.empty(); });
+  if (*kill && queue_.empty()) {
+    // we are shutting down but we should empty the queue first
+    return false;
+  }
+
+  *work = std::move(queue_.front());
+  queue_.pop();
+  busy_workers_++;
+  return true;
+}
+
+void ExecutionScheduler::FinishWork() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    busy_workers_--;
+  }
+  notify_cv_.notify_all();
+}
+
+void ExecutionScheduler::MarkTerminateFlag(bool *kill) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    *kill = true;
+  }
+  queue_cv_.notify_all();
+}
+
+}  // namespace noisepage::network
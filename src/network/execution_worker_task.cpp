@@ -0,0 +1,27 @@
+#include "network/execution_worker_task.h"
+
+#include "loggers/network_logger.h"
+#include "network/execution_scheduler.h"
+
+namespace noisepage::network {
+
+void ExecutionWorkerTask::RunTask() {
+  ExecutionScheduler::Work work;
+  while (scheduler_->GetWorkWithKillFlag(&kill_, &work)) {
+    try {
+      work();
+    } catch (const std::exception &e) {
+      // Work is expected to handle its own errors, but never let one take the worker down with it
+      NETWORK_LOG_ERROR("Execution worker caught exception {0}", e.what());
+    } catch (...) {
+      NETWORK_LOG_ERROR("Execution worker caught unknown exception");
+    }
+    // Release anything the work captured before picking up the next unit
+    work = nullptr;
+    scheduler_->FinishWork();
+  }
+}
+
+void ExecutionWorkerTask::Terminate() { scheduler_->MarkTerminateFlag(&kill_); }
+
+}  // namespace noisepage::network
@@ -13,15 +13,27 @@ namespace noisepage::network {
 static_assert(EAGAIN == EWOULDBLOCK, "If this trips, you'll have to #if guard all existing EAGAIN usages.");
 
 NetworkIoWrapper::NetworkIoWrapper(const int sock_fd)
-    : sock_fd_(sock_fd), in_(std::make_unique<ReadBuffer>()), out_(std::make_unique<WriteQueue>()) {
+    : sock_fd_(sock_fd), in_(std::make_unique<ReadBuffer>()), out_(std::make_unique<WriteQueue>(sock_fd)) {
   RestartState();
 }
 
 Transition NetworkIoWrapper::FlushAllWrites() {
-  for (auto flush_head = out_->FlushHead(); flush_head != nullptr; out_->MarkHeadFlushed()) {
-    const auto result = FlushWriteBuffer(flush_head);
-    if (result != Transition::PROCEED) return result;
-    flush_head = out_->FlushHead();
+  // Everything queued since the last flush (e.g., the responses to a whole pipelined batch of commands) goes out with
+  // as few writev calls as possible instead of one write per buffer
+  while (out_->FlushHead() != nullptr && out_->GetNumUnflushedBytes() > 0) {
+    const auto bytes_written = out_->WriteOutTo(sock_fd_);
+    if (bytes_written < 0) {
+      switch (errno) {
+        case EINTR:
+          continue;
+        case EAGAIN:
+          return Transition::NEED_WRITE;
+        case EPIPE:
+          return Transition::TERMINATE;
+        default:
+          throw NETWORK_PROCESS_EXCEPTION(fmt::format("Fatal error during write: {}", strerror(errno)));
+      }
+    }
   }
   out_->Reset();
   return Transition::PROCEED;
@@ -56,6 +68,8 @@ Transition NetworkIoWrapper::FillReadBuffer() {
       }
       switch (errno) {
         case EAGAIN:
+          // Nothing left to read means the connection is going idle, so it should not hold on to spare write buffers
+          if (result == Transition::NEED_READ) out_->ReleaseSpareBuffers();
           return result;
         case EINTR:
           continue;
@@ -69,26 +83,6 @@ Transition NetworkIoWrapper::FillReadBuffer() {
 
 bool NetworkIoWrapper::ShouldFlush() { return out_->ShouldFlush(); }
 
-Transition NetworkIoWrapper::FlushWriteBuffer(const common::ManagedPointer<WriteBuffer> wbuf) {
-  while (wbuf->HasMore()) {
-    auto bytes_written = wbuf->WriteOutTo(sock_fd_);
-    if (bytes_written < 0) {
-      switch (errno) {
-        case EINTR:
-          continue;
-        case EAGAIN:
-          return Transition::NEED_WRITE;
-        case EPIPE:
-          return Transition::TERMINATE;
-        default:
-          throw NETWORK_PROCESS_EXCEPTION(fmt::format("Fatal error during write: {}", strerror(errno)));
-      }
-    }
-  }
-  wbuf->Reset();
-  return Transition::PROCEED;
-}
-
 void NetworkIoWrapper::RestartState() {
   int err;          // For C-style error codes.
   int enabled = 1;  // For setting socket options.
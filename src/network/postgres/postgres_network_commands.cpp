@@ -120,7 +120,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
 
   auto query_text = in_.ReadString();
 
-  auto parse_result = t_cop->ParseQuery(query_text, connection);
+  auto parse_result = t_cop->ParseQuery(query_text, connection, true);
 
   if (std::holds_alternative<common::ErrorData>(parse_result)) {
     out->WriteError(std::get<common::ErrorData>(parse_result));
@@ -131,8 +131,26 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     return FinishSimpleQueryCommand(out, connection);
   }
 
-  const auto statement = std::make_unique<network::Statement>(
-      std::move(query_text), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
+  auto &parsed = std::get<std::unique_ptr<parser::ParseResult>>(parse_result);
+  // Literals that the parser replaced with parameters are bound at execution like Extended Query protocol parameters
+  auto params = std::move(parsed->GetParameters());
+
+  std::unique_ptr<network::Statement> unnamed_statement = nullptr;
+  common::ManagedPointer<network::Statement> statement = nullptr;
+  if (params.empty()) {
+    unnamed_statement = std::make_unique<network::Statement>(std::move(query_text), std::move(parsed));
+    statement = common::ManagedPointer(unnamed_statement);
+  } else {
+    // Queries that only differ in their parameterized literals share a cached statement, together with its plan
+    const auto cache_key = StatementCache::ParameterizedKey(parsed->GetNormalizedQueryText(), params);
+    statement = postgres_interpreter->LookupParameterizedStatementInCache(cache_key);
+    if (statement == nullptr) {
+      auto new_statement =
+          std::make_unique<network::Statement>(std::string(parsed->GetNormalizedQueryText()), std::move(parsed));
+      statement = common::ManagedPointer(new_statement);
+      postgres_interpreter->AddParameterizedStatementToCache(cache_key, std::move(new_statement));
+    }
+  }
 
   // TODO(Matt): Clients may send multiple statements in a single SimpleQuery packet/string. Handling that would
   // probably exist here, looping over all of the elements in the ParseResult. It's not clear to me how the binder would
@@ -165,7 +183,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
       return FinishSimpleQueryCommand(out, connection);
     }
 
-    auto set_result = t_cop->ExecuteSetStatement(connection, common::ManagedPointer(statement));
+    auto set_result = t_cop->ExecuteSetStatement(connection, statement);
     if (set_result.type_ == trafficcop::ResultType::ERROR) {
       out->WriteError(std::get<common::ErrorData>(set_result.extra_));
     } else {
@@ -176,7 +194,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
 
   // TODO(WAN): this is a temporary hack to unblock Ziqi's oltpbench work. #1188
   if (UNLIKELY(query_type == network::QueryType::QUERY_SHOW)) {
-    auto show_result = t_cop->ExecuteShowStatement(connection, out, common::ManagedPointer(statement));
+    auto show_result = t_cop->ExecuteShowStatement(connection, out, statement);
     NOISEPAGE_ASSERT(show_result.type_ == trafficcop::ResultType::COMPLETE,
                      "TODO this should be fixed to handle failure.");
     out->WriteCommandComplete(network::QueryType::QUERY_SHOW, 0);
@@ -207,16 +225,29 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
                      common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
     out->WriteCommandComplete(query_type, 0);
   } else {
+    const auto params_ptr = params.empty() ? nullptr : common::ManagedPointer(&params);
+
+    // A cached statement whose plan is incomplete or older than the catalog has to be bound again
+    if (statement->OptimizeResult() != nullptr &&
+        (statement->GetExecutableQuery() == nullptr ||
+         t_cop->GetPlanCache()->Outdated(statement->GetExecutableQuery()->GetTimestamp()))) {
+      statement->ClearCachedObjects();
+    }
+
     // Try to bind the parsed statement
-    const auto bind_result = t_cop->BindQuery(connection, common::ManagedPointer(statement), nullptr);
+    const auto bind_result = t_cop->BindQuery(connection, statement, params_ptr);
 
     if (bind_result.type_ == trafficcop::ResultType::COMPLETE) {
-      // Binding succeeded, optimize to generate a physical plan and then execute
-      auto optimize_result = t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), nullptr);
+      // Binding succeeded, optimize to generate a physical plan unless this or another connection already did, then
+      // execute
+      if (statement->OptimizeResult() == nullptr && !t_cop->LookupCachedPlan(connection, statement)) {
+        auto optimize_result = t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), params_ptr);
 
-      statement->SetOptimizeResult(std::move(optimize_result));
+        statement->SetOptimizeResult(std::move(optimize_result));
+      }
 
-      const auto portal = std::make_unique<Portal>(common::ManagedPointer(statement));
+      const auto portal =
+          std::make_unique<Portal>(statement, std::move(params), std::vector<FieldFormat>{FieldFormat::text});
 
       if (query_type == network::QueryType::QUERY_SELECT) {
         out->WriteRowDescription(portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns(),
@@ -241,6 +272,8 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
                        "We're expecting a message here.");
       // failing to bind fails a transaction in postgres
       connection->Transaction()->SetMustAbort();
+      // clear anything cached related to this statement
+      statement->ClearCachedObjects();
       out->WriteError(std::get<common::ErrorData>(bind_result.extra_));
     }
   }
@@ -433,8 +466,9 @@ Transition BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> i
   const auto bind_result = t_cop->BindQuery(connection, statement, common::ManagedPointer(&params));
   if (LIKELY(bind_result.type_ == trafficcop::ResultType::COMPLETE)) {
     // Binding succeeded, optimize to generate a physical plan
-    if (statement->OptimizeResult() == nullptr || !t_cop->UseQueryCache()) {
-      // it's not cached, optimize it
+    if ((statement->OptimizeResult() == nullptr || !t_cop->UseQueryCache()) &&
+        !t_cop->LookupCachedPlan(connection, statement)) {
+      // it's not cached, neither by this connection nor by another one, optimize it
       auto optimize_result =
           t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), common::ManagedPointer(&params));
 
@@ -8,6 +8,15 @@
 
 namespace noisepage::network {
 
+namespace {
+/** Where an attribute lives in the execution engine's output tuples, and how to serialize it. */
+struct DataRowAttribute {
+  uint32_t offset_;
+  execution::sql::SqlTypeId type_;
+  FieldFormat format_;
+};
+}  // namespace
+
 void PostgresPacketWriter::WriteReadyForQuery(NetworkTransactionStateType txn_status) {
   BeginPacket(NetworkMessageType::PG_READY_FOR_QUERY).AppendRawValue(txn_status).EndPacket();
 }
@@ -260,26 +269,45 @@ void PostgresPacketWriter::WriteBindComplete() { BeginPacket(NetworkMessageType:
 void PostgresPacketWriter::WriteDataRow(const byte *const tuple,
                                         const std::vector<planner::OutputSchema::Column> &columns,
                                         const std::vector<FieldFormat> &field_formats) {
-  BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(static_cast<int16_t>(columns.size()));
+  WriteDataRows(tuple, 1, 0, columns, field_formats);
+}
+
+void PostgresPacketWriter::WriteDataRows(const byte *const tuples, const uint32_t num_tuples, const uint32_t tuple_size,
+                                         const std::vector<planner::OutputSchema::Column> &columns,
+                                         const std::vector<FieldFormat> &field_formats) {
+  // Every row in the batch has the same layout, so find each attribute's offset in the tuple and its format up front
+  std::vector<DataRowAttribute> attributes;
+  attributes.reserve(columns.size());
   uint32_t curr_offset = 0;
   for (uint32_t i = 0; i < columns.size(); i++) {
-    // Reinterpret to a base value type first and check if it's NULL
-    auto alignment = execution::sql::ValUtil::GetSqlAlignment(columns[i].GetType());
+    const auto type = columns[i].GetType();
+    const auto alignment = execution::sql::ValUtil::GetSqlAlignment(type);
     if (!common::MathUtil::IsAligned(curr_offset, alignment)) {
       curr_offset = static_cast<uint32_t>(common::MathUtil::AlignTo(curr_offset, alignment));
     }
-    const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + curr_offset);
-
     // Field formats can either be the size of the number of columns, or size 1 where they all use the same format
-    const auto field_format = field_formats[i < field_formats.size() ? i : 0];
-
-    const auto type_size = field_format == FieldFormat::text ? WriteTextAttribute(val, columns[i].GetType())
-                                                             : WriteBinaryAttribute(val, columns[i].GetType());
+    attributes.push_back({curr_offset, type, field_formats[i < field_formats.size() ? i : 0]});
+    // Advance in the tuple based on the execution engine's type size
+    curr_offset += execution::sql::ValUtil::GetSqlSize(type);
+  }
 
-    // Advance in the buffer based on the execution engine's type size
-    curr_offset += type_size;
+  const auto num_columns = static_cast<int16_t>(columns.size());
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    const byte *const tuple = tuples + row * tuple_size;
+    BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(num_columns);
+    for (const auto &attribute : attributes) {
+      const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + attribute.offset_);
+      if (attribute.format_ == FieldFormat::text) {
+        WriteTextAttribute(val, attribute.type_);
+      } else {
+        WriteBinaryAttribute(val, attribute.type_);
+      }
+    }
+    EndPacket();
   }
-  EndPacket();
+
+  // Large results go out batch by batch instead of piling up until the command is done
+  StreamOut();
 }
 
 template <class native_type, class val_type>
@@ -367,9 +395,11 @@ uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *con
       case execution::sql::SqlTypeId::SmallInt:
       case execution::sql::SqlTypeId::BigInt:
       case execution::sql::SqlTypeId::Integer: {
+        // Format into a stack buffer and write the digits directly, rather than allocating a string for every integer
         auto *int_val = reinterpret_cast<const execution::sql::Integer *const>(val);
-        string_value = std::to_string(int_val->val_);
-        break;
+        const fmt::format_int digits(int_val->val_);
+        AppendValue<int32_t>(static_cast<int32_t>(digits.size())).AppendRaw(digits.data(), digits.size());
+        return execution::sql::ValUtil::GetSqlSize(type);
       }
       case execution::sql::SqlTypeId::Boolean: {
         // Don't allocate an actual string for a BOOLEAN, just wrap a std::string_view, write the value directly, and
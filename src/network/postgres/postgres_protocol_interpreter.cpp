@@ -7,6 +7,7 @@
 
 #include "common/error/error_data.h"
 #include "common/error/error_defs.h"
+#include "network/execution_scheduler.h"
 #include "network/network_defs.h"
 #include "network/postgres/postgres_network_commands.h"
 #include "traffic_cop/traffic_cop.h"
@@ -31,23 +32,113 @@ Transition PostgresProtocolInterpreter::Process(common::ManagedPointer<ReadBuffe
     curr_input_packet_.Clear();
     return ProcessStartup(in, out, t_cop, context);
   }
-  auto command = command_factory_->PacketToCommand(common::ManagedPointer<InputPacket>(&curr_input_packet_));
-  PostgresPacketWriter writer(out);
-  if (command->FlushOnComplete()) out->ForceFlush();
 
-  if (WaitingForSync() && curr_input_packet_.msg_type_ != NetworkMessageType::PG_SYNC_COMMAND) {
-    // When an error is detected while processing any Extended Query message, the backend issues ErrorResponse, then
-    // reads and discards messages until a Sync is reached
-    curr_input_packet_.Clear();
-    return Transition::PROCEED;
+  try {
+    DecodePendingCommands(in, out);
+  } catch (std::exception &e) {
+    NETWORK_LOG_ERROR("Encountered exception {0} when parsing packet", e.what());
+    ClearPendingCommands();
+    return Transition::TERMINATE;
+  }
+
+  const bool offload = execution_scheduler_ != nullptr &&
+                       std::any_of(pending_commands_.begin(), pending_commands_.end(),
+                                   [](const auto &pending) { return pending.second->OffloadToWorker(); });
+  if (offload) {
+    // Hand the commands off to an execution worker. The ConnectionHandle stops listening for network events while it
+    // waits, so nothing touches the buffers or the pending commands until the worker wakes it up and GetResult runs.
+    execution_scheduler_->Submit([this, out, t_cop, context] {
+      try {
+        pending_transition_ = ExecutePendingCommands(out, t_cop, context);
+      } catch (const NetworkProcessException &e) {
+        // Inline execution would have this terminate the connection from the state machine, so do the same here
+        NETWORK_LOG_ERROR("{0}\n", e.what());
+        pending_transition_ = Transition::TERMINATE;
+      } catch (const std::exception &e) {
+        NETWORK_LOG_ERROR("Encountered exception {0} when executing commands", e.what());
+        TerminateOnUnexpectedError(out, e.what());
+      } catch (...) {
+        NETWORK_LOG_ERROR("Encountered unknown exception when executing commands");
+        TerminateOnUnexpectedError(out, "unknown exception");
+      }
+      // The connection always has to be woken up, it is not listening for anything else
+      execution_scheduler_->WakeUp(context);
+    });
+    return Transition::NEED_RESULT;
   }
 
-  const Transition ret = command->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
-                                       common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
-  curr_input_packet_.Clear();
+  const Transition ret = ExecutePendingCommands(out, t_cop, context);
+  ClearPendingCommands();
   return ret;
 }
 
+Transition PostgresProtocolInterpreter::GetResult(const common::ManagedPointer<WriteQueue> out) {
+  NOISEPAGE_ASSERT(!pending_commands_.empty(), "Woken up for a result without commands running on a worker.");
+  ClearPendingCommands();
+  return pending_transition_;
+}
+
+void PostgresProtocolInterpreter::DecodePendingCommands(const common::ManagedPointer<ReadBuffer> in,
+                                                        const common::ManagedPointer<WriteQueue> out) {
+  NOISEPAGE_ASSERT(pending_commands_.empty(), "Decoding new commands before the previous ones finished running.");
+  while (true) {
+    const NetworkMessageType msg_type = curr_input_packet_.msg_type_;
+    auto command = command_factory_->PacketToCommand(common::ManagedPointer<InputPacket>(&curr_input_packet_));
+    if (command->FlushOnComplete()) out->ForceFlush();
+    pending_commands_.emplace_back(msg_type, std::move(command));
+
+    if (curr_input_packet_.extended_) {
+      // The command reads from the packet's own buffer, which goes away when the packet is cleared
+      pending_packet_owned_ = true;
+      return;
+    }
+    // The command reads from a view of the read buffer, which is not refilled until the pending commands have run
+    curr_input_packet_.Clear();
+    if (!IsPipelinedMessage(msg_type) || msg_type == NetworkMessageType::PG_SYNC_COMMAND) return;
+
+    // A partially received or extended packet is left for the next call to Process
+    if (!TryBuildPacket(in) || curr_input_packet_.extended_ || !IsPipelinedMessage(curr_input_packet_.msg_type_)) {
+      return;
+    }
+  }
+}
+
+Transition PostgresProtocolInterpreter::ExecutePendingCommands(
+    const common::ManagedPointer<WriteQueue> out, const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+    const common::ManagedPointer<ConnectionContext> context) {
+  PostgresPacketWriter writer(out);
+  for (auto &[msg_type, command] : pending_commands_) {
+    if (WaitingForSync() && msg_type != NetworkMessageType::PG_SYNC_COMMAND) {
+      // When an error is detected while processing any Extended Query message, the backend issues ErrorResponse, then
+      // reads and discards messages until a Sync is reached
+      continue;
+    }
+    const Transition ret = command->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
+                                         common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
+    if (ret != Transition::PROCEED) return ret;
+  }
+  return Transition::PROCEED;
+}
+
+void PostgresProtocolInterpreter::TerminateOnUnexpectedError(const common::ManagedPointer<WriteQueue> out,
+                                                             const std::string &message) {
+  // The commands may have stopped in the middle of a packet, so drop their output rather than send a malformed stream
+  out->Reset();
+  PostgresPacketWriter writer(out);
+  writer.WriteError({common::ErrorSeverity::FATAL, "Internal error while executing commands: " + message,
+                     common::ErrorCode::ERRCODE_INTERNAL_ERROR});
+  out->ForceFlush();
+  pending_transition_ = Transition::TERMINATE;
+}
+
+void PostgresProtocolInterpreter::ClearPendingCommands() {
+  pending_commands_.clear();
+  if (pending_packet_owned_) {
+    curr_input_packet_.Clear();
+    pending_packet_owned_ = false;
+  }
+}
+
 Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPointer<ReadBuffer> in,
                                                        const common::ManagedPointer<WriteQueue> out,
                                                        const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
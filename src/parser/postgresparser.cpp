@@ -1,6 +1,7 @@
 #include "parser/postgresparser.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <memory>
 #include <string>
@@ -42,7 +43,8 @@
 
 namespace noisepage::parser {
 
-std::unique_ptr<parser::ParseResult> PostgresParser::BuildParseTree(const std::string &query_string) {
+std::unique_ptr<parser::ParseResult> PostgresParser::BuildParseTree(const std::string &query_string,
+                                                                    const bool parameterize_literals) {
   auto text = query_string.c_str();
   auto ctx = pg_query_parse_init();
   auto result = pg_query_parse(text);
@@ -60,6 +62,7 @@ std::unique_ptr<parser::ParseResult> PostgresParser::BuildParseTree(const std::s
 
   // Transform the Postgres parse tree to a Terrier representation.
   auto parse_result = std::make_unique<ParseResult>();
+  parse_result->SetParameterizeLiterals(parameterize_literals && IsParameterizable(result.tree));
   try {
     ListTransform(parse_result.get(), result.tree);
   } catch (const Exception &e) {
@@ -71,9 +74,95 @@ std::unique_ptr<parser::ParseResult> PostgresParser::BuildParseTree(const std::s
 
   pg_query_parse_finish(ctx);
   pg_query_free_parse_result(result);
+
+  if (!parse_result->GetParameters().empty() && !NormalizeQueryText(query_string, parse_result.get())) {
+    // Without a normalized text the parameters cannot be told apart from the literals that stay, give up on them
+    PARSER_LOG_DEBUG("BuildParseTree: could not normalize \"{}\"", query_string);
+    return BuildParseTree(query_string, false);
+  }
   return parse_result;
 }
 
+bool PostgresParser::IsParameterizable(List *root) {
+  if (root == nullptr || root->length != 1) return false;
+  switch (static_cast<Node *>(root->head->data.ptr_value)->type) {
+    case T_SelectStmt:
+    case T_InsertStmt:
+    case T_UpdateStmt:
+    case T_DeleteStmt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool PostgresParser::NormalizeQueryText(const std::string &query_string, ParseResult *parse_result) {
+  const auto &locations = parse_result->GetParameterLocations();
+  std::vector<uint32_t> param_idxs(locations.size());
+  for (uint32_t i = 0; i < param_idxs.size(); i++) param_idxs[i] = i;
+  std::sort(param_idxs.begin(), param_idxs.end(),
+            [&locations](const uint32_t lhs, const uint32_t rhs) { return locations[lhs] < locations[rhs]; });
+
+  const auto is_digit = [&query_string](const size_t pos) {
+    return pos < query_string.size() && std::isdigit(static_cast<unsigned char>(query_string[pos])) != 0;
+  };
+
+  std::string normalized;
+  normalized.reserve(query_string.size());
+  size_t copied = 0;
+  for (const auto param_idx : param_idxs) {
+    const size_t start = locations[param_idx];
+    if (start < copied || start >= query_string.size()) return false;
+
+    // Find the end of the literal. Postgres folds a leading minus sign into numeric literals.
+    size_t end = start;
+    if (query_string[end] == '-') {
+      end++;
+      while (end < query_string.size() && std::isspace(static_cast<unsigned char>(query_string[end])) != 0) end++;
+    }
+    if (end < query_string.size() && query_string[end] == '\'') {
+      // Standard string, quotes inside it are doubled. Prefixed strings (E'', B'', ...) are not handled.
+      for (end++; end < query_string.size(); end++) {
+        if (query_string[end] != '\'') continue;
+        if (end + 1 < query_string.size() && query_string[end + 1] == '\'') {
+          end++;
+          continue;
+        }
+        break;
+      }
+      if (end == query_string.size()) return false;
+      end++;
+    } else if (is_digit(end) || (end < query_string.size() && query_string[end] == '.' && is_digit(end + 1))) {
+      while (is_digit(end) || (end < query_string.size() && query_string[end] == '.')) end++;
+      if (end < query_string.size() && (query_string[end] == 'e' || query_string[end] == 'E')) {
+        size_t exponent = end + 1;
+        if (exponent < query_string.size() && (query_string[exponent] == '+' || query_string[exponent] == '-')) {
+          exponent++;
+        }
+        if (is_digit(exponent)) {
+          end = exponent;
+          while (is_digit(end)) end++;
+        }
+      }
+    } else {
+      return false;
+    }
+    // Anything glued to the literal means that it was not a literal on its own
+    if (end < query_string.size() && (std::isalnum(static_cast<unsigned char>(query_string[end])) != 0 ||
+                                      query_string[end] == '_' || query_string[end] == '\'')) {
+      return false;
+    }
+
+    normalized.append(query_string, copied, start - copied);
+    normalized.append("$").append(std::to_string(param_idx + 1));
+    copied = end;
+  }
+  normalized.append(query_string, copied, std::string::npos);
+
+  parse_result->SetNormalizedQueryText(std::move(normalized));
+  return true;
+}
+
 void PostgresParser::ListTransform(ParseResult *parse_result, List *root) {
   if (root != nullptr) {
     for (auto cell = root->head; cell != nullptr; cell = cell->next) {
@@ -251,6 +340,25 @@ std::unique_ptr<AbstractExpression> PostgresParser::ExprTransform(ParseResult *p
   return expr;
 }
 
+// Postgres.A_Const -> noisepage.ParameterValueExpression, if literals are being parameterized. Otherwise ExprTransform.
+std::unique_ptr<AbstractExpression> PostgresParser::ParameterizableExprTransform(ParseResult *parse_result,
+                                                                                Node *node) {
+  if (node == nullptr || node->type != T_A_Const || !parse_result->ParameterizeLiterals()) {
+    return ExprTransform(parse_result, node, nullptr);
+  }
+
+  auto root = reinterpret_cast<A_Const *>(node);
+  // NULL has no type of its own, and literals without a location cannot be normalized. They stay constants.
+  if (root->val_.type_ == T_Null || root->location_ < 0) {
+    return ConstTransform(parse_result, root);
+  }
+
+  auto value = ValueTransform(parse_result, root->val_);
+  const auto param_idx = parse_result->AddParameter(std::move(*static_cast<ConstantValueExpression *>(value.get())),
+                                                    static_cast<uint32_t>(root->location_));
+  return std::make_unique<ParameterValueExpression>(param_idx);
+}
+
 /**
  * DO NOT USE THIS UNLESS YOU MUST.
  * Converts the Postgres parser's expression into our own expression type.
@@ -451,8 +559,31 @@ std::unique_ptr<AbstractExpression> PostgresParser::AExprTransform(ParseResult *
   } else {
     auto name = (reinterpret_cast<value *>(root->name_->head->data.ptr_value))->val_.str_;
     target_type = StringToExpressionType(name);
-    children.emplace_back(ExprTransform(parse_result, root->lexpr_, nullptr));
-    children.emplace_back(ExprTransform(parse_result, root->rexpr_, nullptr));
+    switch (target_type) {
+      case ExpressionType::COMPARE_EQUAL:
+      case ExpressionType::COMPARE_NOT_EQUAL:
+      case ExpressionType::COMPARE_LESS_THAN:
+      case ExpressionType::COMPARE_GREATER_THAN:
+      case ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      case ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      case ExpressionType::COMPARE_LIKE:
+      case ExpressionType::COMPARE_NOT_LIKE: {
+        // The binder types a parameter compared to a column like it types a literal, so these can be parameterized.
+        // Elsewhere, e.g. in a select list, a parameter would change the type of the output.
+        if (parse_result->InPredicate()) {
+          children.emplace_back(ParameterizableExprTransform(parse_result, root->lexpr_));
+          children.emplace_back(ParameterizableExprTransform(parse_result, root->rexpr_));
+        } else {
+          children.emplace_back(ExprTransform(parse_result, root->lexpr_, nullptr));
+          children.emplace_back(ExprTransform(parse_result, root->rexpr_, nullptr));
+        }
+        break;
+      }
+      default: {
+        children.emplace_back(ExprTransform(parse_result, root->lexpr_, nullptr));
+        children.emplace_back(ExprTransform(parse_result, root->rexpr_, nullptr));
+      }
+    }
   }
 
   switch (target_type) {
@@ -800,6 +931,9 @@ std::unique_ptr<AbstractExpression> PostgresParser::ValueTransform(ParseResult *
 
 std::unique_ptr<SelectStatement> PostgresParser::SelectTransform(ParseResult *parse_result, SelectStmt *root) {
   std::unique_ptr<SelectStatement> result{};
+  // Only the predicates of a (sub)query are parameterized, not its select list, grouping or ordering
+  const bool in_predicate = parse_result->InPredicate();
+  parse_result->SetInPredicate(false);
 
   switch (root->op_) {
     case SETOP_NONE: {
@@ -836,6 +970,7 @@ std::unique_ptr<SelectStatement> PostgresParser::SelectTransform(ParseResult *pa
     }
   }
 
+  parse_result->SetInPredicate(in_predicate);
   return result;
 }
 
@@ -1000,7 +1135,10 @@ common::ManagedPointer<AbstractExpression> PostgresParser::WhereTransform(ParseR
   if (root == nullptr) {
     return nullptr;
   }
+  const bool in_predicate = parse_result->InPredicate();
+  parse_result->SetInPredicate(true);
   auto expr = ExprTransform(parse_result, root, nullptr);
+  parse_result->SetInPredicate(in_predicate);
   auto result = common::ManagedPointer(expr);
   parse_result->AddExpression(std::move(expr));
   return result;
@@ -1088,6 +1226,8 @@ std::unique_ptr<JoinDefinition> PostgresParser::JoinTransform(ParseResult *parse
   }
 
   std::unique_ptr<AbstractExpression> expr;
+  const bool in_predicate = parse_result->InPredicate();
+  parse_result->SetInPredicate(true);
   switch (root->quals_->type) {
     case T_A_Expr: {
       expr = AExprTransform(parse_result, reinterpret_cast<A_Expr *>(root->quals_));
@@ -1101,6 +1241,7 @@ std::unique_ptr<JoinDefinition> PostgresParser::JoinTransform(ParseResult *parse
       PARSER_LOG_AND_THROW("JoinTransform", "Join condition type", root->quals_->type);
     }
   }
+  parse_result->SetInPredicate(in_predicate);
 
   auto condition = common::ManagedPointer(expr);
   parse_result->AddExpression(std::move(expr));
@@ -2011,7 +2152,7 @@ PostgresParser::ValueListsTransform(ParseResult *parse_result, List *root) {
           break;
         }
         case T_A_Const: {
-          expr = ConstTransform(parse_result, reinterpret_cast<A_Const *>(expr_pg));
+          expr = ParameterizableExprTransform(parse_result, reinterpret_cast<Node *>(expr_pg));
           break;
         }
         case T_A_Expr: {
@@ -2069,7 +2210,7 @@ std::vector<std::unique_ptr<UpdateClause>> PostgresParser::UpdateTargetTransform
   for (auto cell = root->head; cell != nullptr; cell = cell->next) {
     auto target = reinterpret_cast<ResTarget *>(cell->data.ptr_value);
     auto column = target->name_;
-    auto expr = ExprTransform(parse_result, target->val_, nullptr);
+    auto expr = ParameterizableExprTransform(parse_result, target->val_);
     auto expr_ptr = common::ManagedPointer(expr);
     parse_result->AddExpression(std::move(expr));
     result.emplace_back(std::make_unique<UpdateClause>(column, expr_ptr));
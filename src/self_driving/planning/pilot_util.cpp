@@ -246,7 +246,7 @@ std::unique_ptr<metrics::PipelineMetricRawData> PilotUtil::CollectPipelineFeatur
         for (auto &iter : ous->GetPipelineFeatureMap()) {
           // TODO(lin): Get the execution mode from settings manager when we can support changing it...
           aggregated_data->RecordPipelineData(
-              qid, iter.first, 0, std::vector<ExecutionOperatingUnitFeature>(iter.second), resource_metrics);
+              qid, iter.first, 0, 0, 0, 0, std::vector<ExecutionOperatingUnitFeature>(iter.second), resource_metrics);
         }
         query_util->ClearPlan(query_text);
       }
@@ -708,8 +708,8 @@ void PilotUtil::EstimateCreateIndexAction(PlanningContext *planning_context, Cre
   std::unique_ptr<metrics::PipelineMetricRawData> aggregated_data = std::make_unique<metrics::PipelineMetricRawData>();
   for (auto &iter : ous->GetPipelineFeatureMap()) {
     // TODO(lin): Interpret mode by default. May want to add that as an option (knob) for the action
-    aggregated_data->RecordPipelineData(qid, iter.first, 0, std::vector<ExecutionOperatingUnitFeature>(iter.second),
-                                        resource_metrics);
+    aggregated_data->RecordPipelineData(qid, iter.first, 0, 0, 0, 0,
+                                        std::vector<ExecutionOperatingUnitFeature>(iter.second), resource_metrics);
   }
   query_util->ClearPlan(query_text);
 
@@ -163,6 +163,17 @@ void Callbacks::MetricsExecuteCommand(void *const old_value, void *const new_val
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::MetricsPlanCache(void *const old_value, void *const new_value, DBMain *const db_main,
+                                 common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  bool new_status = *static_cast<bool *>(new_value);
+  if (new_status)
+    db_main->GetMetricsManager()->EnableMetric(metrics::MetricsComponent::PLAN_CACHE);
+  else
+    db_main->GetMetricsManager()->DisableMetric(metrics::MetricsComponent::PLAN_CACHE);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::MetricsQueryTrace(void *const old_value, void *const new_value, DBMain *const db_main,
                                   common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
@@ -201,6 +212,14 @@ void Callbacks::ClearQueryCache(void *old_value, void *new_value, DBMain *db_mai
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::PlanCacheSize(void *const old_value, void *const new_value, DBMain *const db_main,
+                              common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  int64_t plan_cache_size = *static_cast<int64_t *>(new_value);
+  db_main->GetTrafficCop()->GetPlanCache()->SetSizeLimit(static_cast<uint64_t>(plan_cache_size));
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::ForecastSampleLimit(void *old_value, void *new_value, DBMain *db_main,
                                     common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
@@ -99,8 +99,12 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     for (uint16_t i = 0; i < undo->Delta()->NumColumns(); i++)
       StorageUtil::CopyAttrIntoProjection(accessor_, slot, undo->Delta(), i);
 
-    // Update the next pointer of the new head of the version chain
-    undo->Next() = version_ptr;
+    // Update the next pointer of the new head of the version chain, leaving out the previous head if no running
+    // transaction can see it anymore
+    undo->Next() = version_ptr != nullptr && transaction::TransactionUtil::NewerThan(txn->PruneHorizon(),
+                                                                                      version_ptr->Timestamp().load())
+                       ? nullptr
+                       : version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
 
   // Update in place with the new value.
@@ -213,8 +217,12 @@ bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
       return false;
     }
 
-    // Update the next pointer of the new head of the version chain
-    undo->Next() = version_ptr;
+    // Update the next pointer of the new head of the version chain, leaving out the previous head if no running
+    // transaction can see it anymore
+    undo->Next() = version_ptr != nullptr && transaction::TransactionUtil::NewerThan(txn->PruneHorizon(),
+                                                                                      version_ptr->Timestamp().load())
+                       ? nullptr
+                       : version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
 
   // We have the write lock. Go ahead and flip the logically deleted bit to true
@@ -265,6 +273,7 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
   }
 
   // Apply deltas until we reconstruct a version safe for us to read
+  UndoRecord *prev = nullptr;
   while (version_ptr != nullptr &&
          transaction::TransactionUtil::NewerThan(version_ptr->Timestamp().load(), txn->StartTime())) {
     switch (version_ptr->Type()) {
@@ -281,9 +290,12 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
       default:
         throw std::runtime_error("unexpected delta record type");
     }
+    prev = version_ptr;
     version_ptr = version_ptr->Next();
   }
 
+  // Nobody else needs the rest of the version chain either if it is old enough
+  PruneVersionChain(slot, prev, version_ptr, txn->PruneHorizon());
   return visible;
 }
 
@@ -326,12 +338,27 @@ bool DataTable::HasConflict(const transaction::TransactionContext &txn, UndoReco
 }
 
 bool DataTable::CompareAndSwapVersionPtr(const TupleSlot slot, const TupleAccessStrategy &accessor,
-                                         UndoRecord *expected, UndoRecord *const desired) {
+                                         UndoRecord *expected, UndoRecord *const desired) const {
   // Okay to ignore presence bit, because we use that for logical delete, not for validity of the version pointer value
   byte *ptr_location = accessor.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID);
   return reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, desired);
 }
 
+void DataTable::PruneVersionChain(const TupleSlot slot, UndoRecord *const prev, UndoRecord *const version_ptr,
+                                  const transaction::timestamp_t horizon) const {
+  if (version_ptr == nullptr || !transaction::TransactionUtil::NewerThan(horizon, version_ptr->Timestamp().load()))
+    return;
+  if (prev == nullptr) {
+    // Like in the GC, the head can only be unlinked if nobody installed a new one in the meantime. If somebody did,
+    // the chain is left for the next reader or the GC to prune.
+    CompareAndSwapVersionPtr(slot, accessor_, version_ptr, nullptr);
+    return;
+  }
+  // Other than the head's, the next pointers in a version chain are only ever cleared, so it does not matter whether
+  // the GC or another reader got here first.
+  prev->Next().store(nullptr);
+}
+
 RawBlock *DataTable::NewBlock() {
   RawBlock *new_block = block_store_->Get();
   accessor_.InitializeRawBlock(this, new_block, layout_version_);
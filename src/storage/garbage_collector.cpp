@@ -1,7 +1,9 @@
 #include "storage/garbage_collector.h"
 
+#include <algorithm>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/thread_context.h"
@@ -21,14 +23,33 @@ namespace noisepage::storage {
 GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+    const uint32_t num_workers)
     : timestamp_manager_(timestamp_manager),
       deferred_action_manager_(deferred_action_manager),
       txn_manager_(txn_manager),
       observer_(observer),
+      num_workers_(num_workers),
       last_unlinked_{0} {
   NOISEPAGE_ASSERT(txn_manager_->GCEnabled(),
                    "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+  NOISEPAGE_ASSERT(num_workers_ > 0, "The GC needs at least one worker.");
+  if (num_workers_ > 1) {
+    worker_pool_ = std::make_unique<common::WorkerPool>(num_workers_ - 1, common::TaskQueue());
+    worker_pool_->Startup();
+  }
+}
+
+void GarbageCollector::ForEachWorker(const std::function<void(uint32_t)> &task) {
+  for (uint32_t worker = 1; worker < num_workers_; worker++) {
+    worker_pool_->SubmitTask([&task, worker] { task(worker); });
+  }
+  task(0);
+  if (worker_pool_ != nullptr) worker_pool_->WaitUntilAllFinished();
+}
+
+uint32_t GarbageCollector::SlotPartition(const TupleSlot slot) const {
+  return static_cast<uint32_t>(std::hash<TupleSlot>()(slot) % num_workers_);
 }
 
 std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
@@ -60,7 +81,9 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
       common::thread_context.resource_tracker_.Stop();
       auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
       common::thread_context.metrics_store_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked,
-                                                          readonly_unlinked, gc_interval_, resource_metrics);
+                                                          readonly_unlinked, gc_interval_, version_chains_,
+                                                          version_chain_length_, max_version_chain_length_,
+                                                          resource_metrics);
     }
     common::thread_context.resource_tracker_.Start();
   }
@@ -75,9 +98,17 @@ uint32_t GarbageCollector::ProcessDeallocateQueue(transaction::timestamp_t oldes
     // All of the transactions in my deallocation queue were unlinked before the oldest running txn in the system, and
     // have been serialized by the log manager. We are now safe to deallocate these txns because no running
     // transaction should hold a reference to them anymore
-    for (auto &txn : txns_to_deallocate_) {
-      delete txn;
-      txns_processed++;
+    if (num_workers_ == 1) {
+      for (auto &txn : txns_to_deallocate_) {
+        delete txn;
+        txns_processed++;
+      }
+    } else {
+      const std::vector<transaction::TransactionContext *> txns(txns_to_deallocate_.begin(), txns_to_deallocate_.end());
+      ForEachWorker([&](const uint32_t worker) {
+        for (size_t i = worker; i < txns.size(); i += num_workers_) delete txns[i];
+      });
+      txns_processed = static_cast<uint32_t>(txns.size());
     }
     txns_to_deallocate_.clear();
   }
@@ -98,10 +129,8 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
-  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-  // wasteful traversals of the version chain.
-  std::unordered_set<TupleSlot> visited_slots;
+  // Transactions whose UndoRecords can be unlinked
+  std::vector<transaction::TransactionContext *> txns_to_process;
 
   // Process every transaction in the unlink queue
   while (!txns_to_unlink_.empty()) {
@@ -115,22 +144,7 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
       readonly_processed++;
     } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
       // Safe to garbage collect.
-      for (auto &undo_record : txn->undo_buffer_) {
-        // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimBufferIfVarlen(txn, &undo_record);
-          ReclaimSlotIfDeleted(&undo_record);
-        }
-        if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
-        buffer_processed++;
-      }
+      txns_to_process.push_back(txn);
       txns_to_deallocate_.push_front(txn);
       txns_processed++;
     } else {
@@ -139,6 +153,72 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
     }
   }
 
+  // First, every worker splits the UndoRecords of its share of the transactions by the worker that owns their version
+  // chain. partitions[i][j] holds the records found by worker i for worker j.
+  std::vector<std::vector<std::vector<UndoRecord *>>> partitions(
+      num_workers_, std::vector<std::vector<UndoRecord *>>(num_workers_));
+  std::vector<uint32_t> records_found(num_workers_, 0);
+  ForEachWorker([&](const uint32_t worker) {
+    for (size_t i = worker; i < txns_to_process.size(); i += num_workers_) {
+      for (auto &undo_record : txns_to_process[i]->undo_buffer_) {
+        // It is possible for the table field to be null, for aborted transaction's last conflicting record
+        if (undo_record.Table() != nullptr)
+          partitions[worker][SlotPartition(undo_record.Slot())].push_back(&undo_record);
+        records_found[worker]++;
+      }
+    }
+  });
+
+  // Then every worker truncates the version chains it owns. Each version chain is only reachable from a single
+  // partition, so no two workers ever traverse the same version chain.
+  std::vector<uint64_t> chain_lengths(num_workers_, 0), max_chain_lengths(num_workers_, 0);
+  std::vector<uint64_t> num_chains(num_workers_, 0);
+  ForEachWorker([&](const uint32_t worker) {
+    // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
+    // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
+    // wasteful traversals of the version chain.
+    std::unordered_set<TupleSlot> visited_slots;
+    for (const auto &records : partitions) {
+      for (UndoRecord *const undo_record : records[worker]) {
+        if (!visited_slots.insert(undo_record->Slot()).second) continue;
+        const uint32_t chain_length = TruncateVersionChain(undo_record->Table(), undo_record->Slot(), oldest_txn);
+        chain_lengths[worker] += chain_length;
+        max_chain_lengths[worker] = std::max<uint64_t>(max_chain_lengths[worker], chain_length);
+      }
+    }
+    num_chains[worker] = visited_slots.size();
+  });
+  version_chains_ = 0;
+  version_chain_length_ = 0;
+  max_version_chain_length_ = 0;
+  for (uint32_t worker = 0; worker < num_workers_; worker++) {
+    version_chains_ += num_chains[worker];
+    version_chain_length_ += chain_lengths[worker];
+    max_version_chain_length_ = std::max(max_version_chain_length_, max_chain_lengths[worker]);
+  }
+
+  // Last, every worker reclaims deleted slots and any dangling pointers to varlens of its share of the transactions,
+  // unless the transaction is aborted, and the record holds a version that is still visible. This only happens once
+  // all version chains are truncated, so that no slot is deallocated while its version chain is still traversed.
+  ForEachWorker([&](const uint32_t worker) {
+    for (size_t i = worker; i < txns_to_process.size(); i += num_workers_) {
+      transaction::TransactionContext *const txn_to_process = txns_to_process[i];
+      if (txn_to_process->Aborted()) continue;
+      for (auto &undo_record : txn_to_process->undo_buffer_) {
+        ReclaimBufferIfVarlen(txn_to_process, &undo_record);
+        ReclaimSlotIfDeleted(&undo_record);
+      }
+    }
+  });
+
+  for (const uint32_t records : records_found) buffer_processed += records;
+  if (observer_ != nullptr) {
+    // The observer is not thread-safe, so it is only told about the writes once the workers are done
+    for (auto *const txn_to_process : txns_to_process) {
+      for (auto &undo_record : txn_to_process->undo_buffer_) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+    }
+  }
+
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
@@ -152,13 +232,13 @@ void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_tx
   }
 }
 
-void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleSlot slot,
-                                            const transaction::timestamp_t oldest) const {
+uint32_t GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleSlot slot,
+                                                const transaction::timestamp_t oldest) const {
   const TupleAccessStrategy &accessor = table->accessor_;
   UndoRecord *const version_ptr = table->AtomicallyReadVersionPtr(slot, accessor);
   // This is a legitimate case where we truncated the version chain but had to restart because the previous head
   // was aborted.
-  if (version_ptr == nullptr) return;
+  if (version_ptr == nullptr) return 0;
 
   // We need to special case the head of the version chain because contention with running transactions can happen
   // here. Instead of a blind update we will need to CAS and prune the entire version chain if the head of the version
@@ -167,20 +247,23 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
     if (!table->CompareAndSwapVersionPtr(slot, accessor, version_ptr, nullptr))
       // Keep retrying while there are conflicts, since we only invoke truncate once per GC period for every
       // version chain.
-      TruncateVersionChain(table, slot, oldest);
-    return;
+      return TruncateVersionChain(table, slot, oldest);
+    return 1;
   }
 
-  // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-  // to traverse and update pointers without CAS
+  // Other than at the head, a version chain only ever changes by getting truncated, either by the single GC worker
+  // that owns it or by transactions pruning it as they go (see DataTable::PruneVersionChain), so we are safe to
+  // traverse and update pointers without CAS
   UndoRecord *curr = version_ptr;
   UndoRecord *next;
+  uint32_t chain_length = 1;
   // Traverse until we find the earliest UndoRecord that can be unlinked.
   while (true) {
     next = curr->Next();
     // This is a legitimate case where we truncated the version chain but had to restart because the previous head
-    // was aborted.
-    if (next == nullptr) return;
+    // was aborted. It is also what a chain already pruned by transactions looks like.
+    if (next == nullptr) return chain_length;
+    chain_length++;
     if (transaction::TransactionUtil::NewerThan(oldest, next->Timestamp().load())) break;
     curr = next;
   }
@@ -191,7 +274,8 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
   // If the head of the version chain was not committed, it could have been aborted and requires a retry.
   if (curr == version_ptr && !transaction::TransactionUtil::Committed(version_ptr->Timestamp().load()) &&
       table->AtomicallyReadVersionPtr(slot, accessor) != version_ptr)
-    TruncateVersionChain(table, slot, oldest);
+    return TruncateVersionChain(table, slot, oldest);
+  return chain_length;
 }
 
 void GarbageCollector::ReclaimSlotIfDeleted(UndoRecord *const undo_record) const {
@@ -247,7 +331,15 @@ void GarbageCollector::UnregisterIndexForGC(const common::ManagedPointer<index::
 
 void GarbageCollector::ProcessIndexes() {
   common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
-  for (const auto &index : indexes_) index->PerformGarbageCollection();
+  if (num_workers_ == 1) {
+    for (const auto &index : indexes_) index->PerformGarbageCollection();
+    return;
+  }
+  // Indexes are collected independently of each other, so each one is handed to a single worker
+  const std::vector<common::ManagedPointer<index::Index>> indexes(indexes_.cbegin(), indexes_.cend());
+  ForEachWorker([&](const uint32_t worker) {
+    for (size_t i = worker; i < indexes.size(); i += num_workers_) indexes[i]->PerformGarbageCollection();
+  });
 }
 
 }  // namespace noisepage::storage
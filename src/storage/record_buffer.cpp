@@ -3,6 +3,136 @@
 #include "storage/write_ahead_log/log_manager.h"
 
 namespace noisepage::storage {
+RecordBufferSegmentPool::~RecordBufferSegmentPool() {
+  for (auto &cache : caches_)
+    for (auto *segment : cache.segments_) alloc_.Delete(segment);
+  RecordBufferSegment *batch;
+  while (batches_.Dequeue(&batch)) {
+    while (batch != nullptr) {
+      RecordBufferSegment *const next = NextInBatch(batch);
+      alloc_.Delete(batch);
+      batch = next;
+    }
+  }
+}
+
+uint32_t RecordBufferSegmentPool::ThreadCache() {
+  static std::atomic<uint32_t> next_cache{0};
+  thread_local const uint32_t cache = next_cache++ % NUM_CACHES;
+  return cache;
+}
+
+RecordBufferSegment *RecordBufferSegmentPool::Get() {
+  const uint32_t thread_cache = ThreadCache();
+  RecordBufferSegment *result = TakeFromCache(&caches_[thread_cache]);
+  if (result == nullptr) result = TakeFromBatch(&caches_[thread_cache]);
+  if (result == nullptr) result = Allocate();
+  // At the size limit, the free segments can still sit in the caches of other threads
+  for (uint32_t i = 1; result == nullptr && i < NUM_CACHES; i++)
+    result = TakeFromCache(&caches_[(thread_cache + i) % NUM_CACHES]);
+  if (result == nullptr) throw common::NoMoreObjectException(size_limit_.load());
+  alloc_.Reuse(result);
+  return result;
+}
+
+RecordBufferSegment *RecordBufferSegmentPool::TakeFromCache(SegmentCache *const cache) {
+  common::SpinLatch::ScopedSpinLatch guard(&cache->latch_);
+  if (cache->segments_.empty()) return nullptr;
+  RecordBufferSegment *const result = cache->segments_.back();
+  cache->segments_.pop_back();
+  num_reusable_--;
+  return result;
+}
+
+RecordBufferSegment *RecordBufferSegmentPool::TakeFromBatch(SegmentCache *const cache) {
+  RecordBufferSegment *result;
+  if (!batches_.Dequeue(&result)) return nullptr;
+  // The rest of the batch refills the cache
+  common::SpinLatch::ScopedSpinLatch guard(&cache->latch_);
+  for (RecordBufferSegment *segment = NextInBatch(result); segment != nullptr; segment = NextInBatch(segment))
+    cache->segments_.push_back(segment);
+  num_reusable_--;
+  return result;
+}
+
+RecordBufferSegment *RecordBufferSegmentPool::Allocate() {
+  uint64_t size = current_size_.load();
+  do {
+    if (size >= size_limit_.load()) return nullptr;
+  } while (!current_size_.compare_exchange_weak(size, size + 1));
+  RecordBufferSegment *const result = alloc_.New();
+  if (result == nullptr) {
+    current_size_--;
+    throw common::AllocatorFailureException();
+  }
+  return result;
+}
+
+void RecordBufferSegmentPool::Free(RecordBufferSegment *const segment) {
+  alloc_.Delete(segment);
+  current_size_--;
+}
+
+void RecordBufferSegmentPool::Release(RecordBufferSegment *const segment) {
+  NOISEPAGE_ASSERT(segment != nullptr, "releasing a null pointer");
+  if (num_reusable_++ >= reuse_limit_.load()) {
+    num_reusable_--;
+    Free(segment);
+    return;
+  }
+
+  SegmentCache &cache = caches_[ThreadCache()];
+  RecordBufferSegment *batch = nullptr;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&cache.latch_);
+    cache.segments_.push_back(segment);
+    if (cache.segments_.size() < 2 * BATCH_SIZE) return;
+    // Hand the least recently released segments over to other threads, and keep the ones still likely in cache
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+      NextInBatch(cache.segments_[i]) = batch;
+      batch = cache.segments_[i];
+    }
+    cache.segments_.erase(cache.segments_.begin(), cache.segments_.begin() + BATCH_SIZE);
+  }
+  batches_.Enqueue(batch);
+}
+
+bool RecordBufferSegmentPool::SetSizeLimit(const uint64_t new_size) {
+  common::SpinLatch::ScopedSpinLatch guard(&limits_latch_);
+  if (new_size < current_size_.load()) return false;
+  size_limit_.store(new_size);
+  return true;
+}
+
+void RecordBufferSegmentPool::SetReuseLimit(const uint64_t new_reuse_limit) {
+  common::SpinLatch::ScopedSpinLatch guard(&limits_latch_);
+  reuse_limit_.store(new_reuse_limit);
+  // Free the segments nobody is going to reuse soon first
+  RecordBufferSegment *batch;
+  while (num_reusable_.load() > new_reuse_limit && batches_.Dequeue(&batch)) {
+    for (RecordBufferSegment *segment = batch; segment != nullptr;) {
+      RecordBufferSegment *const next = NextInBatch(segment);
+      if (num_reusable_.load() > new_reuse_limit) {
+        num_reusable_--;
+        Free(segment);
+      } else {
+        // Within the limit again, keep the rest
+        common::SpinLatch::ScopedSpinLatch cache_guard(&caches_[ThreadCache()].latch_);
+        caches_[ThreadCache()].segments_.push_back(segment);
+      }
+      segment = next;
+    }
+  }
+  for (auto &cache : caches_) {
+    common::SpinLatch::ScopedSpinLatch cache_guard(&cache.latch_);
+    while (num_reusable_.load() > new_reuse_limit && !cache.segments_.empty()) {
+      num_reusable_--;
+      Free(cache.segments_.back());
+      cache.segments_.pop_back();
+    }
+  }
+}
+
 byte *UndoBuffer::NewEntry(const uint32_t size) {
   if (buffers_.empty() || !buffers_.back()->HasBytesLeft(size)) {
     // we are out of space in the buffer. Get a new buffer segment.
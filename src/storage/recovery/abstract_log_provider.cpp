@@ -36,6 +36,10 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
       return {storage::AbortRecord::Initialize(buf, txn_begin, nullptr, nullptr), varlen_contents};
     }
 
+    case (storage::LogRecordType::CHECKPOINT): {
+      return {storage::CheckpointRecord::Initialize(buf, txn_begin), varlen_contents};
+    }
+
     case (storage::LogRecordType::DELETE): {
       auto database_oid = ReadValue<catalog::db_oid_t>();
       auto table_oid = ReadValue<catalog::table_oid_t>();
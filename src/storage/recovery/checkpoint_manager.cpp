@@ -0,0 +1,462 @@
+#include "storage/recovery/checkpoint_manager.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "common/posix_io_wrappers.h"
+#include "storage/recovery/abstract_log_provider.h"
+#include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+/**
+ * Reads log records from a log file and keeps the serialized bytes of the last record read, so that records can be
+ * copied to another log file without having to serialize them again.
+ */
+class RawLogReader : public AbstractLogProvider {
+ public:
+  explicit RawLogReader(const std::string &log_file_path) : in_(log_file_path.c_str()) {}
+
+  ~RawLogReader() { ReleaseRecord(); }
+
+  LogProviderType GetType() const override { return LogProviderType::DISK; }
+
+  /** @return the next record, nullptr if there are none left. Only valid until the next call. */
+  const LogRecord *NextRecord() {
+    ReleaseRecord();
+    raw_record_.clear();
+    std::tie(record_, varlen_contents_) = GetNextRecord();
+    return record_;
+  }
+
+  /** @return the serialized bytes of the last record read */
+  const std::vector<byte> &RawRecord() const { return raw_record_; }
+
+ private:
+  BufferedLogReader in_;
+  LogRecord *record_ = nullptr;
+  std::vector<byte *> varlen_contents_;
+  std::vector<byte> raw_record_;
+
+  bool HasMoreRecords() override { return in_.HasMore(); }
+
+  bool Read(void *dest, uint32_t size) override {
+    const bool result = in_.Read(dest, size);
+    raw_record_.insert(raw_record_.end(), reinterpret_cast<byte *>(dest), reinterpret_cast<byte *>(dest) + size);
+    return result;
+  }
+
+  void ReleaseRecord() {
+    delete[] reinterpret_cast<byte *>(record_);
+    for (auto *varlen_content : varlen_contents_) delete[] varlen_content;
+    record_ = nullptr;
+    varlen_contents_.clear();
+  }
+};
+
+/** Number of tuples copied between checks of the checkpoint deadline. */
+constexpr uint32_t DEADLINE_CHECK_INTERVAL = 1024;
+
+bool IsCatalogTable(const catalog::table_oid_t table_oid) { return table_oid.UnderlyingValue() < catalog::START_OID; }
+
+bool IsNonEmptyFile(const std::string &path) {
+  struct stat buf;
+  return stat(path.c_str(), &buf) == 0 && buf.st_size > 0;
+}
+
+void WriteBytes(BufferedLogWriter *const out, const void *const data, const uint32_t size) {
+  uint32_t written = 0;
+  while (written < size) {
+    if (out->IsBufferFull()) out->FlushBuffer();
+    written += out->BufferWrite(reinterpret_cast<const byte *>(data) + written, size - written);
+  }
+}
+
+template <class T>
+void WriteValue(BufferedLogWriter *const out, const T &val) {
+  WriteBytes(out, &val, sizeof(T));
+}
+
+/**
+ * Serializes the record that commits the checkpoint, upon which recovery replays every transaction before the
+ * checkpoint, and then the checkpoint.
+ */
+void SerializeCheckpointRecord(BufferedLogWriter *const out, const transaction::timestamp_t checkpoint_ts) {
+  WriteValue(out, CheckpointRecord::Size());
+  WriteValue(out, LogRecordType::CHECKPOINT);
+  WriteValue(out, checkpoint_ts);
+}
+
+/** Copies the records of the log file that pass the filter to out. */
+template <class Filter>
+void CopyRecords(const std::string &log_file_path, BufferedLogWriter *const out, const Filter &filter) {
+  RawLogReader in(log_file_path);
+  for (auto *record = in.NextRecord(); record != nullptr; record = in.NextRecord()) {
+    if (filter(*record)) WriteBytes(out, in.RawRecord().data(), static_cast<uint32_t>(in.RawRecord().size()));
+  }
+}
+
+/**
+ * Writes a file next to the path it is meant for, and only moves it into place once it is persisted. Unless it was
+ * committed, e.g. because writing it threw, the partially written file is removed again when the writer goes out of
+ * scope.
+ */
+class TmpFileWriter {
+ public:
+  TmpFileWriter(std::string path, const LogBlockFormat format) : path_(std::move(path)), tmp_path_(path_ + ".tmp") {
+    unlink(tmp_path_.c_str());
+    out_ = std::make_unique<BufferedLogWriter>(tmp_path_.c_str(), format);
+  }
+
+  ~TmpFileWriter() {
+    if (committed_) return;
+    if (out_ != nullptr) {
+      try {
+        out_->Close();
+      } catch (const std::runtime_error &e) {
+        STORAGE_LOG_WARN("Failed to close {}: {}", tmp_path_, e.what());
+      }
+    }
+    unlink(tmp_path_.c_str());
+  }
+
+  DISALLOW_COPY_AND_MOVE(TmpFileWriter);
+
+  BufferedLogWriter *Get() const { return out_.get(); }
+
+  /** Persists the file and atomically moves it to its path. */
+  void Commit() {
+    out_->FlushBuffer();
+    out_->Persist();
+    out_->Close();
+    out_.reset();
+    if (rename(tmp_path_.c_str(), path_.c_str()) != 0) {
+      throw std::runtime_error("Failed to rename " + tmp_path_ + " to " + path_ + " with errno " +
+                               std::to_string(errno));
+    }
+    committed_ = true;
+    // Persist the rename itself by syncing the directory that contains the file.
+    const auto slash = path_.find_last_of('/');
+    const auto dir = slash == std::string::npos ? std::string(".") : path_.substr(0, slash + 1);
+    int dir_fd;
+    try {
+      dir_fd = PosixIoWrappers::Open(dir.c_str(), O_RDONLY);
+    } catch (const std::runtime_error &e) {
+      throw std::runtime_error("Failed to open directory " + dir + " to persist " + path_ + ": " + e.what());
+    }
+    if (fsync(dir_fd) != 0) {
+      const int fsync_errno = errno;
+      PosixIoWrappers::Close(dir_fd);
+      throw std::runtime_error("Failed to fsync directory " + dir + " with errno " + std::to_string(fsync_errno));
+    }
+    PosixIoWrappers::Close(dir_fd);
+  }
+
+ private:
+  const std::string path_;
+  const std::string tmp_path_;
+  std::unique_ptr<BufferedLogWriter> out_;
+  bool committed_ = false;
+};
+
+/**
+ * Runs the checkpoint transaction. It is committed when it goes out of scope at the latest, so that a checkpoint that
+ * is abandoned or fails does not hold back garbage collection.
+ */
+class CheckpointTransaction {
+ public:
+  explicit CheckpointTransaction(transaction::TransactionManager *const txn_manager)
+      : txn_manager_(txn_manager), txn_(txn_manager->BeginTransaction()) {}
+
+  ~CheckpointTransaction() { Commit(); }
+
+  DISALLOW_COPY_AND_MOVE(CheckpointTransaction);
+
+  common::ManagedPointer<transaction::TransactionContext> Get() const { return common::ManagedPointer(txn_); }
+
+  /** Commits the transaction if it is still running. The transaction only ever reads, so it never fails to commit. */
+  void Commit() {
+    if (txn_ == nullptr) return;
+    txn_manager_->Commit(txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+    txn_ = nullptr;
+  }
+
+ private:
+  transaction::TransactionManager *const txn_manager_;
+  transaction::TransactionContext *txn_;
+};
+
+}  // namespace
+
+void CheckpointManager::SerializeRedoRecord(BufferedLogWriter *const out, const LogRecord &record) {
+  WriteValue(out, record.Size());
+  WriteValue(out, record.RecordType());
+  WriteValue(out, record.TxnBegin());
+
+  auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
+  WriteValue(out, record_body->GetDatabaseOid());
+  WriteValue(out, record_body->GetTableOid());
+  WriteValue(out, record_body->GetTupleSlot());
+
+  auto *delta = record_body->Delta();
+  WriteValue(out, delta->NumColumns());
+  WriteBytes(out, delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
+
+  const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
+  uint16_t boundaries[NUM_ATTR_BOUNDARIES];
+  memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+  StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
+  WriteBytes(out, boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+
+  WriteBytes(out, &(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
+
+  for (uint16_t i = 0; i < delta->NumColumns(); i++) {
+    const auto *column_value_address = delta->AccessWithNullCheck(i);
+    if (column_value_address == nullptr) continue;
+    const col_id_t col_id = delta->ColumnIds()[i];
+    if (block_layout.IsVarlen(col_id)) {
+      const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
+      WriteValue(out, varlen_entry->Size());
+      WriteBytes(out, varlen_entry->IsInlined() ? varlen_entry->Prefix() : varlen_entry->Content(),
+                 varlen_entry->Size());
+    } else {
+      WriteBytes(out, column_value_address, block_layout.AttrSize(col_id));
+    }
+  }
+}
+
+transaction::timestamp_t CheckpointManager::ParseCheckpointFileName(const std::string &name) {
+  const std::string prefix(CHECKPOINT_FILE_PREFIX);
+  const std::string suffix(CHECKPOINT_FILE_SUFFIX);
+  if (name.size() <= prefix.size() + suffix.size() || name.rfind(prefix, 0) != 0 ||
+      name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return transaction::INVALID_TXN_TIMESTAMP;
+  }
+  const auto ts = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+  if (ts.find_first_not_of("0123456789") != std::string::npos) return transaction::INVALID_TXN_TIMESTAMP;
+  return transaction::timestamp_t(std::stoull(ts));
+}
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint(const std::chrono::milliseconds max_duration) {
+  NOISEPAGE_ASSERT(catalog_ != nullptr && txn_manager_ != nullptr, "Taking a checkpoint needs the catalog.");
+  // It is fine if the directory already exists.
+  mkdir(checkpoint_dir_.c_str(), S_IRWXU);
+
+  const bool bounded = max_duration > std::chrono::milliseconds::zero();
+  const auto deadline = std::chrono::steady_clock::now() + max_duration;
+  uint32_t copied = 0;
+
+  CheckpointTransaction txn(txn_manager_.Get());
+  const auto checkpoint_ts = txn.Get()->StartTime();
+  const auto file_path = GetCheckpointFilePath(checkpoint_ts);
+  TmpFileWriter out(file_path, LogBlockFormat::RAW);
+
+  for (const auto db_oid : catalog_->GetDatabaseOids(txn.Get())) {
+    auto db_catalog = catalog_->GetDatabaseCatalog(txn.Get(), db_oid);
+    for (const auto &table : db_catalog->GetTables(txn.Get())) {
+      // Catalog tables are recovered from their records in the log.
+      if (IsCatalogTable(table.first)) continue;
+      const auto &schema = db_catalog->GetSchema(txn.Get(), table.first);
+      std::vector<catalog::col_oid_t> col_oids;
+      col_oids.reserve(schema.GetColumns().size());
+      for (const auto &col : schema.GetColumns()) col_oids.emplace_back(col.Oid());
+      const auto initializer = table.second->InitializerForProjectedRow(col_oids);
+
+      // Every tuple is materialized into the same redo record, which is serialized right away so that varlens still
+      // point into the table.
+      std::unique_ptr<byte[]> buffer(common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer)));
+      auto *record = RedoRecord::Initialize(buffer.get(), checkpoint_ts, db_oid, table.first, initializer);
+      auto *redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+      for (auto it = table.second->begin(); it != table.second->end(); it++) {
+        if (!table.second->Select(txn.Get(), *it, redo->Delta())) continue;
+        redo->SetTupleSlot(*it);
+        SerializeRedoRecord(out.Get(), *record);
+        if (bounded && ++copied % DEADLINE_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() > deadline) break;
+      }
+
+      // The snapshot holds back garbage collection for as long as the checkpoint transaction runs, so a checkpoint
+      // that takes too long is given up on rather than letting version chains grow without bound. Leaving the scope
+      // commits the transaction and removes the unfinished file.
+      if (bounded && std::chrono::steady_clock::now() > deadline) {
+        STORAGE_LOG_WARN("Checkpoint {} abandoned after exceeding {} ms", checkpoint_ts.UnderlyingValue(),
+                         max_duration.count());
+        return transaction::INVALID_TXN_TIMESTAMP;
+      }
+    }
+  }
+  txn.Commit();
+
+  SerializeCheckpointRecord(out.Get(), checkpoint_ts);
+  out.Commit();
+  STORAGE_LOG_INFO("Checkpoint {} written to {}", checkpoint_ts.UnderlyingValue(), file_path);
+
+  // The new checkpoint supersedes all older ones. A log that was truncated with an older checkpoint contains it.
+  // Anything else in the directory, including a newer checkpoint taken concurrently, is left alone.
+  DIR *dir = opendir(checkpoint_dir_.c_str());
+  if (dir != nullptr) {
+    std::vector<std::string> stale_files;
+    for (auto *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+      const auto ts = ParseCheckpointFileName(entry->d_name);
+      if (ts != transaction::INVALID_TXN_TIMESTAMP && ts < checkpoint_ts) {
+        stale_files.emplace_back(checkpoint_dir_ + "/" + entry->d_name);
+      }
+    }
+    closedir(dir);
+    for (const auto &stale_file : stale_files) unlink(stale_file.c_str());
+  }
+
+  if (log_manager_ != nullptr) {
+    try {
+      TruncateRunningLog(checkpoint_ts);
+    } catch (const std::exception &e) {
+      // The checkpoint itself is in place, and the log is appended to whatever file is at its path.
+      STORAGE_LOG_ERROR("Failed to truncate the log to checkpoint {}: {}", checkpoint_ts.UnderlyingValue(), e.what());
+    }
+  }
+
+  return checkpoint_ts;
+}
+
+void CheckpointManager::TruncateRunningLog(const transaction::timestamp_t checkpoint_ts) const {
+  // Transactions stay running until the LogManager serialized their records. Once every transaction that started
+  // before the checkpoint is done, everything that committed before the checkpoint timestamp is in the log file after
+  // the flush that precedes the rewrite, and whatever commits later follows the checkpoint. The checkpoint transaction
+  // itself only read, so it does not matter whether it is still running.
+  const auto oldest_txn = txn_manager_->GetOldestTransactionStartTime();
+  if (oldest_txn < checkpoint_ts) {
+    STORAGE_LOG_INFO("Log not truncated to checkpoint {}, transaction {} is still running",
+                     checkpoint_ts.UnderlyingValue(), oldest_txn.UnderlyingValue());
+    return;
+  }
+  log_manager_->RewriteLogFile([&](const std::string &log_file_path, const LogBlockFormat format) {
+    TruncateLog(log_file_path, checkpoint_ts, format);
+  });
+}
+
+transaction::timestamp_t CheckpointManager::GetLatestCheckpoint() const {
+  auto latest = transaction::INVALID_TXN_TIMESTAMP;
+  DIR *dir = opendir(checkpoint_dir_.c_str());
+  if (dir == nullptr) return latest;
+
+  for (auto *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    const auto checkpoint_ts = ParseCheckpointFileName(entry->d_name);
+    if (checkpoint_ts == transaction::INVALID_TXN_TIMESTAMP) continue;
+    if (latest == transaction::INVALID_TXN_TIMESTAMP || checkpoint_ts > latest) latest = checkpoint_ts;
+  }
+  closedir(dir);
+  return latest;
+}
+
+bool CheckpointManager::TruncateLog(const std::string &log_file_path) const {
+  const auto checkpoint_ts = GetLatestCheckpoint();
+  if (checkpoint_ts == transaction::INVALID_TXN_TIMESTAMP) return false;
+  // The LogManager keeps appending to the truncated log in its original layout, so blocks have to stay blocks.
+  const auto format = BufferedLogWriter::IsBlockFormatted(log_file_path.c_str()) ? LogBlockFormat::COMPRESSED
+                                                                                 : LogBlockFormat::RAW;
+  TruncateLog(log_file_path, checkpoint_ts, format);
+  return true;
+}
+
+void CheckpointManager::TruncateLog(const std::string &log_file_path, const transaction::timestamp_t checkpoint_ts,
+                                    const LogBlockFormat format) const {
+  const bool has_log = IsNonEmptyFile(log_file_path);
+
+  // Find out when every transaction in the log committed, which ones finished at all, and which ones modified the
+  // catalog. Aborted transactions are never copied.
+  std::unordered_map<transaction::timestamp_t, transaction::timestamp_t> commit_times;
+  std::unordered_set<transaction::timestamp_t> finished_txns;
+  std::unordered_set<transaction::timestamp_t> catalog_txns;
+  if (has_log) {
+    RawLogReader in(log_file_path);
+    for (auto *record = in.NextRecord(); record != nullptr; record = in.NextRecord()) {
+      switch (record->RecordType()) {
+        case LogRecordType::COMMIT:
+          commit_times[record->TxnBegin()] = record->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime();
+          finished_txns.insert(record->TxnBegin());
+          break;
+        case LogRecordType::CHECKPOINT:
+          // A checkpoint spliced into the log by an earlier truncation commits at its own timestamp, so it counts as
+          // being before the checkpoint and is replaced.
+          commit_times[record->TxnBegin()] = record->TxnBegin();
+          finished_txns.insert(record->TxnBegin());
+          break;
+        case LogRecordType::ABORT:
+          finished_txns.insert(record->TxnBegin());
+          break;
+        case LogRecordType::REDO:
+          if (IsCatalogTable(record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid())) {
+            catalog_txns.insert(record->TxnBegin());
+          }
+          break;
+        case LogRecordType::DELETE:
+          if (IsCatalogTable(record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid())) {
+            catalog_txns.insert(record->TxnBegin());
+          }
+          break;
+      }
+    }
+  }
+  const auto committed_before_checkpoint = [&](const transaction::timestamp_t txn) {
+    const auto it = commit_times.find(txn);
+    return it != commit_times.end() && it->second <= checkpoint_ts;
+  };
+  // A transaction that started after the checkpoint and has not finished yet may still commit, with its commit record
+  // following in the log. One that started before the checkpoint can only be left over from a crash.
+  const auto belongs_after_checkpoint = [&](const transaction::timestamp_t txn) {
+    const auto it = commit_times.find(txn);
+    if (it != commit_times.end()) return it->second > checkpoint_ts;
+    return finished_txns.count(txn) == 0 && txn > checkpoint_ts;
+  };
+
+  TmpFileWriter out(log_file_path, format);
+
+  if (has_log) {
+    // The catalog changes of the transactions that committed before the checkpoint, in log order.
+    CopyRecords(log_file_path, out.Get(), [&](const LogRecord &record) {
+      if (!committed_before_checkpoint(record.TxnBegin()) || catalog_txns.count(record.TxnBegin()) == 0) return false;
+      switch (record.RecordType()) {
+        case LogRecordType::REDO:
+          return IsCatalogTable(record.GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid());
+        case LogRecordType::DELETE:
+          return IsCatalogTable(record.GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid());
+        default:
+          return record.RecordType() == LogRecordType::COMMIT;
+      }
+    });
+  }
+
+  // The checkpoint, whose checkpoint record makes recovery replay everything before it.
+  CopyRecords(GetCheckpointFilePath(checkpoint_ts), out.Get(), [](const LogRecord &) { return true; });
+
+  if (has_log) {
+    // The tail of the log, which is every transaction that committed after the checkpoint or may still commit.
+    CopyRecords(log_file_path, out.Get(),
+                [&](const LogRecord &record) { return belongs_after_checkpoint(record.TxnBegin()); });
+  }
+
+  out.Commit();
+  STORAGE_LOG_INFO("Log {} truncated to checkpoint {}", log_file_path, checkpoint_ts.UnderlyingValue());
+}
+
+}  // namespace noisepage::storage
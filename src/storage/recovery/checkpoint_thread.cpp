@@ -0,0 +1,44 @@
+#include "storage/recovery/checkpoint_thread.h"
+
+#include <exception>
+
+#include "loggers/storage_logger.h"
+#include "storage/recovery/checkpoint_manager.h"
+
+namespace noisepage::storage {
+
+CheckpointThread::CheckpointThread(const common::ManagedPointer<CheckpointManager> checkpoint_manager,
+                                   const std::chrono::milliseconds checkpoint_period,
+                                   const std::chrono::milliseconds checkpoint_max_duration)
+    : checkpoint_manager_(checkpoint_manager),
+      checkpoint_period_(checkpoint_period),
+      checkpoint_max_duration_(checkpoint_max_duration),
+      checkpoint_thread_(std::thread([this] { CheckpointThreadLoop(); })) {}
+
+void CheckpointThread::StopCheckpoints() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!run_checkpoints_) return;
+    run_checkpoints_ = false;
+  }
+  stop_cv_.notify_all();
+  checkpoint_thread_.join();
+}
+
+void CheckpointThread::CheckpointThreadLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Wake up early on shutdown instead of sleeping out what can be a long period.
+    if (stop_cv_.wait_for(lock, checkpoint_period_, [this] { return !run_checkpoints_; })) return;
+    lock.unlock();
+    try {
+      checkpoint_manager_->TakeCheckpoint(checkpoint_max_duration_);
+    } catch (const std::exception &e) {
+      // A failed checkpoint leaves the previous one in place, so the next period simply tries again.
+      STORAGE_LOG_ERROR("Checkpoint failed: {}", e.what());
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace noisepage::storage
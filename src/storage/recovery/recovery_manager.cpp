@@ -1,6 +1,10 @@
 #include "storage/recovery/recovery_manager.h"
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -119,9 +123,16 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
 
         // We defer all transactions initially
         deferred_txns_.insert(log_record->TxnBegin());
-        // Process any deferred transactions that are safe to execute
-        std::tie(num_txns, num_records) = ProcessDeferredTransactions(commit_record->OldestActiveTxn());
-        recovered_txns_ += num_txns;
+        // Process any deferred transactions that are safe to execute. When replaying from disk with multiple threads,
+        // we wait until enough transactions are ready so that the batch can be spread across the replay threads.
+        // Replicas are not batched because the primary may be waiting for each transaction to be applied.
+        const bool batch_for_parallel_replay =
+            replay_threads_ > 1 && log_provider->GetType() == AbstractLogProvider::LogProviderType::DISK &&
+            deferred_txns_.size() < REPLAY_BATCH_TXNS_PER_THREAD * replay_threads_;
+        if (!batch_for_parallel_replay) {
+          std::tie(num_txns, num_records) = ProcessDeferredTransactions(commit_record->OldestActiveTxn());
+          recovered_txns_ += num_txns;
+        }
         // Record the current commit txn
         num_records++;
 
@@ -130,6 +141,21 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         break;
       }
 
+      case (LogRecordType::CHECKPOINT): {
+        NOISEPAGE_ASSERT(pair.second.empty(), "Checkpoint records should not have any varlen pointers");
+        // A checkpoint spliced into the log by the CheckpointManager commits at its own timestamp, after every
+        // transaction that committed before it. It must be replayed before any transaction that follows it in the log,
+        // so it is never batched.
+        deferred_txns_.insert(log_record->TxnBegin());
+        std::tie(num_txns, num_records) = ProcessDeferredTransactions(log_record->TxnBegin());
+        recovered_txns_ += num_txns;
+        // Record the checkpoint like a commit
+        num_records++;
+
+        deferred_action_manager_->RegisterDeferredAction([=] { delete[] reinterpret_cast<byte *>(log_record); });
+        break;
+      }
+
       default:
         NOISEPAGE_ASSERT(
             log_record->RecordType() == LogRecordType::REDO || log_record->RecordType() == LogRecordType::DELETE,
@@ -138,7 +164,8 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
     }
   }
   // Process all deferred txns
-  ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+  std::tie(num_txns, num_records) = ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+  recovered_txns_ += num_txns;
   NOISEPAGE_ASSERT(deferred_txns_.empty(),
                    "We should have no unprocessed deferred transactions at the end of recovery");
 
@@ -153,19 +180,26 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
 }
 
 uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timestamp_t txn_id) {
+  auto records_processed = ReplayCommittedTransaction(&buffered_changes_map_[txn_id]);
+  FinishCommittedTransaction(txn_id);
+  return records_processed;
+}
+
+uint32_t RecoveryManager::ReplayCommittedTransaction(
+    std::vector<std::pair<LogRecord *, std::vector<byte *>>> *buffered_changes) {
   auto records_processed = 0;
   // Begin a txn to replay changes with.
   auto *txn = txn_manager_->BeginTransaction();
 
   // Apply all buffered changes. They should all succeed. After applying we can safely delete the record
-  for (uint32_t idx = 0; idx < buffered_changes_map_[txn_id].size(); idx++) {
-    auto *buffered_record = buffered_changes_map_[txn_id][idx].first;
+  for (uint32_t idx = 0; idx < buffered_changes->size(); idx++) {
+    auto *buffered_record = (*buffered_changes)[idx].first;
     NOISEPAGE_ASSERT(
         buffered_record->RecordType() == LogRecordType::REDO || buffered_record->RecordType() == LogRecordType::DELETE,
         "Buffered record must be a redo or delete.");
 
     if (IsSpecialCaseCatalogRecord(buffered_record)) {
-      idx += ProcessSpecialCaseCatalogRecord(txn, &buffered_changes_map_[txn_id], idx);
+      idx += ProcessSpecialCaseCatalogRecord(txn, buffered_changes, idx);
     } else if (buffered_record->RecordType() == LogRecordType::REDO) {
       ReplayRedoRecord(txn, buffered_record);
     } else {
@@ -174,13 +208,16 @@ uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::ti
     records_processed++;
   }
 
+  // Commit the txn
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  return records_processed;
+}
+
+void RecoveryManager::FinishCommittedTransaction(noisepage::transaction::timestamp_t txn_id) {
   // Defer deletes of the log records
   DeferRecordDeletes(txn_id, false);
   buffered_changes_map_.erase(txn_id);
 
-  // Commit the txn
-  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
-
   last_applied_txn_id_ = std::max(last_applied_txn_id_, txn_id);
   if (replication_manager_ != DISABLED) {
     // Replicas have to send back their list of deferred transactions that were processed, periodically.
@@ -191,7 +228,132 @@ uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::ti
       replication_manager_->GetAsReplica()->NotifyPrimaryTransactionApplied(txn_id);
     }
   }
+}
+
+uint32_t RecoveryManager::ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txns) {
+  uint32_t records_processed = 0;
+
+  // Each lane is a list of transactions in replay order. Lanes modify disjoint sets of tables, which are tracked by
+  // table_lanes (table key -> lane index) and lane_tables (lane index -> table keys). A table key packs the database
+  // oid in the upper 32 bits and the table oid in the lower 32 bits.
+  std::vector<std::vector<transaction::timestamp_t>> lanes;
+  std::vector<std::vector<uint64_t>> lane_tables;
+  std::unordered_map<uint64_t, uint32_t> table_lanes;
+  auto reset_lanes = [&] {
+    lanes.clear();
+    lane_tables.clear();
+    table_lanes.clear();
+  };
+
+  for (const auto txn_id : txns) {
+    // Find the tables this transaction modifies
+    bool modifies_catalog = false;
+    std::unordered_set<uint64_t> txn_tables;
+    for (const auto &buffered_pair : buffered_changes_map_[txn_id]) {
+      const auto *record = buffered_pair.first;
+      catalog::db_oid_t db_oid;
+      catalog::table_oid_t table_oid;
+      if (record->RecordType() == LogRecordType::REDO) {
+        db_oid = record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid();
+        table_oid = record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid();
+      } else {
+        db_oid = record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid();
+        table_oid = record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+      }
+      if (IsCatalogTable(table_oid)) {
+        modifies_catalog = true;
+        break;
+      }
+      txn_tables.emplace(static_cast<uint64_t>(db_oid.UnderlyingValue()) << 32 | table_oid.UnderlyingValue());
+    }
+
+    // Catalog changes are barriers. Drain every lane, then replay the transaction on its own.
+    if (modifies_catalog) {
+      records_processed += ReplayLanes(&lanes);
+      reset_lanes();
+      records_processed += ProcessCommittedTransaction(txn_id);
+      continue;
+    }
+
+    // Find the lanes that already modify any of these tables. The transaction goes to the lowest such lane, and any
+    // other lane it conflicts with is merged into that lane so that the merged lane is still replayed in order.
+    std::vector<uint32_t> conflicting_lanes;
+    for (const auto table : txn_tables) {
+      auto it = table_lanes.find(table);
+      if (it != table_lanes.end() &&
+          std::find(conflicting_lanes.begin(), conflicting_lanes.end(), it->second) == conflicting_lanes.end()) {
+        conflicting_lanes.emplace_back(it->second);
+      }
+    }
+
+    uint32_t target_lane;
+    if (conflicting_lanes.empty()) {
+      target_lane = static_cast<uint32_t>(lanes.size());
+      lanes.emplace_back();
+      lane_tables.emplace_back();
+    } else {
+      std::sort(conflicting_lanes.begin(), conflicting_lanes.end());
+      target_lane = conflicting_lanes[0];
+      for (uint32_t i = 1; i < conflicting_lanes.size(); i++) {
+        const auto merged_lane = conflicting_lanes[i];
+        std::vector<transaction::timestamp_t> merged;
+        merged.reserve(lanes[target_lane].size() + lanes[merged_lane].size());
+        std::merge(lanes[target_lane].begin(), lanes[target_lane].end(), lanes[merged_lane].begin(),
+                   lanes[merged_lane].end(), std::back_inserter(merged));
+        lanes[target_lane] = std::move(merged);
+        lanes[merged_lane].clear();
+        for (const auto table : lane_tables[merged_lane]) {
+          table_lanes[table] = target_lane;
+          lane_tables[target_lane].emplace_back(table);
+        }
+        lane_tables[merged_lane].clear();
+      }
+    }
+
+    lanes[target_lane].emplace_back(txn_id);
+    for (const auto table : txn_tables) {
+      if (table_lanes.emplace(table, target_lane).second) lane_tables[target_lane].emplace_back(table);
+    }
+  }
 
+  records_processed += ReplayLanes(&lanes);
+  return records_processed;
+}
+
+uint32_t RecoveryManager::ReplayLanes(std::vector<std::vector<transaction::timestamp_t>> *lanes) {
+  // Merging lanes can leave some of them empty
+  lanes->erase(std::remove_if(lanes->begin(), lanes->end(), [](const auto &lane) { return lane.empty(); }),
+               lanes->end());
+  if (lanes->empty()) return 0;
+
+  // Look up the buffered changes up front, the map must not be modified while the replay threads are running
+  std::vector<std::vector<std::vector<std::pair<LogRecord *, std::vector<byte *>>> *>> lane_changes(lanes->size());
+  for (uint32_t i = 0; i < lanes->size(); i++) {
+    for (const auto txn_id : (*lanes)[i]) lane_changes[i].emplace_back(&buffered_changes_map_[txn_id]);
+  }
+
+  std::vector<uint32_t> lane_records(lanes->size(), 0);
+  if (lanes->size() == 1) {
+    for (auto *buffered_changes : lane_changes[0]) lane_records[0] += ReplayCommittedTransaction(buffered_changes);
+  } else {
+    tbb::task_arena limited_arena(static_cast<int>(replay_threads_));
+    limited_arena.execute([&] {
+      tbb::parallel_for(static_cast<size_t>(0), lanes->size(), [&](const size_t lane_idx) {
+        for (auto *buffered_changes : lane_changes[lane_idx]) {
+          lane_records[lane_idx] += ReplayCommittedTransaction(buffered_changes);
+        }
+      });
+    });
+  }
+
+  // Clean up and acknowledge the replayed transactions in order
+  std::vector<transaction::timestamp_t> replayed;
+  for (const auto &lane : *lanes) replayed.insert(replayed.end(), lane.begin(), lane.end());
+  std::sort(replayed.begin(), replayed.end());
+  for (const auto txn_id : replayed) FinishCommittedTransaction(txn_id);
+
+  uint32_t records_processed = 0;
+  for (const auto records : lane_records) records_processed += records;
   return records_processed;
 }
 
@@ -219,9 +381,15 @@ std::pair<uint32_t, uint32_t> RecoveryManager::ProcessDeferredTransactions(
       (upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP) ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
   auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
 
-  for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-    records_processed += ProcessCommittedTransaction(*it);
-    txns_processed++;
+  if (replay_threads_ > 1) {
+    std::vector<transaction::timestamp_t> txns(deferred_txns_.begin(), upper_bound_it);
+    records_processed += ProcessCommittedTransactionsInParallel(txns);
+    txns_processed += txns.size();
+  } else {
+    for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
+      records_processed += ProcessCommittedTransaction(*it);
+      txns_processed++;
+    }
   }
 
   // If we actually processed some txns, remove them from the set
@@ -250,9 +418,10 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
     NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                      "Insert should update redo record with new tuple slot");
     // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
+    common::SharedLatch::ScopedExclusiveLatch guard(&tuple_slot_map_latch_);
     tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
   } else {
-    auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+    auto new_tuple_slot = GetTupleSlotMapping(redo_record->GetTupleSlot());
     redo_record->SetTupleSlot(new_tuple_slot);
     // Stage the write. This way the recovery operation is logged if logging is enabled
     auto staged_record = txn->StageRecoveryWrite(record);
@@ -266,7 +435,7 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
   // Get tuple slot
   auto new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, delete_record->GetDatabaseOid());
+  auto db_catalog_ptr = GetDatabaseCatalogForTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid());
   auto sql_table_ptr = db_catalog_ptr->GetTable(common::ManagedPointer(txn), delete_record->GetTableOid());
   const auto &schema = GetTableSchema(txn, db_catalog_ptr, delete_record->GetTableOid());
 
@@ -291,7 +460,10 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   UpdateIndexesOnTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), sql_table_ptr,
                        new_tuple_slot, pr, false /* delete */);
   // We can delete the TupleSlot from the map
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  {
+    common::SharedLatch::ScopedExclusiveLatch guard(&tuple_slot_map_latch_);
+    tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  }
   delete[] buffer;
 }
 
@@ -299,7 +471,7 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
                                            catalog::table_oid_t table_oid,
                                            common::ManagedPointer<storage::SqlTable> table_ptr,
                                            const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalogForTable(txn, db_oid, table_oid);
 
   // Stores index objects and schemas
   std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> index_objects;
@@ -920,7 +1092,7 @@ common::ManagedPointer<storage::SqlTable> RecoveryManager::GetSqlTable(transacti
     return common::ManagedPointer(catalog_->databases_);
   }
 
-  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  auto db_catalog_ptr = GetDatabaseCatalogForTable(txn, db_oid, table_oid);
 
   common::ManagedPointer<storage::SqlTable> table_ptr = nullptr;
 
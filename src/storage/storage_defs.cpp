@@ -1,5 +1,12 @@
 #include "storage/storage_defs.h"
 
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <new>
+
 #include "common/strong_typedef_body.h"
 
 namespace noisepage::storage {
@@ -7,4 +14,94 @@ namespace noisepage::storage {
 STRONG_TYPEDEF_BODY(col_id_t, uint16_t);
 STRONG_TYPEDEF_BODY(layout_version_t, uint16_t);
 
+namespace {
+
+constexpr uint64_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr uint64_t ARENA_SIZE = BlockAllocator::BLOCKS_PER_ARENA * common::Constants::BLOCK_SIZE;
+static_assert(ARENA_SIZE % HUGE_PAGE_SIZE == 0, "arenas should consist of whole huge pages");
+// Largest number of NUMA nodes the node masks cover
+constexpr uint64_t MAX_NUMA_NODES = 1024;
+
+}  // namespace
+
+BlockAllocator::BlockAllocator(const BlockAllocationMode mode, const BlockNumaPolicy numa_policy,
+                               const uint32_t numa_node)
+    : mode_(mode), numa_policy_(numa_policy), numa_nodes_(MAX_NUMA_NODES / 64, 0) {
+  if (numa_policy_ == BlockNumaPolicy::PINNED) {
+    NOISEPAGE_ASSERT(numa_node < MAX_NUMA_NODES, "NUMA node out of range");
+    numa_nodes_[numa_node / 64] |= uint64_t{1} << (numa_node % 64);
+  } else if (numa_policy_ == BlockNumaPolicy::INTERLEAVE) {
+    // Interleave over the nodes the process is allowed to use
+    if (syscall(SYS_get_mempolicy, nullptr, numa_nodes_.data(), MAX_NUMA_NODES, nullptr, MPOL_F_MEMS_ALLOWED) != 0)
+      numa_policy_ = BlockNumaPolicy::FIRST_TOUCH;
+  }
+}
+
+BlockAllocator::~BlockAllocator() {
+  for (void *const arena : arenas_) munmap(arena, ARENA_SIZE);
+}
+
+void BlockAllocator::Place(void *const memory, const uint64_t size) const {
+  if (numa_policy_ == BlockNumaPolicy::FIRST_TOUCH) return;
+  const int mode = numa_policy_ == BlockNumaPolicy::INTERLEAVE ? MPOL_INTERLEAVE : MPOL_PREFERRED;
+  // Best effort, the memory is still usable if the system does not support the policy
+  syscall(SYS_mbind, memory, size, mode, numa_nodes_.data(), MAX_NUMA_NODES, 0);
+}
+
+bool BlockAllocator::MapArena() {
+  // Explicit huge pages first, which only exist if the system reserved some
+  void *arena = mmap(nullptr, ARENA_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (arena == MAP_FAILED) {
+    // Transparent huge pages otherwise, which need the arena to be aligned to a huge page
+    auto *const mapped = reinterpret_cast<byte *>(
+        mmap(nullptr, ARENA_SIZE + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (mapped == MAP_FAILED) return false;
+    const uint64_t misalignment = reinterpret_cast<uintptr_t>(mapped) % HUGE_PAGE_SIZE;
+    const uint64_t head = misalignment == 0 ? 0 : HUGE_PAGE_SIZE - misalignment;
+    if (head > 0) munmap(mapped, head);
+    munmap(mapped + head + ARENA_SIZE, HUGE_PAGE_SIZE - head);
+    arena = mapped + head;
+    madvise(arena, ARENA_SIZE, MADV_HUGEPAGE);
+  }
+  Place(arena, ARENA_SIZE);
+  arenas_.push_back(arena);
+  // Hand out the blocks in address order
+  for (uint32_t i = BLOCKS_PER_ARENA; i > 0; i--)
+    free_blocks_.push_back(reinterpret_cast<RawBlock *>(reinterpret_cast<byte *>(arena) +
+                                                        (i - 1) * common::Constants::BLOCK_SIZE));
+  return true;
+}
+
+RawBlock *BlockAllocator::New() {
+  if (mode_ == BlockAllocationMode::HEAP) {
+    if (numa_policy_ == BlockNumaPolicy::FIRST_TOUCH) return new RawBlock();
+    // The block has to be placed before it is constructed, which touches all of it
+    void *const memory = ::operator new(sizeof(RawBlock), std::align_val_t(alignof(RawBlock)), std::nothrow);
+    if (memory == nullptr) return nullptr;
+    Place(memory, sizeof(RawBlock));
+    return new (memory) RawBlock();
+  }
+
+  if (free_blocks_.empty() && !MapArena()) return nullptr;
+  RawBlock *const result = free_blocks_.back();
+  free_blocks_.pop_back();
+  return new (result) RawBlock();
+}
+
+void BlockAllocator::Delete(RawBlock *const ptr) {
+  if (mode_ == BlockAllocationMode::HEAP) {
+    if (numa_policy_ == BlockNumaPolicy::FIRST_TOUCH) {
+      delete ptr;
+    } else {
+      ptr->~RawBlock();
+      ::operator delete(ptr, std::align_val_t(alignof(RawBlock)));
+    }
+    return;
+  }
+
+  // The memory stays mapped, to be reused by the next block
+  ptr->~RawBlock();
+  free_blocks_.push_back(ptr);
+}
+
 }  // namespace noisepage::storage
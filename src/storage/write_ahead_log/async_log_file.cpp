@@ -0,0 +1,261 @@
+#include "storage/write_ahead_log/async_log_file.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "common/posix_io_wrappers.h"
+#include "loggers/storage_logger.h"
+
+namespace noisepage::storage {
+
+/** A write that is in flight. Short writes are reissued for the remaining bytes. */
+struct AsyncLogFile::PendingWrite {
+  const char *data_;
+  uint32_t remaining_;
+  uint64_t offset_;
+  void *tag_;
+};
+
+namespace {
+
+// user_data of the persist, writes use the address of their PendingWrite
+constexpr uint64_t PERSIST_USER_DATA = 0;
+
+int IoUringSetup(const uint32_t entries, io_uring_params *const params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(const int ring_fd, const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+void *MapRing(const int ring_fd, const size_t size, const off_t offset) {
+  void *const result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+  return result == MAP_FAILED ? nullptr : result;
+}
+
+template <class T>
+T *RingField(void *const ring, const uint32_t offset) {
+  return reinterpret_cast<T *>(reinterpret_cast<char *>(ring) + offset);
+}
+
+}  // namespace
+
+std::unique_ptr<AsyncLogFile> AsyncLogFile::Open(const std::string &log_file_path, const uint32_t queue_depth) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(io_uring_params));
+  const int ring_fd = IoUringSetup(queue_depth, &params);
+  if (ring_fd < 0) {
+    STORAGE_LOG_WARN("io_uring is not available (errno {}), falling back to blocking log writes.", errno);
+    return nullptr;
+  }
+  // IORING_OP_WRITE came with the same kernel release as this feature flag
+  if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+    STORAGE_LOG_WARN("io_uring does not support writes on this kernel, falling back to blocking log writes.");
+    PosixIoWrappers::Close(ring_fd);
+    return nullptr;
+  }
+
+  const int file_fd = PosixIoWrappers::Open(log_file_path.c_str(), O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
+  struct stat file_stat;
+  if (fstat(file_fd, &file_stat) != 0) {
+    PosixIoWrappers::Close(file_fd);
+    PosixIoWrappers::Close(ring_fd);
+    throw std::runtime_error("fstat failed with errno " + std::to_string(errno));
+  }
+
+  // The kernel may round the number of entries up
+  std::unique_ptr<AsyncLogFile> result(
+      new AsyncLogFile(ring_fd, file_fd, static_cast<uint64_t>(file_stat.st_size), params.sq_entries));
+  const uint32_t sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  const uint32_t cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (!result->MapRings(sq_ring_size, cq_ring_size, params.sq_entries, single_mmap)) {
+    STORAGE_LOG_WARN("Failed to map io_uring rings (errno {}), falling back to blocking log writes.", errno);
+    return nullptr;
+  }
+
+  result->sq_head_ = RingField<uint32_t>(result->sq_ring_, params.sq_off.head);
+  result->sq_tail_ = RingField<uint32_t>(result->sq_ring_, params.sq_off.tail);
+  result->sq_mask_ = RingField<uint32_t>(result->sq_ring_, params.sq_off.ring_mask);
+  result->sq_array_ = RingField<uint32_t>(result->sq_ring_, params.sq_off.array);
+  result->cq_head_ = RingField<uint32_t>(result->cq_ring_, params.cq_off.head);
+  result->cq_tail_ = RingField<uint32_t>(result->cq_ring_, params.cq_off.tail);
+  result->cq_mask_ = RingField<uint32_t>(result->cq_ring_, params.cq_off.ring_mask);
+  result->cqes_ = RingField<io_uring_cqe>(result->cq_ring_, params.cq_off.cqes);
+  return result;
+}
+
+AsyncLogFile::AsyncLogFile(const int ring_fd, const int file_fd, const uint64_t file_size, const uint32_t queue_depth)
+    : ring_fd_(ring_fd), file_fd_(file_fd), queue_depth_(queue_depth), next_offset_(file_size) {}
+
+bool AsyncLogFile::MapRings(const uint32_t sq_ring_size, const uint32_t cq_ring_size, const uint32_t num_sqes,
+                            const bool single_mmap) {
+  // With a single mmap, the completion queue lives in the same mapping as the submission queue
+  sq_ring_size_ = single_mmap ? std::max(sq_ring_size, cq_ring_size) : sq_ring_size;
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == nullptr) return false;
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_size_ = cq_ring_size;
+    cq_ring_ = MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == nullptr) return false;
+  }
+  sqes_size_ = num_sqes * sizeof(io_uring_sqe);
+  sqes_ = reinterpret_cast<io_uring_sqe *>(MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES));
+  return sqes_ != nullptr;
+}
+
+AsyncLogFile::~AsyncLogFile() {
+  if (sqes_ != nullptr) {
+    // The kernel may still write into the buffers of I/O in flight
+    while (num_in_flight_ > 0) {
+      Submit(0, 1);
+      DrainCompletionQueue();
+    }
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+  PosixIoWrappers::Close(file_fd_);
+  PosixIoWrappers::Close(ring_fd_);
+}
+
+io_uring_sqe *AsyncLogFile::NextSqe() {
+  // Every submission is handed to the kernel right away, so the submission queue never holds more than one entry, and
+  // bounding the I/O in flight by the queue depth keeps the completion queue from overflowing.
+  while (num_in_flight_ >= queue_depth_) {
+    Submit(0, 1);
+    DrainCompletionQueue();
+  }
+  const uint32_t tail = *sq_tail_;
+  const uint32_t index = tail & *sq_mask_;
+  io_uring_sqe *const sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(io_uring_sqe));
+  sq_array_[index] = index;
+  return sqe;
+}
+
+void AsyncLogFile::Submit(const uint32_t to_submit, const uint32_t wait_for) {
+  if (to_submit > 0) {
+    // Publish the entry before the kernel can observe the new tail
+    __atomic_store_n(sq_tail_, *sq_tail_ + to_submit, __ATOMIC_RELEASE);
+    num_in_flight_ += to_submit;
+  }
+  const uint32_t flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+  while (IoUringEnter(ring_fd_, to_submit, wait_for, flags) < 0) {
+    if (errno == EINTR || errno == EAGAIN) continue;
+    throw std::runtime_error("io_uring_enter failed with errno " + std::to_string(errno));
+  }
+}
+
+void AsyncLogFile::SubmitWrite(PendingWrite *const write) {
+  io_uring_sqe *const sqe = NextSqe();
+  sqe->opcode = IORING_OP_WRITE;
+  sqe->fd = file_fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(write->data_);
+  sqe->len = write->remaining_;
+  sqe->off = write->offset_;
+  sqe->user_data = reinterpret_cast<uint64_t>(write);
+  Submit(1, 0);
+}
+
+void AsyncLogFile::Write(const void *const data, const uint32_t size, void *const tag) {
+  if (size == 0) {
+    completed_writes_.push_back(tag);
+    return;
+  }
+  auto *const write = new PendingWrite{reinterpret_cast<const char *>(data), size, next_offset_, tag};
+  next_offset_ += size;
+  SubmitWrite(write);
+}
+
+void AsyncLogFile::StartPersist() {
+  NOISEPAGE_ASSERT(!PersistInFlight(), "Only one persist can be in flight at a time.");
+  // A persist does not wait for writes in flight, so they have to complete before it is issued
+  while (num_in_flight_ > 0) {
+    Submit(0, 1);
+    DrainCompletionQueue();
+  }
+  io_uring_sqe *const sqe = NextSqe();
+  sqe->opcode = IORING_OP_FSYNC;
+  sqe->fd = file_fd_;
+  sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+  sqe->user_data = PERSIST_USER_DATA;
+  persist_in_flight_ = true;
+  Submit(1, 0);
+}
+
+void AsyncLogFile::HandleCompletion(const io_uring_cqe &cqe) {
+  num_in_flight_--;
+  if (cqe.user_data == PERSIST_USER_DATA) {
+    if (cqe.res < 0) throw std::runtime_error("fdatasync failed with errno " + std::to_string(-cqe.res));
+    persist_in_flight_ = false;
+    persist_completed_ = true;
+    return;
+  }
+
+  auto *const write = reinterpret_cast<PendingWrite *>(cqe.user_data);
+  if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+    SubmitWrite(write);
+    return;
+  }
+  if (cqe.res <= 0) throw std::runtime_error("Write failed with errno " + std::to_string(-cqe.res));
+  const auto written = static_cast<uint32_t>(cqe.res);
+  if (written < write->remaining_) {
+    // Short write, issue the rest
+    write->data_ += written;
+    write->offset_ += written;
+    write->remaining_ -= written;
+    SubmitWrite(write);
+    return;
+  }
+  completed_writes_.push_back(write->tag_);
+  delete write;
+}
+
+void AsyncLogFile::DrainCompletionQueue() {
+  uint32_t head = *cq_head_;
+  while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+    const io_uring_cqe cqe = cqes_[head & *cq_mask_];
+    // Free the slot before handling the completion, which may issue more I/O
+    __atomic_store_n(cq_head_, ++head, __ATOMIC_RELEASE);
+    HandleCompletion(cqe);
+    head = *cq_head_;
+  }
+}
+
+void AsyncLogFile::WaitForCompletion() {
+  const uint32_t num_in_flight = num_in_flight_;
+  while (num_in_flight_ > 0 && num_in_flight_ == num_in_flight) {
+    Submit(0, 1);
+    DrainCompletionQueue();
+  }
+}
+
+bool AsyncLogFile::ReapCompletions(std::vector<void *> *const completed_writes, const bool wait_for_persist) {
+  DrainCompletionQueue();
+  while (wait_for_persist && persist_in_flight_) {
+    Submit(0, 1);
+    DrainCompletionQueue();
+  }
+
+  completed_writes->insert(completed_writes->end(), completed_writes_.begin(), completed_writes_.end());
+  completed_writes_.clear();
+  const bool persist_completed = persist_completed_;
+  persist_completed_ = false;
+  return persist_completed;
+}
+
+}  // namespace noisepage::storage
@@ -5,6 +5,7 @@
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
+#include "transaction/transaction_util.h"
 
 namespace noisepage::storage {
 
@@ -22,7 +23,8 @@ void DiskLogConsumerTask::Terminate() {
   disk_log_writer_thread_cv_.notify_one();
 }
 
-void DiskLogConsumerTask::WriteBuffersToLogFile() {
+uint64_t DiskLogConsumerTask::WriteBuffersToLogFile() {
+  uint64_t num_new_commits = 0;
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
   while (!filled_buffer_queue_->Empty()) {
@@ -30,33 +32,135 @@ void DiskLogConsumerTask::WriteBuffersToLogFile() {
     filled_buffer_queue_->Dequeue(&logs);
     if (logs.first != nullptr) {
       // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be invoked
-      current_data_written_ += logs.first->FlushBuffer();
+      if (async_log_file_ != nullptr) {
+        // The buffer is released once its write completes, see ReapAsyncLogFile
+        current_data_written_ += logs.first->FlushBuffer(async_log_file_);
+      } else {
+        current_data_written_ += logs.first->FlushBuffer();
+        ReleaseBuffer(logs.first);
+      }
     }
-    commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
-    // Enqueue the flushed buffer to the empty buffer queue if all serializers are done with it.
-    if (logs.first != nullptr && logs.first->MarkSerialized()) {
-      // nullptr check for the same reason as above
-      empty_buffer_queue_->Enqueue(logs.first);
+    for (const auto &callback : logs.second) {
+      // ASYNC commits have already been acknowledged and swapped in the empty callback, nobody is waiting on them
+      if (callback.fn_ == transaction::TransactionUtil::EmptyCallback) continue;
+      if (num_waiting_commits_ == 0) oldest_waiting_commit_ = callback.commit_time_;
+      num_waiting_commits_++;
+      num_new_commits++;
     }
+    commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
   }
+  return num_new_commits;
+}
+
+void DiskLogConsumerTask::ReleaseBuffer(BufferedLogWriter *const buffer) {
+  // Enqueue the flushed buffer to the empty buffer queue if all serializers are done with it.
+  if (buffer->MarkSerialized()) empty_buffer_queue_->Enqueue(buffer);
+}
+
+void DiskLogConsumerTask::SampleCommitArrivals(const uint64_t num_commits,
+                                               const std::chrono::high_resolution_clock::time_point now) {
+  const auto elapsed_us = std::chrono::duration<double, std::micro>(now - last_arrival_sample_).count();
+  last_arrival_sample_ = now;
+  if (elapsed_us <= 0) return;
+  commit_arrival_rate_ = GROUP_COMMIT_SMOOTHING * (static_cast<double>(num_commits) / elapsed_us) +
+                         (1 - GROUP_COMMIT_SMOOTHING) * commit_arrival_rate_;
+}
+
+std::chrono::microseconds DiskLogConsumerTask::RemainingGroupWait(
+    const std::chrono::high_resolution_clock::time_point now) const {
+  if (num_waiting_commits_ >= TargetGroupSize()) return std::chrono::microseconds(0);
+  const auto waited = std::chrono::duration_cast<std::chrono::microseconds>(now - oldest_waiting_commit_);
+  return std::max(MaxGroupWait() - waited, std::chrono::microseconds(0));
+}
+
+void DiskLogConsumerTask::RecordPersistLatency(const double persist_us) {
+  persist_latency_us_ = GROUP_COMMIT_SMOOTHING * persist_us + (1 - GROUP_COMMIT_SMOOTHING) * persist_latency_us_;
+  last_persist_us_ = static_cast<uint64_t>(persist_us);
+}
+
+uint64_t DiskLogConsumerTask::InvokeCommitCallbacks(std::vector<storage::CommitCallback> *const callbacks) {
+  const auto num_buffers = callbacks->size();
+  // Execute the callbacks for the transactions that have been persisted
+  const auto now = std::chrono::high_resolution_clock::now();
+  for (auto &callback : *callbacks) {
+    callback.fn_(callback.arg_);
+    if (callback.fn_ == transaction::TransactionUtil::EmptyCallback) continue;
+    const auto latency_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - callback.commit_time_).count());
+    // Index of the highest set bit plus one, i.e. the bucket whose upper bound is the next power of two above latency
+    const uint32_t bucket = latency_us == 0 ? 0 : 64 - __builtin_clzll(latency_us);
+    commit_latency_histogram_[std::min(bucket, NUM_COMMIT_LATENCY_BUCKETS - 1)]++;
+  }
+  callbacks->clear();
+  return num_buffers;
 }
 
 uint64_t DiskLogConsumerTask::PersistLogFile() {
+  last_persist_us_ = 0;
   if (current_data_written_ > 0) {
     // Force the buffers to be written to disk. Because all buffers log to the same file, it suffices to call persist on
     // any buffer.
+    const auto persist_start = std::chrono::high_resolution_clock::now();
     buffers_->front().Persist();
+    RecordPersistLatency(
+        std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - persist_start).count());
   }
-  const auto num_buffers = commit_callbacks_.size();
-  // Execute the callbacks for the transactions that have been persisted
-  for (auto &callback : commit_callbacks_) callback.fn_(callback.arg_);
-  commit_callbacks_.clear();
+  num_waiting_commits_ = 0;
+  return InvokeCommitCallbacks(&commit_callbacks_);
+}
+
+uint64_t DiskLogConsumerTask::StartPersistLogFile(const bool wait_for_persist) {
+  last_persist_us_ = 0;
+  // Only one persist is in flight at a time, and the commits it covers are acknowledged before any later ones
+  uint64_t num_buffers = ReapAsyncLogFile(async_log_file_->PersistInFlight());
+  if (current_data_written_ > 0) {
+    persisting_callbacks_.swap(commit_callbacks_);
+    persist_start_ = std::chrono::high_resolution_clock::now();
+    async_log_file_->StartPersist();
+  } else {
+    // Everything written before is durable already
+    num_buffers += InvokeCommitCallbacks(&commit_callbacks_);
+  }
+  num_waiting_commits_ = 0;
+  if (wait_for_persist) num_buffers += ReapAsyncLogFile(true);
+  return num_buffers;
+}
+
+uint64_t DiskLogConsumerTask::ReapAsyncLogFile(const bool wait_for_persist) {
+  const bool persisted = async_log_file_->ReapCompletions(&completed_writes_, wait_for_persist);
+  for (void *const tag : completed_writes_) ReleaseBuffer(static_cast<BufferedLogWriter *>(tag));
+  completed_writes_.clear();
+  if (!persisted) return 0;
+  // The persist may have completed a while before it is reaped, which overestimates its latency a little
+  RecordPersistLatency(
+      std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - persist_start_).count());
+  return InvokeCommitCallbacks(&persisting_callbacks_);
+}
+
+uint64_t DiskLogConsumerTask::RewriteLogFile() {
+  // Buffers handed over since the persist were serialized before the rewrite was requested, so they belong in the log
+  // file that is rewritten
+  WriteBuffersToLogFile();
+  const uint64_t num_buffers = async_log_file_ == nullptr ? PersistLogFile() : StartPersistLogFile(true);
+  try {
+    rewrite_log_file_();
+  } catch (...) {
+    rewrite_log_file_error_ = std::current_exception();
+  }
+  rewrite_log_file_ = nullptr;
   return num_buffers;
 }
 
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // input for this operating unit
   uint64_t num_bytes = 0, num_buffers = 0;
+  // Commits acknowledged since the last group commit sample, which is only taken when a persist was measured
+  uint64_t num_group_commits = 0;
+  // Whether the persist was measured separately from writing the buffers, and the resources each of them used
+  bool persist_tracked = false;
+  common::ResourceTracker::Metrics consumer_metrics, persist_metrics;
+  double target_group_size = 0;
+  std::chrono::microseconds max_group_wait(0);
 
   // Keeps track of how much data we've written to the log file since the last persist
   current_data_written_ = 0;
@@ -66,6 +170,7 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   const std::chrono::microseconds max_sleep = std::chrono::microseconds(10000);
   // Time since last log file persist
   auto last_persist = std::chrono::high_resolution_clock::now();
+  last_arrival_sample_ = last_persist;
 
   // Initialize whether to collect metrics outside of the spin loop so as not to count each loop iteration as a sample
   // (by calling ComponentToRecord this increments the sample count)
@@ -82,7 +187,12 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     }
 
     curr_sleep = next_sleep;
-    {
+    if (async_log_file_ != nullptr && async_log_file_->IoInFlight() && filled_buffer_queue_->Empty()) {
+      // The serializer may be waiting on the buffers of writes in flight to fill them again, and the commits covered by
+      // a persist in flight are acknowledged as soon as it completes. Buffers handed over in the meantime are written
+      // after the persist completes, in time for the next one.
+      async_log_file_->WaitForCompletion();
+    } else {
       // Wait until we are told to flush buffers
       std::unique_lock<std::mutex> lock(persist_lock_);
       // Wake up the task thread if:
@@ -90,46 +200,97 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       // 2) There is a filled buffer to write to the disk
       // 3) LogManager has shut down the task
       // 4) Our persist interval timed out
-
+      // 5) The oldest commit waiting to be persisted has waited for as long as its group allows
+      const auto wait = num_waiting_commits_ > 0
+                            ? std::min(curr_sleep, RemainingGroupWait(std::chrono::high_resolution_clock::now()))
+                            : curr_sleep;
       bool signaled = disk_log_writer_thread_cv_.wait_for(
-          lock, curr_sleep, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
+          lock, wait, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
       next_sleep = signaled ? persist_interval_ : curr_sleep * 2;
       next_sleep = std::min(next_sleep, max_sleep);
     }
 
     // Flush all the buffers to the log file
-    WriteBuffersToLogFile();
+    const uint64_t num_new_commits = WriteBuffersToLogFile();
+    const auto now = std::chrono::high_resolution_clock::now();
+    SampleCommitArrivals(num_new_commits, now);
 
     // We persist the log file if the following conditions are met
-    // 1) The persist interval amount of time has passed since the last persist
-    // 2) We have written more data since the last persist than the threshold
-    // 3) We are signaled to persist
-    // 4) We are shutting down this task
-    bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
-                                                                         last_persist) > curr_sleep;
-
-    if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_) {
+    // 1) The current commit group is full, or its oldest commit has waited long enough
+    // 2) No commit is waiting, and the persist interval amount of time has passed since the last persist
+    // 3) We have written more data since the last persist than the threshold
+    // 4) We are signaled to persist
+    // 5) We are shutting down this task
+    const bool group_ready = num_waiting_commits_ > 0 && RemainingGroupWait(now).count() == 0;
+    bool timeout = num_waiting_commits_ == 0 &&
+                   std::chrono::duration_cast<std::chrono::microseconds>(now - last_persist) > curr_sleep;
+
+    // The next group keeps growing while the persist of the previous one is in flight, unless someone waits on it
+    const bool persist_in_flight =
+        async_log_file_ != nullptr && async_log_file_->PersistInFlight() && !force_flush_ && run_task_;
+
+    if (!persist_in_flight &&
+        (group_ready || timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_)) {
       std::unique_lock<std::mutex> lock(persist_lock_);
-      num_buffers = PersistLogFile();
+      target_group_size = TargetGroupSize();
+      max_group_wait = MaxGroupWait();
+      // The persist is its own operating unit, so that its resources are not counted for writing the buffers as well
+      persist_tracked = common::thread_context.resource_tracker_.IsRunning() &&
+                        (current_data_written_ > 0 || !commit_callbacks_.empty());
+      if (persist_tracked) {
+        common::thread_context.resource_tracker_.Stop();
+        consumer_metrics = common::thread_context.resource_tracker_.GetMetrics();
+        common::thread_context.resource_tracker_.Start();
+      }
+      if (async_log_file_ == nullptr) {
+        num_buffers = PersistLogFile();
+      } else {
+        // Whoever forces a persist, and the shutdown, wait for it to complete
+        num_buffers = StartPersistLogFile(force_flush_ || !run_task_);
+      }
+      if (persist_tracked) {
+        common::thread_context.resource_tracker_.Stop();
+        persist_metrics = common::thread_context.resource_tracker_.GetMetrics();
+      }
+      // The log file can only be rewritten while nothing is written to it, which is right after a persist
+      if (rewrite_log_file_ != nullptr) num_buffers += RewriteLogFile();
       num_bytes = current_data_written_;
       // Reset meta data
       last_persist = std::chrono::high_resolution_clock::now();
       current_data_written_ = 0;
       force_flush_ = false;
 
-      // Signal anyone who forced a persist that the persist has finished
+      // Signal anyone who forced a persist or a rewrite of the log file that it has finished
       persist_cv_.notify_all();
+    } else if (async_log_file_ != nullptr) {
+      // Release the buffers whose writes completed, and acknowledge the commits of a completed persist
+      num_buffers = ReapAsyncLogFile(false);
     }
 
-    if (num_buffers > 0) {
-      if (common::thread_context.resource_tracker_.IsRunning()) {
-        // Stop the resource tracker for this operating unit
-        common::thread_context.resource_tracker_.Stop();
-        auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
+    num_group_commits += num_buffers;
+    if (num_buffers > 0 || persist_tracked) {
+      if (persist_tracked || common::thread_context.resource_tracker_.IsRunning()) {
+        if (!persist_tracked) {
+          // Stop the resource tracker for this operating unit
+          common::thread_context.resource_tracker_.Stop();
+          consumer_metrics = common::thread_context.resource_tracker_.GetMetrics();
+        }
         common::thread_context.metrics_store_->RecordConsumerData(num_bytes, num_buffers, persist_interval_.count(),
-                                                                  resource_metrics);
+                                                                  consumer_metrics);
+        // Commits acknowledged by reaping a persist without issuing another one are sampled with the next persist
+        if (persist_tracked) {
+          common::thread_context.metrics_store_->RecordGroupCommitData(
+              num_group_commits, last_persist_us_, static_cast<uint64_t>(target_group_size), max_group_wait.count(),
+              commit_latency_histogram_, persist_metrics);
+          std::fill(commit_latency_histogram_.begin(), commit_latency_histogram_.end(), 0);
+          num_group_commits = 0;
+        }
+      } else {
+        std::fill(commit_latency_histogram_.begin(), commit_latency_histogram_.end(), 0);
+        num_group_commits = 0;
       }
       num_bytes = num_buffers = 0;
+      persist_tracked = false;
       // Update whether to collect metrics only if we did work (starting a new event) so as not to count each loop
       // iteration as a sample (by calling ComponentToRecord this increments the sample count)
       logging_metrics_enabled =
@@ -139,6 +300,10 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   } while (run_task_);
   // Be extra sure we processed everything
   WriteBuffersToLogFile();
-  PersistLogFile();
+  if (async_log_file_ == nullptr) {
+    PersistLogFile();
+  } else {
+    StartPersistLogFile(true);
+  }
 }
 }  // namespace noisepage::storage
@@ -1,8 +1,61 @@
 #include "storage/write_ahead_log/log_io.h"
 
 #include <algorithm>
+#include <cstddef>
+
+#include "storage/write_ahead_log/async_log_file.h"
+
 namespace noisepage::storage {
 
+bool BufferedLogWriter::IsBlockFormatted(const char *const log_file_path) {
+  const int fd = open(log_file_path, O_RDONLY);
+  if (fd == -1) return false;
+  uint32_t magic = 0;
+  const auto bytes_read = pread(fd, &magic, sizeof(magic), 0);
+  PosixIoWrappers::Close(fd);
+  return bytes_read == sizeof(magic) && magic == LogBlockHeader::MAGIC;
+}
+
+LogBlockFormat BufferedLogWriter::ResolveFormat(const char *const log_file_path, const LogBlockFormat format) {
+  struct stat file_stat;
+  if (stat(log_file_path, &file_stat) != 0 || file_stat.st_size == 0) return format;
+  if (IsBlockFormatted(log_file_path)) return format == LogBlockFormat::RAW ? LogBlockFormat::CHECKSUMMED : format;
+  if (format != LogBlockFormat::RAW) {
+    STORAGE_LOG_WARN("Log file {} already has raw contents, appending raw buffers to it.", log_file_path);
+  }
+  return LogBlockFormat::RAW;
+}
+
+uint32_t BufferedLogWriter::EncodeBlock() {
+  if (buffer_size_ == 0) return 0;
+  auto *const header = reinterpret_cast<LogBlockHeader *>(block_.data());
+  byte *const stored = block_.data() + sizeof(LogBlockHeader);
+  header->magic_ = LogBlockHeader::MAGIC;
+  header->flags_ = 0;
+  header->raw_size_ = buffer_size_;
+  header->stored_size_ = buffer_size_;
+  if (format_ == LogBlockFormat::COMPRESSED) {
+    const uint32_t compressed_size = common::CompressionUtil::Compress(buffer_, buffer_size_, stored);
+    if (compressed_size < buffer_size_) {
+      header->flags_ = LogBlockHeader::FLAG_COMPRESSED;
+      header->stored_size_ = compressed_size;
+    }
+  }
+  // Incompressible buffers are stored as they are
+  if (header->flags_ == 0) std::memcpy(stored, buffer_, buffer_size_);
+
+  const uint32_t checksummed_size = sizeof(LogBlockHeader) - offsetof(LogBlockHeader, flags_) + header->stored_size_;
+  header->checksum_ = common::CompressionUtil::Crc32c(&header->flags_, checksummed_size);
+  return sizeof(LogBlockHeader) + header->stored_size_;
+}
+
+uint64_t BufferedLogWriter::FlushBuffer(AsyncLogFile *const log_file) {
+  const auto [data, size] = EncodeBuffer();
+  log_file->Write(data, size, this);
+  buffer_size_ = 0;
+  return size;
+}
+
 bool BufferedLogReader::Read(void *dest, uint32_t size) {
   if (read_head_ + size <= filled_size_) {
     // bytes to read are already buffered.
@@ -24,6 +77,10 @@ bool BufferedLogReader::Read(void *dest, uint32_t size) {
 void BufferedLogReader::RefillBuffer() {
   NOISEPAGE_ASSERT(read_head_ == filled_size_, "Refilling a buffer that is not fully read results in loss of data");
   if (in_ == -1) throw std::runtime_error("No more bytes left in the log file");
+  if (block_formatted_) {
+    RefillBufferFromBlock();
+    return;
+  }
   read_head_ = 0;
   filled_size_ = PosixIoWrappers::ReadFully(in_, buffer_, common::Constants::LOG_BUFFER_SIZE);
   if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
@@ -33,4 +90,36 @@ void BufferedLogReader::RefillBuffer() {
   }
 }
 
+void BufferedLogReader::RefillBufferFromBlock() {
+  read_head_ = filled_size_ = 0;
+  LogBlockHeader header;
+  const uint32_t header_size = PosixIoWrappers::ReadFully(in_, &header, sizeof(LogBlockHeader));
+  bool intact = header_size == sizeof(LogBlockHeader) && header.magic_ == LogBlockHeader::MAGIC &&
+                header.raw_size_ > 0 && header.raw_size_ <= common::Constants::LOG_BUFFER_SIZE &&
+                header.stored_size_ <= MAX_LOG_BLOCK_SIZE - sizeof(LogBlockHeader);
+  if (intact) {
+    std::memcpy(block_.data(), &header, sizeof(LogBlockHeader));
+    byte *const stored = block_.data() + sizeof(LogBlockHeader);
+    const uint32_t checksummed_size = sizeof(LogBlockHeader) - offsetof(LogBlockHeader, flags_) + header.stored_size_;
+    intact = PosixIoWrappers::ReadFully(in_, stored, header.stored_size_) == header.stored_size_ &&
+             common::CompressionUtil::Crc32c(block_.data() + offsetof(LogBlockHeader, flags_), checksummed_size) ==
+                 header.checksum_;
+    if (intact && (header.flags_ & LogBlockHeader::FLAG_COMPRESSED) != 0) {
+      intact = common::CompressionUtil::Decompress(stored, header.stored_size_, buffer_, header.raw_size_);
+    } else if (intact) {
+      intact = header.stored_size_ == header.raw_size_;
+      if (intact) std::memcpy(buffer_, stored, header.raw_size_);
+    }
+  }
+
+  if (!intact) {
+    // Nothing at all is left to read at the end of a cleanly written log
+    if (header_size > 0) STORAGE_LOG_WARN("Log ends with a torn or corrupted block, ignoring the rest of the log.");
+    PosixIoWrappers::Close(in_);
+    in_ = -1;
+    return;
+  }
+  filled_size_ = header.raw_size_;
+}
+
 }  // namespace noisepage::storage
@@ -1,5 +1,8 @@
 #include "storage/write_ahead_log/log_manager.h"
 
+#include <exception>
+#include <utility>
+
 #include "common/dedicated_thread_registry.h"
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_serializer_task.h"
@@ -11,18 +14,21 @@ void LogManager::Start() {
   NOISEPAGE_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
   // Initialize buffers for logging
   for (size_t i = 0; i < num_buffers_; i++) {
-    buffers_.emplace_back(log_file_path_.c_str());
+    buffers_.emplace_back(log_file_path_.c_str(), block_format_);
   }
   for (size_t i = 0; i < num_buffers_; i++) {
     empty_buffer_queue_->Enqueue(&buffers_[i]);
   }
 
+  // Every buffer can have a write in flight. Open falls back to blocking writes if io_uring is not available.
+  if (use_io_uring_) async_log_file_ = AsyncLogFile::Open(log_file_path_, num_buffers_);
+
   run_log_manager_ = true;
 
   // Register DiskLogConsumerTask
   disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
       this /* requester */, persist_interval_, persist_threshold_, &buffers_, empty_buffer_queue_.Get(),
-      &filled_buffer_queue_);
+      &filled_buffer_queue_, async_log_file_.get());
 
   // Register LogSerializerTask
   log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
@@ -42,6 +48,37 @@ void LogManager::ForceFlush() {
   disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->force_flush_; });
 }
 
+void LogManager::RewriteLogFile(const std::function<void(const std::string &, LogBlockFormat)> &rewrite) {
+  NOISEPAGE_ASSERT(run_log_manager_, "Can't rewrite the log file of an un-started LogManager");
+  // Force the serializer task to serialize buffers, so that everything handed over until now is in the log file
+  log_serializer_task_->Process();
+  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
+  // Runs on the disk log consumer task thread once it persisted the log file
+  disk_log_writer_task_->rewrite_log_file_ = [&] {
+    std::exception_ptr error;
+    try {
+      rewrite(log_file_path_, buffers_.front().GetFormat());
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // The log file may have been replaced even if the rewrite failed afterwards
+    for (auto &buf : buffers_) buf.Reopen(log_file_path_.c_str());
+    if (async_log_file_ != nullptr) {
+      async_log_file_.reset();
+      async_log_file_ = AsyncLogFile::Open(log_file_path_, num_buffers_);
+      disk_log_writer_task_->async_log_file_ = async_log_file_.get();
+    }
+    if (error != nullptr) std::rethrow_exception(error);
+  };
+  disk_log_writer_task_->force_flush_ = true;
+  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
+
+  // Wait for the disk log consumer task thread to persist and rewrite the log file
+  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return disk_log_writer_task_->rewrite_log_file_ == nullptr; });
+  const auto error = std::exchange(disk_log_writer_task_->rewrite_log_file_error_, nullptr);
+  if (error != nullptr) std::rethrow_exception(error);
+}
+
 void LogManager::PersistAndStop() {
   NOISEPAGE_ASSERT(run_log_manager_, "Can't call PersistAndStop on an un-started LogManager");
   run_log_manager_ = false;
@@ -57,6 +94,8 @@ void LogManager::PersistAndStop() {
   NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
   NOISEPAGE_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
 
+  // The disk consumer task waited for all I/O on the log file to complete before it stopped
+  async_log_file_.reset();
   // Close the buffers corresponding to the log file
   for (auto &buf : buffers_) {
     buf.Close();
@@ -223,7 +223,7 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
         if (!commit_record->IsReadOnly()) num_bytes += SerializeRecord(record);
         commits_in_buffer_.emplace_back(CommitCallback{commit_record->CommitCallback(),
                                                        commit_record->CommitCallbackArg(), record.TxnBegin(),
-                                                       commit_record->IsReadOnly()});
+                                                       commit_record->IsReadOnly(), commit_record->CreationTime()});
         // Once serialization is done, we notify the txn manager to let GC know this txn is ready to clean up
         serialized_txns_[commit_record->TimestampManager()].push_back(record.TxnBegin());
         num_txns++;
@@ -336,6 +336,10 @@ uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord
       // AbortRecord does not hold any additional metadata
       break;
     }
+    case LogRecordType::CHECKPOINT: {
+      // CheckpointRecord does not hold any additional metadata
+      break;
+    }
   }
 
   return num_bytes;
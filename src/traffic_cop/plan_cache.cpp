@@ -0,0 +1,122 @@
+#include "traffic_cop/plan_cache.h"
+
+#include <utility>
+#include <vector>
+
+#include "common/thread_context.h"
+#include "metrics/metrics_store.h"
+
+namespace noisepage::trafficcop {
+
+static void RecordPlanCacheData(const uint64_t hits, const uint64_t misses, const uint64_t evictions) {
+  if (common::thread_context.metrics_store_ != nullptr &&
+      common::thread_context.metrics_store_->ComponentEnabled(metrics::MetricsComponent::PLAN_CACHE)) {
+    common::thread_context.metrics_store_->RecordPlanCacheData(hits, misses, evictions);
+  }
+}
+
+bool PlanCache::Lookup(const Key &key, const transaction::timestamp_t start_time, CachedPlan *const plan) {
+  bool hit = false;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    if (start_time >= catalog_version_ && catalog_changes_in_flight_ == 0) {
+      const auto it = entries_.find(key);
+      // An entry generated before the catalog version is never handed out, even if it was added concurrently with
+      // the change that moved the version forward
+      if (it != entries_.end() && it->second.start_time_ >= catalog_version_) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+        *plan = it->second.plan_;
+        hit = true;
+      }
+    }
+    if (hit) {
+      num_hits_++;
+    } else {
+      num_misses_++;
+    }
+  }
+  RecordPlanCacheData(hit ? 1 : 0, hit ? 0 : 1, 0);
+  return hit;
+}
+
+bool PlanCache::Insert(Key key, const transaction::timestamp_t start_time, CachedPlan plan, const uint64_t size) {
+  NOISEPAGE_ASSERT(plan.optimize_result_ != nullptr && plan.executable_query_ != nullptr,
+                   "Only plans that have been optimized and compiled should be cached.");
+  // Plans are freed outside of the latch, their generated code can take a while to release
+  std::vector<CachedPlan> evicted;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    // The plan may depend on a catalog that has changed since
+    if (start_time < catalog_version_ || catalog_changes_in_flight_ > 0 || size > size_limit_) return false;
+
+    const auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      // Another connection prepared the same query concurrently, keep the newer plan
+      evicted.emplace_back(std::move(it->second.plan_));
+      size_ -= it->second.size_;
+      lru_.erase(it->second.lru_position_);
+      entries_.erase(it);
+    }
+    lru_.push_front(key);
+    entries_.emplace(std::move(key), Entry{std::move(plan), size, start_time, lru_.begin()});
+    size_ += size;
+    EvictToSizeLimit(&evicted);
+  }
+  if (!evicted.empty()) RecordPlanCacheData(0, 0, evicted.size());
+  return true;
+}
+
+void PlanCache::Invalidate(const transaction::timestamp_t timestamp) {
+  // Statements still holding on to the plans keep them alive until they notice the change themselves
+  std::unordered_map<Key, Entry, KeyHasher> invalidated;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  invalidated = DropAll(timestamp);
+}
+
+void PlanCache::BeginCatalogChange(const transaction::timestamp_t timestamp) {
+  std::unordered_map<Key, Entry, KeyHasher> invalidated;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  catalog_changes_in_flight_++;
+  invalidated = DropAll(timestamp);
+}
+
+void PlanCache::EndCatalogChange(const transaction::timestamp_t timestamp) {
+  std::unordered_map<Key, Entry, KeyHasher> invalidated;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  NOISEPAGE_ASSERT(catalog_changes_in_flight_ > 0, "Catalog change ended without beginning.");
+  catalog_changes_in_flight_--;
+  invalidated = DropAll(timestamp);
+}
+
+std::unordered_map<PlanCache::Key, PlanCache::Entry, PlanCache::KeyHasher> PlanCache::DropAll(
+    const transaction::timestamp_t timestamp) {
+  if (timestamp > catalog_version_) catalog_version_ = timestamp;
+  std::unordered_map<Key, Entry, KeyHasher> dropped;
+  dropped.swap(entries_);
+  lru_.clear();
+  size_ = 0;
+  return dropped;
+}
+
+void PlanCache::SetSizeLimit(const uint64_t size_limit) {
+  std::vector<CachedPlan> evicted;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    size_limit_ = size_limit;
+    EvictToSizeLimit(&evicted);
+  }
+  if (!evicted.empty()) RecordPlanCacheData(0, 0, evicted.size());
+}
+
+void PlanCache::EvictToSizeLimit(std::vector<CachedPlan> *const evicted) {
+  while (size_ > size_limit_) {
+    NOISEPAGE_ASSERT(!lru_.empty(), "Cached plans should account for the whole size of the cache.");
+    const auto it = entries_.find(lru_.back());
+    evicted->emplace_back(std::move(it->second.plan_));
+    size_ -= it->second.size_;
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+}  // namespace noisepage::trafficcop
@@ -259,6 +259,7 @@ TrafficCopResult TrafficCop::ExecuteCreateStatement(
           query_type == network::QueryType::QUERY_CREATE_INDEX || query_type == network::QueryType::QUERY_CREATE_DB ||
           query_type == network::QueryType::QUERY_CREATE_VIEW || query_type == network::QueryType::QUERY_CREATE_TRIGGER,
       "ExecuteCreateStatement called with invalid QueryType.");
+  InvalidatePlanCache(connection_ctx);
   switch (query_type) {
     case network::QueryType::QUERY_CREATE_TABLE: {
       if (execution::sql::DDLExecutors::CreateTableExecutor(
@@ -313,6 +314,7 @@ TrafficCopResult TrafficCop::ExecuteDropStatement(
           query_type == network::QueryType::QUERY_DROP_INDEX || query_type == network::QueryType::QUERY_DROP_DB ||
           query_type == network::QueryType::QUERY_DROP_VIEW || query_type == network::QueryType::QUERY_DROP_TRIGGER,
       "ExecuteDropStatement called with invalid QueryType.");
+  InvalidatePlanCache(connection_ctx);
   switch (query_type) {
     case network::QueryType::QUERY_DROP_TABLE: {
       if (execution::sql::DDLExecutors::DropTableExecutor(
@@ -403,10 +405,11 @@ TrafficCopResult TrafficCop::ExecuteExplainStatement(
 }
 
 std::variant<std::unique_ptr<parser::ParseResult>, common::ErrorData> TrafficCop::ParseQuery(
-    const std::string &query, const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+    const std::string &query, const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const bool parameterize_literals) const {
   std::variant<std::unique_ptr<parser::ParseResult>, common::ErrorData> result;
   try {
-    auto parse_result = parser::PostgresParser::BuildParseTree(query);
+    auto parse_result = parser::PostgresParser::BuildParseTree(query, parameterize_literals && AutoParameterize());
     result.emplace<std::unique_ptr<parser::ParseResult>>(std::move(parse_result));
   } catch (const ParserException &e) {
     common::ErrorData error(common::ErrorSeverity::ERROR, std::string(e.what()),
@@ -520,6 +523,7 @@ TrafficCopResult TrafficCop::CodegenPhysicalPlan(
   }
 
   portal->GetStatement()->SetExecutableQuery(std::move(exec_query));
+  CachePlan(connection_ctx, portal->GetStatement());
 
   return {ResultType::COMPLETE, 0u};
 }
@@ -551,15 +555,21 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
 
   /*
    * ANALYZE will update the statistics held in the pg_statistic catalog table. These statistics are also cached in
-   * StatsStorage. So once ANALYZE commits, we need to mark the columns updated as dirty in StatsStorage.
+   * StatsStorage. So once ANALYZE commits, we need to mark the columns updated as dirty in StatsStorage. Plans that
+   * were optimized with the old statistics are dropped from the plan cache after that, so that the next plans use the
+   * new ones.
    */
   if (query_type == network::QueryType::QUERY_ANALYZE) {
     const auto analyze_plan = physical_plan.CastManagedPointerTo<planner::AnalyzePlanNode>();
     auto db_oid = analyze_plan->GetDatabaseOid();
     auto table_oid = analyze_plan->GetTableOid();
     std::vector<catalog::col_oid_t> col_oids = analyze_plan->GetColumnOids();
-    connection_ctx->Transaction()->RegisterCommitAction(
-        [=]() { stats_storage_->MarkStatsStale(db_oid, table_oid, col_oids); });
+    const auto plan_cache = common::ManagedPointer(plan_cache_);
+    const auto txn_manager = txn_manager_;
+    connection_ctx->Transaction()->RegisterCommitAction([=]() {
+      stats_storage_->MarkStatsStale(db_oid, table_oid, col_oids);
+      plan_cache->Invalidate(txn_manager->GetCurrentTimestamp());
+    });
   }
 
   execution::exec::OutputWriter writer(physical_plan->GetOutputSchema(), out, portal->ResultFormats());
@@ -680,6 +690,42 @@ bool TrafficCop::DropTempNamespace(const catalog::db_oid_t db_oid, const catalog
   return result;
 }
 
-void TrafficCop::UpdateQueryCacheTimestamp() { query_cache_timestamp_ = txn_manager_->GetCurrentTimestamp(); }
+void TrafficCop::UpdateQueryCacheTimestamp() {
+  query_cache_timestamp_ = txn_manager_->GetCurrentTimestamp();
+  plan_cache_->Invalidate(query_cache_timestamp_);
+}
+
+bool TrafficCop::LookupCachedPlan(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                  const common::ManagedPointer<network::Statement> statement) const {
+  if (!use_query_cache_ || !CacheableQueryType(statement->GetQueryType())) return false;
+  CachedPlan plan;
+  if (!plan_cache_->Lookup({connection_ctx->GetDatabaseOid(), statement->GetQueryText(),
+                            statement->GetDesiredParamTypes()},
+                           connection_ctx->Transaction()->StartTime(), &plan))
+    return false;
+  statement->SetCachedPlan(plan);
+  return true;
+}
+
+void TrafficCop::CachePlan(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                           const common::ManagedPointer<network::Statement> statement) const {
+  if (!use_query_cache_ || !CacheableQueryType(statement->GetQueryType())) return;
+  // Plans are not measured, the generated code and the query text are what grows with the query
+  const uint64_t size = statement->GetQueryText().size() + statement->GetExecutableQuery()->GetCodeSize();
+  plan_cache_->Insert({connection_ctx->GetDatabaseOid(), statement->GetQueryText(), statement->GetDesiredParamTypes()},
+                      connection_ctx->Transaction()->StartTime(), statement->GetCachedPlan(), size);
+}
+
+void TrafficCop::InvalidatePlanCache(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+  // Other transactions keep seeing the old catalog until this one commits, so the cache is bypassed until then rather
+  // than letting them cache plans that outlive the change
+  plan_cache_->BeginCatalogChange(txn_manager_->GetCurrentTimestamp());
+  const auto plan_cache = common::ManagedPointer(plan_cache_);
+  const auto txn_manager = txn_manager_;
+  connection_ctx->Transaction()->RegisterCommitAction(
+      [=]() { plan_cache->EndCatalogChange(txn_manager->GetCurrentTimestamp()); });
+  connection_ctx->Transaction()->RegisterAbortAction(
+      [=]() { plan_cache->EndCatalogChange(txn_manager->GetCurrentTimestamp()); });
+}
 
 }  // namespace noisepage::trafficcop
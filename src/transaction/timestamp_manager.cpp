@@ -6,28 +6,75 @@
 namespace noisepage::transaction {
 
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Any txn whose begin is not visible in its shard yet checks out its start time after this, see BeginTransaction
+  timestamp_t result = time_.load();
+  for (auto &shard : running_txn_shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (!shard.txns_.empty()) result = std::min(result, shard.txns_.front().first);
+  }
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
 
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
+uint32_t TimestampManager::ThreadShard() {
+  static std::atomic<uint32_t> next_shard{0};
+  thread_local const uint32_t shard = next_shard++ % NUM_RUNNING_TXN_SHARDS;
+  return shard;
+}
+
+bool TimestampManager::RunningTxnShard::Remove(const timestamp_t timestamp) {
+  // Outside of the shard's range, no need to search
+  if (txns_.empty() || timestamp < txns_.front().first || timestamp > txns_.back().first) return false;
+  const auto it = std::lower_bound(txns_.begin(), txns_.end(), timestamp,
+                                   [](const std::pair<timestamp_t, bool> &txn, const timestamp_t target) {
+                                     return txn.first < target;
+                                   });
+  if (it == txns_.end() || it->first != timestamp || !it->second) return false;
+  it->second = false;
+  num_finished_++;
+  while (!txns_.empty() && !txns_.front().second) {
+    txns_.pop_front();
+    num_finished_--;
+  }
+  while (!txns_.empty() && !txns_.back().second) {
+    txns_.pop_back();
+    num_finished_--;
+  }
+  if (2 * num_finished_ > txns_.size()) {
+    txns_.erase(std::remove_if(txns_.begin(), txns_.end(),
+                               [](const std::pair<timestamp_t, bool> &txn) { return !txn.second; }),
+                txns_.end());
+    num_finished_ = 0;
+  }
+  return true;
+}
+
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-  NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Txns are usually finished by the thread that began them, so look in its shard first
+  const uint32_t thread_shard = ThreadShard();
+  for (uint32_t i = 0; i < NUM_RUNNING_TXN_SHARDS; i++) {
+    RunningTxnShard &shard = running_txn_shards_[(thread_shard + i) % NUM_RUNNING_TXN_SHARDS];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (shard.Remove(timestamp)) return;
+  }
+  NOISEPAGE_ASSERT(false, "erased timestamp did not exist");
 }
 
 bool TimestampManager::RemoveTransactions(const std::vector<noisepage::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  std::vector<timestamp_t> remaining = timestamps;
+  bool all_removed = true;
+  for (auto &shard : running_txn_shards_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    const auto removed = std::remove_if(remaining.begin(), remaining.end(),
+                                        [&](const timestamp_t timestamp) { return shard.Remove(timestamp); });
+    remaining.erase(removed, remaining.end());
+    all_removed = all_removed && shard.txns_.empty();
   }
-  return curr_running_txns_.empty();
+  NOISEPAGE_ASSERT(remaining.empty(), "erased timestamp did not exist");
+  // Txns that began in an already visited shard since are younger than all of the removed ones
+  return all_removed;
 }
 
 }  // namespace noisepage::transaction
@@ -21,6 +21,9 @@ TransactionContext *TransactionManager::BeginTransaction() {
   if (txn_metrics_enabled) common::thread_context.resource_tracker_.Start();
   start_time = timestamp_manager_->BeginTransaction();
   result = new TransactionContext(start_time, start_time + INT64_MIN, buffer_pool_, log_manager_);
+  // Without the GC, txns are deleted whenever their owner sees fit, so their versions must not be walked past what a
+  // read needs. With it, whatever the GC last saw as the oldest running txn stays a safe bound for this whole txn.
+  if (gc_enabled_) result->prune_horizon_ = timestamp_manager_->CachedOldestTransactionStartTime();
   // Set the current default policies for durability and replication.
   result->SetDurabilityPolicy(default_txn_policy_.durability_);
   result->SetReplicationPolicy(default_txn_policy_.replication_);
@@ -160,7 +163,7 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -237,7 +240,7 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -283,7 +286,7 @@ void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
 }
 
 TransactionQueue TransactionManager::CompletedTransactionsForGC() {
-  common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
   return std::move(completed_txns_);
 }
 
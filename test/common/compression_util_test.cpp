@@ -0,0 +1,82 @@
+#include "common/compression_util.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_util/test_harness.h"
+
+namespace noisepage::common::test {
+
+// NOLINTNEXTLINE
+TEST(CompressionUtilTest, Crc32cTest) {
+  // Check value of the CRC-32C parameters
+  const std::string data = "123456789";
+  EXPECT_EQ(0xE3069283, CompressionUtil::Crc32c(data.data(), data.size()));
+  // Checksumming in pieces gives the same result
+  EXPECT_EQ(0xE3069283, CompressionUtil::Crc32c(data.data() + 4, 5, CompressionUtil::Crc32c(data.data(), 4)));
+  EXPECT_EQ(0, CompressionUtil::Crc32c(data.data(), 0));
+}
+
+// NOLINTNEXTLINE
+TEST(CompressionUtilTest, RoundTripTest) {
+  std::default_random_engine generator;
+  std::uniform_int_distribution<uint32_t> size_dist(0, 8192);
+  std::uniform_int_distribution<uint32_t> byte_dist(0, 255);
+  std::uniform_int_distribution<uint32_t> alphabet_dist('a', 'c');
+  for (uint32_t iteration = 0; iteration < 1000; iteration++) {
+    const uint32_t size = size_dist(generator);
+    std::vector<uint8_t> input(size);
+    // Alternate between incompressible, compressible and highly repetitive inputs
+    for (auto &input_byte : input) {
+      switch (iteration % 3) {
+        case 0:
+          input_byte = static_cast<uint8_t>(byte_dist(generator));
+          break;
+        case 1:
+          input_byte = static_cast<uint8_t>(alphabet_dist(generator));
+          break;
+        default:
+          input_byte = 0;
+      }
+    }
+
+    std::vector<uint8_t> compressed(CompressionUtil::MaxCompressedSize(size));
+    const uint32_t compressed_size = CompressionUtil::Compress(input.data(), size, compressed.data());
+    EXPECT_LE(compressed_size, CompressionUtil::MaxCompressedSize(size));
+    if (iteration % 3 == 2 && size > 1024) EXPECT_LT(compressed_size, size / 32);
+
+    std::vector<uint8_t> output(size);
+    EXPECT_TRUE(CompressionUtil::Decompress(compressed.data(), compressed_size, output.data(), size));
+    EXPECT_EQ(input, output);
+    // A block has to decompress to exactly the expected size
+    if (size > 0) {
+      EXPECT_FALSE(CompressionUtil::Decompress(compressed.data(), compressed_size, output.data(), size - 1));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(CompressionUtilTest, MalformedInputTest) {
+  std::default_random_engine generator;
+  std::uniform_int_distribution<uint32_t> byte_dist(0, 255);
+  const uint32_t size = 4096;
+  std::vector<uint8_t> input(size);
+  for (uint32_t i = 0; i < size; i++) input[i] = static_cast<uint8_t>(i % 7);
+  std::vector<uint8_t> compressed(CompressionUtil::MaxCompressedSize(size));
+  const uint32_t compressed_size = CompressionUtil::Compress(input.data(), size, compressed.data());
+
+  // Decompressing garbage never writes past the output, whether or not it is detected
+  std::vector<uint8_t> output(size + 1, 0xFF);
+  for (uint32_t i = 0; i < 1000; i++) {
+    auto corrupted = compressed;
+    corrupted[i % compressed_size] ^= static_cast<uint8_t>(byte_dist(generator));
+    CompressionUtil::Decompress(corrupted.data(), compressed_size, output.data(), size);
+    EXPECT_EQ(0xFF, output[size]);
+  }
+  // Truncated input is detected
+  EXPECT_FALSE(CompressionUtil::Decompress(compressed.data(), compressed_size - 1, output.data(), size));
+}
+
+}  // namespace noisepage::common::test
@@ -0,0 +1,152 @@
+#include "execution/vm/compiled_module_cache.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "execution/ast/context.h"
+#include "execution/compiler/compiler.h"
+#include "execution/compiler/compiler_settings.h"
+#include "execution/sema/error_reporter.h"
+#include "execution/tpl_test.h"
+#include "execution/util/region.h"
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "spdlog/fmt/fmt.h"
+#include "test_util/fs_util.h"
+
+namespace noisepage::execution::vm::test {
+
+class CompiledModuleCacheTest : public TplTest {
+ public:
+  CompiledModuleCacheTest() : region_("compiled_module_cache_test") {}
+
+  static std::string CacheDirectory() {
+    return (std::filesystem::temp_directory_path() / "noisepage-compiled-module-cache-test").string();
+  }
+
+  static void SetUpTestSuite() {
+    const auto bytecode_handlers_path = common::GetBinaryArtifactPath("bytecode_handlers_ir.bc");
+    auto settings = std::make_unique<const LLVMEngine::Settings>(bytecode_handlers_path, CacheDirectory(), 1 << 20);
+    LLVMEngine::Initialize(std::move(settings));
+  }
+
+  static void TearDownTestSuite() {
+    LLVMEngine::Shutdown();
+    std::error_code error;
+    std::filesystem::remove_all(CacheDirectory(), error);
+  }
+
+  std::unique_ptr<Module> CompileToBytecode(const std::string &src) {
+    sema::ErrorReporter error_reporter(&region_);
+    ast::Context context(&region_, &error_reporter);
+    auto input = compiler::Compiler::Input("Cache Test", &context, &src, compiler::CompilerSettings{});
+    return compiler::Compiler::RunCompilationSimple(input);
+  }
+
+ private:
+  util::Region region_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CompiledModuleCacheTest, CompileFromCache) {
+  auto *cache = LLVMEngine::GetCompiledModuleCache();
+  ASSERT_NE(nullptr, cache);
+  cache->Clear();
+
+  auto module = CompileToBytecode("fun add_one(x: int32) -> int32 { return x + 1 }");
+  ASSERT_NE(nullptr, module);
+
+  // The first compilation misses and populates the cache
+  const auto hits = cache->GetNumHits(), misses = cache->GetNumMisses();
+  auto compiled = LLVMEngine::Compile(*module->GetBytecodeModule(), LLVMEngine::CompilerOptions());
+  ASSERT_TRUE(compiled->IsLoaded());
+  EXPECT_EQ(misses + 1, cache->GetNumMisses());
+  EXPECT_EQ(hits, cache->GetNumHits());
+  EXPECT_GT(cache->GetSize(), 0);
+
+  // The second compilation is served from the cache, and its code works
+  auto cached = LLVMEngine::Compile(*module->GetBytecodeModule(), LLVMEngine::CompilerOptions());
+  ASSERT_TRUE(cached->IsLoaded());
+  EXPECT_EQ(misses + 1, cache->GetNumMisses());
+  EXPECT_EQ(hits + 1, cache->GetNumHits());
+  auto *add_one = reinterpret_cast<int32_t (*)(int32_t)>(cached->GetFunctionPointer("add_one"));
+  ASSERT_NE(nullptr, add_one);
+  EXPECT_EQ(42, add_one(41));
+
+  // A module with different code must not share the entry
+  auto other = CompileToBytecode("fun add_one(x: int32) -> int32 { return x + 2 }");
+  ASSERT_NE(nullptr, other);
+  auto other_compiled = LLVMEngine::Compile(*other->GetBytecodeModule(), LLVMEngine::CompilerOptions());
+  EXPECT_EQ(misses + 2, cache->GetNumMisses());
+  auto *add_two = reinterpret_cast<int32_t (*)(int32_t)>(other_compiled->GetFunctionPointer("add_one"));
+  EXPECT_EQ(43, add_two(41));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompiledModuleCacheTest, EvictLeastRecentlyUsed) {
+  const auto directory = CacheDirectory() + "-eviction";
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+
+  const std::string object(400, 'x');
+  const auto buffer = llvm::MemoryBuffer::getMemBuffer(object, "", false);
+  const auto set_last_use = [&](const std::string &key, int64_t seconds_ago) {
+    const auto path = std::filesystem::path(directory) / (key + CompiledModuleCache::OBJECT_FILE_EXTENSION);
+    const auto last_use = std::filesystem::file_time_type::clock::now() - std::chrono::seconds(seconds_ago);
+    std::filesystem::last_write_time(path, last_use);
+  };
+
+  {
+    CompiledModuleCache cache(directory, 1000, "fingerprint");
+    cache.Insert("a", *buffer);
+    set_last_use("a", 30);
+    cache.Insert("b", *buffer);
+    set_last_use("b", 20);
+    EXPECT_EQ(800, cache.GetSize());
+
+    // Replacing an entry does not count its size twice
+    cache.Insert("b", *buffer);
+    set_last_use("b", 20);
+    EXPECT_EQ(800, cache.GetSize());
+    EXPECT_EQ(0, cache.GetNumEvictions());
+
+    // Reading 'a' makes 'b' the least recently used entry, which is evicted to make room for 'c'
+    EXPECT_NE(nullptr, cache.Lookup("a"));
+    cache.Insert("c", *buffer);
+    EXPECT_EQ(1, cache.GetNumEvictions());
+    EXPECT_EQ(800, cache.GetSize());
+    EXPECT_NE(nullptr, cache.Lookup("a"));
+    EXPECT_EQ(nullptr, cache.Lookup("b"));
+    EXPECT_NE(nullptr, cache.Lookup("c"));
+  }
+
+  // Leftovers of a crashed writer, next to a file that may still be written to
+  const auto stale_temp_file = std::filesystem::path(directory) / "d.o.1.0.tmp";
+  const auto fresh_temp_file = std::filesystem::path(directory) / fmt::format("e.o.{}.0.tmp", ::getpid());
+  std::ofstream(stale_temp_file) << object;
+  std::ofstream(fresh_temp_file) << object;
+  std::filesystem::last_write_time(stale_temp_file,
+                                   std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+
+  {
+    // Entries survive a restart, and are trimmed if the limit shrank. Stale temporary files are removed.
+    CompiledModuleCache cache(directory, 500, "fingerprint");
+    EXPECT_EQ(400, cache.GetSize());
+    EXPECT_EQ(1, cache.GetNumEvictions());
+    EXPECT_FALSE(std::filesystem::exists(stale_temp_file));
+    EXPECT_TRUE(std::filesystem::exists(fresh_temp_file));
+    cache.Clear();
+    EXPECT_EQ(0, cache.GetSize());
+    EXPECT_EQ(nullptr, cache.Lookup("a"));
+    EXPECT_EQ(nullptr, cache.Lookup("c"));
+  }
+
+  std::filesystem::remove_all(directory, error);
+}
+
+}  // namespace noisepage::execution::vm::test
@@ -4,6 +4,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -199,6 +200,73 @@ TEST_F(CompilerTest, SimpleSeqScanTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SharedExecutableQueryTest) {
+  // SELECT colA FROM test_1 WHERE colA < 500, compiled once and run by many threads at once
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  ExpressionMaker expr_maker;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, execution::sql::SqlTypeId::Integer);
+    seq_scan_out.AddOutput("col1", common::ManagedPointer(col1));
+    auto schema = seq_scan_out.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+
+  // The query must not depend on the settings it was compiled with staying alive
+  std::unique_ptr<ExecutableQuery> executable;
+  {
+    exec::ExecutionSettings exec_settings{};
+    executable = execution::compiler::CompilationContext::Compile(*seq_scan, exec_settings, accessor.get());
+  }
+  const ExecutableQuery &shared = *executable;
+
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_runs = 10;
+  std::vector<uint32_t> num_rows(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i] {
+      // Each execution has its own execution context
+      auto thread_accessor = MakeAccessor();
+      exec::ExecutionSettings exec_settings{};
+      exec::OutputCallback callback = [&num_rows, i](byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
+        num_rows[i] += num_tuples;
+      };
+      for (uint32_t run = 0; run < num_runs; run++) {
+        exec::ExecutionContext exec_ctx{test_db_oid_,
+                                        common::ManagedPointer(test_txn_),
+                                        callback,
+                                        seq_scan->GetOutputSchema().Get(),
+                                        common::ManagedPointer(thread_accessor),
+                                        exec_settings,
+                                        DISABLED,
+                                        DISABLED,
+                                        DISABLED};
+        shared.Run(common::ManagedPointer(&exec_ctx), MODE);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t i = 0; i < num_threads; i++) {
+    EXPECT_EQ(500 * num_runs, num_rows[i]);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSeqScanNonVecFilterTest) {
   // SELECT col1, col2, col1 * col2, col1 >= 100*col2 FROM test_1
@@ -1537,6 +1605,111 @@ TEST_F(CompilerTest, SimpleHashJoinTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec1, exp_vec1));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SpilledHashJoinTest) {
+  // SELECT t1.colA, t2.col1 FROM t1 {INNER, LEFT} JOIN t2 ON t1.colA=t2.col1 WHERE t1.colA >= 500
+  // The build side is much larger than the join memory budget, so both joins go through the spilled partitions.
+  // Pipelines run serially, so that every spilled byte is counted by the calling thread's memory tracker.
+  SetJoinMemoryBudget(16 * common::Constants::KB);
+  SetParallelExecution(false);
+  constexpr int32_t min_build_key = 500;
+
+  for (const auto join_type : {planner::LogicalJoinType::INNER, planner::LogicalJoinType::LEFT}) {
+    auto accessor = MakeAccessor();
+    ExpressionMaker expr_maker;
+    auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+    auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+    auto table_schema1 = accessor->GetSchema(table_oid1);
+    auto table_schema2 = accessor->GetSchema(table_oid2);
+
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    {
+      auto cola_oid = table_schema1.GetColumn("colA").Oid();
+      auto col1 = expr_maker.CVE(cola_oid, execution::sql::SqlTypeId::Integer);
+      seq_scan_out1.AddOutput("col1", col1);
+      auto schema = seq_scan_out1.MakeSchema();
+      auto predicate = expr_maker.ComparisonGe(col1, expr_maker.Constant(min_build_key));
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                      .SetColumnOids({cola_oid})
+                      .SetScanPredicate(predicate)
+                      .SetIsForUpdateFlag(false)
+                      .SetTableOid(table_oid1)
+                      .Build();
+    }
+    std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+    OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+    {
+      auto col1_oid = table_schema2.GetColumn("col1").Oid();
+      auto col1 = expr_maker.CVE(col1_oid, execution::sql::SqlTypeId::SmallInt);
+      seq_scan_out2.AddOutput("col1", col1);
+      auto schema = seq_scan_out2.MakeSchema();
+      planner::SeqScanPlanNode::Builder builder;
+      seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                      .SetColumnOids({col1_oid})
+                      .SetScanPredicate(nullptr)
+                      .SetIsForUpdateFlag(false)
+                      .SetTableOid(table_oid2)
+                      .Build();
+    }
+    std::unique_ptr<planner::AbstractPlanNode> hash_join;
+    OutputSchemaHelper hash_join_out{0, &expr_maker};
+    {
+      auto t1_col1 = seq_scan_out1.GetOutput("col1");
+      auto t2_col1 = seq_scan_out2.GetOutput("col1");
+      hash_join_out.AddOutput("t1.col1", t1_col1);
+      hash_join_out.AddOutput("t2.col1", t2_col1);
+      auto schema = hash_join_out.MakeSchema();
+      planner::HashJoinPlanNode::Builder builder;
+      hash_join = builder.AddChild(std::move(seq_scan1))
+                      .AddChild(std::move(seq_scan2))
+                      .SetOutputSchema(std::move(schema))
+                      .AddLeftHashKey(t1_col1)
+                      .AddRightHashKey(t2_col1)
+                      .SetJoinType(join_type)
+                      .SetJoinPredicate(expr_maker.ComparisonEq(t1_col1, t2_col1))
+                      .Build();
+    }
+
+    // Every t2 row with col1 >= 500 finds exactly one partner, the others only show up in the LEFT join
+    const bool is_left = join_type == planner::LogicalJoinType::LEFT;
+    const uint32_t num_expected_matched = sql::TEST2_SIZE - static_cast<uint32_t>(min_build_key);
+    const uint32_t num_expected_unmatched = is_left ? static_cast<uint32_t>(min_build_key) : 0;
+    uint32_t num_matched{0}, num_unmatched{0};
+    RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+      auto build_col = static_cast<sql::Integer *>(vals[0]);
+      auto probe_col = static_cast<sql::Integer *>(vals[1]);
+      ASSERT_FALSE(probe_col->is_null_);
+      if (build_col->is_null_) {
+        ASSERT_TRUE(is_left);
+        ASSERT_LT(probe_col->val_, min_build_key);
+        num_unmatched++;
+      } else {
+        ASSERT_EQ(build_col->val_, probe_col->val_);
+        num_matched++;
+      }
+    };
+    CorrectnessFn correctness_fn = [&]() {
+      EXPECT_EQ(num_expected_matched, num_matched);
+      EXPECT_EQ(num_expected_unmatched, num_unmatched);
+    };
+    GenericChecker checker(row_checker, correctness_fn);
+
+    OutputStore store{&checker, hash_join->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(hash_join->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+    auto exec_ctx = MakeExecCtx(&callback_fn, hash_join->GetOutputSchema().Get());
+
+    auto executable = execution::compiler::CompilationContext::Compile(*hash_join, exec_ctx->GetExecutionSettings(),
+                                                                       exec_ctx->GetAccessor());
+    executable->Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+    EXPECT_GT(exec_ctx->GetMemoryPool()->GetTracker()->GetSpilledSize(), 0u) << "The join did not spill";
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, MultiWayHashJoinTest) {
   // SELECT t1.col1, t2.col1, t3.col1, t1.col1 + t2.col1 + t3.col1
@@ -1,6 +1,7 @@
 #include <tbb/tbb.h>
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <random>
 #include <unordered_map>
@@ -83,6 +84,106 @@ class AggregationHashTableTest : public SqlBasedTest {
 
   AggregationHashTable *AggTable() { return agg_table_.get(); }
 
+  /** The aggregates found by a parallel scan of the partitions of a merged table. */
+  struct ScanResult {
+    uint32_t num_aggs_;
+    // The number of aggregates whose count1_ is not the expected one
+    uint32_t num_wrong_counts_;
+  };
+
+  /** Make the container hold a thread-local aggregation hash table. */
+  static void InitThreadLocalTables(ThreadStateContainer *container, exec::ExecutionContext *exec_ctx) {
+    container->Reset(
+        sizeof(AggregationHashTable),
+        [](void *ctx, void *aht) {
+          auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+          new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+        },
+        [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx);
+  }
+
+  /** Move the overflow partitions of all thread-local tables into the main table, and clear the container. */
+  static void MergeThreadLocalTables(AggregationHashTable *main_table, ThreadStateContainer *container) {
+    main_table->TransferMemoryAndPartitions(
+        container, 0,
+        // Merging function merges a set of overflow partitions into the provided table.
+        [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+          for (; iter->HasNext(); iter->Next()) {
+            auto *partial_agg = iter->GetRowAs<AggTuple>();
+            auto *existing =
+                reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+            if (existing != nullptr) {
+              existing->Merge(*partial_agg);
+            } else {
+              table->Insert(iter->GetEntryForRow());
+            }
+          }
+        });
+    // Clear thread-local container to ensure all memory has been moved
+    container->Clear();
+  }
+
+  /** Scan the partitions of the merged main table in parallel, checking that every count1_ is expected_count1. */
+  static ScanResult ScanPartitions(AggregationHashTable *main_table, ThreadStateContainer *container,
+                                   uint64_t expected_count1) {
+    struct QueryState {
+      uint64_t expected_count1_;
+      std::atomic<uint32_t> num_aggs_;
+      std::atomic<uint32_t> num_wrong_counts_;
+    };
+    QueryState query_state{expected_count1, {0}, {0}};
+    main_table->ExecuteParallelPartitionedScan(
+        &query_state, container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+          auto *qs = reinterpret_cast<QueryState *>(query_state);
+          for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+            auto *agg = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+            if (agg->count1_ != qs->expected_count1_) {
+              qs->num_wrong_counts_++;
+            }
+            qs->num_aggs_++;
+          }
+        });
+    return {query_state.num_aggs_.load(), query_state.num_wrong_counts_.load()};
+  }
+
+  /**
+   * Feed batches to the table in partitioned mode. Tuples are numbered on from first_tuple, and the key of tuple i is
+   * key_fn(i). Every tuple adds 1 to count1_ of its aggregate.
+   */
+  static void ProcessPartitionedBatches(AggregationHashTable *agg_table, uint64_t first_tuple, uint32_t num_batches,
+                                        const std::function<uint32_t(uint64_t)> &key_fn) {
+    VectorProjection vector_projection;
+    vector_projection.Initialize({TypeId::Integer, TypeId::Integer});
+    vector_projection.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+    for (uint32_t batch = 0; batch < num_batches; batch++) {
+      auto keys = reinterpret_cast<uint32_t *>(vector_projection.GetColumn(0)->GetData());
+      auto values = reinterpret_cast<uint32_t *>(vector_projection.GetColumn(1)->GetData());
+      for (uint32_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) {
+        keys[i] = key_fn(first_tuple + batch * common::Constants::K_DEFAULT_VECTOR_SIZE + i);
+        values[i] = 1;
+      }
+      VectorProjectionIterator vpi(&vector_projection);
+      agg_table->ProcessBatch(
+          &vpi, {0},
+          [](VectorProjectionIterator *new_aggs, VectorProjectionIterator *input) {
+            VectorProjectionIterator::SynchronizedForEach({new_aggs, input}, [&]() {
+              auto *e = *new_aggs->GetValue<sql::HashTableEntry *, false>(1, nullptr);
+              auto agg = const_cast<AggTuple *>(e->PayloadAs<AggTuple>());
+              agg->key_ = *input->GetValue<uint32_t, false>(0, nullptr);
+              agg->count1_ = agg->count2_ = agg->count3_ = 0;
+            });
+          },
+          [](VectorProjectionIterator *aggs, VectorProjectionIterator *input) {
+            VectorProjectionIterator::SynchronizedForEach({aggs, input}, [&]() {
+              auto *e = *aggs->GetValue<sql::HashTableEntry *, false>(1, nullptr);
+              auto agg = const_cast<AggTuple *>(e->PayloadAs<AggTuple>());
+              agg->count1_ += *input->GetValue<uint32_t, false>(1, nullptr);
+            });
+          },
+          true /* Partitioned? */);
+    }
+  }
+
  private:
   std::unique_ptr<exec::ExecutionContext> exec_ctx_;
   std::unique_ptr<AggregationHashTable> agg_table_;
@@ -360,26 +461,12 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   auto exec_ctx = MakeExecCtx();
   tbb::task_scheduler_init sched;
 
-  // The whole-query state.
-  struct QueryState {
-    std::atomic<uint32_t> row_count_;
-  };
-
-  QueryState query_state{0};
   MemoryPool memory(nullptr);
   ThreadStateContainer container(&memory);
 
   // -------------------------------------------------------
   // Step 1: thread-local container contains only an aggregation hash table.
-  container.Reset(
-      sizeof(AggregationHashTable),
-      // Init function.
-      [](void *ctx, void *aht) {
-        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
-        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
-      },
-      // Tear-down function.
-      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+  InitThreadLocalTables(&container, exec_ctx.get());
 
   // -------------------------------------------------------
   // Step 2: build 4 thread-local aggregation hash tables.
@@ -407,35 +494,118 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   // -------------------------------------------------------
   // Step 2: Transfer thread-local memory into global/main hash table.
   AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
-  main_table.TransferMemoryAndPartitions(
-      &container, 0,
-      // Merging function merges a set of overflow partitions into the provided
-      // table.
-      [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
-        for (; iter->HasNext(); iter->Next()) {
-          auto *partial_agg = iter->GetRowAs<AggTuple>();
-          auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
-          if (existing != nullptr) {
-            existing->Merge(*partial_agg);
-          } else {
-            table->Insert(iter->GetEntryForRow());
-          }
-        }
-      });
-
-  // Clear thread-local container to ensure all memory has been moved
-  container.Clear();
+  MergeThreadLocalTables(&main_table, &container);
 
   // -------------------------------------------------------
-  // Step 3: scan main table and ensure all data exists.
-  main_table.ExecuteParallelPartitionedScan(
-      &query_state, &container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
-        auto *qs = reinterpret_cast<QueryState *>(query_state);
-        qs->row_count_ += agg_table->GetTupleCount();
-      });
-
-  // Check
-  EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
+  // Step 3: scan main table and ensure all data exists. The counts are random, so only the groups are checked.
+  EXPECT_EQ(num_aggs, ScanPartitions(&main_table, &container, 0).num_aggs_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, AdaptivePreAggregationTest) {
+  SetAggAdaptivePreAggregation(true);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  // Tuples of the same key arrive four in a row, so pre-aggregation cuts the input down to a quarter
+  const auto duplicate_keys = [](uint64_t tuple) { return static_cast<uint32_t>(tuple / 4); };
+  const auto unique_keys = [](uint64_t tuple) { return static_cast<uint32_t>(tuple); };
+
+  // Few groups per tuple are worth pre-aggregating, even once the table has been flushed and sampled
+  {
+    AggregationHashTable agg_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+    ProcessPartitionedBatches(&agg_table, 0, 256, duplicate_keys);
+    EXPECT_GT(agg_table.GetStatistics()->num_flushes_, 0);
+    EXPECT_EQ(0, agg_table.GetStatistics()->num_bypassed_tuples_);
+  }
+
+  // Once the keys become unique, pre-aggregation is bypassed. After they turn back into duplicates, the next sample
+  // taken when resampling switches back to pre-aggregation for good.
+  {
+    AggregationHashTable agg_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+    const auto *stats = agg_table.GetStatistics();
+    uint64_t num_tuples = 0;
+    constexpr uint32_t num_unique_batches = 256;
+    ProcessPartitionedBatches(&agg_table, num_tuples, num_unique_batches, unique_keys);
+    num_tuples += num_unique_batches * common::Constants::K_DEFAULT_VECTOR_SIZE;
+    ASSERT_GT(stats->num_bypassed_tuples_, 0);
+
+    // Wait for two flushes in a row without any bypassed tuple in between, bounded by the longest possible bypass
+    constexpr uint32_t max_duplicate_batches = 4096;
+    uint64_t num_bypassed = stats->num_bypassed_tuples_, num_flushes_since_bypass = 0;
+    for (uint32_t batch = 0; batch < max_duplicate_batches && num_flushes_since_bypass < 2; batch++) {
+      const uint64_t num_flushes = stats->num_flushes_;
+      ProcessPartitionedBatches(&agg_table, num_tuples + batch * common::Constants::K_DEFAULT_VECTOR_SIZE, 1,
+                                duplicate_keys);
+      if (stats->num_bypassed_tuples_ != num_bypassed) {
+        num_bypassed = stats->num_bypassed_tuples_;
+        num_flushes_since_bypass = 0;
+      } else {
+        num_flushes_since_bypass += stats->num_flushes_ - num_flushes;
+      }
+    }
+    EXPECT_GE(num_flushes_since_bypass, 2);
+  }
+
+  // Unique keys bypass pre-aggregation in every thread, and are merged correctly across threads
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+  InitThreadLocalTables(&container, exec_ctx.get());
+
+  constexpr uint32_t num_threads = 4, num_batches = 128;
+  constexpr uint32_t num_aggs = num_batches * common::Constants::K_DEFAULT_VECTOR_SIZE;
+  std::atomic<uint64_t> num_bypassed{0};
+  LaunchParallel(num_threads, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+    ProcessPartitionedBatches(agg_table, 0, num_batches, unique_keys);
+    num_bypassed += agg_table->GetStatistics()->num_bypassed_tuples_;
+  });
+  EXPECT_GT(num_bypassed.load(), 0);
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  MergeThreadLocalTables(&main_table, &container);
+  const auto result = ScanPartitions(&main_table, &container, num_threads);
+  EXPECT_EQ(num_aggs, result.num_aggs_);
+  EXPECT_EQ(0, result.num_wrong_counts_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, SpillTest) {
+  // Every flush of the thread-local tables exceeds the budget
+  SetAggMemoryBudget(64 * common::Constants::KB);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+  InitThreadLocalTables(&container, exec_ctx.get());
+
+  // Each thread sees every key twice
+  constexpr uint32_t num_threads = 4, num_aggs = 100000, num_rounds = 2;
+  LaunchParallel(num_threads, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+    for (uint32_t idx = 0; idx < num_aggs * num_rounds; idx++) {
+      InputTuple input(idx % num_aggs, 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->AllocInputTuplePartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+  });
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  MergeThreadLocalTables(&main_table, &container);
+  ASSERT_TRUE(main_table.IsSpilled());
+  EXPECT_GT(main_table.GetSpilledTupleCount(), 0);
+
+  // Partial aggregates read back from disk are merged correctly
+  const auto result = ScanPartitions(&main_table, &container, num_threads * num_rounds);
+  EXPECT_EQ(num_aggs, result.num_aggs_);
+  EXPECT_EQ(0, result.num_wrong_counts_);
 }
 
 }  // namespace noisepage::execution::sql
@@ -217,6 +217,166 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, RadixPartitionedParallelBuildTest) {
+  SetJoinRadixPartitioning(true);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  const uint32_t num_tuples = 300000;
+  const uint32_t num_thread_local_tables = 4;
+
+  // The directory of the merged table takes several MB. The cache it has to fit in is set explicitly, rather than
+  // taken from the machine, whose L2 size may be unknown. A cache as large as the directory disables partitioning.
+  for (const bool partitioned : {true, false}) {
+    const uint64_t cache_size = partitioned ? 64 * common::Constants::KB : 1024 * common::Constants::MB;
+    ThreadStateContainer container(exec_ctx->GetMemoryPool());
+    container.Reset(
+        sizeof(JoinHashTable),
+        [](auto *ctx, auto *s) {
+          auto *exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+          new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+        },
+        [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, exec_ctx.get());
+
+    LaunchParallel(num_thread_local_tables, [&](auto tid) {
+      auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+      PopulateJoinHashTable(jht, num_tuples, 1);
+    });
+
+    JoinHashTable main_jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+    main_jht.radix_partition_cache_size_ = cache_size;
+    main_jht.MergeParallel(&container, 0);
+
+    // The merge is partitioned exactly when the directory outgrows the cache
+    ASSERT_EQ(partitioned, main_jht.chaining_hash_table_.GetTotalMemoryUsage() > cache_size);
+    if (partitioned) {
+      EXPECT_GT(main_jht.num_merge_partitions_, 1);
+      EXPECT_LE(main_jht.num_merge_partitions_, 1u << JoinHashTable::MAX_RADIX_PARTITION_BITS);
+    } else {
+      EXPECT_EQ(0, main_jht.num_merge_partitions_);
+    }
+
+    // Every tuple was inserted, and every key finds all its duplicates
+    EXPECT_EQ(num_tuples * num_thread_local_tables, main_jht.GetTupleCount());
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto probe = Tuple{i, 1, 2, 3};
+      uint32_t count = 0;
+      for (auto iter = main_jht.Lookup<false>(probe.Hash()); iter.HasNext();) {
+        auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+        if (matched->a_ == probe.a_) {
+          count++;
+        }
+      }
+      EXPECT_EQ(num_thread_local_tables, count) << "Wrong number of matches for key [" << i << "]";
+    }
+  }
+}
+
+// Spill probe tuples with keys in [0, num_probe_keys) into the spilled table, join all partitions, and return
+// the number of matches found for each key
+std::vector<uint32_t> JoinSpilledPartitions(JoinHashTable *jht, uint32_t num_probe_keys) {
+  for (uint32_t i = 0; i < num_probe_keys; i++) {
+    auto probe = Tuple{i, 0, 0, 0};
+    jht->SpillProbeTuple(probe.Hash(), reinterpret_cast<const byte *>(&probe));
+  }
+
+  std::vector<uint32_t> counts(num_probe_keys, 0);
+  while (jht->NextSpilledPartition()) {
+    for (const byte *row; (row = jht->NextSpilledProbeTuple()) != nullptr;) {
+      const auto *probe = reinterpret_cast<const Tuple *>(row);
+      for (auto iter = jht->Lookup<false>(probe->Hash()); iter.HasNext();) {
+        auto *matched = reinterpret_cast<const Tuple *>(iter.GetMatchPayload());
+        if (matched->a_ == probe->a_) {
+          counts[probe->a_]++;
+        }
+      }
+    }
+  }
+  return counts;
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillTest) {
+  // Partitions are larger than the budget too, and have to be split again
+  SetJoinMemoryBudget(16 * common::Constants::KB);
+  auto exec_ctx = MakeExecCtx();
+  const uint32_t num_tuples = 20000, dup_scale_factor = 2;
+
+  // Only tables that are able to spill probe tuples spill
+  JoinHashTable unspillable(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+  PopulateJoinHashTable(&unspillable, num_tuples, dup_scale_factor);
+  unspillable.Build();
+  EXPECT_FALSE(unspillable.IsSpilled());
+
+  JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false, sizeof(Tuple));
+  PopulateJoinHashTable(&jht, num_tuples, dup_scale_factor);
+  jht.Build();
+  ASSERT_TRUE(jht.IsSpilled());
+  EXPECT_EQ(num_tuples * dup_scale_factor, jht.GetSpilledTupleCount());
+
+  // Every key finds all its duplicates, and keys that were not inserted find nothing
+  const auto counts = JoinSpilledPartitions(&jht, num_tuples + 1000);
+  for (uint32_t i = 0; i < counts.size(); i++) {
+    EXPECT_EQ(i < num_tuples ? dup_scale_factor : 0, counts[i]) << "Wrong number of matches for key [" << i << "]";
+  }
+  EXPECT_FALSE(jht.NextSpilledPartition());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillDuplicateKeyTest) {
+  // A single key can never be split into smaller partitions, and is loaded once splitting gives up
+  SetJoinMemoryBudget(16 * common::Constants::KB);
+  auto exec_ctx = MakeExecCtx();
+  const uint32_t num_duplicates = 5000;
+
+  JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false, sizeof(Tuple));
+  PopulateJoinHashTable(&jht, 1, num_duplicates);
+  jht.Build();
+  ASSERT_TRUE(jht.IsSpilled());
+
+  const auto counts = JoinSpilledPartitions(&jht, 2);
+  EXPECT_EQ(num_duplicates, counts[0]);
+  EXPECT_EQ(0u, counts[1]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillParallelBuildTest) {
+  SetJoinMemoryBudget(16 * common::Constants::KB);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  const uint32_t num_thread_local_tables = 4;
+  ThreadStateContainer container(exec_ctx->GetMemoryPool());
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) {
+        auto *exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple), false, sizeof(Tuple));
+      },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, exec_ctx.get());
+
+  // Only one thread inserts enough tuples to exceed the budget, yet all thread-local tables are spilled
+  const uint32_t large_num_tuples = 10000, small_num_tuples = 100;
+  LaunchParallel(num_thread_local_tables, [&](auto tid) {
+    auto *jht = container.AccessCurrentThreadStateAs<JoinHashTable>();
+    PopulateJoinHashTable(jht, tid == 0 ? large_num_tuples : small_num_tuples, 1);
+  });
+
+  JoinHashTable main_jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple), false, sizeof(Tuple));
+  main_jht.MergeParallel(&container, 0);
+  ASSERT_TRUE(main_jht.IsSpilled());
+
+  EXPECT_EQ(large_num_tuples + (num_thread_local_tables - 1) * small_num_tuples, main_jht.GetSpilledTupleCount());
+
+  // Each key is found once for every thread that inserted it
+  const auto counts = JoinSpilledPartitions(&main_jht, large_num_tuples);
+  for (uint32_t i = 0; i < counts.size(); i++) {
+    const uint32_t expected = i < small_num_tuples ? num_thread_local_tables : 1;
+    EXPECT_EQ(expected, counts[i]) << "Wrong number of matches for key [" << i << "]";
+  }
+}
+
 #if 0
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, PerfTest) {
@@ -5,8 +5,10 @@
 #include <limits>
 #include <queue>
 #include <random>
+#include <string>
 #include <vector>
 
+#include "execution/sql/sort_key.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql_test.h"
@@ -249,6 +251,99 @@ TEST_F(SorterTest, SingleThreadLocalParallelSortTest) {
   TestParallelSort<2>(exec_ctx.get(), {1000});
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillSortTest) {
+  // With a budget of one byte, sorters spill every MIN_TUPLES_PER_SPILLED_RUN tuples
+  SetSortMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const uint32_t *>(a);
+    const auto val_b = *reinterpret_cast<const uint32_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  const auto tracker = exec_ctx->GetMemoryPool()->GetTracker();
+  for (uint32_t num_elems : {100u, 1024u, 1025u, 5000u, 10000u}) {
+    std::uniform_int_distribution<uint32_t> rng(0, num_elems / 2);
+    std::vector<uint32_t> reference;
+    const uint64_t spilled_bytes = tracker->GetSpilledSize();
+    Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(uint32_t));
+    for (uint32_t i = 0; i < num_elems; i++) {
+      reference.push_back(rng(generator_));
+      *reinterpret_cast<uint32_t *>(sorter.AllocInputTuple()) = reference.back();
+    }
+    sorter.Sort();
+    std::sort(reference.begin(), reference.end());
+
+    EXPECT_EQ((num_elems - 1) / Sorter::MIN_TUPLES_PER_SPILLED_RUN, sorter.GetSpilledRunCount());
+    EXPECT_EQ(num_elems, sorter.GetTupleCount());
+    // Every spilled tuple is counted in the thread's memory tracker
+    EXPECT_EQ(sorter.GetSpilledRunCount() * Sorter::MIN_TUPLES_PER_SPILLED_RUN * sizeof(uint32_t),
+              tracker->GetSpilledSize() - spilled_bytes);
+
+    // Iterate over all tuples, and skip over some of them
+    uint32_t idx = 0;
+    for (SorterIterator iter(sorter); iter.HasNext(); iter.Next(), idx++) {
+      EXPECT_EQ(num_elems - idx, iter.NumRemaining());
+      EXPECT_EQ(reference[idx], *iter.GetRowAs<uint32_t>()) << "index " << idx;
+    }
+    EXPECT_EQ(num_elems, idx);
+
+    SorterIterator iter(sorter);
+    iter.AdvanceBy(num_elems / 3);
+    ASSERT_TRUE(iter.HasNext());
+    EXPECT_EQ(reference[num_elems / 3], *iter.GetRowAs<uint32_t>());
+    iter.AdvanceBy(num_elems);
+    EXPECT_FALSE(iter.HasNext());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillBudgetTest) {
+  // The budget only covers the sorter's own buffered tuples, not what else the thread allocated
+  SetSortMemoryBudget(64 * common::Constants::KB);
+  auto exec_ctx = MakeExecCtx();
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const uint32_t *>(a);
+    const auto val_b = *reinterpret_cast<const uint32_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  auto *const memory = exec_ctx->GetMemoryPool();
+  const std::size_t other_size = common::Constants::MB;
+  void *const other = memory->Allocate(other_size);
+  Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(uint32_t));
+
+  // 4096 tuples and the pointers to them fit in the budget
+  uint32_t num_elems = 0;
+  for (; num_elems < 4096; num_elems++) *reinterpret_cast<uint32_t *>(sorter.AllocInputTuple()) = num_elems;
+  EXPECT_EQ(0, sorter.GetSpilledRunCount());
+
+  // Four times as many do not
+  for (; num_elems < 4 * 4096; num_elems++) *reinterpret_cast<uint32_t *>(sorter.AllocInputTuple()) = num_elems;
+  EXPECT_LT(0, sorter.GetSpilledRunCount());
+  EXPECT_EQ(num_elems, sorter.GetTupleCount());
+
+  sorter.Sort();
+  uint32_t idx = 0;
+  for (SorterIterator iter(sorter); iter.HasNext(); iter.Next(), idx++) {
+    EXPECT_EQ(idx, *iter.GetRowAs<uint32_t>());
+  }
+  EXPECT_EQ(num_elems, idx);
+  memory->Deallocate(other, other_size);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillParallelSortTest) {
+  SetSortMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  // Some, all or none of the thread-local sorters spill
+  TestParallelSort<2>(exec_ctx.get(), {5000});
+  TestParallelSort<2>(exec_ctx.get(), {5000, 10, 0, 2000});
+  TestParallelSort<2>(exec_ctx.get(), {3000, 3000, 3000, 3000});
+  TestParallelSort<2>(exec_ctx.get(), {1000, 1000, 1000});
+}
+
 // NOLINTNEXTLINE
 TEST_F(SorterTest, UnbalancedParallelSortTest) {
   auto exec_ctx = MakeExecCtx();
@@ -262,4 +357,155 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   }
 }
 
+
+// Check that memcmp() orders the encodings of each pair of adjacent values the same way as the values
+template <typename T, typename Write>
+void CheckSortKeyOrder(const std::vector<T> &ascending, TypeId type, Write write) {
+  const uint32_t size = SortKey::EncodedSize(type);
+  std::vector<byte> lhs(size), rhs(size);
+  for (std::size_t i = 1; i < ascending.size(); i++) {
+    write(lhs.data(), ascending[i - 1], false);
+    write(rhs.data(), ascending[i], false);
+    EXPECT_LT(std::memcmp(lhs.data(), rhs.data(), size), 0) << "ascending, index " << i;
+    write(lhs.data(), ascending[i - 1], true);
+    write(rhs.data(), ascending[i], true);
+    EXPECT_GT(std::memcmp(lhs.data(), rhs.data(), size), 0) << "descending, index " << i;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SortKeyOrderTest) {
+  // NULLs sort last in ascending order
+  CheckSortKeyOrder<BoolVal>({BoolVal(false), BoolVal(true), BoolVal::Null()}, TypeId::Boolean,
+                             SortKey::WriteBool);
+  CheckSortKeyOrder<Integer>({Integer(std::numeric_limits<int64_t>::min()), Integer(-256), Integer(-1), Integer(0),
+                              Integer(1), Integer(255), Integer(std::numeric_limits<int64_t>::max()), Integer::Null()},
+                             TypeId::BigInt, SortKey::WriteInteger);
+  CheckSortKeyOrder<Real>({Real(-std::numeric_limits<double>::infinity()), Real(-1e10), Real(-1.5), Real(-1e-10),
+                           Real(0.0), Real(1e-10), Real(1.5), Real(1e10), Real(std::numeric_limits<double>::infinity()),
+                           Real::Null()},
+                          TypeId::Double, SortKey::WriteReal);
+  CheckSortKeyOrder<DateVal>({DateVal(Date::FromYMD(1969, 12, 31)), DateVal(Date::FromYMD(1992, 1, 2)),
+                              DateVal(Date::FromYMD(1998, 12, 1)), DateVal::Null()},
+                             TypeId::Date, SortKey::WriteDate);
+  CheckSortKeyOrder<TimestampVal>({TimestampVal(Timestamp::FromYMDHMS(1992, 1, 2, 3, 4, 5)),
+                                   TimestampVal(Timestamp::FromYMDHMS(1992, 1, 2, 3, 4, 6)),
+                                   TimestampVal(Timestamp::FromYMDHMS(2020, 1, 1, 0, 0, 0)), TimestampVal::Null()},
+                                  TypeId::Timestamp, SortKey::WriteTimestamp);
+  CheckSortKeyOrder<StringVal>({StringVal(""), StringVal("a"), StringVal("ab"), StringVal("b"), StringVal::Null()},
+                               TypeId::Varchar, SortKey::WriteString);
+
+  // Zeros of either sign, and strings sharing a prefix, encode to the same key
+  std::vector<byte> lhs(SortKey::EncodedSize(TypeId::Double)), rhs(SortKey::EncodedSize(TypeId::Double));
+  SortKey::WriteReal(lhs.data(), Real(-0.0), false);
+  SortKey::WriteReal(rhs.data(), Real(0.0), false);
+  EXPECT_EQ(0, std::memcmp(lhs.data(), rhs.data(), lhs.size()));
+
+  const std::string prefix(SortKey::STRING_PREFIX_SIZE, 'x');
+  const std::string left = prefix + "a", right = prefix + "b";
+  lhs.resize(SortKey::EncodedSize(TypeId::Varchar));
+  rhs.resize(SortKey::EncodedSize(TypeId::Varchar));
+  SortKey::WriteString(lhs.data(), StringVal(left.c_str(), left.size()), false);
+  SortKey::WriteString(rhs.data(), StringVal(right.c_str(), right.size()), false);
+  EXPECT_EQ(0, std::memcmp(lhs.data(), rhs.data(), lhs.size()));
+}
+
+// A tuple sorted on (a ASC, s DESC), whose normalized key encodes 'a' and a prefix of 's'
+struct KeyedTuple {
+  static constexpr uint32_t KEY_SIZE = SortKey::EncodedSize(TypeId::BigInt) + SortKey::EncodedSize(TypeId::Varchar);
+
+  byte key_[KEY_SIZE];
+  Integer a_;
+  StringVal s_;
+
+  void WriteKey() {
+    SortKey::WriteInteger(key_, a_, false);
+    SortKey::WriteString(key_ + SortKey::EncodedSize(TypeId::BigInt), s_, true);
+  }
+
+  static int32_t Compare(const void *left, const void *right) {
+    const auto *l = reinterpret_cast<const KeyedTuple *>(left);
+    const auto *r = reinterpret_cast<const KeyedTuple *>(right);
+    if (l->a_.is_null_ || r->a_.is_null_) {
+      if (l->a_.is_null_ != r->a_.is_null_) return l->a_.is_null_ ? 1 : -1;
+    } else if (l->a_.val_ != r->a_.val_) {
+      return l->a_.val_ < r->a_.val_ ? -1 : 1;
+    }
+    const int32_t cmp = r->s_.val_.StringView().compare(l->s_.val_.StringView());
+    return cmp < 0 ? -1 : (cmp == 0 ? 0 : 1);
+  }
+};
+
+// Insert random tuples into a sorter, then check that sorting on the normalized key agrees with the comparison function
+template <typename Random>
+void TestNormalizedKeySort(exec::ExecutionContext *exec_ctx, const uint32_t num_elems, const uint64_t top_k,
+                           Random *generator) {
+  // Strings longer than the key's prefix force the comparison function to break ties
+  const std::string long_prefix(SortKey::STRING_PREFIX_SIZE + 4, 'm');
+  std::vector<std::string> strings;
+  strings.reserve(num_elems);
+  std::uniform_int_distribution<int64_t> rng_int(-50, 50);
+  std::uniform_int_distribution<uint32_t> rng_char('a', 'z');
+
+  Sorter sorter(exec_ctx, KeyedTuple::Compare, sizeof(KeyedTuple), KeyedTuple::KEY_SIZE);
+  EXPECT_EQ(KeyedTuple::KEY_SIZE, sorter.GetKeySize());
+  std::vector<KeyedTuple> reference;
+  reference.reserve(num_elems);
+  for (uint32_t i = 0; i < num_elems; i++) {
+    strings.emplace_back(rng_char(*generator) % 2 == 0 ? long_prefix : "");
+    strings.back().push_back(static_cast<char>(rng_char(*generator)));
+    const auto a = rng_int(*generator);
+
+    auto *tuple = reinterpret_cast<KeyedTuple *>(top_k == 0 ? sorter.AllocInputTuple()
+                                                            : sorter.AllocInputTupleTopK(top_k));
+    tuple->a_ = a % 10 == 0 ? Integer::Null() : Integer(a);
+    tuple->s_ = StringVal(strings.back().c_str(), strings.back().size());
+    tuple->WriteKey();
+    reference.push_back(*tuple);
+    if (top_k != 0) {
+      sorter.AllocInputTupleTopKFinish(top_k);
+    }
+  }
+
+  sorter.Sort();
+  std::stable_sort(reference.begin(), reference.end(),
+                   [](const KeyedTuple &l, const KeyedTuple &r) { return KeyedTuple::Compare(&l, &r) < 0; });
+  if (top_k != 0 && top_k < reference.size()) {
+    reference.erase(reference.begin() + top_k, reference.end());
+  }
+
+  EXPECT_TRUE(sorter.IsSorted());
+  ASSERT_EQ(reference.size(), sorter.GetTupleCount());
+  uint32_t idx = 0;
+  for (SorterIterator iter(sorter); iter.HasNext(); iter.Next(), idx++) {
+    EXPECT_EQ(0, KeyedTuple::Compare(&reference[idx], iter.GetRow())) << "index " << idx;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeySortTest) {
+  auto exec_ctx = MakeExecCtx();
+  // Sizes around the radix sort threshold exercise both radix and comparison sorting
+  for (uint32_t num_elems : {1u, 10u, 63u, 64u, 65u, 1000u, 10000u}) {
+    TestNormalizedKeySort(exec_ctx.get(), num_elems, 0, &generator_);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeySpillSortTest) {
+  SetSortMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  TestNormalizedKeySort(exec_ctx.get(), 10000, 0, &generator_);
+  // Top-K never spills
+  TestNormalizedKeySort(exec_ctx.get(), 10000, 100, &generator_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeyTopKTest) {
+  auto exec_ctx = MakeExecCtx();
+  for (uint64_t top_k : {1, 10, 100}) {
+    TestNormalizedKeySort(exec_ctx.get(), 1000, top_k, &generator_);
+  }
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -0,0 +1,114 @@
+#include <chrono>  // NOLINT
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "execution/ast/context.h"
+#include "execution/compiled_tpl_test.h"
+#include "execution/compiler/compiler.h"
+#include "execution/compiler/compiler_settings.h"
+#include "execution/sema/error_reporter.h"
+#include "execution/util/region.h"
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "execution/vm/vm_defs.h"
+
+namespace noisepage::execution::vm::test {
+
+class TieredCompilationTest : public CompiledTplTest {
+ public:
+  TieredCompilationTest() : region_("tiered_compilation_test") {}
+
+  std::unique_ptr<Module> CompileToBytecode(const std::string &src) {
+    sema::ErrorReporter error_reporter(&region_);
+    ast::Context context(&region_, &error_reporter);
+    auto input = compiler::Compiler::Input("Tiered Compilation Test", &context, &src, compiler::CompilerSettings{});
+    return compiler::Compiler::RunCompilationSimple(input);
+  }
+
+  // Wait for background compilations to move the module up to the given tier
+  static bool WaitForTier(const Module &module, const CompilationTier tier) {
+    for (uint32_t i = 0; i < 600 && module.GetCompiledTier() < tier; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return module.GetCompiledTier() >= tier;
+  }
+
+ private:
+  util::Region region_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(TieredCompilationTest, BaselineTier) {
+  auto module = CompileToBytecode("fun add_one(x: int32) -> int32 { return x + 1 }");
+  ASSERT_NE(nullptr, module);
+
+  LLVMEngine::CompilerOptions baseline_options;
+  baseline_options.SetTier(CompilationTier::Baseline);
+  auto baseline = LLVMEngine::Compile(*module->GetBytecodeModule(), baseline_options);
+  auto optimized = LLVMEngine::Compile(*module->GetBytecodeModule(), LLVMEngine::CompilerOptions());
+
+  // Both tiers compute the same thing
+  auto *baseline_add_one = reinterpret_cast<int32_t (*)(int32_t)>(baseline->GetFunctionPointer("add_one"));
+  auto *optimized_add_one = reinterpret_cast<int32_t (*)(int32_t)>(optimized->GetFunctionPointer("add_one"));
+  ASSERT_NE(nullptr, baseline_add_one);
+  ASSERT_NE(nullptr, optimized_add_one);
+  EXPECT_EQ(42, baseline_add_one(41));
+  EXPECT_EQ(42, optimized_add_one(41));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TieredCompilationTest, AdaptiveTiersUpThroughBaseline) {
+  auto module = CompileToBytecode("fun add_one(x: int32) -> int32 { return x + 1 }");
+  ASSERT_NE(nullptr, module);
+  EXPECT_EQ(CompilationTier::Interpreted, module->GetCompiledTier());
+
+  std::function<int32_t(int32_t)> add_one;
+  ASSERT_TRUE(module->GetFunction("add_one", ExecutionMode::Adaptive, &add_one));
+
+  // The first call is interpreted and kicks off the baseline compilation
+  EXPECT_EQ(42, add_one(41));
+  ASSERT_TRUE(WaitForTier(*module, CompilationTier::Baseline));
+  EXPECT_GT(module->GetCompileTimeUs(CompilationTier::Baseline), 0);
+
+  // Enough calls make the module hot, and the optimized code takes over
+  for (uint64_t i = 0; i < Module::TIER_UP_INVOCATION_THRESHOLD; i++) {
+    EXPECT_EQ(42, add_one(41));
+  }
+  ASSERT_TRUE(WaitForTier(*module, CompilationTier::Optimized));
+  EXPECT_GT(module->GetCompileTimeUs(CompilationTier::Optimized), 0);
+  EXPECT_EQ(42, add_one(41));
+  EXPECT_EQ(CompilationTier::Optimized, module->GetExecutionTier(ExecutionMode::Adaptive));
+  EXPECT_EQ(CompilationTier::Interpreted, module->GetExecutionTier(ExecutionMode::Interpret));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TieredCompilationTest, AdaptiveSkipsBaselineForHotLoops) {
+  auto module = CompileToBytecode(R"(
+    fun sum(n: int64) -> int64 {
+      var s: int64 = 0
+      for (var i: int64 = 0; i < n; i = i + 1) {
+        s = s + i
+      }
+      return s
+    })");
+  ASSERT_NE(nullptr, module);
+
+  // Interpreting a long loop marks the module as hot
+  const int64_t n = Module::TIER_UP_LOOP_ITERATION_THRESHOLD;
+  std::function<int64_t(int64_t)> interpreted_sum;
+  ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Interpret, &interpreted_sum));
+  EXPECT_EQ(n * (n - 1) / 2, interpreted_sum(n));
+
+  // So adaptive execution goes straight to optimized code
+  std::function<int64_t(int64_t)> sum;
+  ASSERT_TRUE(module->GetFunction("sum", ExecutionMode::Adaptive, &sum));
+  EXPECT_EQ(45, sum(10));
+  ASSERT_TRUE(WaitForTier(*module, CompilationTier::Optimized));
+  EXPECT_EQ(0, module->GetCompileTimeUs(CompilationTier::Baseline));
+  EXPECT_GT(module->GetCompileTimeUs(CompilationTier::Optimized), 0);
+  EXPECT_EQ(45, sum(10));
+}
+
+}  // namespace noisepage::execution::vm::test
@@ -0,0 +1,126 @@
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "execution/tpl_test.h"
+#include "execution/vm/bytecode_iterator.h"
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+#include "execution/vm/superinstructions.h"
+
+namespace noisepage::execution::vm::test {
+
+class SuperinstructionsTest : public TplTest {
+ public:
+  // Collect the pairs of bytecodes that were fused in the given function
+  static std::vector<std::pair<Bytecode, Bytecode>> GetFusedPairs(const Module &module, const std::string &name) {
+    std::vector<std::pair<Bytecode, Bytecode>> fused;
+    const auto *func_info = module.GetFuncInfoByName(name);
+    auto iter = module.GetBytecodeModule()->GetBytecodeForFunction(*func_info);
+    for (; !iter.Done(); iter.Advance()) {
+      if (iter.IsSuperinstruction()) {
+        const auto first = iter.CurrentBytecode();
+        iter.Advance();
+        EXPECT_FALSE(iter.Done());
+        EXPECT_FALSE(iter.IsSuperinstruction());
+        fused.emplace_back(first, iter.CurrentBytecode());
+      }
+    }
+    return fused;
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(SuperinstructionsTest, LookupTest) {
+  for (uint32_t i = 0; i < Superinstructions::NumSuperinstructions(); i++) {
+    const auto superinstruction = static_cast<Superinstruction>(i);
+    const auto raw = Superinstructions::ToByte(superinstruction);
+    EXPECT_TRUE(Superinstructions::IsSuperinstruction(raw));
+    EXPECT_EQ(superinstruction, Superinstructions::FromByte(raw));
+
+    Superinstruction found;
+    EXPECT_TRUE(Superinstructions::Lookup(Superinstructions::GetFirst(superinstruction),
+                                          Superinstructions::GetSecond(superinstruction), &found));
+    EXPECT_EQ(superinstruction, found);
+  }
+
+  for (uint32_t i = 0; i < Bytecodes::NumBytecodes(); i++) {
+    EXPECT_FALSE(Superinstructions::IsSuperinstruction(i));
+  }
+
+  Superinstruction found;
+  EXPECT_FALSE(Superinstructions::Lookup(Bytecode::Return, Bytecode::Jump, &found));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SuperinstructionsTest, FuseLoopTest) {
+  auto src = R"(
+    fun sum(n: int64) -> int64 {
+      var s: int64 = 0
+      for (var i: int64 = 0; i < n; i = i + 1) {
+        if (i != 3) {
+          s = s + i
+        }
+      }
+      return s
+    })";
+
+  ModuleCompiler fused_compiler, unfused_compiler;
+  auto fused = fused_compiler.CompileToModule(src, true);
+  auto unfused = unfused_compiler.CompileToModule(src, false);
+  ASSERT_TRUE(fused != nullptr);
+  ASSERT_TRUE(unfused != nullptr);
+
+  // The loop condition, the branch in the body and the loop latch are all fused
+  const auto pairs = GetFusedPairs(*fused, "sum");
+  const std::vector<std::pair<Bytecode, Bytecode>> expected = {
+      {Bytecode::LessThan_int64_t, Bytecode::JumpIfFalse},
+      {Bytecode::NotEqual_int64_t, Bytecode::JumpIfFalse},
+      {Bytecode::Add_int64_t, Bytecode::Jump},
+  };
+  EXPECT_EQ(expected, pairs);
+  EXPECT_TRUE(GetFusedPairs(*unfused, "sum").empty());
+
+  // Fusion neither changes the layout of the bytecode nor its results
+  EXPECT_EQ(unfused->GetBytecodeModule()->GetInstructionCount(), fused->GetBytecodeModule()->GetInstructionCount());
+  EXPECT_EQ(unfused->GetBytecodeModule()->GetCodeSize(), fused->GetBytecodeModule()->GetCodeSize());
+
+  std::function<int64_t(int64_t)> fused_sum, unfused_sum;
+  ASSERT_TRUE(fused->GetFunction("sum", ExecutionMode::Interpret, &fused_sum));
+  ASSERT_TRUE(unfused->GetFunction("sum", ExecutionMode::Interpret, &unfused_sum));
+  for (int64_t n : {0, 1, 3, 4, 10, 1000}) {
+    EXPECT_EQ(unfused_sum(n), fused_sum(n));
+  }
+  EXPECT_EQ(42, fused_sum(10));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SuperinstructionsTest, BranchOnOtherValueTest) {
+  // The comparison's result is not what the branch tests, so the pair must not be fused
+  auto src = R"(
+    fun test(a: int32, b: int32, c: bool) -> int32 {
+      var x = a < b
+      if (c) {
+        return 1
+      }
+      if (x) {
+        return 2
+      }
+      return 3
+    })";
+
+  ModuleCompiler compiler;
+  auto module = compiler.CompileToModule(src);
+  ASSERT_TRUE(module != nullptr);
+  for (const auto &[first, second] : GetFusedPairs(*module, "test")) {
+    EXPECT_NE(Bytecode::LessThan_int32_t, first);
+  }
+
+  std::function<int32_t(int32_t, int32_t, bool)> test;
+  ASSERT_TRUE(module->GetFunction("test", ExecutionMode::Interpret, &test));
+  EXPECT_EQ(1, test(1, 2, true));
+  EXPECT_EQ(2, test(1, 2, false));
+  EXPECT_EQ(3, test(2, 1, false));
+}
+
+}  // namespace noisepage::execution::vm::test
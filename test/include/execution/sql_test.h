@@ -75,6 +75,24 @@ class SqlBasedTest : public TplTest {
     return catalog_->GetAccessor(common::ManagedPointer(test_txn_), test_db_oid_, DISABLED);
   }
 
+  /** Give the sorts of execution contexts made from now on the given memory budget, see Sorter. */
+  void SetSortMemoryBudget(uint64_t budget) { exec_settings_->sort_memory_budget_ = budget; }
+
+  /** Make execution contexts made from now on run their pipelines in parallel or serially. */
+  void SetParallelExecution(bool enabled) { exec_settings_->is_parallel_execution_enabled_ = enabled; }
+
+  /** Give the join hash tables of execution contexts made from now on the given memory budget, see JoinHashTable. */
+  void SetJoinMemoryBudget(uint64_t budget) { exec_settings_->join_memory_budget_ = budget; }
+
+  /** Give the aggregation hash tables of execution contexts made from now on the given memory budget. */
+  void SetAggMemoryBudget(uint64_t budget) { exec_settings_->agg_memory_budget_ = budget; }
+
+  /** Make the partitioned aggregations of execution contexts made from now on bypass pre-aggregation adaptively. */
+  void SetAggAdaptivePreAggregation(bool enabled) { exec_settings_->is_agg_adaptive_preaggregation_enabled_ = enabled; }
+
+  /** Make the join hash tables of execution contexts made from now on radix-partition parallel builds. */
+  void SetJoinRadixPartitioning(bool enabled) { exec_settings_->is_join_radix_partitioning_enabled_ = enabled; }
+
  protected:
   std::unique_ptr<catalog::CatalogAccessor> accessor_;
   catalog::db_oid_t test_db_oid_{0};
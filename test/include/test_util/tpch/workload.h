@@ -38,8 +38,12 @@ class Workload {
  public:
   enum class BenchmarkType : uint32_t { TPCH, SSB };
 
+  /**
+   * Load the tables of the benchmark and compile its queries
+   * @param sort_normalized_keys whether the queries' sorts use normalized keys
+   */
   Workload(common::ManagedPointer<DBMain> db_main, const std::string &db_name, const std::string &table_root,
-           enum BenchmarkType type);
+           enum BenchmarkType type, bool sort_normalized_keys = false);
 
   /**
    * Function to invoke for a single worker thread to invoke the TPCH queries
@@ -47,8 +51,23 @@ class Workload {
    */
   void Execute(int8_t worker_id, uint64_t execution_us_per_worker, uint64_t avg_interval_us, uint32_t query_num,
                execution::vm::ExecutionMode mode);
+
+  /**
+   * Execute a single query once, in its own transaction
+   * @param query_idx 0-indexed position of the query in the workload
+   * @param mode the execution mode to run the query in
+   */
+  void ExecuteQuery(uint32_t query_idx, execution::vm::ExecutionMode mode);
   uint32_t GetQueryNum() { return query_and_plan_.size(); }
 
+  /**
+   * @param query_idx 0-indexed position of the query in the workload
+   * @return the compiled query
+   */
+  const execution::compiler::ExecutableQuery &GetQuery(uint32_t query_idx) const {
+    return *std::get<0>(query_and_plan_[query_idx]);
+  }
+
  private:
   void GenerateTables(execution::exec::ExecutionContext *exec_ctx, const std::string &dir_name,
                       enum BenchmarkType type);
@@ -1,10 +1,12 @@
 #include <memory>
+#include <future>  // NOLINT
 #include <pqxx/pqxx>  // NOLINT
 #include <random>
 #include <string>
 #include <thread>  //NOLINT
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "main/db_main.h"
 #include "metrics/metrics_manager.h"
@@ -66,7 +68,8 @@ class MetricsTests : public TerrierTest {
   const catalog::Schema table_schema_{{{"attribute", execution::sql::SqlTypeId::Integer, false,
                                         parser::ConstantValueExpression(execution::sql::SqlTypeId::Integer)}}};
 
-  void Insert() {
+  void Insert(const transaction::callback_fn commit_callback = transaction::TransactionUtil::EmptyCallback,
+              void *const commit_callback_arg = nullptr) {
     static storage::ProjectedRowInitializer tuple_initializer =
         sql_table_->InitializerForProjectedRow({catalog::col_oid_t(0)});
     auto *const insert_txn = txn_manager_->BeginTransaction();
@@ -75,7 +78,11 @@ class MetricsTests : public TerrierTest {
     auto *const insert_tuple = insert_redo->Delta();
     *reinterpret_cast<int32_t *>(insert_tuple->AccessForceNotNull(0)) = 15721;
     sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
-    txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    txn_manager_->Commit(insert_txn, commit_callback, commit_callback_arg);
+  }
+
+  static void DurableCallback(void *const callback_arg) {
+    reinterpret_cast<std::promise<void> *>(callback_arg)->set_value();
   }
 
   static void EmptySetterCallback(common::ManagedPointer<common::ActionContext> action_context UNUSED_ATTRIBUTE) {}
@@ -111,6 +118,7 @@ TEST_F(MetricsTests, LoggingCSVTest) {
   metrics_manager_->ToOutput(DISABLED);
   EXPECT_EQ(aggregated_data->serializer_data_.size(), 0);
   EXPECT_EQ(aggregated_data->consumer_data_.size(), 0);
+  EXPECT_EQ(aggregated_data->group_commit_data_.size(), 0);
 
   Insert();
   Insert();
@@ -154,6 +162,53 @@ TEST_F(MetricsTests, LoggingCSVTest) {
                              setter_callback);
 }
 
+/**
+ *  Testing that group commit metrics account for every commit a client waited on, single thread
+ */
+// NOLINTNEXTLINE
+TEST_F(MetricsTests, LoggingGroupCommitTest) {
+  for (const auto &file : metrics::LoggingMetricRawData::FILES) unlink(std::string(file).c_str());
+  const settings::setter_callback_fn setter_callback = MetricsTests::EmptySetterCallback;
+  auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+  settings_manager_->SetBool(settings::Param::logging_metrics_enable, true, common::ManagedPointer(action_context),
+                             setter_callback);
+
+  // The log consumer only picks up that metrics are enabled after it has done some work
+  Insert();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  const uint64_t num_waited_commits = 3;
+  for (uint64_t i = 0; i < num_waited_commits; i++) {
+    std::promise<void> durable;
+    Insert(MetricsTests::DurableCallback, &durable);
+    durable.get_future().wait();
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  metrics_manager_->Aggregate();
+  const auto aggregated_data = reinterpret_cast<LoggingMetricRawData *>(
+      metrics_manager_->AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::LOGGING)).get());
+  ASSERT_NE(aggregated_data, nullptr);
+  ASSERT_FALSE(aggregated_data->group_commit_data_.empty());
+  uint64_t num_latencies = 0;
+  for (const auto &group : aggregated_data->group_commit_data_) {
+    // Commits nobody waited on are persisted in the same groups but are not in the latency histogram
+    uint64_t num_group_latencies = 0;
+    for (const auto count : group.latency_histogram_) num_group_latencies += count;
+    EXPECT_LE(num_group_latencies, group.num_commits_);
+    EXPECT_GE(group.target_group_size_, 1);
+    num_latencies += num_group_latencies;
+  }
+  EXPECT_EQ(num_latencies, num_waited_commits);
+  metrics_manager_->ToOutput(DISABLED);
+  EXPECT_EQ(aggregated_data->group_commit_data_.size(), 0);
+
+  action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
+  settings_manager_->SetBool(settings::Param::logging_metrics_enable, false, common::ManagedPointer(action_context),
+                             setter_callback);
+}
+
 /**
  *  Testing transaction metric stats collection and persistence, single thread
  */
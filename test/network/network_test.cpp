@@ -1,3 +1,7 @@
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
@@ -11,6 +15,7 @@
 #include "common/settings.h"
 #include "gtest/gtest.h"
 #include "network/connection_handle_factory.h"
+#include "network/execution_scheduler.h"
 #include "network/noisepage_server.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
 #include "storage/garbage_collector.h"
@@ -33,6 +38,30 @@ class FakeCommandFactory : public PostgresCommandFactory {
   }
 };
 
+/*
+ * Same as EmptyCommand, except that it asks to be run on an execution worker whenever an ExecutionScheduler is present.
+ */
+class OffloadedEmptyCommand : public PostgresNetworkCommand {
+ public:
+  explicit OffloadedEmptyCommand(const common::ManagedPointer<InputPacket> in)
+      : PostgresNetworkCommand(in, true, true) {}
+
+  Transition Exec(common::ManagedPointer<ProtocolInterpreter> interpreter,
+                  common::ManagedPointer<PostgresPacketWriter> out,
+                  common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                  common::ManagedPointer<ConnectionContext> connection) override {
+    out->WriteEmptyQueryResponse();
+    out->WriteReadyForQuery(NetworkTransactionStateType::IDLE);
+    return Transition::PROCEED;
+  }
+};
+
+class OffloadedCommandFactory : public PostgresCommandFactory {
+  std::unique_ptr<PostgresNetworkCommand> PacketToCommand(const common::ManagedPointer<InputPacket> packet) override {
+    return std::make_unique<OffloadedEmptyCommand>(packet);
+  }
+};
+
 /**
  * This test should be refactored to use DBMain, since there's a bunch of redundant setup here. However we don't have a
  * way to inject a new CommandFactory.
@@ -72,7 +101,8 @@ class NetworkTests : public TerrierTest {
                                     common::ManagedPointer(gc_));
 
     tcop_ = new trafficcop::TrafficCop(common::ManagedPointer(txn_manager_), common::ManagedPointer(catalog_), DISABLED,
-                                       DISABLED, DISABLED, DISABLED, 0, false, execution::vm::ExecutionMode::Interpret);
+                                       DISABLED, DISABLED, DISABLED, 0, false, false, 0,
+                                       execution::vm::ExecutionMode::Interpret);
 
     auto txn = txn_manager_->BeginTransaction();
     catalog_->CreateDatabase(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE, true);
@@ -156,6 +186,53 @@ class NetworkTests : public TerrierTest {
     ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
     io_socket->Close();
   }
+
+  /**
+   * Sends a pipelined batch of extended query messages followed by a single Sync in one write, like pgjdbc or libpq's
+   * pipeline mode do, and checks that every message in the batch gets its response. The batch and its responses span
+   * several read and write buffers.
+   */
+  void TestPipelinedExtendedQuery(uint16_t port) {
+    auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port);
+    auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+    io_socket->GetWriteQueue()->Reset();
+    std::string stmt_name = "pipelined_test";
+    std::string portal_name;
+    const uint32_t num_executes = 1000;
+
+    PostgresPacketWriter writer(io_socket->GetWriteQueue());
+    auto type_oid = static_cast<int>(PostgresValueType::INTEGER);
+    writer.WriteParseCommand(stmt_name, "INSERT INTO foo VALUES($1);", std::vector<int>(1, type_oid));
+    for (uint32_t i = 0; i < num_executes; i++) {
+      writer.WriteBindCommand(portal_name, stmt_name, {}, {}, {});
+      writer.WriteExecuteCommand(portal_name, 0);
+    }
+    writer.WriteSyncCommand();
+    EXPECT_EQ(io_socket->FlushAllWrites(), Transition::PROCEED);
+
+    // The fake commands each answer with a ReadyForQuery, which may be split across reads
+    const uint32_t num_messages = 2 * num_executes + 2;
+    uint32_t num_ready = 0;
+    size_t to_skip = 0;
+    auto in = io_socket->GetReadBuffer();
+    in->Reset();
+    while (num_ready < num_messages) {
+      Transition trans = io_socket->FillReadBuffer();
+      ASSERT_NE(trans, Transition::TERMINATE);
+      while (true) {
+        const auto skipped = std::min(to_skip, in->BytesAvailable());
+        in->Skip(skipped);
+        to_skip -= skipped;
+        if (to_skip > 0 || !in->HasMore(1 + sizeof(int32_t))) break;
+        if (in->ReadValue<NetworkMessageType>() == NetworkMessageType::PG_READY_FOR_QUERY) num_ready++;
+        to_skip = static_cast<size_t>(in->ReadValue<int32_t>()) - sizeof(int32_t);
+      }
+    }
+    EXPECT_EQ(num_ready, num_messages);
+
+    ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    io_socket->Close();
+  }
 };
 
 /**
@@ -271,6 +348,16 @@ TEST_F(NetworkTests, PgNetworkCommandsTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(NetworkTests, PipelinedExtendedQueryTest) {
+  try {
+    TestPipelinedExtendedQuery(port_);
+  } catch (const std::exception &e) {
+    NETWORK_LOG_ERROR("[PipelinedExtendedQueryTest] Exception occurred: {0}", e.what());
+    EXPECT_TRUE(false);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(NetworkTests, LargePacketsTest) {
   try {
@@ -288,6 +375,27 @@ TEST_F(NetworkTests, LargePacketsTest) {
   }
 }
 
+/**
+ * A client that sends Terminate gets its connection closed. The server flushes the empty response to Terminate before
+ * closing, which must not get stuck on a write queue with nothing in it.
+ */
+// NOLINTNEXTLINE
+TEST_F(NetworkTests, CleanDisconnectTest) {
+  // More clients than handler threads, so every handler closes at least one connection and keeps serving afterwards
+  for (size_t i = 0; i < connection_thread_count_ * 2u; i++) {
+    auto io_socket = network::ManualPacketUtil::StartConnection(port_);
+    ASSERT_NE(io_socket, nullptr);
+    ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+
+    // The server closes its end, which the client reads as end of file
+    struct pollfd poll_fd = {io_socket->GetSocketFd(), POLLIN, 0};
+    ASSERT_EQ(poll(&poll_fd, 1, 10000), 1) << "the server did not close the connection";
+    char byte;
+    EXPECT_EQ(read(io_socket->GetSocketFd(), &byte, 1), 0);
+    io_socket->Close();
+  }
+}
+
 /**
  * This is a less "parallelized" version of RacerTest that tests the network layers functionality
  * on multiple synchronous clients in two batches
@@ -312,6 +420,50 @@ TEST_F(NetworkTests, MultipleConnectionTest) {
   }
 }
 
+/**
+ * Runs clients against a second server whose commands all execute on an ExecutionScheduler. More clients than handler
+ * threads are used so that connections sharing a handler thread have commands in flight at the same time.
+ */
+// NOLINTNEXTLINE
+TEST_F(NetworkTests, ExecutionSchedulerTest) {
+  const uint16_t port = port_ + 1;
+  OffloadedCommandFactory command_factory;
+  ExecutionScheduler scheduler{common::ManagedPointer(&thread_registry_), 2};
+  PostgresProtocolInterpreter::Provider provider{common::ManagedPointer<PostgresCommandFactory>(&command_factory),
+                                                 common::ManagedPointer(&scheduler)};
+  TerrierServer server(common::ManagedPointer<ProtocolInterpreterProvider>(&provider),
+                       common::ManagedPointer(handle_factory_.get()), common::ManagedPointer(&thread_registry_), port,
+                       connection_thread_count_, socket_directory_);
+  server.RunServer();
+
+  std::vector<std::thread> clients;
+  for (uint16_t i = 0; i < connection_thread_count_ * 2; i++) {
+    clients.emplace_back([port] {
+      try {
+        pqxx::connection c(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                       port, catalog::DEFAULT_DATABASE));
+        for (uint32_t j = 0; j < 10; j++) {
+          pqxx::work txn(c);
+          pqxx::result r = txn.exec("SELECT name FROM employee where id=1;");
+          txn.commit();
+          EXPECT_EQ(r.size(), 0);
+        }
+      } catch (const std::exception &e) {
+        NETWORK_LOG_ERROR("[ExecutionSchedulerTest] Exception occurred: {0}", e.what());
+        EXPECT_TRUE(false);
+      }
+    });
+  }
+  for (auto &client : clients) client.join();
+
+  // A pipelined batch is handed to the workers as a whole
+  TestPipelinedExtendedQuery(port);
+
+  scheduler.StopWakeUps();
+  server.StopServer();
+  scheduler.WaitForFlush();
+}
+
 /**
  * This is meant to overload the network layer with multiple concurrent client threads. It was made to uncover
  * a bug where ConnectionHandlerTask had a few race conditions amongst its fields. Two threads using the same
@@ -0,0 +1,55 @@
+#include "network/postgres/statement_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "parser/postgresparser.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class StatementCacheTests : public TerrierTest {
+ protected:
+  /** @return key and statement of an auto-parameterized query */
+  static std::pair<std::string, std::unique_ptr<Statement>> ParameterizedStatement(const std::string &query_text) {
+    auto parse_result = parser::PostgresParser::BuildParseTree(query_text, true);
+    const auto key = StatementCache::ParameterizedKey(parse_result->GetNormalizedQueryText(),
+                                                      parse_result->GetParameters());
+    std::string normalized_query_text = parse_result->GetNormalizedQueryText();
+    return {key, std::make_unique<Statement>(std::move(normalized_query_text), std::move(parse_result))};
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(StatementCacheTests, ParameterizedLRUTest) {
+  StatementCache cache(2);
+
+  // Queries that only differ in their literals share an entry
+  auto [key_a, statement_a] = ParameterizedStatement("SELECT id FROM foo WHERE id = 1;");
+  const auto statement_a_ptr = common::ManagedPointer(statement_a);
+  cache.AddParameterized(key_a, std::move(statement_a));
+  EXPECT_EQ(ParameterizedStatement("SELECT id FROM foo WHERE id = 2;").first, key_a);
+  EXPECT_EQ(cache.LookupParameterized(key_a), statement_a_ptr);
+  // ... unless the literals have different types
+  EXPECT_NE(ParameterizedStatement("SELECT id FROM foo WHERE id = 'x';").first, key_a);
+
+  auto [key_b, statement_b] = ParameterizedStatement("SELECT id FROM bar WHERE id = 1;");
+  cache.AddParameterized(key_b, std::move(statement_b));
+  EXPECT_EQ(cache.NumParameterized(), 2);
+
+  // The first statement was used more recently than the second, so the second one is evicted
+  EXPECT_EQ(cache.LookupParameterized(key_a), statement_a_ptr);
+  auto [key_c, statement_c] = ParameterizedStatement("SELECT id FROM baz WHERE id = 1;");
+  cache.AddParameterized(key_c, std::move(statement_c));
+  EXPECT_EQ(cache.NumParameterized(), 2);
+  EXPECT_EQ(cache.LookupParameterized(key_a), statement_a_ptr);
+  EXPECT_EQ(cache.LookupParameterized(key_b), nullptr);
+  EXPECT_NE(cache.LookupParameterized(key_c), nullptr);
+
+  // Auto-parameterized statements are kept apart from the statements cached by query text
+  EXPECT_EQ(cache.Lookup(key_a), nullptr);
+}
+
+}  // namespace noisepage::network
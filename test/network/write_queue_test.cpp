@@ -0,0 +1,146 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "network/network_io_utils.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class WriteQueueTests : public TerrierTest {
+ protected:
+  /** Buffer num_bytes bytes of a recognizable pattern, continuing after the first num_written bytes of it. */
+  static void BufferPattern(WriteQueue *queue, size_t num_bytes, size_t num_written = 0) {
+    for (size_t i = num_written; i < num_written + num_bytes; i++) queue->BufferWriteRawValue(PatternByte(i));
+  }
+
+  static uchar PatternByte(size_t i) { return static_cast<uchar>(i % 251); }
+
+  /** Read everything available on the non-blocking fd into out. */
+  static void Drain(int fd, std::vector<uchar> *out) {
+    std::vector<uchar> buf(WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY);
+    for (ssize_t n; (n = read(fd, buf.data(), buf.size())) > 0;) out->insert(out->end(), buf.begin(), buf.begin() + n);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(WriteQueueTests, SpareBufferReuseTest) {
+  WriteQueue queue;
+  EXPECT_EQ(queue.GetNumSpareBuffers(), 0);
+
+  // Small responses only use the first buffer
+  BufferPattern(&queue, SOCKET_BUFFER_CAPACITY);
+  EXPECT_FALSE(queue.ShouldFlush());
+  queue.Reset();
+  EXPECT_EQ(queue.GetNumSpareBuffers(), 0);
+
+  // Spilling into a second and third buffer leaves both of them for the next result
+  const size_t large_result = SOCKET_BUFFER_CAPACITY + WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY + 1;
+  BufferPattern(&queue, large_result);
+  EXPECT_TRUE(queue.ShouldFlush());
+  EXPECT_EQ(queue.GetNumUnflushedBytes(), large_result);
+  queue.Reset();
+  EXPECT_EQ(queue.GetNumSpareBuffers(), 2);
+  EXPECT_EQ(queue.GetNumUnflushedBytes(), 0);
+
+  // The next result of the same size takes them back instead of allocating new ones
+  BufferPattern(&queue, large_result);
+  EXPECT_EQ(queue.GetNumSpareBuffers(), 0);
+  queue.Reset();
+  EXPECT_EQ(queue.GetNumSpareBuffers(), 2);
+
+  // Idle connections give them up
+  queue.ReleaseSpareBuffers();
+  EXPECT_EQ(queue.GetNumSpareBuffers(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(WriteQueueTests, SpareBufferCapTest) {
+  // A result twice as large as all spare buffers together only leaves behind as many as the cap allows
+  WriteQueue queue;
+  const size_t num_overflow_buffers = 2 * WRITE_QUEUE_MAX_SPARE_BUFFERS;
+  BufferPattern(&queue, SOCKET_BUFFER_CAPACITY + num_overflow_buffers * WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY);
+  queue.Reset();
+  EXPECT_EQ(queue.GetNumSpareBuffers(), WRITE_QUEUE_MAX_SPARE_BUFFERS);
+}
+
+// NOLINTNEXTLINE
+TEST_F(WriteQueueTests, ForceFlushEmptyTest) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+  // A command that writes nothing but still asks for a flush, e.g. Terminate, leaves nothing to write
+  WriteQueue queue;
+  queue.ForceFlush();
+  EXPECT_TRUE(queue.ShouldFlush());
+  EXPECT_EQ(queue.GetNumUnflushedBytes(), 0);
+  EXPECT_EQ(queue.WriteOutTo(fds[0]), 0);
+  EXPECT_EQ(queue.FlushHead(), nullptr);
+
+  // The queue is usable again afterwards
+  queue.Reset();
+  BufferPattern(&queue, SOCKET_BUFFER_CAPACITY);
+  queue.ForceFlush();
+  EXPECT_EQ(queue.WriteOutTo(fds[0]), static_cast<ssize_t>(SOCKET_BUFFER_CAPACITY));
+  EXPECT_EQ(queue.FlushHead(), nullptr);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(WriteQueueTests, StreamOutTest) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  for (int fd : fds) ASSERT_EQ(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK), 0);
+
+  // Without a socket, nothing is streamed
+  WriteQueue unstreamed;
+  BufferPattern(&unstreamed, WRITE_QUEUE_STREAM_THRESHOLD);
+  unstreamed.StreamOut();
+  EXPECT_EQ(unstreamed.GetNumUnflushedBytes(), WRITE_QUEUE_STREAM_THRESHOLD);
+
+  // Below the threshold, everything is kept until the regular flush
+  WriteQueue queue(fds[0]);
+  size_t num_buffered = WRITE_QUEUE_STREAM_THRESHOLD - 1;
+  BufferPattern(&queue, num_buffered);
+  queue.StreamOut();
+  EXPECT_EQ(queue.GetNumUnflushedBytes(), num_buffered);
+
+  // Past it, the result goes out as fast as the client reads it, and the queue only holds what the socket did not take
+  std::vector<uchar> received;
+  uint32_t num_streamed = 0;
+  for (uint32_t batch = 0; batch < 16; batch++) {
+    BufferPattern(&queue, WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY, num_buffered);
+    num_buffered += WRITE_QUEUE_OVERFLOW_BUFFER_CAPACITY;
+    const size_t num_unflushed = queue.GetNumUnflushedBytes();
+    queue.StreamOut();
+    if (num_unflushed >= WRITE_QUEUE_STREAM_THRESHOLD) {
+      EXPECT_LT(queue.GetNumUnflushedBytes(), num_unflushed);
+      num_streamed++;
+    } else {
+      EXPECT_EQ(queue.GetNumUnflushedBytes(), num_unflushed);
+    }
+    EXPECT_LE(queue.GetNumSpareBuffers(), WRITE_QUEUE_MAX_SPARE_BUFFERS);
+    Drain(fds[1], &received);
+  }
+  EXPECT_GT(num_streamed, 0);
+  EXPECT_EQ(received.size() + queue.GetNumUnflushedBytes(), num_buffered);
+
+  // The regular flush writes the rest, and the client sees every byte once and in order
+  while (queue.FlushHead() != nullptr) {
+    if (queue.WriteOutTo(fds[0]) < 0) ASSERT_EQ(errno, EAGAIN);
+    Drain(fds[1], &received);
+  }
+  queue.Reset();
+  ASSERT_EQ(received.size(), num_buffered);
+  for (size_t i = 0; i < received.size(); i++) ASSERT_EQ(received[i], PatternByte(i)) << "at byte " << i;
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // namespace noisepage::network
@@ -13,6 +13,7 @@
 #include "parser/expression/default_value_expression.h"
 #include "parser/expression/function_expression.h"
 #include "parser/expression/operator_expression.h"
+#include "parser/expression/parameter_value_expression.h"
 #include "parser/expression/type_cast_expression.h"
 #include "parser/pg_trigger.h"
 #include "parser/postgresparser.h"
@@ -1778,4 +1779,68 @@ TEST_F(ParserTestBase, OldTypeCastInExpressionTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, AutoParameterizeTest) {
+  // Compared, inserted and assigned literals become parameters, everything else stays as written
+  auto result = parser::PostgresParser::BuildParseTree(
+      "SELECT id, 1 FROM foo WHERE id = 42 AND name LIKE 'a''b%' AND score > -1.5 LIMIT 10;", true);
+  EXPECT_EQ(result->GetNormalizedQueryText(),
+            "SELECT id, 1 FROM foo WHERE id = $1 AND name LIKE $2 AND score > $3 LIMIT 10;");
+  auto &params = result->GetParameters();
+  EXPECT_EQ(params.size(), 3);
+  EXPECT_EQ(params[0].GetReturnValueType(), execution::sql::SqlTypeId::Integer);
+  EXPECT_EQ(params[0].Peek<int64_t>(), 42);
+  EXPECT_EQ(params[1].GetReturnValueType(), execution::sql::SqlTypeId::Varchar);
+  EXPECT_EQ(params[1].Peek<std::string_view>(), "a'b%");
+  EXPECT_EQ(params[2].GetReturnValueType(), execution::sql::SqlTypeId::Double);
+  EXPECT_EQ(params[2].Peek<double>(), -1.5);
+
+  auto select_stmt = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  EXPECT_EQ(select_stmt->GetSelectColumns()[1]->GetExpressionType(), ExpressionType::VALUE_CONSTANT);
+  auto id_compare = select_stmt->GetSelectCondition()->GetChild(0);
+  EXPECT_EQ(id_compare->GetExpressionType(), ExpressionType::COMPARE_EQUAL);
+  EXPECT_EQ(id_compare->GetChild(1)->GetExpressionType(), ExpressionType::VALUE_PARAMETER);
+  EXPECT_EQ(id_compare->GetChild(1).CastManagedPointerTo<ParameterValueExpression>()->GetValueIdx(), 0);
+
+  // Queries that only differ in their parameterized literals share the normalized text
+  auto result2 = parser::PostgresParser::BuildParseTree(
+      "SELECT id, 1 FROM foo WHERE id = 7 AND name LIKE 'c%' AND score > 3.25 LIMIT 10;", true);
+  EXPECT_EQ(result2->GetNormalizedQueryText(), result->GetNormalizedQueryText());
+
+  // Comparisons in a select list keep their literals, which decide the output type, but JOIN predicates don't
+  result = parser::PostgresParser::BuildParseTree(
+      "SELECT id = 1, id FROM foo JOIN bar ON foo.id = bar.id AND bar.score > 2 WHERE name = 'x';", true);
+  EXPECT_EQ(result->GetNormalizedQueryText(),
+            "SELECT id = 1, id FROM foo JOIN bar ON foo.id = bar.id AND bar.score > $1 WHERE name = $2;");
+  EXPECT_EQ(result->GetParameters().size(), 2);
+  select_stmt = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  EXPECT_EQ(select_stmt->GetSelectColumns()[0]->GetChild(1)->GetExpressionType(), ExpressionType::VALUE_CONSTANT);
+
+  // Neither do comparisons in the select list of a subquery in a predicate
+  result = parser::PostgresParser::BuildParseTree(
+      "SELECT id FROM foo WHERE id IN (SELECT id = 1 FROM bar WHERE score < 5);", true);
+  EXPECT_EQ(result->GetNormalizedQueryText(),
+            "SELECT id FROM foo WHERE id IN (SELECT id = 1 FROM bar WHERE score < $1);");
+  EXPECT_EQ(result->GetParameters().size(), 1);
+
+  result = parser::PostgresParser::BuildParseTree("INSERT INTO foo VALUES (1, 'abc', NULL);", true);
+  EXPECT_EQ(result->GetNormalizedQueryText(), "INSERT INTO foo VALUES ($1, $2, NULL);");
+  EXPECT_EQ(result->GetParameters().size(), 2);
+
+  result = parser::PostgresParser::BuildParseTree("UPDATE foo SET name = 'x' WHERE id >= 3;", true);
+  EXPECT_EQ(result->GetNormalizedQueryText(), "UPDATE foo SET name = $1 WHERE id >= $2;");
+  EXPECT_EQ(result->GetParameters().size(), 2);
+
+  // Without auto-parameterization, outside of DML, or for literals that can't be located, nothing is replaced
+  result = parser::PostgresParser::BuildParseTree("SELECT id FROM foo WHERE id = 42;");
+  EXPECT_TRUE(result->GetParameters().empty());
+  EXPECT_TRUE(result->GetNormalizedQueryText().empty());
+  result = parser::PostgresParser::BuildParseTree("EXPLAIN SELECT id FROM foo WHERE id = 42;", true);
+  EXPECT_TRUE(result->GetParameters().empty());
+  result = parser::PostgresParser::BuildParseTree("SELECT id FROM foo WHERE name = E'a\\tb';", true);
+  EXPECT_TRUE(result->GetParameters().empty());
+  auto select_stmt_2 = result->GetStatement(0).CastManagedPointerTo<SelectStatement>();
+  EXPECT_EQ(select_stmt_2->GetSelectCondition()->GetChild(1)->GetExpressionType(), ExpressionType::VALUE_CONSTANT);
+}
+
 }  // namespace noisepage::parser
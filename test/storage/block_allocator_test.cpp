@@ -0,0 +1,53 @@
+#include <unordered_set>
+#include <vector>
+
+#include "storage/storage_defs.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+class BlockAllocatorTests : public TerrierTest {
+ protected:
+  // Gets more blocks than fit into an arena, checks that they are aligned and usable, and releases them again
+  static void GetAndRelease(BlockStore *const block_store, const uint32_t num_blocks,
+                            std::unordered_set<RawBlock *> *const blocks) {
+    std::vector<RawBlock *> got;
+    for (uint32_t i = 0; i < num_blocks; i++) {
+      RawBlock *const block = block_store->Get();
+      EXPECT_EQ(0, reinterpret_cast<uintptr_t>(block) % common::Constants::BLOCK_SIZE);
+      EXPECT_EQ(0, block->insert_head_.load());
+      block->content_[sizeof(block->content_) - 1] = static_cast<byte>(i);
+      got.push_back(block);
+      blocks->insert(block);
+    }
+    for (auto *const block : got) block_store->Release(block);
+  }
+};
+
+// Heap allocated blocks behave like they always did, with and without a NUMA policy
+// NOLINTNEXTLINE
+TEST_F(BlockAllocatorTests, HeapTest) {
+  for (const auto policy : {BlockNumaPolicy::FIRST_TOUCH, BlockNumaPolicy::INTERLEAVE, BlockNumaPolicy::PINNED}) {
+    BlockStore block_store(10, 2, BlockAllocator(BlockAllocationMode::HEAP, policy));
+    std::unordered_set<RawBlock *> blocks;
+    GetAndRelease(&block_store, 10, &blocks);
+    EXPECT_EQ(10, blocks.size());
+  }
+}
+
+// Blocks on huge pages are reused once freed, even beyond the reuse limit of the BlockStore
+// NOLINTNEXTLINE
+TEST_F(BlockAllocatorTests, HugePagesTest) {
+  const uint32_t num_blocks = BlockAllocator::BLOCKS_PER_ARENA + 1;
+  for (const auto policy : {BlockNumaPolicy::FIRST_TOUCH, BlockNumaPolicy::INTERLEAVE}) {
+    BlockStore block_store(num_blocks, 1, BlockAllocator(BlockAllocationMode::HUGE_PAGES, policy));
+    std::unordered_set<RawBlock *> blocks;
+    GetAndRelease(&block_store, num_blocks, &blocks);
+    EXPECT_EQ(num_blocks, blocks.size());
+    // The same blocks are handed out again, initialized like new ones
+    GetAndRelease(&block_store, num_blocks, &blocks);
+    EXPECT_EQ(num_blocks, blocks.size());
+  }
+}
+
+}  // namespace noisepage::storage
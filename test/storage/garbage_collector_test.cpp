@@ -699,4 +699,142 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Updates of many txns that share version chains, collected with the work spread over several GC workers
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ParallelWorkers) {
+  const uint32_t num_tuples = 100;
+  const uint32_t num_updates = 10;
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).SetGCNumWorkers(4).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    std::vector<storage::TupleSlot> slots;
+    std::vector<storage::ProjectedRow *> inserted, latest;
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+      slots.push_back(tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple));
+      inserted.push_back(insert_tuple);
+      latest.push_back(insert_tuple);
+    }
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+    EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+
+    // Keeps every version alive until all of the updates are in
+    auto *reader = txn_manager->BeginTransaction();
+    // The insert was unlinked before the reader began, so it can be deallocated regardless
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+
+    for (uint32_t update_id = 0; update_id < num_updates; update_id++) {
+      auto *txn = txn_manager->BeginTransaction();
+      for (uint32_t i = 0; i < num_tuples; i++) {
+        storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+        EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slots[i], *update));
+        latest[i] = tested.GenerateVersionFromUpdate(*update, *latest[i]);
+      }
+      txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      // Nothing can be unlinked or deallocated while the reader is running
+      EXPECT_EQ(std::make_pair(0U, 0U), gc->PerformGarbageCollection());
+    }
+
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(reader, slots[i]);
+      EXPECT_TRUE(tested.select_result_);
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, inserted[i]));
+    }
+    txn_manager->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Unlink all of the updates and the reader, then deallocate the updates
+    EXPECT_EQ(std::make_pair(0U, num_updates + 1), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(num_updates, 0U), gc->PerformGarbageCollection());
+
+    auto *txn1 = txn_manager->BeginTransaction();
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn1, slots[i]);
+      EXPECT_TRUE(tested.select_result_);
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, latest[i]));
+    }
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+    EXPECT_EQ(std::make_pair(0U, 1U), gc->PerformGarbageCollection());
+  }
+}
+
+// Txns prune the version chains they traverse, but never cut off versions that are still visible to a running txn
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, CooperativePruning) {
+  const uint32_t num_updates = 5;
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple);
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *old_reader = txn_manager->BeginTransaction();
+    storage::ProjectedRow *latest = insert_tuple;
+    for (uint32_t update_id = 0; update_id < num_updates; update_id++) {
+      auto *txn = txn_manager->BeginTransaction();
+      // Lets txns that begin from now on prune up to the old reader
+      timestamp_manager->OldestTransactionStartTime();
+      auto *new_reader = txn_manager->BeginTransaction();
+
+      storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+      EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *update));
+      storage::ProjectedRow *previous = latest;
+      latest = tested.GenerateVersionFromUpdate(*update, *latest);
+      txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+      // The new reader walks past the update, and unlinks what is older than the old reader on the way
+      storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(new_reader, slot);
+      EXPECT_TRUE(tested.select_result_);
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, previous));
+      txn_manager->Commit(new_reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+      select_tuple = tested.SelectIntoBuffer(old_reader, slot);
+      EXPECT_TRUE(tested.select_result_);
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+    }
+    txn_manager->Commit(old_reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // With the old reader gone, the next txns can prune everything but the latest version
+    timestamp_manager->OldestTransactionStartTime();
+    auto *txn1 = txn_manager->BeginTransaction();
+    storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), slot, *update));
+    storage::ProjectedRow *previous = latest;
+    latest = tested.GenerateVersionFromUpdate(*update, *latest);
+
+    auto *txn2 = txn_manager->BeginTransaction();
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn2, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, previous));
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+    select_tuple = tested.SelectIntoBuffer(txn2, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, previous));
+    txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn3 = txn_manager->BeginTransaction();
+    select_tuple = tested.SelectIntoBuffer(txn3, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, latest));
+    txn_manager->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The GC still unlinks and deallocates all of the txns, no matter how much of their versions was pruned already
+    EXPECT_EQ(std::make_pair(0U, num_updates * 2 + 5), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(num_updates + 2, 0U), gc->PerformGarbageCollection());
+  }
+}
 }  // namespace noisepage
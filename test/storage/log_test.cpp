@@ -1,6 +1,11 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
 #include <future>  // NOLINT
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
@@ -11,6 +16,8 @@
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/async_log_file.h"
+#include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_manager.h"
 #include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
@@ -448,4 +455,228 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
   // DeferredAction
   db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
 }
+
+// Verify that buffers written as compressed, checksummed blocks read back as they were written, and that the log ends
+// at a block that was torn by a crash.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, BlockFormatTest) {
+  // Shut down log manager so that the test has the log file to itself
+  log_manager_->PersistAndStop();
+  unlink(LOG_TEST_LOG_FILE_NAME);
+
+  // Every other buffer compresses well
+  const uint32_t num_buffers = 10;
+  std::vector<uint64_t> values;
+  uint64_t bytes_written = 0;
+  BufferedLogWriter out(LOG_TEST_LOG_FILE_NAME, LogBlockFormat::COMPRESSED);
+  EXPECT_EQ(LogBlockFormat::COMPRESSED, out.GetFormat());
+  for (uint32_t buffer = 0; buffer < num_buffers; buffer++) {
+    while (!out.IsBufferFull()) {
+      const uint64_t value = buffer % 2 == 0 ? buffer : generator_();
+      values.push_back(value);
+      out.BufferWrite(&value, sizeof(uint64_t));
+    }
+    bytes_written += out.FlushBuffer();
+  }
+  out.Persist();
+  out.Close();
+  EXPECT_LT(bytes_written, num_buffers * common::Constants::LOG_BUFFER_SIZE);
+
+  // A writer that appends to the log keeps writing blocks
+  BufferedLogWriter appender(LOG_TEST_LOG_FILE_NAME);
+  EXPECT_EQ(LogBlockFormat::CHECKSUMMED, appender.GetFormat());
+  EXPECT_TRUE(BufferedLogWriter::IsBlockFormatted(LOG_TEST_LOG_FILE_NAME));
+
+  // Tear the last block by leaving out the end of it
+  const uint64_t torn_value = 0;
+  appender.BufferWrite(&torn_value, sizeof(uint64_t));
+  const auto block_size = appender.FlushBuffer();
+  appender.Close();
+  struct stat log_stat;
+  ASSERT_EQ(0, stat(LOG_TEST_LOG_FILE_NAME, &log_stat));
+  ASSERT_EQ(0, truncate(LOG_TEST_LOG_FILE_NAME, log_stat.st_size - static_cast<off_t>(block_size / 2)));
+
+  BufferedLogReader in(LOG_TEST_LOG_FILE_NAME);
+  for (const auto value : values) {
+    EXPECT_TRUE(in.HasMore());
+    EXPECT_EQ(value, in.ReadValue<uint64_t>());
+  }
+  EXPECT_FALSE(in.HasMore());
+}
+
+// Verify that the disk log consumer persists a commit group right away under light load, and holds it open for more
+// commits, but no longer than a persist takes, under heavy load.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, GroupCommitDecisionTest) {
+  log_manager_->PersistAndStop();
+
+  const std::chrono::microseconds persist_interval(10000);
+  DiskLogConsumerTask task(persist_interval, common::Constants::LOG_BUFFER_SIZE, nullptr, nullptr, nullptr);
+  auto now = std::chrono::high_resolution_clock::now();
+  task.last_arrival_sample_ = now;
+  // Persists take about a millisecond
+  for (uint32_t i = 0; i < 50; i++) task.RecordPersistLatency(1000);
+  EXPECT_GT(task.MaxGroupWait().count(), 0);
+  EXPECT_LE(task.MaxGroupWait(), persist_interval);
+
+  // Light load: one commit every 100ms, so no other commit would join the group while it is persisted
+  for (uint32_t i = 0; i < 50; i++) {
+    now += std::chrono::milliseconds(100);
+    task.SampleCommitArrivals(1, now);
+  }
+  EXPECT_EQ(task.TargetGroupSize(), 1.0);
+  task.num_waiting_commits_ = 1;
+  task.oldest_waiting_commit_ = now;
+  EXPECT_EQ(task.RemainingGroupWait(now).count(), 0);
+
+  // Heavy load: one commit every microsecond, so hundreds of commits would arrive during a single persist
+  for (uint32_t i = 0; i < 50; i++) {
+    now += std::chrono::microseconds(10);
+    task.SampleCommitArrivals(10, now);
+  }
+  EXPECT_GT(task.TargetGroupSize(), 100.0);
+  task.num_waiting_commits_ = 10;
+  task.oldest_waiting_commit_ = now;
+  EXPECT_EQ(task.RemainingGroupWait(now), task.MaxGroupWait());
+  // The group keeps waiting for the rest of the longest wait
+  const auto half_wait = task.MaxGroupWait() / 2;
+  EXPECT_GT(task.RemainingGroupWait(now + half_wait).count(), 0);
+  EXPECT_LT(task.RemainingGroupWait(now + half_wait), task.MaxGroupWait());
+  // ... until its oldest commit has waited long enough
+  EXPECT_EQ(task.RemainingGroupWait(now + task.MaxGroupWait()).count(), 0);
+  // ... or enough commits joined it
+  task.num_waiting_commits_ = static_cast<uint64_t>(std::ceil(task.TargetGroupSize()));
+  EXPECT_EQ(task.RemainingGroupWait(now).count(), 0);
+
+  // Once the load drops again, groups are persisted right away again
+  for (uint32_t i = 0; i < 50; i++) {
+    now += std::chrono::milliseconds(100);
+    task.SampleCommitArrivals(1, now);
+  }
+  EXPECT_EQ(task.TargetGroupSize(), 1.0);
+  task.num_waiting_commits_ = 1;
+  task.oldest_waiting_commit_ = now;
+  EXPECT_EQ(task.RemainingGroupWait(now).count(), 0);
+}
+
+// Verify that buffers written through io_uring, with several writes in flight at once and writes issued while a persist
+// is in flight, read back in the order they were issued.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, AsyncLogFileTest) {
+  // Shut down log manager so that the test has the log file to itself
+  log_manager_->PersistAndStop();
+  unlink(LOG_TEST_LOG_FILE_NAME);
+
+  const uint32_t num_writers = 4;
+  const uint32_t num_buffers = 40;
+  std::vector<BufferedLogWriter> writers;
+  writers.reserve(num_writers);
+  for (uint32_t i = 0; i < num_writers; i++) writers.emplace_back(LOG_TEST_LOG_FILE_NAME);
+  auto log_file = AsyncLogFile::Open(LOG_TEST_LOG_FILE_NAME, num_writers);
+  if (log_file == nullptr) {
+    // IoUringLogManagerTest covers the log manager falling back to blocking writes
+    for (auto &writer : writers) writer.Close();
+    GTEST_SKIP() << "io_uring is not available";
+  }
+
+  std::vector<BufferedLogWriter *> free_writers;
+  for (auto &writer : writers) free_writers.push_back(&writer);
+  std::vector<void *> completed_writes;
+  uint64_t next_value = 0;
+  for (uint32_t buffer = 0; buffer < num_buffers; buffer++) {
+    while (free_writers.empty()) {
+      log_file->ReapCompletions(&completed_writes, false);
+      for (void *const tag : completed_writes) free_writers.push_back(static_cast<BufferedLogWriter *>(tag));
+      completed_writes.clear();
+      std::this_thread::yield();
+    }
+    BufferedLogWriter *const writer = free_writers.back();
+    free_writers.pop_back();
+    while (!writer->IsBufferFull()) {
+      writer->BufferWrite(&next_value, sizeof(uint64_t));
+      next_value++;
+    }
+    EXPECT_EQ(uint64_t{common::Constants::LOG_BUFFER_SIZE}, writer->FlushBuffer(log_file.get()));
+    // Keep writing while a persist is in flight
+    if (buffer % 8 == 7 && !log_file->PersistInFlight()) log_file->StartPersist();
+  }
+  if (log_file->PersistInFlight()) log_file->ReapCompletions(&completed_writes, true);
+  log_file->StartPersist();
+  EXPECT_TRUE(log_file->ReapCompletions(&completed_writes, true));
+  EXPECT_FALSE(log_file->IoInFlight());
+  log_file.reset();
+  for (auto &writer : writers) writer.Close();
+
+  BufferedLogReader in(LOG_TEST_LOG_FILE_NAME);
+  for (uint64_t value = 0; value < next_value; value++) {
+    EXPECT_TRUE(in.HasMore());
+    EXPECT_EQ(value, in.ReadValue<uint64_t>());
+  }
+  // Nothing was written past the last buffer
+  uint64_t past_end;
+  EXPECT_FALSE(in.Read(&past_end, sizeof(uint64_t)));
+}
+
+// Verify that a log manager asked to write through io_uring acknowledges a commit only once it is durable, and logs
+// every commit, both when io_uring is available and when it falls back to blocking writes.
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, IoUringLogManagerTest) {
+  db_main_.reset();
+  unlink(LOG_TEST_LOG_FILE_NAME);
+  db_main_ = noisepage::DBMain::Builder()
+                 .SetWalFilePath(LOG_TEST_LOG_FILE_NAME)
+                 .SetUseLogging(true)
+                 .SetUseGC(true)
+                 .SetWalIoUring(true)
+                 .Build();
+  txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+  log_manager_ = db_main_->GetLogManager();
+  store_ = db_main_->GetStorageLayer()->GetBlockStore();
+
+  // Create SQLTable
+  auto col = catalog::Schema::Column("attribute", execution::sql::SqlTypeId::Integer, false,
+                                     parser::ConstantValueExpression(execution::sql::SqlTypeId::Integer));
+  StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(0));
+  auto table_schema = catalog::Schema(std::vector<catalog::Schema::Column>({col}));
+  auto *const sql_table = new storage::SqlTable(store_, table_schema);
+  auto tuple_initializer = sql_table->InitializerForProjectedRow({catalog::col_oid_t(0)});
+
+  // Commit transactions one at a time, each waiting until its commit is durable
+  const int32_t num_txns = 100;
+  std::unordered_map<transaction::timestamp_t, bool> committed;
+  for (int32_t i = 0; i < num_txns; i++) {
+    auto *const txn = txn_manager_->BeginTransaction();
+    auto *const insert_redo =
+        txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = i;
+    sql_table->Insert(common::ManagedPointer(txn), insert_redo);
+    committed[txn->StartTime()] = false;
+    std::promise<bool> promise;
+    auto future = promise.get_future();
+    txn_manager_->Commit(txn, TestCommitCallback, &promise);
+    EXPECT_TRUE(future.get());
+  }
+
+  // Shut down log manager
+  log_manager_->PersistAndStop();
+
+  // Every commit made it to the log exactly once
+  storage::BufferedLogReader in(LOG_TEST_LOG_FILE_NAME);
+  while (in.HasMore()) {
+    storage::LogRecord *log_record = ReadNextRecord(&in);
+    if (log_record->RecordType() == LogRecordType::COMMIT) {
+      auto it = committed.find(log_record->TxnBegin());
+      if (it != committed.end()) {
+        EXPECT_FALSE(it->second);
+        it->second = true;
+      }
+    }
+    delete[] reinterpret_cast<byte *>(log_record);
+  }
+  for (const auto &entry : committed) EXPECT_TRUE(entry.second);
+
+  // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
+  // DeferredAction
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
+}
 }  // namespace noisepage::storage
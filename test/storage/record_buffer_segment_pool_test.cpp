@@ -0,0 +1,98 @@
+#include <thread>  // NOLINT
+#include <unordered_set>
+#include <vector>
+
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+class RecordBufferSegmentPoolTests : public TerrierTest {};
+
+// Segments released by a thread are handed out to it again
+// NOLINTNEXTLINE
+TEST_F(RecordBufferSegmentPoolTests, SimpleReuseTest) {
+  RecordBufferSegmentPool pool(10, 10);
+  RecordBufferSegment *const segment = pool.Get();
+  segment->Reserve(8);
+  pool.Release(segment);
+  for (uint32_t i = 0; i < 10; i++) {
+    RecordBufferSegment *const reused = pool.Get();
+    EXPECT_EQ(segment, reused);
+    EXPECT_TRUE(reused->HasBytesLeft(common::Constants::BUFFER_SEGMENT_SIZE));
+    pool.Release(reused);
+  }
+}
+
+// Segments released on another thread are reused once the size limit is reached, wherever they are cached
+// NOLINTNEXTLINE
+TEST_F(RecordBufferSegmentPoolTests, ReuseAcrossThreadsTest) {
+  const uint32_t size_limit = 3 * RecordBufferSegmentPool::BATCH_SIZE;
+  RecordBufferSegmentPool pool(size_limit, size_limit);
+  std::unordered_set<RecordBufferSegment *> segments;
+  for (uint32_t i = 0; i < size_limit; i++) segments.insert(pool.Get());
+  EXPECT_EQ(size_limit, segments.size());
+  EXPECT_THROW(pool.Get(), common::NoMoreObjectException);
+
+  std::thread releaser([&] {
+    for (auto *const segment : segments) pool.Release(segment);
+  });
+  releaser.join();
+
+  std::unordered_set<RecordBufferSegment *> reused;
+  for (uint32_t i = 0; i < size_limit; i++) reused.insert(pool.Get());
+  EXPECT_EQ(segments, reused);
+  EXPECT_THROW(pool.Get(), common::NoMoreObjectException);
+  for (auto *const segment : reused) pool.Release(segment);
+}
+
+// Lowering the limits frees the segments kept for reuse beyond them
+// NOLINTNEXTLINE
+TEST_F(RecordBufferSegmentPoolTests, ResetLimitTest) {
+  const uint32_t size_limit = 4 * RecordBufferSegmentPool::BATCH_SIZE;
+  RecordBufferSegmentPool pool(size_limit, size_limit);
+  std::vector<RecordBufferSegment *> segments;
+  for (uint32_t i = 0; i < size_limit; i++) segments.push_back(pool.Get());
+  EXPECT_FALSE(pool.SetSizeLimit(size_limit / 2));
+  for (auto *const segment : segments) pool.Release(segment);
+
+  pool.SetReuseLimit(size_limit / 2);
+  EXPECT_TRUE(pool.SetSizeLimit(size_limit / 2));
+  EXPECT_EQ(size_limit / 2, pool.GetSizeLimit());
+  segments.clear();
+  for (uint32_t i = 0; i < size_limit / 2; i++) segments.push_back(pool.Get());
+  EXPECT_THROW(pool.Get(), common::NoMoreObjectException);
+  for (auto *const segment : segments) pool.Release(segment);
+}
+
+// Many threads getting and releasing segments never get the same segment at the same time, or more than the limit
+// NOLINTNEXTLINE
+TEST_F(RecordBufferSegmentPoolTests, ConcurrentGetReleaseTest) {
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency() + 4;
+  const uint32_t segments_per_thread = 2 * RecordBufferSegmentPool::BATCH_SIZE + 1;
+  RecordBufferSegmentPool pool(num_threads * segments_per_thread, num_threads * RecordBufferSegmentPool::BATCH_SIZE);
+  auto workload = [&](const uint32_t thread_id) {
+    for (uint32_t iteration = 0; iteration < 100; iteration++) {
+      std::vector<RecordBufferSegment *> segments;
+      std::vector<uint32_t *> owners;
+      for (uint32_t i = 0; i < segments_per_thread; i++) {
+        RecordBufferSegment *const segment = pool.Get();
+        EXPECT_TRUE(segment->HasBytesLeft(common::Constants::BUFFER_SEGMENT_SIZE));
+        owners.push_back(reinterpret_cast<uint32_t *>(segment->Reserve(sizeof(uint32_t))));
+        *owners.back() = thread_id;
+        segments.push_back(segment);
+      }
+      // No other thread got any of the segments in the meantime
+      for (uint32_t i = 0; i < segments_per_thread; i++) {
+        EXPECT_EQ(thread_id, *owners[i]);
+        pool.Release(segments[i]);
+      }
+    }
+  };
+  common::WorkerPool thread_pool(num_threads, {});
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+}
+
+}  // namespace noisepage::storage
@@ -1,14 +1,20 @@
+#include <sys/stat.h>
+
+#include <chrono>  // NOLINT
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
 #include "catalog/catalog.h"
 #include "catalog/postgres/pg_namespace.h"
+#include "common/posix_io_wrappers.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/index_builder.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/disk_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
@@ -24,6 +30,7 @@
 // executions will read old test's data, and the cause of the errors will be hard to identify. Trust me it will drive
 // you nuts...
 #define RECOVERY_TEST_LOG_FILE_NAME "./test_recovery_test.log"
+#define RECOVERY_TEST_CHECKPOINT_DIR "./test_recovery_test_checkpoints"
 
 namespace noisepage::storage {
 class RecoveryTests : public TerrierTest {
@@ -78,6 +85,13 @@ class RecoveryTests : public TerrierTest {
   void TearDown() override {
     // Delete log file
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    // Delete checkpoints, if a test took any
+    CheckpointManager checkpoint_manager(RECOVERY_TEST_CHECKPOINT_DIR, catalog_, txn_manager_);
+    const auto checkpoint_ts = checkpoint_manager.GetLatestCheckpoint();
+    if (checkpoint_ts != transaction::INVALID_TXN_TIMESTAMP) {
+      unlink(checkpoint_manager.GetCheckpointFilePath(checkpoint_ts).c_str());
+      rmdir(RECOVERY_TEST_CHECKPOINT_DIR);
+    }
   }
 
   catalog::IndexSchema DummyIndexSchema() {
@@ -185,7 +199,7 @@ class RecoveryTests : public TerrierTest {
     recovery_manager.WaitForRecoveryToFinish();
   }
 
-  void RunTest(const LargeSqlTableTestConfiguration &config) {
+  void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t replay_threads = 1) {
     // Run workload
     auto *tested =
         new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
@@ -201,10 +215,19 @@ class RecoveryTests : public TerrierTest {
                                      recovery_deferred_action_manager_,
                                      DISABLED,
                                      recovery_thread_registry_,
-                                     recovery_block_store_};
+                                     recovery_block_store_,
+                                     replay_threads};
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
 
+    CheckRecoveredTables(tested, recovery_manager);
+    // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
+    // DeferredAction
+    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+  }
+
+  // Checks that the recovery manager recovered all the tables of the workload
+  void CheckRecoveredTables(LargeSqlTableTestObject *tested, const RecoveryManager &recovery_manager) {
     // Check we recovered all the original tables
     for (auto &database : tested->GetTables()) {
       auto database_oid = database.first;
@@ -229,9 +252,6 @@ class RecoveryTests : public TerrierTest {
         recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
       }
     }
-    // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
-    // DeferredAction
-    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
   }
 };
 
@@ -269,6 +289,176 @@ TEST_F(RecoveryTests, HighAbortRateTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test takes a checkpoint while a workload is running, and truncates the log with it once the workload is done.
+// Recovering from the truncated log, which only holds the checkpoint and the transactions that committed after it,
+// should recover the same tables as recovering from the whole log.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+
+  // Take the checkpoint concurrently with more of the workload
+  CheckpointManager checkpoint_manager(RECOVERY_TEST_CHECKPOINT_DIR, catalog_, txn_manager_);
+  std::thread workload([&] { tested->SimulateOltp(100, 4); });
+  const auto checkpoint_ts = checkpoint_manager.TakeCheckpoint();
+  workload.join();
+  EXPECT_EQ(checkpoint_ts, checkpoint_manager.GetLatestCheckpoint());
+
+  // Simulate the system shutting down, and truncate the log before booting up again
+  db_main_->GetGarbageCollectorThread()->StopGC();
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->FullyPerformGC(
+      db_main_->GetStorageLayer()->GetGarbageCollector(), log_manager_);
+  log_manager_->PersistAndStop();
+  struct stat log_stat;
+  stat(RECOVERY_TEST_LOG_FILE_NAME, &log_stat);
+  const auto full_log_size = log_stat.st_size;
+  EXPECT_TRUE(checkpoint_manager.TruncateLog(RECOVERY_TEST_LOG_FILE_NAME));
+  stat(RECOVERY_TEST_LOG_FILE_NAME, &log_stat);
+  EXPECT_LT(log_stat.st_size, full_log_size);
+  log_manager_->Start();
+  db_main_->GetGarbageCollectorThread()->StartGC();
+
+  DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  CheckRecoveredTables(tested, recovery_manager);
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test gives a checkpoint, which runs concurrently with a workload, less time than it needs. The checkpoint should
+// be abandoned without leaving a file behind, while an unbounded checkpoint afterwards should only remove the older
+// checkpoint files in the directory.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointMaxDurationTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(10000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+
+  CheckpointManager checkpoint_manager(RECOVERY_TEST_CHECKPOINT_DIR, catalog_, txn_manager_);
+  std::thread workload([&] { tested->SimulateOltp(100, 4); });
+  EXPECT_EQ(transaction::INVALID_TXN_TIMESTAMP, checkpoint_manager.TakeCheckpoint(std::chrono::milliseconds(1)));
+  workload.join();
+  EXPECT_EQ(transaction::INVALID_TXN_TIMESTAMP, checkpoint_manager.GetLatestCheckpoint());
+
+  // An older checkpoint is superseded, files that are not named like a checkpoint are not
+  const std::string older_checkpoint = checkpoint_manager.GetCheckpointFilePath(transaction::timestamp_t(1));
+  const std::string unrelated_file = std::string(RECOVERY_TEST_CHECKPOINT_DIR) + "/checkpoint_notes.txt";
+  for (const auto &path : {older_checkpoint, unrelated_file}) {
+    const int fd = PosixIoWrappers::Open(path.c_str(), O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
+    PosixIoWrappers::Close(fd);
+  }
+  const auto checkpoint_ts = checkpoint_manager.TakeCheckpoint();
+  EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP, checkpoint_ts);
+  EXPECT_EQ(checkpoint_ts, checkpoint_manager.GetLatestCheckpoint());
+  struct stat file_stat;
+  EXPECT_NE(0, stat(older_checkpoint.c_str(), &file_stat));
+  EXPECT_EQ(0, stat(unrelated_file.c_str(), &file_stat));
+  unlink(unrelated_file.c_str());
+
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test enables checkpoints in DBMain and takes checkpoints through it, one of them while a workload is running.
+// The running log should be truncated to each checkpoint, stay recoverable, and not grow when DBMain is restarted.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTruncationTest) {
+  const std::string log_file = "./test_recovery_test_truncation.log";
+  unlink(log_file.c_str());
+  const auto build = [&] {
+    return DBMain::Builder()
+        .SetWalFilePath(log_file)
+        .SetUseLogging(true)
+        .SetUseGC(true)
+        .SetUseGCThread(true)
+        .SetUseCatalog(true)
+        .SetUseCheckpoints(true)
+        .SetCheckpointDirectory(RECOVERY_TEST_CHECKPOINT_DIR)
+        .SetCheckpointInterval(3600)
+        .Build();
+  };
+  const auto log_size = [&] {
+    struct stat log_stat;
+    stat(log_file.c_str(), &log_stat);
+    return log_stat.st_size;
+  };
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+
+  auto db_main = build();
+  ASSERT_TRUE(db_main->GetCheckpointThread());
+  auto *tested = new LargeSqlTableTestObject(config, db_main->GetTransactionLayer()->GetTransactionManager().Get(),
+                                             db_main->GetCatalogLayer()->GetCatalog().Get(),
+                                             db_main->GetStorageLayer()->GetBlockStore().Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+
+  // Nothing is running, so the log is truncated as soon as the checkpoint is taken
+  db_main->GetLogManager()->ForceFlush();
+  const auto full_log_size = log_size();
+  EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP, db_main->GetCheckpointManager()->TakeCheckpoint());
+  EXPECT_LT(log_size(), full_log_size);
+
+  // Take another checkpoint concurrently with more of the workload, which keeps appending to the truncated log
+  std::thread workload([&] { tested->SimulateOltp(100, 4); });
+  EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP, db_main->GetCheckpointManager()->TakeCheckpoint());
+  workload.join();
+  tested->SimulateOltp(100, 4);
+  db_main->GetLogManager()->ForceFlush();
+
+  DiskLogProvider log_provider{log_file};
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+  CheckRecoveredTables(tested, recovery_manager);
+  db_main->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+  db_main.reset();
+
+  // The log already starts from the latest checkpoint, so truncating it again at startup does not grow it
+  const auto shutdown_log_size = log_size();
+  db_main = build();
+  db_main.reset();
+  EXPECT_LE(log_size(), shutdown_log_size);
+  unlink(log_file.c_str());
+}
+
 // This test inserts some tuples into multiple tables across multiple databases. It then recovers these tables, and
 // verifies that the recovered tables are equal to the test tables.
 // NOLINTNEXTLINE
@@ -285,6 +475,22 @@ TEST_F(RecoveryTests, MultiDatabaseTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test runs the multi-database workload but replays the log with multiple threads. Transactions on different
+// tables are replayed concurrently, and the recovered tables should still be equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(3)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.6, 0.0, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 4);
+}
+
 // Tests that we correctly process records corresponding to a drop database command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropDatabaseTest) {
@@ -20,7 +20,7 @@
 namespace noisepage::tpch {
 
 Workload::Workload(common::ManagedPointer<DBMain> db_main, const std::string &db_name, const std::string &table_root,
-                   enum BenchmarkType type) {
+                   enum BenchmarkType type, bool sort_normalized_keys) {
   // cache db main and members
   db_main_ = db_main;
   txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
@@ -39,6 +39,7 @@ Workload::Workload(common::ManagedPointer<DBMain> db_main, const std::string &db
   // Enable counters and disable the parallel execution for this workload
   exec_settings_.is_parallel_execution_enabled_ = false;
   exec_settings_.is_counters_enabled_ = true;
+  exec_settings_.is_sort_normalized_keys_enabled_ = sort_normalized_keys;
 
   // Make the execution context
   auto exec_ctx =
@@ -139,25 +140,10 @@ void Workload::Execute(int8_t worker_id, uint64_t execution_us_per_worker, uint6
   uint64_t end_time = metrics::MetricsUtil::Now() + execution_us_per_worker;
   while (metrics::MetricsUtil::Now() < end_time) {
     // Executing all the queries on by one in round robin
-    auto txn = txn_manager_->BeginTransaction();
-    auto accessor =
-        catalog_->GetAccessor(common::ManagedPointer<transaction::TransactionContext>(txn), db_oid_, DISABLED);
-
-    auto output_schema = std::get<1>(query_and_plan_[index[counter]])->GetOutputSchema().Get();
-    // Uncomment this line and change output.cpp:90 to EXECUTION_LOG_INFO to print output
-    // execution::exec::OutputPrinter printer(output_schema);
-    execution::exec::NoOpResultConsumer printer;
-    auto exec_ctx = execution::exec::ExecutionContext(
-        db_oid_, common::ManagedPointer<transaction::TransactionContext>(txn), printer, output_schema,
-        common::ManagedPointer<catalog::CatalogAccessor>(accessor), exec_settings_, db_main_->GetMetricsManager(),
-        DISABLED, DISABLED);
-
-    std::get<0>(query_and_plan_[index[counter]])
-        ->Run(common::ManagedPointer<execution::exec::ExecutionContext>(&exec_ctx), mode);
+    ExecuteQuery(index[counter], mode);
 
     // Only execute up to query_num number of queries for this thread in round-robin
     counter = counter == query_num - 1 ? 0 : counter + 1;
-    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 
     // Sleep to create different execution frequency patterns
     auto random_sleep_time = distribution(generator);
@@ -168,4 +154,24 @@ void Workload::Execute(int8_t worker_id, uint64_t execution_us_per_worker, uint6
   db_main_->GetMetricsManager()->UnregisterThread();
 }
 
+void Workload::ExecuteQuery(uint32_t query_idx, execution::vm::ExecutionMode mode) {
+  auto txn = txn_manager_->BeginTransaction();
+  auto accessor =
+      catalog_->GetAccessor(common::ManagedPointer<transaction::TransactionContext>(txn), db_oid_, DISABLED);
+
+  auto output_schema = std::get<1>(query_and_plan_[query_idx])->GetOutputSchema().Get();
+  // Uncomment this line and change output.cpp:90 to EXECUTION_LOG_INFO to print output
+  // execution::exec::OutputPrinter printer(output_schema);
+  execution::exec::NoOpResultConsumer printer;
+  auto exec_ctx = execution::exec::ExecutionContext(
+      db_oid_, common::ManagedPointer<transaction::TransactionContext>(txn), printer, output_schema,
+      common::ManagedPointer<catalog::CatalogAccessor>(accessor), exec_settings_, db_main_->GetMetricsManager(),
+      DISABLED, DISABLED);
+
+  std::get<0>(query_and_plan_[query_idx])
+      ->Run(common::ManagedPointer<execution::exec::ExecutionContext>(&exec_ctx), mode);
+
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 }  // namespace noisepage::tpch
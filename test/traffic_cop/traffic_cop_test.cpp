@@ -210,4 +210,144 @@ TEST_F(TrafficCopTests, AsyncCommitTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, SharedPlanCacheTest) {
+  StartServer(false);
+  const auto plan_cache = db_main_->GetTrafficCop()->GetPlanCache();
+  try {
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    {
+      pqxx::work txn1(connection1);
+      txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+      txn1.exec("INSERT INTO TableA VALUES (1, 'abc');");
+      txn1.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 0);
+
+    // The first connection compiles the plan, the second one reuses it
+    connection1.prepare("select_a", "SELECT data FROM TableA WHERE id = $1");
+    connection2.prepare("select_a", "SELECT data FROM TableA WHERE id = $1");
+    {
+      pqxx::work txn1(connection1);
+      pqxx::result r = txn1.exec_prepared("select_a", 1);
+      EXPECT_EQ(r.size(), 1);
+      txn1.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 1);
+    const auto hits = plan_cache->GetNumHits();
+    const auto misses = plan_cache->GetNumMisses();
+    {
+      pqxx::work txn2(connection2);
+      pqxx::result r = txn2.exec_prepared("select_a", 1);
+      EXPECT_EQ(r.size(), 1);
+      txn2.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 1);
+    EXPECT_EQ(plan_cache->GetNumHits(), hits + 1);
+    EXPECT_EQ(plan_cache->GetNumMisses(), misses);
+
+    // DDL drops every cached plan, and no plans are cached for the old catalog until it commits
+    {
+      pqxx::work txn1(connection1);
+      txn1.exec("CREATE INDEX index_a ON TableA (data);");
+      EXPECT_EQ(plan_cache->GetNumEntries(), 0);
+      {
+        pqxx::work txn2(connection2);
+        pqxx::result r = txn2.exec_prepared("select_a", 1);
+        EXPECT_EQ(r.size(), 1);
+        txn2.commit();
+      }
+      EXPECT_EQ(plan_cache->GetNumEntries(), 0);
+      txn1.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 0);
+
+    // New statistics drop every cached plan as well
+    {
+      pqxx::work txn2(connection2);
+      pqxx::result r = txn2.exec_prepared("select_a", 1);
+      EXPECT_EQ(r.size(), 1);
+      txn2.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 1);
+    {
+      pqxx::work txn1(connection1);
+      txn1.exec("ANALYZE TableA;");
+      txn1.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 0);
+
+    // A budget smaller than any plan disables the cache
+    plan_cache->SetSizeLimit(0);
+    {
+      pqxx::work txn1(connection1);
+      pqxx::result r = txn1.exec("SELECT data FROM TableA WHERE id = 1;");
+      EXPECT_EQ(r.size(), 1);
+      txn1.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), 0);
+    EXPECT_EQ(plan_cache->GetSize(), 0);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, AutoParameterizeTest) {
+  StartServer(false);
+  const auto plan_cache = db_main_->GetTrafficCop()->GetPlanCache();
+  try {
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    {
+      pqxx::work txn1(connection1);
+      txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+      txn1.exec("INSERT INTO TableA VALUES (1, 'abc');");
+      txn1.exec("INSERT INTO TableA VALUES (2, 'def');");
+      txn1.commit();
+    }
+    // The INSERTs above were auto-parameterized as well
+    const auto num_entries = plan_cache->GetNumEntries();
+
+    // Simple queries that only differ in the literals of their predicate share one plan, across connections too
+    {
+      pqxx::work txn1(connection1);
+      pqxx::result r = txn1.exec("SELECT data, 1 FROM TableA WHERE id = 1;");
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<std::string>(), "abc");
+      EXPECT_EQ(r[0][1].as<int>(), 1);
+      txn1.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), num_entries + 1);
+    const auto hits = plan_cache->GetNumHits();
+    {
+      pqxx::work txn2(connection2);
+      pqxx::result r = txn2.exec("SELECT data, 1 FROM TableA WHERE id = 2;");
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<std::string>(), "def");
+      EXPECT_EQ(r[0][1].as<int>(), 1);
+      txn2.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), num_entries + 1);
+    EXPECT_EQ(plan_cache->GetNumHits(), hits + 1);
+
+    // A constant in the select list is part of the plan, not a parameter
+    {
+      pqxx::work txn2(connection2);
+      pqxx::result r = txn2.exec("SELECT data, 2 FROM TableA WHERE id = 2;");
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][1].as<int>(), 2);
+      txn2.commit();
+    }
+    EXPECT_EQ(plan_cache->GetNumEntries(), num_entries + 2);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
 }  // namespace noisepage::trafficcop
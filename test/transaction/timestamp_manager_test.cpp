@@ -0,0 +1,106 @@
+#include "transaction/timestamp_manager.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "storage/record_buffer.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::transaction {
+
+class TimestampManagerTests : public TerrierTest {
+ protected:
+  storage::RecordBufferSegmentPool buffer_pool_{10000, 10000};
+  TimestampManager timestamp_manager_;
+  TransactionManager txn_manager_{common::ManagedPointer(&timestamp_manager_), DISABLED,
+                                  common::ManagedPointer(&buffer_pool_), false, false, DISABLED};
+
+  void Finish(TransactionContext *const txn) {
+    txn_manager_.Commit(txn, TransactionUtil::EmptyCallback, nullptr);
+    delete txn;
+  }
+};
+
+// Txns that finish out of order leave the oldest running txn behind
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, OutOfOrderFinishTest) {
+  auto *const first = txn_manager_.BeginTransaction();
+  auto *const second = txn_manager_.BeginTransaction();
+  auto *const third = txn_manager_.BeginTransaction();
+  EXPECT_EQ(first->StartTime(), timestamp_manager_.OldestTransactionStartTime());
+
+  Finish(second);
+  EXPECT_EQ(first->StartTime(), timestamp_manager_.OldestTransactionStartTime());
+  Finish(first);
+  EXPECT_EQ(third->StartTime(), timestamp_manager_.OldestTransactionStartTime());
+  EXPECT_EQ(third->StartTime(), timestamp_manager_.CachedOldestTransactionStartTime());
+  Finish(third);
+  // Without running txns, the oldest start time is the current time
+  EXPECT_EQ(timestamp_manager_.CurrentTime(), timestamp_manager_.OldestTransactionStartTime());
+}
+
+// A long-running txn at the front of a shard does not keep the txns that finished after it around
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, LongRunningTxnTest) {
+  auto *const long_running = txn_manager_.BeginTransaction();
+  const auto &shard = timestamp_manager_.running_txn_shards_[TimestampManager::ThreadShard()];
+  std::vector<TransactionContext *> running;
+  for (uint32_t i = 0; i < 10000; i++) {
+    running.push_back(txn_manager_.BeginTransaction());
+    // Keep a few txns running at a time, and finish them out of order
+    if (running.size() == 4) {
+      Finish(running[2]);
+      Finish(running[0]);
+      running.erase(running.begin() + 2);
+      running.erase(running.begin());
+    }
+    EXPECT_LE(shard.txns_.size(), 2 * (running.size() + 1));
+  }
+  EXPECT_EQ(long_running->StartTime(), timestamp_manager_.OldestTransactionStartTime());
+
+  for (auto *const txn : running) Finish(txn);
+  Finish(long_running);
+  EXPECT_TRUE(shard.txns_.empty());
+  EXPECT_EQ(timestamp_manager_.CurrentTime(), timestamp_manager_.OldestTransactionStartTime());
+}
+
+// Txns begun on many threads, and finished on threads other than the one that began them, are never newer than the
+// oldest start time reported while they run
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, ConcurrentBeginTest) {
+  const uint32_t num_threads = 2 * TimestampManager::NUM_RUNNING_TXN_SHARDS;
+  const uint32_t num_txns = 1000;
+  std::vector<std::vector<TransactionContext *>> handed_over(num_threads);
+  std::atomic<uint32_t> num_violations = 0;
+  std::vector<std::thread> threads;
+  for (uint32_t thread_id = 0; thread_id < num_threads; thread_id++) {
+    threads.emplace_back([&, thread_id] {
+      for (uint32_t i = 0; i < num_txns; i++) {
+        auto *const txn = txn_manager_.BeginTransaction();
+        if (timestamp_manager_.OldestTransactionStartTime() > txn->StartTime()) num_violations++;
+        if (i % 2 == 0) {
+          Finish(txn);
+        } else {
+          handed_over[thread_id].push_back(txn);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(0, num_violations.load());
+
+  // Finish the rest in reverse, on a thread that began none of them
+  for (auto it = handed_over.rbegin(); it != handed_over.rend(); it++) {
+    for (auto *const txn : *it) {
+      EXPECT_LE(timestamp_manager_.OldestTransactionStartTime(), txn->StartTime());
+      Finish(txn);
+    }
+  }
+  EXPECT_EQ(timestamp_manager_.CurrentTime(), timestamp_manager_.OldestTransactionStartTime());
+}
+
+}  // namespace noisepage::transaction
@@ -29,6 +29,7 @@
 #include "execution/util/timer.h"
 #include "execution/vm/bytecode_generator.h"
 #include "execution/vm/bytecode_module.h"
+#include "execution/vm/bytecode_pair_profiler.h"
 #include "execution/vm/llvm_engine.h"
 #include "execution/vm/module.h"
 #include "execution/vm/module_metadata.h"
@@ -58,6 +59,8 @@ llvm::cl::opt<std::string> DATA_DIR("data", llvm::cl::desc("Where to find data f
 llvm::cl::opt<std::string> INPUT_FILE(llvm::cl::Positional, llvm::cl::desc("<input file>"), llvm::cl::init(""), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<std::string> OUTPUT_NAME("output-name", llvm::cl::desc("Print the output name"), llvm::cl::init("schema10"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 llvm::cl::opt<std::string> HANDLERS_PATH("handlers-path", llvm::cl::desc("Path to the bytecode handlers bitcode file"), llvm::cl::init("./bytecode_handlers_ir.bc"), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
+llvm::cl::opt<bool> FUSE_SUPERINSTRUCTIONS("fuse-superinstructions", llvm::cl::desc("Fuse frequent bytecode pairs into superinstructions"), llvm::cl::init(true), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
+llvm::cl::opt<uint32_t> PROFILE_BYTECODE_PAIRS("profile-bytecode-pairs", llvm::cl::desc("Print the N most frequently interpreted bytecode pairs"), llvm::cl::init(0), llvm::cl::cat(TPL_OPTIONS_CATEGORY));  // NOLINT
 // clang-format on
 
 tbb::task_scheduler_init scheduler;
@@ -176,7 +179,7 @@ static void CompileAndRun(const std::string &source, const std::string &name = "
   std::unique_ptr<vm::BytecodeModule> bytecode_module;
   {
     util::ScopedTimer<std::milli> timer(&codegen_ms);
-    bytecode_module = vm::BytecodeGenerator::Compile(root, name);
+    bytecode_module = vm::BytecodeGenerator::Compile(root, name, FUSE_SUPERINSTRUCTIONS);
   }
 
   // Dump Bytecode
@@ -269,6 +272,16 @@ static void CompileAndRun(const std::string &source, const std::string &name = "
       "Parse: {} ms, Type-check: {} ms, Code-gen: {} ms, Interp. Exec.: {} ms, "
       "Adaptive Exec.: {} ms, Jit+Exec.: {} ms",
       parse_ms, typecheck_ms, codegen_ms, interp_exec_ms, adaptive_exec_ms, jit_exec_ms);
+
+  // Dump the bytecode pairs executed by the interpreter
+  if (PROFILE_BYTECODE_PAIRS > 0) {
+    if (vm::BytecodePairProfiler::IsEnabled()) {
+      vm::BytecodePairProfiler::Instance()->Dump(std::cout, PROFILE_BYTECODE_PAIRS);  // NOLINT
+      vm::BytecodePairProfiler::Instance()->Reset();
+    } else {
+      EXECUTION_LOG_WARN("Bytecode pair profiling requires a build with NOISEPAGE_PROFILE_BYTECODE_PAIRS=ON");
+    }
+  }
   txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 